@@ -22,8 +22,14 @@ compile_all="$compile_all \"$src_path/DataSetByFeatureCombination.cpp\""
 compile_all="$compile_all \"$src_path/InteractionDetection.cpp\""
 compile_all="$compile_all \"$src_path/Logging.cpp\""
 compile_all="$compile_all \"$src_path/SamplingWithReplacement.cpp\""
+compile_all="$compile_all \"$src_path/SamplingWithoutReplacement.cpp\""
+compile_all="$compile_all \"$src_path/SamplingGradientOneSide.cpp\""
 compile_all="$compile_all \"$src_path/Boosting.cpp\""
 compile_all="$compile_all \"$src_path/Discretization.cpp\""
+compile_all="$compile_all \"$src_path/Scoring.cpp\""
+compile_all="$compile_all \"$src_path/ModelFile.cpp\""
+compile_all="$compile_all \"$src_path/TrainValidationSplit.cpp\""
+compile_all="$compile_all \"$src_path/DataSetShared.cpp\""
 compile_all="$compile_all -I\"$src_path\""
 compile_all="$compile_all -I\"$src_path/inc\""
 compile_all="$compile_all -Wall -Wextra -Wno-parentheses -Wold-style-cast -Wdouble-promotion -Wshadow -Wformat=2 -std=c++11"
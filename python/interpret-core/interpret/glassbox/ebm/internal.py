@@ -167,6 +167,208 @@ class Native:
         ]
         self.lib.InitializeBoostingRegression.restype = ct.c_void_p
 
+        # the *Split functions and GenerateTrainValidationSplit are not used by the
+        # EBM fit paths yet.  See the TODO in EBMUtils.ebm_train_test_split
+        self.lib.InitializeBoostingClassificationSplit.argtypes = [
+            # int64_t countTargetClasses
+            ct.c_longlong,
+            # int64_t countFeatures
+            ct.c_longlong,
+            # EbmNativeFeature * features
+            ct.POINTER(self.EbmNativeFeature),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t * binnedData
+            ndpointer(dtype=np.int64, ndim=2, flags="C_CONTIGUOUS"),
+            # int64_t * targets
+            ndpointer(dtype=np.int64, ndim=1),
+            # double * predictorScores
+            # scores can either be 1 or 2 dimensional
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+            # double validationFraction
+            ct.c_double,
+            # int64_t countInnerBags
+            ct.c_longlong,
+            # int64_t randomSeed
+            ct.c_longlong,
+            # double * optionalTempParams
+            ct.POINTER(ct.c_double),
+        ]
+        self.lib.InitializeBoostingClassificationSplit.restype = ct.c_void_p
+
+        self.lib.InitializeBoostingRegressionSplit.argtypes = [
+            # int64_t countFeatures
+            ct.c_longlong,
+            # EbmNativeFeature * features
+            ct.POINTER(self.EbmNativeFeature),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t * binnedData
+            ndpointer(dtype=np.int64, ndim=2, flags="C_CONTIGUOUS"),
+            # double * targets
+            ndpointer(dtype=np.float64, ndim=1),
+            # double * predictorScores
+            # scores can either be 1 or 2 dimensional
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+            # double validationFraction
+            ct.c_double,
+            # int64_t countInnerBags
+            ct.c_longlong,
+            # int64_t randomSeed
+            ct.c_longlong,
+            # double * optionalTempParams
+            ct.POINTER(ct.c_double),
+        ]
+        self.lib.InitializeBoostingRegressionSplit.restype = ct.c_void_p
+
+        self.lib.GenerateTrainValidationSplit.argtypes = [
+            # int64_t randomSeed
+            ct.c_longlong,
+            # int64_t countTargetClasses
+            ct.c_longlong,
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t * targets
+            ndpointer(dtype=np.int64, ndim=1),
+            # double validationFraction
+            ct.c_double,
+            # int64_t * isValidationOut
+            ndpointer(dtype=np.int64, ndim=1, flags="C_CONTIGUOUS"),
+        ]
+        self.lib.GenerateTrainValidationSplit.restype = ct.c_longlong
+
+        self.lib.SizeDataSetHeader.argtypes = [
+            # int64_t countFeatures
+            ct.c_longlong,
+        ]
+        self.lib.SizeDataSetHeader.restype = ct.c_longlong
+
+        self.lib.SizeFeature.argtypes = [
+            # int64_t countBins
+            ct.c_longlong,
+            # int64_t countInstances
+            ct.c_longlong,
+        ]
+        self.lib.SizeFeature.restype = ct.c_longlong
+
+        self.lib.SizeClassificationTarget.argtypes = [
+            # int64_t countTargetClasses
+            ct.c_longlong,
+            # int64_t countInstances
+            ct.c_longlong,
+        ]
+        self.lib.SizeClassificationTarget.restype = ct.c_longlong
+
+        self.lib.SizeRegressionTarget.argtypes = [
+            # int64_t countInstances
+            ct.c_longlong,
+        ]
+        self.lib.SizeRegressionTarget.restype = ct.c_longlong
+
+        self.lib.FillDataSetHeader.argtypes = [
+            # int64_t countFeatures
+            ct.c_longlong,
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t countBytesAllocated
+            ct.c_longlong,
+            # unsigned char * fillMem
+            ct.POINTER(ct.c_ubyte),
+        ]
+        self.lib.FillDataSetHeader.restype = ct.c_longlong
+
+        self.lib.FillFeature.argtypes = [
+            # int64_t featureType
+            ct.c_longlong,
+            # int64_t hasMissing
+            ct.c_longlong,
+            # int64_t countBins
+            ct.c_longlong,
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t * binnedData
+            ndpointer(dtype=np.int64, ndim=1),
+            # int64_t countBytesAllocated
+            ct.c_longlong,
+            # unsigned char * fillMem
+            ct.POINTER(ct.c_ubyte),
+        ]
+        self.lib.FillFeature.restype = ct.c_longlong
+
+        self.lib.FillClassificationTarget.argtypes = [
+            # int64_t countTargetClasses
+            ct.c_longlong,
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t * targets
+            ndpointer(dtype=np.int64, ndim=1),
+            # int64_t countBytesAllocated
+            ct.c_longlong,
+            # unsigned char * fillMem
+            ct.POINTER(ct.c_ubyte),
+        ]
+        self.lib.FillClassificationTarget.restype = ct.c_longlong
+
+        self.lib.FillRegressionTarget.argtypes = [
+            # int64_t countInstances
+            ct.c_longlong,
+            # double * targets
+            ndpointer(dtype=np.float64, ndim=1),
+            # int64_t countBytesAllocated
+            ct.c_longlong,
+            # unsigned char * fillMem
+            ct.POINTER(ct.c_ubyte),
+        ]
+        self.lib.FillRegressionTarget.restype = ct.c_longlong
+
+        self.lib.InitializeBoostingFromDataSet.argtypes = [
+            # void * dataSet
+            ct.c_void_p,
+            # int64_t * isValidation
+            ndpointer(dtype=np.int64, ndim=1),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # double * predictorScores
+            # scores can either be 1 or 2 dimensional
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+            # int64_t countInnerBags
+            ct.c_longlong,
+            # int64_t randomSeed
+            ct.c_longlong,
+            # double * optionalTempParams
+            ct.POINTER(ct.c_double),
+        ]
+        self.lib.InitializeBoostingFromDataSet.restype = ct.c_void_p
+
+        self.lib.InitializeInteractionFromDataSet.argtypes = [
+            # void * dataSet
+            ct.c_void_p,
+            # int64_t * isValidation
+            ndpointer(dtype=np.int64, ndim=1),
+            # double * predictorScores
+            # scores can either be 1 or 2 dimensional
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+            # double * optionalTempParams
+            ct.POINTER(ct.c_double),
+        ]
+        self.lib.InitializeInteractionFromDataSet.restype = ct.c_void_p
+
         self.lib.GenerateModelFeatureCombinationUpdate.argtypes = [
             # void * ebmBoosting
             ct.c_void_p,
@@ -201,6 +403,38 @@ class Native:
         ]
         self.lib.ApplyModelFeatureCombinationUpdate.restype = ct.c_longlong
 
+        self.lib.BoostCyclic.argtypes = [
+            # void * ebmBoosting
+            ct.c_void_p,
+            # int64_t countFeatureCombinationsToBoost
+            ct.c_longlong,
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # int64_t countRoundsMax
+            ct.c_longlong,
+            # int64_t countStepsPerFeatureCombination
+            ct.c_longlong,
+            # double learningRate
+            ct.c_double,
+            # int64_t countTreeSplitsMax
+            ct.c_longlong,
+            # int64_t countInstancesRequiredForParentSplitMin
+            ct.c_longlong,
+            # double * trainingWeights
+            ct.c_void_p,
+            # double * validationWeights
+            ct.c_void_p,
+            # int64_t earlyStoppingRunLength
+            ct.c_longlong,
+            # double earlyStoppingTolerance
+            ct.c_double,
+            # int64_t * countRoundsReturn
+            ct.POINTER(ct.c_longlong),
+            # double * bestValidationMetricReturn
+            ct.POINTER(ct.c_double),
+        ]
+        self.lib.BoostCyclic.restype = ct.c_longlong
+
         self.lib.GetBestModelFeatureCombination.argtypes = [
             # void * ebmBoosting
             ct.c_void_p,
@@ -222,6 +456,277 @@ class Native:
             ct.c_void_p
         ]
 
+        self.lib.ScoreInstancesClassification.argtypes = [
+            # int64_t countTargetClasses
+            ct.c_longlong,
+            # int64_t countFeatures
+            ct.c_longlong,
+            # EbmNativeFeature * features
+            ct.POINTER(self.EbmNativeFeature),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # double ** modelFeatureCombinationTensors
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # double * intercept
+            ndpointer(dtype=np.float64, ndim=1),
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t * binnedData
+            ndpointer(dtype=np.int64, ndim=2, flags="C_CONTIGUOUS"),
+            # int64_t isBinnedDataRowMajor
+            ct.c_longlong,
+            # int64_t isProbabilities
+            ct.c_longlong,
+            # double * scoresReturn
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+        ]
+        self.lib.ScoreInstancesClassification.restype = ct.c_longlong
+
+        self.lib.ScoreInstancesRegression.argtypes = [
+            # int64_t countFeatures
+            ct.c_longlong,
+            # EbmNativeFeature * features
+            ct.POINTER(self.EbmNativeFeature),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # double ** modelFeatureCombinationTensors
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # double * intercept
+            ndpointer(dtype=np.float64, ndim=1),
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t * binnedData
+            ndpointer(dtype=np.int64, ndim=2, flags="C_CONTIGUOUS"),
+            # int64_t isBinnedDataRowMajor
+            ct.c_longlong,
+            # double * scoresReturn
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+        ]
+        self.lib.ScoreInstancesRegression.restype = ct.c_longlong
+
+        self.lib.ScoreRawInstancesClassification.argtypes = [
+            # int64_t countTargetClasses
+            ct.c_longlong,
+            # int64_t countFeatures
+            ct.c_longlong,
+            # EbmNativeFeature * features
+            ct.POINTER(self.EbmNativeFeature),
+            # double ** cutPointsLowerBoundInclusive
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # double ** modelFeatureCombinationTensors
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # double * intercept
+            ndpointer(dtype=np.float64, ndim=1),
+            # int64_t countInstances
+            ct.c_longlong,
+            # double * rawData
+            ndpointer(dtype=np.float64, ndim=2, flags="C_CONTIGUOUS"),
+            # int64_t isRawDataRowMajor
+            ct.c_longlong,
+            # int64_t isProbabilities
+            ct.c_longlong,
+            # double * scoresReturn
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+        ]
+        self.lib.ScoreRawInstancesClassification.restype = ct.c_longlong
+
+        self.lib.ScoreRawInstancesRegression.argtypes = [
+            # int64_t countFeatures
+            ct.c_longlong,
+            # EbmNativeFeature * features
+            ct.POINTER(self.EbmNativeFeature),
+            # double ** cutPointsLowerBoundInclusive
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # double ** modelFeatureCombinationTensors
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # double * intercept
+            ndpointer(dtype=np.float64, ndim=1),
+            # int64_t countInstances
+            ct.c_longlong,
+            # double * rawData
+            ndpointer(dtype=np.float64, ndim=2, flags="C_CONTIGUOUS"),
+            # int64_t isRawDataRowMajor
+            ct.c_longlong,
+            # double * scoresReturn
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+        ]
+        self.lib.ScoreRawInstancesRegression.restype = ct.c_longlong
+
+        self.lib.GetTermContributionsClassification.argtypes = [
+            # int64_t countTargetClasses
+            ct.c_longlong,
+            # int64_t countFeatures
+            ct.c_longlong,
+            # EbmNativeFeature * features
+            ct.POINTER(self.EbmNativeFeature),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # double ** modelFeatureCombinationTensors
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t * binnedData
+            ndpointer(dtype=np.int64, ndim=2, flags="C_CONTIGUOUS"),
+            # int64_t isBinnedDataRowMajor
+            ct.c_longlong,
+            # int64_t countTopTerms
+            ct.c_longlong,
+            # int64_t * termIndexesReturn
+            # None when countTopTerms is zero
+            ct.POINTER(ct.c_longlong),
+            # double * contributionsReturn
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+        ]
+        self.lib.GetTermContributionsClassification.restype = ct.c_longlong
+
+        self.lib.GetTermContributionsRegression.argtypes = [
+            # int64_t countFeatures
+            ct.c_longlong,
+            # EbmNativeFeature * features
+            ct.POINTER(self.EbmNativeFeature),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # double ** modelFeatureCombinationTensors
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t * binnedData
+            ndpointer(dtype=np.int64, ndim=2, flags="C_CONTIGUOUS"),
+            # int64_t isBinnedDataRowMajor
+            ct.c_longlong,
+            # int64_t countTopTerms
+            ct.c_longlong,
+            # int64_t * termIndexesReturn
+            # None when countTopTerms is zero
+            ct.POINTER(ct.c_longlong),
+            # double * contributionsReturn
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+        ]
+        self.lib.GetTermContributionsRegression.restype = ct.c_longlong
+
+        self.lib.SaveModelClassification.argtypes = [
+            # int64_t countTargetClasses
+            ct.c_longlong,
+            # int64_t countFeatures
+            ct.c_longlong,
+            # EbmNativeFeature * features
+            ct.POINTER(self.EbmNativeFeature),
+            # double ** cutPointsLowerBoundInclusive
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # double ** modelFeatureCombinationTensors
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # double * intercept
+            ct.POINTER(ct.c_double),
+            # char * filePath
+            ct.c_char_p,
+        ]
+        self.lib.SaveModelClassification.restype = ct.c_longlong
+
+        self.lib.SaveModelRegression.argtypes = [
+            # int64_t countFeatures
+            ct.c_longlong,
+            # EbmNativeFeature * features
+            ct.POINTER(self.EbmNativeFeature),
+            # double ** cutPointsLowerBoundInclusive
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # int64_t countFeatureCombinations
+            ct.c_longlong,
+            # EbmNativeFeatureCombination * featureCombinations
+            ct.POINTER(self.EbmNativeFeatureCombination),
+            # int64_t * featureCombinationIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # double ** modelFeatureCombinationTensors
+            ct.POINTER(ct.POINTER(ct.c_double)),
+            # double * intercept
+            ct.POINTER(ct.c_double),
+            # char * filePath
+            ct.c_char_p,
+        ]
+        self.lib.SaveModelRegression.restype = ct.c_longlong
+
+        self.lib.LoadModel.argtypes = [
+            # char * filePath
+            ct.c_char_p
+        ]
+        self.lib.LoadModel.restype = ct.c_void_p
+
+        self.lib.GetModelCountTargetClasses.argtypes = [
+            # void * ebmModel
+            ct.c_void_p
+        ]
+        self.lib.GetModelCountTargetClasses.restype = ct.c_longlong
+
+        self.lib.ScoreModelInstances.argtypes = [
+            # void * ebmModel
+            ct.c_void_p,
+            # int64_t countInstances
+            ct.c_longlong,
+            # int64_t * binnedData
+            ndpointer(dtype=np.int64, ndim=2, flags="C_CONTIGUOUS"),
+            # int64_t isBinnedDataRowMajor
+            ct.c_longlong,
+            # int64_t isProbabilities
+            ct.c_longlong,
+            # double * scoresReturn
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+        ]
+        self.lib.ScoreModelInstances.restype = ct.c_longlong
+
+        self.lib.ScoreModelRawInstances.argtypes = [
+            # void * ebmModel
+            ct.c_void_p,
+            # int64_t countInstances
+            ct.c_longlong,
+            # double * rawData
+            ndpointer(dtype=np.float64, ndim=2, flags="C_CONTIGUOUS"),
+            # int64_t isRawDataRowMajor
+            ct.c_longlong,
+            # int64_t isProbabilities
+            ct.c_longlong,
+            # double * scoresReturn
+            ndpointer(dtype=np.float64, flags="C_CONTIGUOUS"),
+        ]
+        self.lib.ScoreModelRawInstances.restype = ct.c_longlong
+
+        self.lib.FreeModel.argtypes = [
+            # void * ebmModel
+            ct.c_void_p
+        ]
+
         self.lib.InitializeInteractionClassification.argtypes = [
             # int64_t countTargetClasses
             ct.c_longlong,
@@ -273,6 +778,34 @@ class Native:
         ]
         self.lib.GetInteractionScore.restype = ct.c_longlong
 
+        self.lib.GetInteractionScoresAnchored.argtypes = [
+            # void * ebmInteraction
+            ct.c_void_p,
+            # int64_t indexFeatureAnchor
+            ct.c_longlong,
+            # int64_t countPartners
+            ct.c_longlong,
+            # int64_t * partnerFeatureIndexes
+            ndpointer(dtype=np.int64, ndim=1),
+            # double * interactionScoresReturn
+            ndpointer(dtype=np.float64, ndim=1),
+        ]
+        self.lib.GetInteractionScoresAnchored.restype = ct.c_longlong
+
+        self.lib.GetTopInteractionPairs.argtypes = [
+            # void * ebmInteraction
+            ct.c_void_p,
+            # int64_t countPairsMax
+            ct.c_longlong,
+            # int64_t * pairFeatureIndexesReturn
+            ndpointer(dtype=np.int64, ndim=2, flags="C_CONTIGUOUS"),
+            # double * interactionScoresReturn
+            ndpointer(dtype=np.float64, ndim=1),
+            # int64_t * countPairsReturn
+            ct.POINTER(ct.c_longlong),
+        ]
+        self.lib.GetTopInteractionPairs.restype = ct.c_longlong
+
         self.lib.FreeInteraction.argtypes = [
             # void * ebmInteraction
             ct.c_void_p
@@ -708,6 +1241,61 @@ class NativeEBMBoosting:
         # log.debug("Boosting step end")
         return metric_output.value
 
+    def boost_cyclic(
+        self,
+        n_rounds,
+        learning_rate,
+        max_tree_splits,
+        min_cases_for_split,
+        boosting_step_episodes,
+        early_stopping_run_length,
+        early_stopping_tolerance,
+    ):
+
+        """ Boosts each feature combination in turn for up to n_rounds
+            rounds inside a single native call.
+
+        Args:
+            n_rounds: Maximum number of rounds over all feature combinations.
+            learning_rate: Learning rate as a float.
+            max_tree_splits: Max tree splits on feature step.
+            min_cases_for_split: Min observations required to split.
+            boosting_step_episodes: Number of episodes to boost feature step.
+            early_stopping_run_length: Number of rounds without improvement
+                before stopping.  Negative values disable early stopping.
+            early_stopping_tolerance: Minimum improvement in the best
+                validation metric that resets the run length.
+
+        Returns:
+            Number of rounds completed and the best validation metric.
+        """
+
+        n_rounds_return = ct.c_longlong(0)
+        min_metric = ct.c_double(0.0)
+        feature_combination_indexes = np.arange(
+            len(self._feature_combinations), dtype=np.int64
+        )
+        return_code = self._native.lib.BoostCyclic(
+            self._booster_pointer,
+            len(feature_combination_indexes),
+            feature_combination_indexes,
+            n_rounds,
+            boosting_step_episodes,
+            learning_rate,
+            max_tree_splits,
+            min_cases_for_split,
+            0,
+            0,
+            early_stopping_run_length,
+            early_stopping_tolerance,
+            ct.byref(n_rounds_return),
+            ct.byref(min_metric),
+        )
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in BoostCyclic")
+
+        return n_rounds_return.value, min_metric.value
+
     def _get_feature_combination_shape(self, feature_combination_index):
         # TODO PK do this once during construction so that we don't have to do it again
         #         and so that we don't have to store self._features & self._feature_combinations
@@ -969,6 +1557,43 @@ class NativeEBMInteraction:
         log.info("Fast interaction score end")
         return score.value
 
+    def get_interaction_scores_anchored(self, anchor_index, partner_indexes):
+        """ Provides scores for the pairs (anchor_index, partner) of each partner, reading the data once per block of partners. Higher is better."""
+        log.info("Fast anchored interaction scores start")
+        partner_indexes = np.array(partner_indexes, dtype=np.int64)
+        scores = np.zeros(len(partner_indexes), dtype=np.float64)
+        return_code = self._native.lib.GetInteractionScoresAnchored(
+            self._interaction_pointer,
+            anchor_index,
+            len(partner_indexes),
+            partner_indexes,
+            scores,
+        )
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in GetInteractionScoresAnchored")
+
+        log.info("Fast anchored interaction scores end")
+        return scores
+
+    def get_top_interaction_pairs(self, count_pairs_max):
+        """ Provides the highest scoring feature pairs and their scores, skipping pairs whose upper bound can't reach the top."""
+        log.info("Top interaction pairs start")
+        pairs = np.zeros((count_pairs_max, 2), dtype=np.int64)
+        scores = np.zeros(count_pairs_max, dtype=np.float64)
+        count_pairs = ct.c_longlong(0)
+        return_code = self._native.lib.GetTopInteractionPairs(
+            self._interaction_pointer,
+            count_pairs_max,
+            pairs,
+            scores,
+            ct.byref(count_pairs),
+        )
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in GetTopInteractionPairs")
+
+        log.info("Top interaction pairs end")
+        return pairs[: count_pairs.value], scores[: count_pairs.value]
+
 
 class NativeHelper:
     @staticmethod
@@ -996,8 +1621,6 @@ class NativeHelper:
         optional_temp_params=None,
     ):
 
-        min_metric = np.inf
-        episode_index = 0
         with closing(
             NativeEBMBoosting(
                 model_type,
@@ -1015,44 +1638,18 @@ class NativeHelper:
                 optional_temp_params,
             )
         ) as native_ebm_boosting:
-            no_change_run_length = 0
-            bp_metric = np.inf
             log.info("Start boosting {0}".format(name))
-            for episode_index in range(data_n_episodes):
-                if episode_index % 10 == 0:
-                    log.debug("Sweep Index for {0}: {1}".format(name, episode_index))
-                    log.debug("Metric: {0}".format(min_metric))
-
-                for feature_combination_index in range(len(feature_combinations)):
-                    curr_metric = native_ebm_boosting.boosting_step(
-                        feature_combination_index=feature_combination_index,
-                        learning_rate=learning_rate,
-                        max_tree_splits=max_tree_splits,
-                        min_cases_for_split=min_cases_for_splits,
-                        boosting_step_episodes=boosting_step_episodes,
-                    )
-
-                    min_metric = min(curr_metric, min_metric)
-
-                # TODO PK this early_stopping_tolerance is a little inconsistent
-                #      since it triggers intermittently and only re-triggers if the
-                #      threshold is re-passed, but not based on a smooth windowed set
-                #      of checks.  We can do better by keeping a list of the last
-                #      number of measurements to have a consistent window of values.
-                #      If we only cared about the metric at the start and end of the epoch
-                #      window a circular buffer would be best choice with O(1).
-                if no_change_run_length == 0:
-                    bp_metric = min_metric
-                if min_metric + early_stopping_tolerance < bp_metric:
-                    no_change_run_length = 0
-                else:
-                    no_change_run_length += 1
-
-                if (
-                    early_stopping_run_length >= 0
-                    and no_change_run_length >= early_stopping_run_length
-                ):
-                    break
+            n_rounds, min_metric = native_ebm_boosting.boost_cyclic(
+                n_rounds=data_n_episodes,
+                learning_rate=learning_rate,
+                max_tree_splits=max_tree_splits,
+                min_cases_for_split=min_cases_for_splits,
+                boosting_step_episodes=boosting_step_episodes,
+                early_stopping_run_length=early_stopping_run_length,
+                early_stopping_tolerance=early_stopping_tolerance,
+            )
+            # keep reporting the index of the last round, as our python loop did
+            episode_index = max(n_rounds - 1, 0)
 
             log.info(
                 "End boosting {0}, Best Metric: {1}, Num Rounds: {2}".format(
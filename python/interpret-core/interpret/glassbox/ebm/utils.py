@@ -29,6 +29,11 @@ class EBMUtils:
         # all test/train splits should be done with this function to ensure that
         # if we re-generate the train/test splits that they are generated exactly
         # the same as before
+        # TODO PK the native library now has GenerateTrainValidationSplit and
+        #         InitializeBoosting*Split which split the binned data without copying it.
+        #         We still use sklearn here because switching would change the splits that
+        #         existing random_state values produce, and the interaction detection and
+        #         pair scoring below still need X_train and X_val as separate arrays
         if test_size > 0:
             if is_train:
                 X_train, X_val, y_train, y_val = train_test_split(
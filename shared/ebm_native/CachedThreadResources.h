@@ -5,8 +5,6 @@
 #ifndef CACHED_THREAD_RESOURCES_H
 #define CACHED_THREAD_RESOURCES_H
 
-#include <vector>
-#include <queue>
 #include <stdlib.h> // malloc, realloc, free
 #include <stddef.h> // size_t, ptrdiff_t
 
@@ -15,45 +13,110 @@
 
 #include "TreeNode.h"
 
+// TreeNodeHeap is a max-heap of the TreeNodes that we're considering for splitting, ordered by their split gain.  GrowDecisionTree can only ever 
+// push TreeNodes that it has allocated children for in ThreadByteBuffer2, so the number of TreeNodes in our heap is bounded by the size of that buffer
+// and we can allocate our array once up front.  Unlike std::priority_queue we never allocate while boosting, and we can't throw exceptions.
 template<bool bClassification>
-class CompareTreeNodeSplittingGain final {
+class TreeNodeHeap final {
+   TreeNode<bClassification> ** m_apTreeNodes;
+   size_t m_cTreeNodes;
+   size_t m_cTreeNodesCapacity;
+
+   static EBM_INLINE FloatEbmType GetSplitGain(const TreeNode<bClassification> * const pTreeNode) {
+      return pTreeNode->m_UNION.m_afterExaminationForPossibleSplitting.m_splitGain;
+   }
+
 public:
-   // TODO : check how efficient this is.  Is there a faster way to to this
-   EBM_INLINE bool operator() (const TreeNode<bClassification> * const & lhs, const TreeNode<bClassification> * const & rhs) const {
-      return lhs->m_UNION.m_afterExaminationForPossibleSplitting.m_splitGain <= rhs->m_UNION.m_afterExaminationForPossibleSplitting.m_splitGain;
+
+   TreeNodeHeap()
+      : m_apTreeNodes(nullptr)
+      , m_cTreeNodes(0)
+      , m_cTreeNodesCapacity(0) {
    }
-};
 
-template<bool bClassification>
-class SafeTreeNodeQueue final {
-   // make it zero the error just in case someone introduces an initialization bug such that this doesn't set set.  The default will be an error then
-   bool m_bSuccess;
+   ~TreeNodeHeap() {
+      free(m_apTreeNodes);
+   }
 
-public:
-   // THIS SHOULD ALWAYS BE THE LAST ITEM IN THIS STRUCTURE.  C++ guarantees that constructions initialize data members in the order that they are declared
-   // since this class can potentially throw an exception in the constructor, we leave it last so that we are guaranteed that the rest of our object 
-   // has been initialized
-   std::priority_queue<TreeNode<bClassification> *, std::vector<TreeNode<bClassification> *>, CompareTreeNodeSplittingGain<bClassification>> m_queue;
-
-   // in case you were wondering, this odd syntax of putting a try outside the function is called "Function try blocks" and it's the best way of 
-   // handling exception in initialization
-   SafeTreeNodeQueue() try
-      : m_bSuccess(false)
-      , m_queue() {
-      // an unfortunate thing about function exception handling is that accessing non-static data from the catch block gives undefined behavior
-      // so, we can't set m_bSuccess to false if an error occurs, so instead we set it to false in the static initialization
-      // C++ guarantees that initialization will occur in the order the variables are declared (not in the order of initialization)
-      // but since we put m_bSuccess at the top, if an exception occurs then our m_bSuccess will be left as false since it won't call the 
-      // initializer which sets it to true
-      // https://en.cppreference.com/w/cpp/language/function-try-block
-      m_bSuccess = true;
-   } catch(...) {
-      // the only reason we should potentially find outselves here is if there was an exception thrown during construction
-      // C++ exceptions are suposed to be thrown by value and caught by reference, so it shouldn't be a pointer, and we shouldn't leak memory
-   }
-
-   EBM_INLINE bool IsSuccess() const {
-      return m_bSuccess;
+   EBM_INLINE bool Reserve(const size_t cTreeNodesCapacity) {
+      if(UNLIKELY(m_cTreeNodesCapacity < cTreeNodesCapacity)) {
+         LOG_N(TraceLevelInfo, "Growing TreeNodeHeap to %zu", cTreeNodesCapacity);
+         if(IsMultiplyError(sizeof(TreeNode<bClassification> *), cTreeNodesCapacity)) {
+            LOG_0(TraceLevelWarning, "WARNING TreeNodeHeap::Reserve IsMultiplyError(sizeof(TreeNode<bClassification> *), cTreeNodesCapacity)");
+            return true;
+         }
+         EBM_ASSERT(0 == m_cTreeNodes); // we don't preserve our contents, so only reserve when we're empty
+         free(m_apTreeNodes);
+         m_apTreeNodes = static_cast<TreeNode<bClassification> **>(malloc(sizeof(TreeNode<bClassification> *) * cTreeNodesCapacity));
+         if(UNLIKELY(nullptr == m_apTreeNodes)) {
+            LOG_0(TraceLevelWarning, "WARNING TreeNodeHeap::Reserve nullptr == m_apTreeNodes");
+            m_cTreeNodesCapacity = 0;
+            return true;
+         }
+         m_cTreeNodesCapacity = cTreeNodesCapacity;
+      }
+      return false;
+   }
+
+   EBM_INLINE void Clear() {
+      m_cTreeNodes = 0;
+   }
+
+   EBM_INLINE bool IsEmpty() const {
+      return 0 == m_cTreeNodes;
+   }
+
+   EBM_INLINE TreeNode<bClassification> * Top() const {
+      EBM_ASSERT(0 != m_cTreeNodes);
+      return m_apTreeNodes[0];
+   }
+
+   EBM_INLINE void Push(TreeNode<bClassification> * const pTreeNode) {
+      EBM_ASSERT(m_cTreeNodes < m_cTreeNodesCapacity);
+      const FloatEbmType splitGain = GetSplitGain(pTreeNode);
+      size_t iTreeNode = m_cTreeNodes;
+      ++m_cTreeNodes;
+      // sift up, moving parents down into the hole instead of swapping
+      while(0 != iTreeNode) {
+         const size_t iParent = (iTreeNode - 1) >> 1;
+         TreeNode<bClassification> * const pParent = m_apTreeNodes[iParent];
+         if(!(GetSplitGain(pParent) < splitGain)) {
+            break;
+         }
+         m_apTreeNodes[iTreeNode] = pParent;
+         iTreeNode = iParent;
+      }
+      m_apTreeNodes[iTreeNode] = pTreeNode;
+   }
+
+   EBM_INLINE void Pop() {
+      EBM_ASSERT(0 != m_cTreeNodes);
+      --m_cTreeNodes;
+      const size_t cTreeNodes = m_cTreeNodes;
+      if(0 != cTreeNodes) {
+         TreeNode<bClassification> * const pLast = m_apTreeNodes[cTreeNodes];
+         const FloatEbmType splitGain = GetSplitGain(pLast);
+         size_t iTreeNode = 0;
+         // sift down the last item from the top, moving bigger children up into the hole instead of swapping
+         while(true) {
+            size_t iChild = (iTreeNode << 1) + 1;
+            if(cTreeNodes <= iChild) {
+               break;
+            }
+            TreeNode<bClassification> * pChild = m_apTreeNodes[iChild];
+            const size_t iChildRight = iChild + 1;
+            if(iChildRight < cTreeNodes && GetSplitGain(pChild) < GetSplitGain(m_apTreeNodes[iChildRight])) {
+               iChild = iChildRight;
+               pChild = m_apTreeNodes[iChildRight];
+            }
+            if(!(splitGain < GetSplitGain(pChild))) {
+               break;
+            }
+            m_apTreeNodes[iTreeNode] = pChild;
+            iTreeNode = iChild;
+         }
+         m_apTreeNodes[iTreeNode] = pLast;
+      }
    }
 };
 
@@ -61,9 +124,10 @@ template<bool bClassification>
 struct HistogramBucketVectorEntry;
 
 template<bool bClassification>
-class CachedBoostingThreadResources {
-   // TODO: can I preallocate m_aThreadByteBuffer1 and m_aThreadByteBuffer2 without resorting to grow them if I examine my inputs
+struct HistogramBucket;
 
+template<bool bClassification>
+class CachedBoostingThreadResources {
    // this allows us to share the memory between underlying data types
    void * m_aThreadByteBuffer1;
    size_t m_cThreadByteBufferCapacity1;
@@ -71,6 +135,14 @@ class CachedBoostingThreadResources {
    void * m_aThreadByteBuffer2;
    size_t m_cThreadByteBufferCapacity2;
 
+   // holds the histograms of all our inner bags when we bin them together in a single pass
+   void * m_aThreadByteBuffer3;
+   size_t m_cThreadByteBufferCapacity3;
+
+   // pointers to the non-empty buckets of a single feature histogram, which is what our mains tree sweeps
+   const HistogramBucket<bClassification> ** m_apHistogramBucketsActive;
+   size_t m_cHistogramBucketsActiveCapacity;
+
 public:
 
    HistogramBucketVectorEntry<bClassification> * const m_aSumHistogramBucketVectorEntry;
@@ -79,13 +151,17 @@ public:
 
    void * m_aEquivalentSplits; // we use different structures for mains and multidimension and between classification and regression
 
-   SafeTreeNodeQueue<bClassification> m_bestTreeNodeToSplit;
+   TreeNodeHeap<bClassification> m_bestTreeNodeToSplit;
 
    CachedBoostingThreadResources(const size_t cVectorLength)
       : m_aThreadByteBuffer1(nullptr)
       , m_cThreadByteBufferCapacity1(0)
       , m_aThreadByteBuffer2(nullptr)
       , m_cThreadByteBufferCapacity2(0)
+      , m_aThreadByteBuffer3(nullptr)
+      , m_cThreadByteBufferCapacity3(0)
+      , m_apHistogramBucketsActive(nullptr)
+      , m_cHistogramBucketsActiveCapacity(0)
       , m_aSumHistogramBucketVectorEntry(new (std::nothrow) HistogramBucketVectorEntry<bClassification>[cVectorLength])
       , m_aSumHistogramBucketVectorEntry1(new (std::nothrow) HistogramBucketVectorEntry<bClassification>[cVectorLength])
       , m_aTempFloatVector(new (std::nothrow) FloatEbmType[cVectorLength])
@@ -99,6 +175,8 @@ public:
 
       free(m_aThreadByteBuffer1);
       free(m_aThreadByteBuffer2);
+      free(m_aThreadByteBuffer3);
+      free(m_apHistogramBucketsActive);
       delete[] m_aSumHistogramBucketVectorEntry;
       delete[] m_aSumHistogramBucketVectorEntry1;
       delete[] m_aTempFloatVector;
@@ -107,23 +185,83 @@ public:
       LOG_0(TraceLevelInfo, "Exited ~CachedBoostingThreadResources");
    }
 
+   EBM_INLINE bool ReserveThreadByteBuffers(const size_t cBytesBuffer1, const size_t cBytesBuffer2) {
+      // EbmBoostingState::Initialize knows the largest histogram and the largest tree that any of our boosting steps can request, so we allocate
+      // our buffers once here and our boosting steps run without heap calls.  GetThreadByteBuffer1 and GrowThreadByteBuffer2 still grow if our
+      // estimates are ever low, so this is purely an optimization
+      EBM_ASSERT(nullptr == m_aThreadByteBuffer1);
+      EBM_ASSERT(nullptr == m_aThreadByteBuffer2);
+      if(0 != cBytesBuffer1) {
+         LOG_N(TraceLevelInfo, "Reserving CachedBoostingThreadResources::ThreadByteBuffer1 of %zu", cBytesBuffer1);
+         m_aThreadByteBuffer1 = malloc(cBytesBuffer1);
+         if(UNLIKELY(nullptr == m_aThreadByteBuffer1)) {
+            LOG_0(TraceLevelWarning, "WARNING ReserveThreadByteBuffers nullptr == m_aThreadByteBuffer1");
+            return true;
+         }
+         m_cThreadByteBufferCapacity1 = cBytesBuffer1;
+      }
+      if(0 != cBytesBuffer2) {
+         LOG_N(TraceLevelInfo, "Reserving CachedBoostingThreadResources::ThreadByteBuffer2 of %zu", cBytesBuffer2);
+         m_aThreadByteBuffer2 = malloc(cBytesBuffer2);
+         if(UNLIKELY(nullptr == m_aThreadByteBuffer2)) {
+            LOG_0(TraceLevelWarning, "WARNING ReserveThreadByteBuffers nullptr == m_aThreadByteBuffer2");
+            return true;
+         }
+         m_cThreadByteBufferCapacity2 = cBytesBuffer2;
+      }
+      return false;
+   }
+
    EBM_INLINE void * GetThreadByteBuffer1(const size_t cBytesRequired) {
       if(UNLIKELY(m_cThreadByteBufferCapacity1 < cBytesRequired)) {
          m_cThreadByteBufferCapacity1 = cBytesRequired << 1;
          LOG_N(TraceLevelInfo, "Growing CachedBoostingThreadResources::ThreadByteBuffer1 to %zu", m_cThreadByteBufferCapacity1);
-         // TODO : use malloc here instead of realloc.  We don't need to copy the data, and if we free first then we can either slot the new memory 
-         // in the old slot or it can be moved
-         void * const aNewThreadByteBuffer = realloc(m_aThreadByteBuffer1, m_cThreadByteBufferCapacity1);
-         if(UNLIKELY(nullptr == aNewThreadByteBuffer)) {
-            // according to the realloc spec, if realloc fails to allocate the new memory, it returns nullptr BUT the old memory is valid.
-            // we leave m_aThreadByteBuffer1 alone in this instance and will free that memory later in the destructor
+         // our callers overwrite this buffer after getting it, so free first and then malloc to avoid having realloc copy the old contents
+         free(m_aThreadByteBuffer1);
+         m_aThreadByteBuffer1 = malloc(m_cThreadByteBufferCapacity1);
+         if(UNLIKELY(nullptr == m_aThreadByteBuffer1)) {
+            m_cThreadByteBufferCapacity1 = 0;
             return nullptr;
          }
-         m_aThreadByteBuffer1 = aNewThreadByteBuffer;
       }
       return m_aThreadByteBuffer1;
    }
 
+   EBM_INLINE void * GetThreadByteBuffer3(const size_t cBytesRequired) {
+      if(UNLIKELY(m_cThreadByteBufferCapacity3 < cBytesRequired)) {
+         // our histogram sizes differ between feature combinations, but we keep whichever is largest, so we don't double here
+         m_cThreadByteBufferCapacity3 = cBytesRequired;
+         LOG_N(TraceLevelInfo, "Growing CachedBoostingThreadResources::ThreadByteBuffer3 to %zu", m_cThreadByteBufferCapacity3);
+         free(m_aThreadByteBuffer3);
+         m_aThreadByteBuffer3 = malloc(m_cThreadByteBufferCapacity3);
+         if(UNLIKELY(nullptr == m_aThreadByteBuffer3)) {
+            m_cThreadByteBufferCapacity3 = 0;
+            return nullptr;
+         }
+      }
+      return m_aThreadByteBuffer3;
+   }
+
+   EBM_INLINE const HistogramBucket<bClassification> ** GetHistogramBucketsActive(const size_t cHistogramBuckets) {
+      if(UNLIKELY(m_cHistogramBucketsActiveCapacity < cHistogramBuckets)) {
+         // like ThreadByteBuffer3 we keep the largest feature's size, so we don't double here
+         if(IsMultiplyError(cHistogramBuckets, sizeof(*m_apHistogramBucketsActive))) {
+            LOG_0(TraceLevelWarning, "WARNING GetHistogramBucketsActive IsMultiplyError(cHistogramBuckets, sizeof(*m_apHistogramBucketsActive))");
+            return nullptr;
+         }
+         LOG_N(TraceLevelInfo, "Growing CachedBoostingThreadResources::HistogramBucketsActive to %zu", cHistogramBuckets);
+         free(m_apHistogramBucketsActive);
+         m_apHistogramBucketsActive = static_cast<const HistogramBucket<bClassification> **>(
+            malloc(sizeof(*m_apHistogramBucketsActive) * cHistogramBuckets));
+         if(UNLIKELY(nullptr == m_apHistogramBucketsActive)) {
+            m_cHistogramBucketsActiveCapacity = 0;
+            return nullptr;
+         }
+         m_cHistogramBucketsActiveCapacity = cHistogramBuckets;
+      }
+      return m_apHistogramBucketsActive;
+   }
+
    EBM_INLINE bool GrowThreadByteBuffer2(const size_t cByteBoundaries) {
       // by adding cByteBoundaries and shifting our existing size, we do 2 things:
       //   1) we ensure that if we have zero size, we'll get some size that we'll get a non-zero size after the shift
@@ -131,16 +269,14 @@ public:
       EBM_ASSERT(0 == m_cThreadByteBufferCapacity2 % cByteBoundaries);
       m_cThreadByteBufferCapacity2 = cByteBoundaries + (m_cThreadByteBufferCapacity2 << 1);
       LOG_N(TraceLevelInfo, "Growing CachedBoostingThreadResources::ThreadByteBuffer2 to %zu", m_cThreadByteBufferCapacity2);
-      // TODO : use malloc here.  our tree objects have internal pointers, so we're going to dispose of our work anyways
-      // There is no way to check if the array was re-allocated or not without invoking undefined behavior, 
-      // so we don't get a benefit if the array can be resized with realloc
-      void * const aNewThreadByteBuffer = realloc(m_aThreadByteBuffer2, m_cThreadByteBufferCapacity2);
-      if(UNLIKELY(nullptr == aNewThreadByteBuffer)) {
-         // according to the realloc spec, if realloc fails to allocate the new memory, it returns nullptr BUT the old memory is valid.
-         // we leave m_aThreadByteBuffer1 alone in this instance and will free that memory later in the destructor
+      // our tree objects have internal pointers, so our caller discards its work and starts again after we grow.  There is no benefit in having
+      // realloc copy the old contents
+      free(m_aThreadByteBuffer2);
+      m_aThreadByteBuffer2 = malloc(m_cThreadByteBufferCapacity2);
+      if(UNLIKELY(nullptr == m_aThreadByteBuffer2)) {
+         m_cThreadByteBufferCapacity2 = 0;
          return true;
       }
-      m_aThreadByteBuffer2 = aNewThreadByteBuffer;
       return false;
    }
 
@@ -153,8 +289,7 @@ public:
    }
 
    EBM_INLINE bool IsError() const {
-      return !m_bestTreeNodeToSplit.IsSuccess() || nullptr == m_aSumHistogramBucketVectorEntry || 
-         nullptr == m_aSumHistogramBucketVectorEntry1 || nullptr == m_aTempFloatVector;
+      return nullptr == m_aSumHistogramBucketVectorEntry || nullptr == m_aSumHistogramBucketVectorEntry1 || nullptr == m_aTempFloatVector;
    }
 };
 
@@ -163,17 +298,23 @@ class CachedInteractionThreadResources {
    void * m_aThreadByteBuffer1;
    size_t m_cThreadByteBufferCapacity1;
 
+   void * m_aThreadByteBuffer2;
+   size_t m_cThreadByteBufferCapacity2;
+
 public:
 
    CachedInteractionThreadResources()
       : m_aThreadByteBuffer1(nullptr)
-      , m_cThreadByteBufferCapacity1(0) {
+      , m_cThreadByteBufferCapacity1(0)
+      , m_aThreadByteBuffer2(nullptr)
+      , m_cThreadByteBufferCapacity2(0) {
    }
 
    ~CachedInteractionThreadResources() {
       LOG_0(TraceLevelInfo, "Entered ~CachedInteractionThreadResources");
 
       free(m_aThreadByteBuffer1);
+      free(m_aThreadByteBuffer2);
 
       LOG_0(TraceLevelInfo, "Exited ~CachedInteractionThreadResources");
    }
@@ -194,6 +335,21 @@ public:
       }
       return m_aThreadByteBuffer1;
    }
+
+   EBM_INLINE void * GetThreadByteBuffer2(const size_t cBytesRequired) {
+      if(UNLIKELY(m_cThreadByteBufferCapacity2 < cBytesRequired)) {
+         // this holds the anchored histograms of a block of pairs, which are binned together and then scored one by one
+         m_cThreadByteBufferCapacity2 = cBytesRequired;
+         LOG_N(TraceLevelInfo, "Growing CachedInteractionThreadResources::ThreadByteBuffer2 to %zu", m_cThreadByteBufferCapacity2);
+         free(m_aThreadByteBuffer2);
+         m_aThreadByteBuffer2 = malloc(m_cThreadByteBufferCapacity2);
+         if(UNLIKELY(nullptr == m_aThreadByteBuffer2)) {
+            m_cThreadByteBufferCapacity2 = 0;
+            return nullptr;
+         }
+      }
+      return m_aThreadByteBuffer2;
+   }
 };
 
 #endif // CACHED_THREAD_RESOURCES_H
@@ -71,8 +71,9 @@ EBM_INLINE static const StorageDataType * const * ConstructInputData(
    const size_t cFeatures, 
    const Feature * const aFeatures, 
    const size_t cInstances, 
-   const IntEbmType * 
-   const aBinnedData
+   const IntEbmType * const aBinnedData,
+   const size_t cInstancesBinnedData,
+   const size_t * const aiInstancesBinnedData
 ) {
    LOG_0(TraceLevelInfo, "Entered DataSetByFeature::ConstructInputData");
 
@@ -111,18 +112,21 @@ EBM_INLINE static const StorageDataType * const * ConstructInputData(
       *paInputDataTo = pInputDataTo;
       ++paInputDataTo;
 
-      const IntEbmType * pInputDataFrom = &aBinnedData[pFeature->m_iFeatureData * cInstances];
-      const IntEbmType * pInputDataFromEnd = &pInputDataFrom[cInstances];
+      const IntEbmType * const aInputDataFrom = &aBinnedData[pFeature->m_iFeatureData * cInstancesBinnedData];
+      const StorageDataType * const pInputDataToEnd = &pInputDataTo[cInstances];
+      size_t iInstance = 0;
       do {
-         const IntEbmType data = *pInputDataFrom;
+         const size_t iInstanceFrom = nullptr == aiInstancesBinnedData ? iInstance : aiInstancesBinnedData[iInstance];
+         EBM_ASSERT(iInstanceFrom < cInstancesBinnedData);
+         const IntEbmType data = aInputDataFrom[iInstanceFrom];
          EBM_ASSERT(0 <= data);
          EBM_ASSERT((IsNumberConvertable<size_t, IntEbmType>(data))); // data must be lower than cBins and cBins fits into a size_t which we checked earlier
          EBM_ASSERT(static_cast<size_t>(data) < pFeature->m_cBins);
          EBM_ASSERT((IsNumberConvertable<StorageDataType, IntEbmType>(data)));
          *pInputDataTo = static_cast<StorageDataType>(data);
          ++pInputDataTo;
-         ++pInputDataFrom;
-      } while(pInputDataFromEnd != pInputDataFrom);
+         ++iInstance;
+      } while(pInputDataToEnd != pInputDataTo);
 
       ++pFeature;
    } while(pFeatureEnd != pFeature);
@@ -147,10 +151,13 @@ DataSetByFeature::DataSetByFeature(
    const void * const aTargetData, 
    const FloatEbmType * const aPredictorScores, 
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
-   FloatEbmType * const aTempFloatVector
+   FloatEbmType * const aTempFloatVector,
+   const size_t cInstancesInputData,
+   const size_t * const aiInstancesInputData
 )
    : m_aResidualErrors(ConstructResidualErrors(cInstances, aTargetData, aPredictorScores, runtimeLearningTypeOrCountTargetClasses, aTempFloatVector))
-   , m_aaInputData(0 == cFeatures ? nullptr : ConstructInputData(cFeatures, aFeatures, cInstances, aBinnedData))
+   , m_aaInputData(0 == cFeatures ? nullptr : ConstructInputData(cFeatures, aFeatures, cInstances, aBinnedData, 
+      cInstancesInputData, aiInstancesInputData))
    , m_cInstances(cInstances)
    , m_cFeatures(cFeatures) {
 
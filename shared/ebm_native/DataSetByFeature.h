@@ -28,7 +28,11 @@ public:
       const void * const aTargetData, 
       const FloatEbmType * const aPredictorScores, 
       const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
-      FloatEbmType * const aTempFloatVector
+      FloatEbmType * const aTempFloatVector,
+      // aInputDataFrom holds cInstancesInputData instances per feature, and if aiInstancesInputData is not nullptr we only take the cInstances 
+      // instances that it lists.  aTargetData and aPredictorScores always hold exactly cInstances instances
+      const size_t cInstancesInputData,
+      const size_t * const aiInstancesInputData
    );
    ~DataSetByFeature();
 
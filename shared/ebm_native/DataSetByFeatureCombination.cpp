@@ -137,10 +137,16 @@ EBM_INLINE static const StorageDataType * const * ConstructInputData(
    const size_t cFeatureCombinations, 
    const FeatureCombination * const * const apFeatureCombination, 
    const size_t cInstances, 
-   const IntEbmType * const aInputDataFrom
+   const IntEbmType * const aInputDataFrom,
+   const size_t cInstancesInputData,
+   const size_t * const aiInstancesInputData
 ) {
    LOG_0(TraceLevelInfo, "Entered DataSetByFeatureCombination::ConstructInputData");
 
+   // aiInstancesInputData selects which of the cInstancesInputData instances in aInputDataFrom we take, in order.  If it is nullptr we take all of
+   // them, in which case cInstancesInputData == cInstances
+   EBM_ASSERT(nullptr != aiInstancesInputData || cInstancesInputData == cInstances);
+
    EBM_ASSERT(0 < cFeatureCombinations);
    EBM_ASSERT(nullptr != apFeatureCombination);
    EBM_ASSERT(0 < cInstances);
@@ -204,7 +210,7 @@ EBM_INLINE static const StorageDataType * const * ConstructInputData(
          const InputDataPointerAndCountBins * const pDimensionInfoEnd = &dimensionInfo[cFeatures];
          do {
             const Feature * const pFeature = pFeatureCombinationEntry->m_pFeature;
-            pDimensionInfo->m_pInputData = &aInputDataFrom[pFeature->m_iFeatureData * cInstances];
+            pDimensionInfo->m_pInputData = &aInputDataFrom[pFeature->m_iFeatureData * cInstancesInputData];
             pDimensionInfo->m_cBins = pFeature->m_cBins;
             ++pFeatureCombinationEntry;
             ++pDimensionInfo;
@@ -216,6 +222,7 @@ EBM_INLINE static const StorageDataType * const * ConstructInputData(
          // as it is, it isn't a constant, so the compiler would not be able to figure out that most
          // of the time it is a constant
          size_t shiftEnd = cBitsPerItemMax * cItemsPerBitPackedDataUnit;
+         size_t iInstance = 0;
          while(pInputDataTo < pInputDataToLast) /* do the last iteration AFTER we re-enter this loop through the goto label! */ {
          one_last_loop:;
             EBM_ASSERT(shiftEnd <= CountBitsRequiredPositiveMax<StorageDataType>());
@@ -225,11 +232,12 @@ EBM_INLINE static const StorageDataType * const * ConstructInputData(
             do {
                size_t tensorMultiple = 1;
                size_t tensorIndex = 0;
+               const size_t iInstanceFrom = nullptr == aiInstancesInputData ? iInstance : aiInstancesInputData[iInstance];
+               EBM_ASSERT(iInstanceFrom < cInstancesInputData);
+               ++iInstance;
                pDimensionInfo = &dimensionInfo[0];
                do {
-                  const IntEbmType * pInputData = pDimensionInfo->m_pInputData;
-                  const IntEbmType inputData = *pInputData;
-                  pDimensionInfo->m_pInputData = pInputData + 1;
+                  const IntEbmType inputData = pDimensionInfo->m_pInputData[iInstanceFrom];
 
                   EBM_ASSERT(0 <= inputData);
                   // data must be lower than inputData and inputData fits into a size_t which we checked earlier
@@ -281,6 +289,7 @@ free_all:
 
 DataSetByFeatureCombination::DataSetByFeatureCombination(
    const bool bAllocateResidualErrors, 
+   const bool bAllocateNewtonRaphsonSteps, 
    const bool bAllocatePredictorScores, 
    const bool bAllocateTargetData, 
    const size_t cFeatureCombinations, 
@@ -289,17 +298,25 @@ DataSetByFeatureCombination::DataSetByFeatureCombination(
    const IntEbmType * const aInputDataFrom, 
    const void * const aTargets, 
    const FloatEbmType * const aPredictorScoresFrom, 
-   const size_t cVectorLength
+   const size_t cVectorLength,
+   const size_t cInstancesInputData,
+   const size_t * const aiInstancesInputData
 )
    : m_aResidualErrors(bAllocateResidualErrors ? ConstructResidualErrors(cInstances, cVectorLength) : static_cast<FloatEbmType *>(nullptr))
+   // the Newton-Raphson steps are parallel to the residual errors, so they have the same shape
+   , m_aNewtonRaphsonSteps(bAllocateNewtonRaphsonSteps ? ConstructResidualErrors(cInstances, cVectorLength) : static_cast<FloatEbmType *>(nullptr))
    , m_aPredictorScores(
       bAllocatePredictorScores ? ConstructPredictorScores(cInstances, cVectorLength, aPredictorScoresFrom) : static_cast<FloatEbmType *>(nullptr))
    , m_aTargetData(
       bAllocateTargetData ? ConstructTargetData(cInstances, static_cast<const IntEbmType *>(aTargets)) : static_cast<const StorageDataType *>(nullptr))
-   , m_aaInputData(0 == cFeatureCombinations ? nullptr : ConstructInputData(cFeatureCombinations, apFeatureCombination, cInstances, aInputDataFrom))
+   , m_aaInputData(0 == cFeatureCombinations ? nullptr : ConstructInputData(
+      cFeatureCombinations, apFeatureCombination, cInstances, aInputDataFrom, cInstancesInputData, aiInstancesInputData))
    , m_cInstances(cInstances)
    , m_cFeatureCombinations(cFeatureCombinations) 
+   , m_aWeights(nullptr)
+   , m_weightTotal(static_cast<FloatEbmType>(cInstances))
    , m_bAllocateResidualErrors(bAllocateResidualErrors)
+   , m_bAllocateNewtonRaphsonSteps(bAllocateNewtonRaphsonSteps)
    , m_bAllocatePredictorScores(bAllocatePredictorScores)
    , m_bAllocateTargetData(bAllocateTargetData) {
    EBM_ASSERT(0 < cInstances);
@@ -309,6 +326,7 @@ DataSetByFeatureCombination::~DataSetByFeatureCombination() {
    LOG_0(TraceLevelInfo, "Entered ~DataSetByFeatureCombination");
 
    free(m_aResidualErrors);
+   free(m_aNewtonRaphsonSteps);
    free(m_aPredictorScores);
    free(const_cast<StorageDataType *>(m_aTargetData));
 
@@ -13,17 +13,30 @@
 #include "Logging.h" // EBM_ASSERT & LOG
 #include "FeatureCombination.h"
 
+// For classification, our histogram kernels need the Newton-Raphson denominator (which is a function of the residual error) for every instance,
+// every class and every inner bag, so by default we recompute the same value cInnerBags times per boosting step.  If m_aNewtonRaphsonSteps is 
+// allocated, our apply-update kernels compute it once when they write the residual error, and our histogram kernels read it from that parallel 
+// array instead.  This costs us an extra array of cInstances * cVectorLength floats and more memory bandwidth in the histogram kernels, and 
+// ComputeNewtonRaphsonStep is cheap, so it's only a win when the kernels are compute bound and there are many inner bags.  Our caller opts into 
+// it through optionalTempParams (see ebm_native.h)
+
 // TODO: let's take how clean this class is (with almost everything const and the arrays constructed in initialization list) 
 // and apply it to as many other classes as we can
 class DataSetByFeatureCombination final {
    FloatEbmType * const m_aResidualErrors;
+   FloatEbmType * const m_aNewtonRaphsonSteps;
    FloatEbmType * const m_aPredictorScores;
    const StorageDataType * const m_aTargetData;
    const StorageDataType * const * const m_aaInputData;
    const size_t m_cInstances;
    const size_t m_cFeatureCombinations;
+   // our caller's instance weights for the current boosting step, or nullptr if every instance has a weight of 1.  We don't own this memory
+   const FloatEbmType * m_aWeights;
+   // the sum of m_aWeights, or m_cInstances without weights
+   FloatEbmType m_weightTotal;
 
    const bool m_bAllocateResidualErrors;
+   const bool m_bAllocateNewtonRaphsonSteps;
    const bool m_bAllocatePredictorScores;
    const bool m_bAllocateTargetData;
 
@@ -31,6 +44,7 @@ public:
 
    DataSetByFeatureCombination(
       const bool bAllocateResidualErrors, 
+      const bool bAllocateNewtonRaphsonSteps, 
       const bool bAllocatePredictorScores, 
       const bool bAllocateTargetData, 
       const size_t cFeatureCombinations, 
@@ -39,12 +53,18 @@ public:
       const IntEbmType * const aInputDataFrom, 
       const void * const aTargets, 
       const FloatEbmType * const aPredictorScoresFrom, 
-      const size_t cVectorLength
+      const size_t cVectorLength,
+      // aInputDataFrom holds cInstancesInputData instances per feature.  If aiInstancesInputData is not nullptr, it lists the cInstances of them 
+      // that we take, which lets us build both our training and validation sets from the same binned data without copying it first.  aTargets
+      // and aPredictorScoresFrom always hold exactly cInstances instances
+      const size_t cInstancesInputData,
+      const size_t * const aiInstancesInputData
    );
    ~DataSetByFeatureCombination();
 
    EBM_INLINE bool IsError() const {
-      return (m_bAllocateResidualErrors && nullptr == m_aResidualErrors) || (m_bAllocatePredictorScores && nullptr == m_aPredictorScores) || 
+      return (m_bAllocateResidualErrors && nullptr == m_aResidualErrors) || (m_bAllocateNewtonRaphsonSteps && nullptr == m_aNewtonRaphsonSteps) ||
+         (m_bAllocatePredictorScores && nullptr == m_aPredictorScores) || 
          (m_bAllocateTargetData && nullptr == m_aTargetData) || (0 != m_cFeatureCombinations && nullptr == m_aaInputData);
    }
 
@@ -56,6 +76,17 @@ public:
       EBM_ASSERT(nullptr != m_aResidualErrors);
       return m_aResidualErrors;
    }
+   EBM_INLINE bool IsNewtonRaphsonStepsStored() const {
+      return nullptr != m_aNewtonRaphsonSteps;
+   }
+   EBM_INLINE FloatEbmType * GetNewtonRaphsonStepPointer() {
+      EBM_ASSERT(nullptr != m_aNewtonRaphsonSteps);
+      return m_aNewtonRaphsonSteps;
+   }
+   EBM_INLINE const FloatEbmType * GetNewtonRaphsonStepPointer() const {
+      EBM_ASSERT(nullptr != m_aNewtonRaphsonSteps);
+      return m_aNewtonRaphsonSteps;
+   }
    EBM_INLINE FloatEbmType * GetPredictorScores() {
       EBM_ASSERT(nullptr != m_aPredictorScores);
       return m_aPredictorScores;
@@ -71,6 +102,17 @@ public:
       EBM_ASSERT(nullptr != m_aaInputData);
       return m_aaInputData[pFeatureCombination->m_iInputData];
    }
+   EBM_INLINE const FloatEbmType * GetWeights() const {
+      return m_aWeights;
+   }
+   EBM_INLINE FloatEbmType GetWeightTotal() const {
+      return m_weightTotal;
+   }
+   EBM_INLINE void SetWeights(const FloatEbmType * const aWeights, const FloatEbmType weightTotal) {
+      EBM_ASSERT(nullptr != aWeights || static_cast<FloatEbmType>(m_cInstances) == weightTotal);
+      m_aWeights = aWeights;
+      m_weightTotal = weightTotal;
+   }
    EBM_INLINE size_t GetCountInstances() const {
       return m_cInstances;
    }
@@ -0,0 +1,525 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <string.h> // memset, memcpy
+#include <stddef.h> // size_t, ptrdiff_t
+#include <type_traits> // std::is_standard_layout
+
+#include "ebm_native.h"
+#include "EbmInternal.h" // EBM_INLINE & UNLIKLEY
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "DataSetShared.h"
+
+// The shared dataset lives in memory that our caller allocates (possibly a RawArray or other shared memory block that is mapped into several
+// processes at different addresses), so we never store pointers inside it.  Every part is located by a byte offset from the start of the memory.
+// The layout is:
+//   DataSetSharedHeader
+//   EbmNativeFeature[cFeatures]
+//   IntEbmType binnedData[cFeatures][cInstances]
+//   IntEbmType (classification) or FloatEbmType (regression) targets[cInstances]
+// Everything is 8 bytes wide, so every part stays aligned if the memory starts aligned.
+
+static_assert(sizeof(IntEbmType) == sizeof(FloatEbmType), "our targets are sized the same for classification and regression");
+
+// arbitrary tag that we put at the start of the memory so that we can detect when we're handed something that isn't a shared dataset
+constexpr IntEbmType k_sharedDataSetId = 0x0e8d;
+
+struct DataSetSharedHeader final {
+   IntEbmType m_id;
+   IntEbmType m_cBytes;
+   IntEbmType m_cFeatures;
+   IntEbmType m_cInstances;
+   IntEbmType m_cFeaturesFilled;
+   // only valid once m_offsetTargets is non-zero
+   IntEbmType m_runtimeLearningTypeOrCountTargetClasses;
+   IntEbmType m_offsetFeatures;
+   IntEbmType m_offsetBinnedData;
+   // zero until the targets are filled, which is always the last step
+   IntEbmType m_offsetTargets;
+};
+static_assert(std::is_standard_layout<DataSetSharedHeader>::value, "we use offsets into this struct, so it needs to be standard layout");
+static_assert(0 == sizeof(DataSetSharedHeader) % sizeof(IntEbmType), "the parts after the header need to be aligned");
+static_assert(0 == sizeof(EbmNativeFeature) % sizeof(IntEbmType), "the binned data after the features needs to be aligned");
+
+// returns true on error
+static bool GetBytesHeader(const size_t cFeatures, size_t * const pcBytesOut) {
+   if(IsMultiplyError(sizeof(EbmNativeFeature), cFeatures)) {
+      LOG_0(TraceLevelWarning, "WARNING GetBytesHeader IsMultiplyError(sizeof(EbmNativeFeature), cFeatures)");
+      return true;
+   }
+   const size_t cBytesFeatures = sizeof(EbmNativeFeature) * cFeatures;
+   if(IsAddError(sizeof(DataSetSharedHeader), cBytesFeatures)) {
+      LOG_0(TraceLevelWarning, "WARNING GetBytesHeader IsAddError(sizeof(DataSetSharedHeader), cBytesFeatures)");
+      return true;
+   }
+   *pcBytesOut = sizeof(DataSetSharedHeader) + cBytesFeatures;
+   return false;
+}
+
+// returns true on error
+static bool GetBytesPerFeature(const size_t cInstances, size_t * const pcBytesOut) {
+   if(IsMultiplyError(sizeof(IntEbmType), cInstances)) {
+      LOG_0(TraceLevelWarning, "WARNING GetBytesPerFeature IsMultiplyError(sizeof(IntEbmType), cInstances)");
+      return true;
+   }
+   *pcBytesOut = sizeof(IntEbmType) * cInstances;
+   return false;
+}
+
+static IntEbmType ReturnBytes(const size_t cBytes) {
+   if(!IsNumberConvertable<IntEbmType, size_t>(cBytes)) {
+      LOG_0(TraceLevelWarning, "WARNING ReturnBytes !IsNumberConvertable<IntEbmType, size_t>(cBytes)");
+      return IntEbmType { -1 };
+   }
+   return static_cast<IntEbmType>(cBytes);
+}
+
+// The header is in our caller's memory, so it could have been modified since we filled it.  Before we trust any offset in it we recompute
+// the layout from the counts, and check that the offsets match it and that everything fits in m_cBytes.  Returns true on error
+static bool IsHeaderInvalid(const DataSetSharedHeader * const pHeader) {
+   const IntEbmType countFeatures = pHeader->m_cFeatures;
+   const IntEbmType countInstances = pHeader->m_cInstances;
+   const IntEbmType countBytes = pHeader->m_cBytes;
+   if(countFeatures < 0 || !IsNumberConvertable<size_t, IntEbmType>(countFeatures) || 
+      countInstances < 0 || !IsNumberConvertable<size_t, IntEbmType>(countInstances) || 
+      countBytes < 0 || !IsNumberConvertable<size_t, IntEbmType>(countBytes)) 
+   {
+      LOG_0(TraceLevelError, "ERROR IsHeaderInvalid the shared dataset header has invalid counts");
+      return true;
+   }
+   if(pHeader->m_cFeaturesFilled < 0 || countFeatures < pHeader->m_cFeaturesFilled) {
+      LOG_0(TraceLevelError, "ERROR IsHeaderInvalid the shared dataset header has an invalid count of filled features");
+      return true;
+   }
+   const size_t cFeatures = static_cast<size_t>(countFeatures);
+   const size_t cInstances = static_cast<size_t>(countInstances);
+
+   size_t cBytesHeader;
+   size_t cBytesPerFeature;
+   if(GetBytesHeader(cFeatures, &cBytesHeader) || GetBytesPerFeature(cInstances, &cBytesPerFeature)) {
+      return true;
+   }
+   if(IsMultiplyError(cBytesPerFeature, cFeatures)) {
+      LOG_0(TraceLevelWarning, "WARNING IsHeaderInvalid IsMultiplyError(cBytesPerFeature, cFeatures)");
+      return true;
+   }
+   const size_t cBytesBinnedData = cBytesPerFeature * cFeatures;
+   if(IsAddError(cBytesHeader, cBytesBinnedData) || IsAddError(cBytesHeader + cBytesBinnedData, cBytesPerFeature)) {
+      LOG_0(TraceLevelWarning, "WARNING IsHeaderInvalid IsAddError");
+      return true;
+   }
+   const size_t iByteTargets = cBytesHeader + cBytesBinnedData;
+   if(static_cast<size_t>(countBytes) < iByteTargets + cBytesPerFeature) {
+      LOG_0(TraceLevelError, "ERROR IsHeaderInvalid the shared dataset header describes more memory than it holds");
+      return true;
+   }
+   // all of these are less than countBytes now, so they convert to IntEbmType
+   if(static_cast<IntEbmType>(sizeof(DataSetSharedHeader)) != pHeader->m_offsetFeatures || 
+      static_cast<IntEbmType>(cBytesHeader) != pHeader->m_offsetBinnedData || 
+      (0 != pHeader->m_offsetTargets && static_cast<IntEbmType>(iByteTargets) != pHeader->m_offsetTargets)) 
+   {
+      LOG_0(TraceLevelError, "ERROR IsHeaderInvalid the shared dataset header has invalid offsets");
+      return true;
+   }
+   return false;
+}
+
+// checks the parts of the header that we need for filling the memory, and returns nullptr on error
+static DataSetSharedHeader * GetHeaderForFill(const IntEbmType countBytesAllocated, unsigned char * const fillMem) {
+   if(nullptr == fillMem) {
+      LOG_0(TraceLevelError, "ERROR GetHeaderForFill nullptr == fillMem");
+      return nullptr;
+   }
+   if(countBytesAllocated < static_cast<IntEbmType>(sizeof(DataSetSharedHeader))) {
+      LOG_0(TraceLevelError, "ERROR GetHeaderForFill countBytesAllocated is too small to hold the header");
+      return nullptr;
+   }
+   DataSetSharedHeader * const pHeader = reinterpret_cast<DataSetSharedHeader *>(fillMem);
+   if(k_sharedDataSetId != pHeader->m_id) {
+      LOG_0(TraceLevelError, "ERROR GetHeaderForFill FillDataSetHeader needs to be called first");
+      return nullptr;
+   }
+   if(countBytesAllocated != pHeader->m_cBytes) {
+      LOG_0(TraceLevelError, "ERROR GetHeaderForFill countBytesAllocated does not match the value given to FillDataSetHeader");
+      return nullptr;
+   }
+   if(IsHeaderInvalid(pHeader)) {
+      LOG_0(TraceLevelError, "ERROR GetHeaderForFill the header was modified after FillDataSetHeader");
+      return nullptr;
+   }
+   if(0 != pHeader->m_offsetTargets) {
+      LOG_0(TraceLevelError, "ERROR GetHeaderForFill the dataset is already complete");
+      return nullptr;
+   }
+   return pHeader;
+}
+
+bool GetDataSetSharedView(const void * const pDataSet, DataSetSharedView * const pViewOut) {
+   EBM_ASSERT(nullptr != pViewOut);
+
+   if(nullptr == pDataSet) {
+      LOG_0(TraceLevelError, "ERROR GetDataSetSharedView nullptr == pDataSet");
+      return true;
+   }
+   // our callers don't pass us the size of their memory, so we need to trust that it holds at least a header.  It does if it came from 
+   // FillDataSetHeader, which refuses memory that is too small.  Everything after the header is checked against the size stored in the header
+   const unsigned char * const pMem = static_cast<const unsigned char *>(pDataSet);
+   const DataSetSharedHeader * const pHeader = reinterpret_cast<const DataSetSharedHeader *>(pMem);
+   if(k_sharedDataSetId != pHeader->m_id) {
+      LOG_0(TraceLevelError, "ERROR GetDataSetSharedView the memory does not hold a shared dataset");
+      return true;
+   }
+   if(IsHeaderInvalid(pHeader)) {
+      LOG_0(TraceLevelError, "ERROR GetDataSetSharedView the header was modified after it was filled");
+      return true;
+   }
+   if(pHeader->m_cFeaturesFilled != pHeader->m_cFeatures || 0 == pHeader->m_offsetTargets) {
+      LOG_0(TraceLevelError, "ERROR GetDataSetSharedView the shared dataset has not been completely filled");
+      return true;
+   }
+   if(k_Regression != pHeader->m_runtimeLearningTypeOrCountTargetClasses && 
+      (pHeader->m_runtimeLearningTypeOrCountTargetClasses < 0 || 
+      !IsNumberConvertable<ptrdiff_t, IntEbmType>(pHeader->m_runtimeLearningTypeOrCountTargetClasses))) 
+   {
+      LOG_0(TraceLevelError, "ERROR GetDataSetSharedView the shared dataset has an invalid learning type");
+      return true;
+   }
+
+   pViewOut->m_cFeatures = static_cast<size_t>(pHeader->m_cFeatures);
+   pViewOut->m_cInstances = static_cast<size_t>(pHeader->m_cInstances);
+   pViewOut->m_runtimeLearningTypeOrCountTargetClasses = static_cast<ptrdiff_t>(pHeader->m_runtimeLearningTypeOrCountTargetClasses);
+   pViewOut->m_aFeatures = reinterpret_cast<const EbmNativeFeature *>(pMem + static_cast<size_t>(pHeader->m_offsetFeatures));
+   pViewOut->m_aBinnedData = reinterpret_cast<const IntEbmType *>(pMem + static_cast<size_t>(pHeader->m_offsetBinnedData));
+   pViewOut->m_aTargets = pMem + static_cast<size_t>(pHeader->m_offsetTargets);
+   return false;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION SizeDataSetHeader(IntEbmType countFeatures) {
+   LOG_N(TraceLevelInfo, "Entered SizeDataSetHeader: countFeatures=%" IntEbmTypePrintf, countFeatures);
+
+   if(countFeatures < 0 || !IsNumberConvertable<size_t, IntEbmType>(countFeatures)) {
+      LOG_0(TraceLevelError, "ERROR SizeDataSetHeader countFeatures must be zero or positive");
+      return IntEbmType { -1 };
+   }
+   size_t cBytes;
+   if(GetBytesHeader(static_cast<size_t>(countFeatures), &cBytes)) {
+      return IntEbmType { -1 };
+   }
+   return ReturnBytes(cBytes);
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION SizeFeature(IntEbmType countBins, IntEbmType countInstances) {
+   LOG_N(TraceLevelInfo, "Entered SizeFeature: countBins=%" IntEbmTypePrintf ", countInstances=%" IntEbmTypePrintf, countBins, countInstances);
+
+   // TODO: once we bit pack our shared features, countBins will determine how many instances we can fit into each IntEbmType
+   if(countBins < 0) {
+      LOG_0(TraceLevelError, "ERROR SizeFeature countBins must be zero or positive");
+      return IntEbmType { -1 };
+   }
+   if(countInstances < 0 || !IsNumberConvertable<size_t, IntEbmType>(countInstances)) {
+      LOG_0(TraceLevelError, "ERROR SizeFeature countInstances must be zero or positive");
+      return IntEbmType { -1 };
+   }
+   size_t cBytes;
+   if(GetBytesPerFeature(static_cast<size_t>(countInstances), &cBytes)) {
+      return IntEbmType { -1 };
+   }
+   return ReturnBytes(cBytes);
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION SizeClassificationTarget(
+   IntEbmType countTargetClasses,
+   IntEbmType countInstances
+) {
+   LOG_N(TraceLevelInfo, "Entered SizeClassificationTarget: countTargetClasses=%" IntEbmTypePrintf ", countInstances=%" IntEbmTypePrintf,
+      countTargetClasses, countInstances);
+
+   if(countTargetClasses < 0) {
+      LOG_0(TraceLevelError, "ERROR SizeClassificationTarget countTargetClasses must be zero or positive");
+      return IntEbmType { -1 };
+   }
+   if(countInstances < 0 || !IsNumberConvertable<size_t, IntEbmType>(countInstances)) {
+      LOG_0(TraceLevelError, "ERROR SizeClassificationTarget countInstances must be zero or positive");
+      return IntEbmType { -1 };
+   }
+   size_t cBytes;
+   if(GetBytesPerFeature(static_cast<size_t>(countInstances), &cBytes)) {
+      return IntEbmType { -1 };
+   }
+   return ReturnBytes(cBytes);
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION SizeRegressionTarget(IntEbmType countInstances) {
+   LOG_N(TraceLevelInfo, "Entered SizeRegressionTarget: countInstances=%" IntEbmTypePrintf, countInstances);
+
+   if(countInstances < 0 || !IsNumberConvertable<size_t, IntEbmType>(countInstances)) {
+      LOG_0(TraceLevelError, "ERROR SizeRegressionTarget countInstances must be zero or positive");
+      return IntEbmType { -1 };
+   }
+   size_t cBytes;
+   if(GetBytesPerFeature(static_cast<size_t>(countInstances), &cBytes)) {
+      return IntEbmType { -1 };
+   }
+   return ReturnBytes(cBytes);
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION FillDataSetHeader(
+   IntEbmType countFeatures,
+   IntEbmType countInstances,
+   IntEbmType countBytesAllocated,
+   unsigned char * fillMem
+) {
+   LOG_N(TraceLevelInfo, "Entered FillDataSetHeader: countFeatures=%" IntEbmTypePrintf ", countInstances=%" IntEbmTypePrintf
+      ", countBytesAllocated=%" IntEbmTypePrintf ", fillMem=%p",
+      countFeatures,
+      countInstances,
+      countBytesAllocated,
+      static_cast<void *>(fillMem)
+   );
+
+   if(nullptr == fillMem) {
+      LOG_0(TraceLevelError, "ERROR FillDataSetHeader nullptr == fillMem");
+      return 1;
+   }
+   if(countFeatures < 0 || !IsNumberConvertable<size_t, IntEbmType>(countFeatures)) {
+      LOG_0(TraceLevelError, "ERROR FillDataSetHeader countFeatures must be zero or positive");
+      return 1;
+   }
+   if(countInstances < 0 || !IsNumberConvertable<size_t, IntEbmType>(countInstances)) {
+      LOG_0(TraceLevelError, "ERROR FillDataSetHeader countInstances must be zero or positive");
+      return 1;
+   }
+   if(countBytesAllocated < 0 || !IsNumberConvertable<size_t, IntEbmType>(countBytesAllocated)) {
+      LOG_0(TraceLevelError, "ERROR FillDataSetHeader countBytesAllocated must be zero or positive");
+      return 1;
+   }
+   const size_t cFeatures = static_cast<size_t>(countFeatures);
+   const size_t cInstances = static_cast<size_t>(countInstances);
+
+   size_t cBytesHeader;
+   size_t cBytesPerFeature;
+   if(GetBytesHeader(cFeatures, &cBytesHeader) || GetBytesPerFeature(cInstances, &cBytesPerFeature)) {
+      return 1;
+   }
+   if(IsMultiplyError(cBytesPerFeature, cFeatures)) {
+      LOG_0(TraceLevelWarning, "WARNING FillDataSetHeader IsMultiplyError(cBytesPerFeature, cFeatures)");
+      return 1;
+   }
+   const size_t cBytesBinnedData = cBytesPerFeature * cFeatures;
+   // the targets take the same space as one feature
+   if(IsAddError(cBytesHeader, cBytesBinnedData) || IsAddError(cBytesHeader + cBytesBinnedData, cBytesPerFeature)) {
+      LOG_0(TraceLevelWarning, "WARNING FillDataSetHeader IsAddError");
+      return 1;
+   }
+   if(static_cast<size_t>(countBytesAllocated) < cBytesHeader + cBytesBinnedData + cBytesPerFeature) {
+      LOG_0(TraceLevelError, "ERROR FillDataSetHeader countBytesAllocated is smaller than the sizes returned by the Size* functions");
+      return 1;
+   }
+
+   memset(fillMem, 0, cBytesHeader);
+   DataSetSharedHeader * const pHeader = reinterpret_cast<DataSetSharedHeader *>(fillMem);
+   pHeader->m_id = k_sharedDataSetId;
+   pHeader->m_cBytes = countBytesAllocated;
+   pHeader->m_cFeatures = countFeatures;
+   pHeader->m_cInstances = countInstances;
+   pHeader->m_cFeaturesFilled = 0;
+   pHeader->m_runtimeLearningTypeOrCountTargetClasses = 0;
+   pHeader->m_offsetFeatures = static_cast<IntEbmType>(sizeof(DataSetSharedHeader));
+   pHeader->m_offsetBinnedData = static_cast<IntEbmType>(cBytesHeader);
+   pHeader->m_offsetTargets = 0;
+
+   LOG_0(TraceLevelInfo, "Exited FillDataSetHeader");
+   return 0;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION FillFeature(
+   IntEbmType featureType,
+   IntEbmType hasMissing,
+   IntEbmType countBins,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType countBytesAllocated,
+   unsigned char * fillMem
+) {
+   LOG_N(TraceLevelInfo, "Entered FillFeature: featureType=%" IntEbmTypePrintf ", hasMissing=%" IntEbmTypePrintf ", countBins=%" IntEbmTypePrintf
+      ", countInstances=%" IntEbmTypePrintf ", binnedData=%p, countBytesAllocated=%" IntEbmTypePrintf ", fillMem=%p",
+      featureType,
+      hasMissing,
+      countBins,
+      countInstances,
+      static_cast<const void *>(binnedData),
+      countBytesAllocated,
+      static_cast<void *>(fillMem)
+   );
+
+   DataSetSharedHeader * const pHeader = GetHeaderForFill(countBytesAllocated, fillMem);
+   if(nullptr == pHeader) {
+      return 1;
+   }
+   if(pHeader->m_cFeatures <= pHeader->m_cFeaturesFilled) {
+      LOG_0(TraceLevelError, "ERROR FillFeature all the features have already been filled");
+      return 1;
+   }
+   if(countInstances != pHeader->m_cInstances) {
+      LOG_0(TraceLevelError, "ERROR FillFeature countInstances does not match the value given to FillDataSetHeader");
+      return 1;
+   }
+   if(FeatureTypeOrdinal != featureType && FeatureTypeNominal != featureType) {
+      LOG_0(TraceLevelError, "ERROR FillFeature featureType must be FeatureTypeOrdinal or FeatureTypeNominal");
+      return 1;
+   }
+   if(EBM_FALSE != hasMissing && EBM_TRUE != hasMissing) {
+      LOG_0(TraceLevelError, "ERROR FillFeature hasMissing must be EBM_FALSE or EBM_TRUE");
+      return 1;
+   }
+   if(countBins < 0 || (0 == countBins && 0 != countInstances)) {
+      LOG_0(TraceLevelError, "ERROR FillFeature countBins must be positive if there are instances");
+      return 1;
+   }
+   if(0 != countInstances && nullptr == binnedData) {
+      LOG_0(TraceLevelError, "ERROR FillFeature nullptr == binnedData");
+      return 1;
+   }
+
+   const size_t cInstances = static_cast<size_t>(countInstances);
+   const size_t iFeature = static_cast<size_t>(pHeader->m_cFeaturesFilled);
+
+   // the binned data is checked here once, so that the datasets we build from this memory later can rely on it
+   const IntEbmType * pBinnedData = binnedData;
+   const IntEbmType * const pBinnedDataEnd = binnedData + cInstances;
+   while(pBinnedDataEnd != pBinnedData) {
+      const IntEbmType data = *pBinnedData;
+      if(data < 0 || countBins <= data) {
+         LOG_0(TraceLevelError, "ERROR FillFeature binnedData values must be zero or positive and less than countBins");
+         return 1;
+      }
+      ++pBinnedData;
+   }
+
+   EbmNativeFeature * const pFeature =
+      reinterpret_cast<EbmNativeFeature *>(fillMem + static_cast<size_t>(pHeader->m_offsetFeatures)) + iFeature;
+   pFeature->featureType = featureType;
+   pFeature->hasMissing = hasMissing;
+   pFeature->countBins = countBins;
+
+   if(0 != cInstances) {
+      // we checked in FillDataSetHeader that the entire binned data section fits in countBytesAllocated
+      IntEbmType * const aBinnedDataTo =
+         reinterpret_cast<IntEbmType *>(fillMem + static_cast<size_t>(pHeader->m_offsetBinnedData)) + iFeature * cInstances;
+      memcpy(aBinnedDataTo, binnedData, sizeof(IntEbmType) * cInstances);
+   }
+   ++pHeader->m_cFeaturesFilled;
+
+   LOG_0(TraceLevelInfo, "Exited FillFeature");
+   return 0;
+}
+
+// returns nullptr on error, otherwise the location where the targets go
+static unsigned char * PrepareTargetFill(
+   const IntEbmType countInstances,
+   const void * const targets,
+   const IntEbmType countBytesAllocated,
+   unsigned char * const fillMem
+) {
+   DataSetSharedHeader * const pHeader = GetHeaderForFill(countBytesAllocated, fillMem);
+   if(nullptr == pHeader) {
+      return nullptr;
+   }
+   if(pHeader->m_cFeaturesFilled != pHeader->m_cFeatures) {
+      LOG_0(TraceLevelError, "ERROR PrepareTargetFill all the features need to be filled before the targets");
+      return nullptr;
+   }
+   if(countInstances != pHeader->m_cInstances) {
+      LOG_0(TraceLevelError, "ERROR PrepareTargetFill countInstances does not match the value given to FillDataSetHeader");
+      return nullptr;
+   }
+   if(0 != countInstances && nullptr == targets) {
+      LOG_0(TraceLevelError, "ERROR PrepareTargetFill nullptr == targets");
+      return nullptr;
+   }
+   // the targets go directly after the binned data, which FillDataSetHeader checked fits in countBytesAllocated
+   return fillMem + static_cast<size_t>(pHeader->m_offsetBinnedData) +
+      sizeof(IntEbmType) * static_cast<size_t>(pHeader->m_cInstances) * static_cast<size_t>(pHeader->m_cFeatures);
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION FillClassificationTarget(
+   IntEbmType countTargetClasses,
+   IntEbmType countInstances,
+   const IntEbmType * targets,
+   IntEbmType countBytesAllocated,
+   unsigned char * fillMem
+) {
+   LOG_N(TraceLevelInfo, "Entered FillClassificationTarget: countTargetClasses=%" IntEbmTypePrintf ", countInstances=%" IntEbmTypePrintf
+      ", targets=%p, countBytesAllocated=%" IntEbmTypePrintf ", fillMem=%p",
+      countTargetClasses,
+      countInstances,
+      static_cast<const void *>(targets),
+      countBytesAllocated,
+      static_cast<void *>(fillMem)
+   );
+
+   if(countTargetClasses < 0 || (0 == countTargetClasses && 0 != countInstances)) {
+      LOG_0(TraceLevelError, "ERROR FillClassificationTarget countTargetClasses must be positive if there are instances");
+      return 1;
+   }
+   if(!IsNumberConvertable<ptrdiff_t, IntEbmType>(countTargetClasses)) {
+      LOG_0(TraceLevelWarning, "WARNING FillClassificationTarget !IsNumberConvertable<ptrdiff_t, IntEbmType>(countTargetClasses)");
+      return 1;
+   }
+   unsigned char * const pTargetsTo = PrepareTargetFill(countInstances, targets, countBytesAllocated, fillMem);
+   if(nullptr == pTargetsTo) {
+      return 1;
+   }
+   const size_t cInstances = static_cast<size_t>(countInstances);
+   for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
+      const IntEbmType target = targets[iInstance];
+      if(target < 0 || countTargetClasses <= target) {
+         LOG_0(TraceLevelError, "ERROR FillClassificationTarget targets must be zero or positive and less than countTargetClasses");
+         return 1;
+      }
+   }
+   if(0 != cInstances) {
+      memcpy(pTargetsTo, targets, sizeof(IntEbmType) * cInstances);
+   }
+   DataSetSharedHeader * const pHeader = reinterpret_cast<DataSetSharedHeader *>(fillMem);
+   pHeader->m_runtimeLearningTypeOrCountTargetClasses = countTargetClasses;
+   // setting the target offset marks the dataset as complete and read only
+   pHeader->m_offsetTargets = static_cast<IntEbmType>(pTargetsTo - fillMem);
+
+   LOG_0(TraceLevelInfo, "Exited FillClassificationTarget");
+   return 0;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION FillRegressionTarget(
+   IntEbmType countInstances,
+   const FloatEbmType * targets,
+   IntEbmType countBytesAllocated,
+   unsigned char * fillMem
+) {
+   LOG_N(TraceLevelInfo, "Entered FillRegressionTarget: countInstances=%" IntEbmTypePrintf ", targets=%p, countBytesAllocated=%" IntEbmTypePrintf
+      ", fillMem=%p",
+      countInstances,
+      static_cast<const void *>(targets),
+      countBytesAllocated,
+      static_cast<void *>(fillMem)
+   );
+
+   unsigned char * const pTargetsTo = PrepareTargetFill(countInstances, targets, countBytesAllocated, fillMem);
+   if(nullptr == pTargetsTo) {
+      return 1;
+   }
+   const size_t cInstances = static_cast<size_t>(countInstances);
+   if(0 != cInstances) {
+      memcpy(pTargetsTo, targets, sizeof(FloatEbmType) * cInstances);
+   }
+   DataSetSharedHeader * const pHeader = reinterpret_cast<DataSetSharedHeader *>(fillMem);
+   pHeader->m_runtimeLearningTypeOrCountTargetClasses = static_cast<IntEbmType>(k_Regression);
+   // setting the target offset marks the dataset as complete and read only
+   pHeader->m_offsetTargets = static_cast<IntEbmType>(pTargetsTo - fillMem);
+
+   LOG_0(TraceLevelInfo, "Exited FillRegressionTarget");
+   return 0;
+}
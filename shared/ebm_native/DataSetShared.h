@@ -0,0 +1,28 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef DATA_SET_SHARED_H
+#define DATA_SET_SHARED_H
+
+#include <stddef.h> // size_t, ptrdiff_t
+
+#include "ebm_native.h" // FloatEbmType
+#include "EbmInternal.h" // EBM_INLINE
+
+// a completely filled shared dataset, viewed in place.  Everything here points into our caller's read only memory, so nothing needs to be freed
+struct DataSetSharedView final {
+   size_t m_cFeatures;
+   size_t m_cInstances;
+   ptrdiff_t m_runtimeLearningTypeOrCountTargetClasses;
+   const EbmNativeFeature * m_aFeatures;
+   // feature major, so the binned data for feature iFeature starts at m_aBinnedData[iFeature * m_cInstances]
+   const IntEbmType * m_aBinnedData;
+   // IntEbmType for classification and FloatEbmType for regression
+   const void * m_aTargets;
+};
+
+// checks that pDataSet holds a completely filled shared dataset and points pViewOut at its parts.  Returns true on error
+bool GetDataSetSharedView(const void * const pDataSet, DataSetSharedView * const pViewOut);
+
+#endif // DATA_SET_SHARED_H
@@ -14,7 +14,7 @@
 #include "EbmStatistics.h"
 #include "CachedThreadResources.h"
 #include "Feature.h"
-#include "SamplingWithReplacement.h"
+#include "SamplingMethod.h"
 #include "HistogramBucket.h"
 
 #ifndef NDEBUG
@@ -123,7 +123,9 @@ void CompareTotalsDebug(
          runtimeLearningTypeOrCountTargetClasses, 
          pComparison2
       );
-      EBM_ASSERT(pComparison->m_cInstancesInBucket == pComparison2->m_cInstancesInBucket);
+      // we sum in a different order here, so fractional weights can differ in their last bits.  Unweighted counts are exact
+      EBM_ASSERT(std::abs(pComparison->m_weightInBucket - pComparison2->m_weightInBucket) <= 
+         k_epsilonResidualError * pComparison2->m_weightInBucket);
       free(pComparison2);
    }
 }
@@ -234,7 +236,7 @@ void CompareTotalsDebug(
 //            aiLast[iDebugDimension] = currentIndexAndCountBins[iDebugDimension].m_iCur;
 //         }
 //         GetTotalsDebugSlow<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(aHistogramBucketsDebugCopy, pFeatureCombination, aiStart, aiLast, runtimeLearningTypeOrCountTargetClasses, pDebugBucket);
-//         EBM_ASSERT(pDebugBucket->m_cInstancesInBucket == pHistogramBucket->m_cInstancesInBucket);
+//         EBM_ASSERT(pDebugBucket->m_weightInBucket == pHistogramBucket->m_weightInBucket);
 //
 //         free(aHistogramBucketsDebugCopy);
 //      }
@@ -367,7 +369,7 @@ void CompareTotalsDebug(
 //            multipleTotalDebug = currentIndexAndCountBins[iDebugDimension].multipleTotal;
 //         }
 //         GetTotalsDebugSlow<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(aHistogramBucketsDebugCopy, pFeatureCombination, aiStart, aiLast, runtimeLearningTypeOrCountTargetClasses, pDebugBucket);
-//         EBM_ASSERT(pDebugBucket->m_cInstancesInBucket == pHistogramBucket->m_cInstancesInBucket);
+//         EBM_ASSERT(pDebugBucket->m_weightInBucket == pHistogramBucket->m_weightInBucket);
 //         free(aHistogramBucketsDebugCopy);
 //      }
 //#endif // NDEBUG
@@ -396,6 +398,108 @@ void CompareTotalsDebug(
 
 
 
+// pairs are nearly all of our interaction terms, so we build their totals with two plain loops instead of the N-dimensional bookkeeping in 
+// BuildFastTotals.  Dimension 0 is contiguous in memory.  We keep a running total for each bin of dimension 0 in our auxiliary zone and a running 
+// total along the current row, which adds our buckets in exactly the same order as BuildFastTotals, so both produce identical totals
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
+void BuildFastTotalsPair(
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets, 
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses, 
+   const FeatureCombination * const pFeatureCombination, 
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const pBucketAuxiliaryBuildZone
+#ifndef NDEBUG
+   , const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsDebugCopy, 
+   const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+   LOG_0(TraceLevelVerbose, "Entered BuildFastTotalsPair");
+
+   EBM_ASSERT(2 == pFeatureCombination->m_cFeatures);
+
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+
+   const size_t cBins0 = ARRAY_TO_POINTER_CONST(pFeatureCombination->m_FeatureCombinationEntry)[0].m_pFeature->m_cBins;
+   const size_t cBins1 = ARRAY_TO_POINTER_CONST(pFeatureCombination->m_FeatureCombinationEntry)[1].m_pFeature->m_cBins;
+   // this function can handle 1 == cBins even though that's a degenerate case that shouldn't be boosted on 
+   // (dimensions with 1 bin don't contribute anything since they always have the same value)
+   EBM_ASSERT(1 <= cBins0);
+   EBM_ASSERT(1 <= cBins1);
+
+   // BuildFastTotals puts the running total of dimension 0 first, followed by the running totals for each bin of dimension 0
+   HistogramBucket<bClassification> * const pRowTotal = pBucketAuxiliaryBuildZone;
+   HistogramBucket<bClassification> * const aColumnTotals =
+      GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pBucketAuxiliaryBuildZone, 1);
+
+#ifndef NDEBUG
+   // the last column total needs to fit within our buffer
+   ASSERT_BINNED_BUCKET_OK(
+      cBytesPerHistogramBucket, 
+      GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aColumnTotals, cBins0 - 1), 
+      aHistogramBucketsEndDebug
+   );
+   for(size_t iBucketDebug = 0; iBucketDebug <= cBins0; ++iBucketDebug) {
+      GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pBucketAuxiliaryBuildZone, iBucketDebug)->AssertZero(cVectorLength);
+   }
+   HistogramBucket<bClassification> * const pDebugBucket =
+      static_cast<HistogramBucket<bClassification> *>(malloc(cBytesPerHistogramBucket));
+#endif //NDEBUG
+
+   HistogramBucket<bClassification> * pHistogramBucket = aHistogramBuckets;
+   size_t iBin1 = 0;
+   do {
+      HistogramBucket<bClassification> * pColumnTotal = aColumnTotals;
+      size_t iBin0 = 0;
+      do {
+         ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucket, aHistogramBucketsEndDebug);
+
+         pColumnTotal->Add(*pHistogramBucket, cVectorLength);
+         pRowTotal->Add(*pColumnTotal, cVectorLength);
+         pHistogramBucket->Copy(*pRowTotal, cVectorLength);
+
+#ifndef NDEBUG
+         if(nullptr != aHistogramBucketsDebugCopy && nullptr != pDebugBucket) {
+            size_t aiStart[2] = { 0, 0 };
+            size_t aiLast[2] = { iBin0, iBin1 };
+            GetTotalsDebugSlow<bClassification>(
+               aHistogramBucketsDebugCopy, 
+               pFeatureCombination, 
+               aiStart, 
+               aiLast, 
+               runtimeLearningTypeOrCountTargetClasses, 
+               pDebugBucket
+            );
+            // we sum in a different order here, so fractional weights can differ in their last bits.  Unweighted counts are exact
+            EBM_ASSERT(std::abs(pDebugBucket->m_weightInBucket - pHistogramBucket->m_weightInBucket) <= 
+               k_epsilonResidualError * pDebugBucket->m_weightInBucket);
+         }
+#endif // NDEBUG
+
+         pColumnTotal = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pColumnTotal, 1);
+         pHistogramBucket = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pHistogramBucket, 1);
+         ++iBin0;
+      } while(iBin0 < cBins0);
+      pRowTotal->Zero(cVectorLength);
+      ++iBin1;
+   } while(iBin1 < cBins1);
+
+   // leave our auxiliary zone zeroed, just like BuildFastTotals does
+   memset(aColumnTotals, 0, cBytesPerHistogramBucket * cBins0);
+
+#ifndef NDEBUG
+   free(pDebugBucket);
+#endif // NDEBUG
+
+   LOG_0(TraceLevelVerbose, "Exited BuildFastTotalsPair");
+}
+
 // TODO : ALL OF THE BELOW!
 //- D is the number of dimensions
 //- N is the number of cases per dimension(assume all dimensions have the same number of cases for simplicity)
@@ -409,7 +513,7 @@ void CompareTotalsDebug(
 //- have a look at our final dimensionality.Is the totals calculation the bottleneck, or the point to corner totals function ?
 //- I think I understand the costs of all implementations of point to corner computation, so don't implement the (1,1,...,1,1) to point algorithm yet.. try implementing the more optimized totals calculation (with more memory).  After we have the optimized totals calculation, then try to re-do the splitting code to do splitting at the same time as totals calculation.  If that isn't better than our existing stuff, then optimzie the point to corner calculation code
 //- implement a function that calcualtes the total of any volume using just the(0, 0, ..., 0, 0) totals ..as a debugging function.We might use this for trying out more complicated splits where we allow 2 splits on some axies
-// TODO: build a pair and triple specific version of this function.  For pairs we can get ride of the pPrevious and just use the actual cell at (-1,-1) from our current cell, and we can use two loops with everything in memory [look at code above from before we incoporated the previous totals].  Triples would also benefit from pulling things out since we have low iterations of the inner loop and we can access indicies directly without additional add/subtract/bit operations.  Beyond triples, the combinatorial choices start to explode, so we should probably use this general N-dimensional code.
+// TODO: build a triple specific version of this function (pairs are handled by BuildFastTotalsPair).  Triples would also benefit from pulling things out since we have low iterations of the inner loop and we can access indicies directly without additional add/subtract/bit operations.  Beyond triples, the combinatorial choices start to explode, so we should probably use this general N-dimensional code.
 // TODO: after we build pair and triple specific versions of this function, we don't need to have a compiler countCompilerDimensions, since the compiler won't really be able to simpify the loops that are exploding in dimensionality
 // TODO: sort our N-dimensional combinations at initialization so that the longest dimension is first!  That way we can more efficiently walk through contiguous memory better in this function!  After we determine the cuts, we can undo the re-ordering for cutting the tensor, which has just a few cells, so will be efficient
 template<bool bClassification>
@@ -438,6 +542,20 @@ void BuildFastTotals(
    const size_t cDimensions = GET_ATTRIBUTE_COMBINATION_DIMENSIONS(countCompilerDimensions, pFeatureCombination->m_cFeatures);
    EBM_ASSERT(1 <= cDimensions);
 
+   if(2 == cDimensions) {
+      BuildFastTotalsPair<compilerLearningTypeOrCountTargetClasses>(
+         aHistogramBuckets, 
+         runtimeLearningTypeOrCountTargetClasses, 
+         pFeatureCombination, 
+         pBucketAuxiliaryBuildZone
+#ifndef NDEBUG
+         , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
+#endif // NDEBUG
+      );
+      LOG_0(TraceLevelVerbose, "Exited BuildFastTotals");
+      return;
+   }
+
    const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
       compilerLearningTypeOrCountTargetClasses,
       runtimeLearningTypeOrCountTargetClasses
@@ -544,7 +662,9 @@ void BuildFastTotals(
             runtimeLearningTypeOrCountTargetClasses, 
             pDebugBucket
          );
-         EBM_ASSERT(pDebugBucket->m_cInstancesInBucket == pHistogramBucket->m_cInstancesInBucket);
+         // we sum in a different order here, so fractional weights can differ in their last bits.  Unweighted counts are exact
+         EBM_ASSERT(std::abs(pDebugBucket->m_weightInBucket - pHistogramBucket->m_weightInBucket) <= 
+            k_epsilonResidualError * pDebugBucket->m_weightInBucket);
       }
 #endif // NDEBUG
 
@@ -657,9 +777,9 @@ void BuildFastTotals(
 //
 //      ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucket, aHistogramBucketsEndDebug);
 //
-//      const size_t cInstancesInBucket = pHistogramBucket->m_cInstancesInBucket + pPrevious->m_cInstancesInBucket;
-//      pHistogramBucket->m_cInstancesInBucket = cInstancesInBucket;
-//      pPrevious->m_cInstancesInBucket = cInstancesInBucket;
+//      const FloatEbmType weightInBucket = pHistogramBucket->m_weightInBucket + pPrevious->m_weightInBucket;
+//      pHistogramBucket->m_weightInBucket = weightInBucket;
+//      pPrevious->m_weightInBucket = weightInBucket;
 //      for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
 //         const FloatEbmType sumResidualError = ARRAY_TO_POINTER(pHistogramBucket->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError + ARRAY_TO_POINTER(pPrevious->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError;
 //         ARRAY_TO_POINTER(pHistogramBucket->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError = sumResidualError;
@@ -715,7 +835,7 @@ void BuildFastTotals(
 //         multipleTotalDebug = currentIndexAndCountBins[iDebugDimension].multipleTotal;
 //      }
 //      GetTotalsDebugSlow<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(aHistogramBucketsDebugCopy, pFeatureCombination, aiStart, aiLast, runtimeLearningTypeOrCountTargetClasses, pDebugBucket);
-//      EBM_ASSERT(pDebugBucket->m_cInstancesInBucket == pHistogramBucket->m_cInstancesInBucket);
+//      EBM_ASSERT(pDebugBucket->m_weightInBucket == pHistogramBucket->m_weightInBucket);
 //#endif // NDEBUG
 //
 //      // we're walking through all buckets, so just move to the next one in the flat array, with the knoledge that we'll figure out it's multi-dimenional index below
@@ -760,6 +880,97 @@ struct TotalsDimension {
    size_t m_cLast;
 };
 
+// the pair version of GetTotals.  Our totals are a summed area table, so each of the 4 quadrants around aiPoint takes at most 4 direct lookups.  
+// We add and subtract them in the same order as GetTotals so that both return identical totals
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
+void GetTotalsPair(
+   const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets, 
+   const FeatureCombination * const pFeatureCombination, 
+   const size_t * const aiPoint, 
+   const size_t directionVector, 
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses, 
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const pRet
+#ifndef NDEBUG
+   , const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsDebugCopy, 
+   const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+   // don't LOG this!  It would create way too much chatter!
+
+   EBM_ASSERT(2 == pFeatureCombination->m_cFeatures);
+   EBM_ASSERT(directionVector < 4);
+
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+
+   const size_t cBins0 = ARRAY_TO_POINTER_CONST(pFeatureCombination->m_FeatureCombinationEntry)[0].m_pFeature->m_cBins;
+   const size_t cBins1 = ARRAY_TO_POINTER_CONST(pFeatureCombination->m_FeatureCombinationEntry)[1].m_pFeature->m_cBins;
+   const size_t iBin0 = aiPoint[0];
+   const size_t iBin1 = aiPoint[1];
+   EBM_ASSERT(iBin0 < cBins0);
+   EBM_ASSERT(iBin1 < cBins1);
+
+   // we're accessing allocated memory, so none of these can overflow
+   const size_t iRow = iBin1 * cBins0;
+   const size_t iLastRow = (cBins1 - 1) * cBins0;
+   const HistogramBucket<bClassification> * const pLowLow = 
+      GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBuckets, iRow + iBin0);
+   ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pRet, aHistogramBucketsEndDebug);
+   ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pLowLow, aHistogramBucketsEndDebug);
+
+   if(0 == directionVector) {
+      pRet->Copy(*pLowLow, cVectorLength);
+      return;
+   }
+   if(1 == directionVector) {
+      const HistogramBucket<bClassification> * const pHighLow =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBuckets, iRow + cBins0 - 1);
+      ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHighLow, aHistogramBucketsEndDebug);
+      pRet->Copy(*pHighLow, cVectorLength);
+      pRet->Subtract(*pLowLow, cVectorLength);
+   } else {
+      const HistogramBucket<bClassification> * const pLowHigh =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBuckets, iLastRow + iBin0);
+      ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pLowHigh, aHistogramBucketsEndDebug);
+      if(2 == directionVector) {
+         pRet->Copy(*pLowHigh, cVectorLength);
+         pRet->Subtract(*pLowLow, cVectorLength);
+      } else {
+         EBM_ASSERT(3 == directionVector);
+         const HistogramBucket<bClassification> * const pHighLow =
+            GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBuckets, iRow + cBins0 - 1);
+         const HistogramBucket<bClassification> * const pHighHigh =
+            GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBuckets, iLastRow + cBins0 - 1);
+         ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHighLow, aHistogramBucketsEndDebug);
+         ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHighHigh, aHistogramBucketsEndDebug);
+         pRet->Copy(*pLowLow, cVectorLength);
+         pRet->Subtract(*pHighLow, cVectorLength);
+         pRet->Subtract(*pLowHigh, cVectorLength);
+         pRet->Add(*pHighHigh, cVectorLength);
+      }
+   }
+
+#ifndef NDEBUG
+   if(nullptr != aHistogramBucketsDebugCopy) {
+      CompareTotalsDebug<bClassification>(
+         aHistogramBucketsDebugCopy, 
+         pFeatureCombination, 
+         aiPoint, 
+         directionVector, 
+         runtimeLearningTypeOrCountTargetClasses, 
+         pRet
+      );
+   }
+#endif // NDEBUG
+}
+
 template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t countCompilerDimensions>
 void GetTotals(
    const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets, 
@@ -782,6 +993,21 @@ void GetTotals(
    EBM_ASSERT(1 <= cDimensions);
    EBM_ASSERT(cDimensions < k_cBitsForSizeT);
 
+   if(2 == cDimensions) {
+      GetTotalsPair<compilerLearningTypeOrCountTargetClasses>(
+         aHistogramBuckets, 
+         pFeatureCombination, 
+         aiPoint, 
+         directionVector, 
+         runtimeLearningTypeOrCountTargetClasses, 
+         pRet
+#ifndef NDEBUG
+         , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
+#endif // NDEBUG
+      );
+      return;
+   }
+
    const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
       compilerLearningTypeOrCountTargetClasses,
       runtimeLearningTypeOrCountTargetClasses
@@ -917,6 +1143,162 @@ void GetTotals(
 #endif // NDEBUG
 }
 
+// walks the cuts of one dimension of a pair.  If cSuperBinBins is 0 we try every cut.  Otherwise we group our bins into super-bins of cSuperBinBins
+// bins, try only the cuts between super-bins, and then try every cut inside the two super-bins next to the best of those.  For features with
+// thousands of bins this visits about cBins / cSuperBinBins + 2 * cSuperBinBins cuts instead of cBins - 1, and since our pair splitter nests a
+// sweep of one dimension inside a sweep of the other, the savings multiply.  Gains are usually close to the exhaustive search, but not always equal
+class CoarseToFineCuts final {
+   const size_t m_cSuperBinBins;
+   size_t m_iCut;
+   size_t m_iCutEnd;
+   size_t m_cStep;
+   bool m_bCoarseBest;
+   size_t m_iCoarseBest;
+   FloatEbmType m_coarseBestScore;
+
+public:
+
+   EBM_INLINE CoarseToFineCuts(const size_t cSuperBinBins, const size_t cBins)
+      : m_cSuperBinBins(cSuperBinBins)
+      , m_iCut(0)
+      , m_iCutEnd(cBins - 1)
+      , m_cStep(1)
+      , m_bCoarseBest(false)
+      , m_iCoarseBest(0)
+      , m_coarseBestScore(k_illegalGain) {
+      EBM_ASSERT(2 <= cBins);
+      if(IsCoarseToFine(cSuperBinBins, cBins)) {
+         m_iCut = cSuperBinBins - 1;
+         m_cStep = cSuperBinBins;
+      }
+   }
+
+   EBM_INLINE static bool IsCoarseToFine(const size_t cSuperBinBins, const size_t cBins) {
+      // with fewer than 2 super-bins per side of our refinement, we'd try about as many cuts as the exhaustive search
+      return 2 <= cSuperBinBins && cSuperBinBins < (cBins >> 1);
+   }
+
+   EBM_INLINE size_t GetCut() const {
+      return m_iCut;
+   }
+
+   EBM_INLINE void RecordScore(const FloatEbmType splittingScore) {
+      // we use the same NaN propagating comparison as our callers
+      if(1 != m_cStep && !(splittingScore <= m_coarseBestScore)) {
+         m_coarseBestScore = splittingScore;
+         m_iCoarseBest = m_iCut;
+         m_bCoarseBest = true;
+      }
+   }
+
+   EBM_INLINE bool Next() {
+      m_iCut += m_cStep;
+      if(UNLIKELY(m_iCutEnd <= m_iCut)) {
+         if(1 == m_cStep) {
+            return false;
+         }
+         m_cStep = 1;
+         if(m_bCoarseBest) {
+            EBM_ASSERT(m_cSuperBinBins - 1 <= m_iCoarseBest);
+            m_iCut = m_iCoarseBest - (m_cSuperBinBins - 1);
+            const size_t iCutEnd = m_iCoarseBest + m_cSuperBinBins;
+            m_iCutEnd = iCutEnd < m_iCutEnd ? iCutEnd : m_iCutEnd;
+         } else {
+            // our minimum child weights can reject every cut between super-bins while allowing some inside them, so try them all
+            m_iCut = 0;
+         }
+         EBM_ASSERT(m_iCut < m_iCutEnd);
+      }
+      return true;
+   }
+};
+
+// scores a single cut for SweepMultiDiemensional and SweepPairBlock.  The totals below and above the cut are left in pTotalsLow and the bucket 
+// after it.  Returns k_illegalGain if either side has fewer than cInstancesRequiredForChildSplitMin instances
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t countCompilerDimensions>
+EBM_INLINE FloatEbmType ScoreSweepCut(
+   const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets, 
+   const FeatureCombination * const pFeatureCombination, 
+   const size_t * const aiPoint, 
+   const size_t directionVectorLow, 
+   const size_t directionVectorHigh, 
+   const size_t cInstancesRequiredForChildSplitMin, 
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses, 
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const pTotalsLow
+#ifndef NDEBUG
+   , const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsDebugCopy, 
+   const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+   // don't LOG this!  It would create way too much chatter!
+
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+
+   HistogramBucket<bClassification> * const pTotalsHigh =
+      GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pTotalsLow, 1);
+   ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pTotalsLow, aHistogramBucketsEndDebug);
+   ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pTotalsHigh, aHistogramBucketsEndDebug);
+
+   GetTotals<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
+      aHistogramBuckets, 
+      pFeatureCombination, 
+      aiPoint, 
+      directionVectorLow, 
+      runtimeLearningTypeOrCountTargetClasses, 
+      pTotalsLow
+#ifndef NDEBUG
+      , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
+#endif // NDEBUG
+   );
+   if(UNLIKELY(!(static_cast<FloatEbmType>(cInstancesRequiredForChildSplitMin) <= pTotalsLow->m_weightInBucket))) {
+      return k_illegalGain;
+   }
+   GetTotals<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
+      aHistogramBuckets, 
+      pFeatureCombination, 
+      aiPoint, 
+      directionVectorHigh, 
+      runtimeLearningTypeOrCountTargetClasses, 
+      pTotalsHigh
+#ifndef NDEBUG
+      , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
+#endif // NDEBUG
+   );
+   if(UNLIKELY(!(static_cast<FloatEbmType>(cInstancesRequiredForChildSplitMin) <= pTotalsHigh->m_weightInBucket))) {
+      return k_illegalGain;
+   }
+   FloatEbmType splittingScore = FloatEbmType { 0 };
+#ifndef LEGACY_COMPATIBILITY
+   EBM_ASSERT(0 < pTotalsLow->m_weightInBucket);
+   EBM_ASSERT(0 < pTotalsHigh->m_weightInBucket);
+#endif // LEGACY_COMPATIBILITY
+   FloatEbmType weightLow = pTotalsLow->m_weightInBucket;
+   FloatEbmType weightHigh = pTotalsHigh->m_weightInBucket;
+   for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+      // TODO : we can make this faster by doing the division in ComputeNodeSplittingScore after we add all the numerators 
+      // (but only do this after we've determined the best node splitting score for classification, and the NewtonRaphsonStep for gain
+
+      const FloatEbmType splittingScoreUpdate1 = EbmStatistics::ComputeNodeSplittingScore(
+         ARRAY_TO_POINTER(pTotalsLow->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, weightLow);
+      EBM_ASSERT(std::isnan(splittingScoreUpdate1) || FloatEbmType { 0 } <= splittingScoreUpdate1);
+      splittingScore += splittingScoreUpdate1;
+      const FloatEbmType splittingScoreUpdate2 = EbmStatistics::ComputeNodeSplittingScore(
+         ARRAY_TO_POINTER(pTotalsHigh->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, weightHigh);
+      EBM_ASSERT(std::isnan(splittingScoreUpdate2) || FloatEbmType { 0 } <= splittingScoreUpdate2);
+      splittingScore += splittingScoreUpdate2;
+   }
+   EBM_ASSERT(std::isnan(splittingScore) || FloatEbmType { 0 } <= splittingScore); // sumation of positive numbers should be positive
+   return splittingScore;
+}
+
 template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t countCompilerDimensions>
 FloatEbmType SweepMultiDiemensional(
    const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets, 
@@ -926,6 +1308,8 @@ FloatEbmType SweepMultiDiemensional(
    const unsigned int iDimensionSweep, 
    const size_t cInstancesRequiredForChildSplitMin, 
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses, 
+   // see CoarseToFineCuts.  0 tries every cut
+   const size_t cSuperBinBins, 
    HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const pHistogramBucketBestAndTemp, 
    size_t * const piBestCut
 #ifndef NDEBUG
@@ -937,8 +1321,6 @@ FloatEbmType SweepMultiDiemensional(
 
    // don't LOG this!  It would create way too much chatter!
 
-   // TODO : optimize this function
-
    EBM_ASSERT(1 <= pFeatureCombination->m_cFeatures);
    EBM_ASSERT(iDimensionSweep < pFeatureCombination->m_cFeatures);
    EBM_ASSERT(0 == (directionVectorLow & (size_t { 1 } << iDimensionSweep)));
@@ -966,94 +1348,59 @@ FloatEbmType SweepMultiDiemensional(
       GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pHistogramBucketBestAndTemp, 2);
    ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pTotalsLow, aHistogramBucketsEndDebug);
 
-   HistogramBucket<bClassification> * const pTotalsHigh =
-      GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pHistogramBucketBestAndTemp, 3);
-   ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pTotalsHigh, aHistogramBucketsEndDebug);
-
 #ifndef LEGACY_COMPATIBILITY
    EBM_ASSERT(0 < cInstancesRequiredForChildSplitMin);
 #endif // LEGACY_COMPATIBILITY
 
    FloatEbmType bestSplit = k_illegalGain;
-   size_t iBin = 0;
+   CoarseToFineCuts cuts(cSuperBinBins, cBins);
    do {
+      const size_t iBin = cuts.GetCut();
       *piBin = iBin;
 
-      GetTotals<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
+      const FloatEbmType splittingScore = ScoreSweepCut<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
          aHistogramBuckets, 
          pFeatureCombination, 
          aiPoint, 
          directionVectorLow, 
+         directionVectorHigh, 
+         cInstancesRequiredForChildSplitMin, 
          runtimeLearningTypeOrCountTargetClasses, 
          pTotalsLow
 #ifndef NDEBUG
          , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
 #endif // NDEBUG
       );
-      if(LIKELY(cInstancesRequiredForChildSplitMin <= pTotalsLow->m_cInstancesInBucket)) {
-         GetTotals<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
-            aHistogramBuckets, 
-            pFeatureCombination, 
-            aiPoint, 
-            directionVectorHigh, 
-            runtimeLearningTypeOrCountTargetClasses, 
-            pTotalsHigh
-   #ifndef NDEBUG
-            , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
-   #endif // NDEBUG
-         );
-         if(LIKELY(cInstancesRequiredForChildSplitMin <= pTotalsHigh->m_cInstancesInBucket)) {
-            FloatEbmType splittingScore = FloatEbmType { 0 };
-#ifndef LEGACY_COMPATIBILITY
-            EBM_ASSERT(0 < pTotalsLow->m_cInstancesInBucket);
-            EBM_ASSERT(0 < pTotalsHigh->m_cInstancesInBucket);
-#endif // LEGACY_COMPATIBILITY
-            FloatEbmType cLowInstancesInBucket = static_cast<FloatEbmType>(pTotalsLow->m_cInstancesInBucket);
-            FloatEbmType cHighInstancesInBucket = static_cast<FloatEbmType>(pTotalsHigh->m_cInstancesInBucket);
-            for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
-               // TODO : we can make this faster by doing the division in ComputeNodeSplittingScore after we add all the numerators 
-               // (but only do this after we've determined the best node splitting score for classification, and the NewtonRaphsonStep for gain
-
-               const FloatEbmType splittingScoreUpdate1 = EbmStatistics::ComputeNodeSplittingScore(
-                  ARRAY_TO_POINTER(pTotalsLow->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, cLowInstancesInBucket);
-               EBM_ASSERT(std::isnan(splittingScoreUpdate1) || FloatEbmType { 0 } <= splittingScoreUpdate1);
-               splittingScore += splittingScoreUpdate1;
-               const FloatEbmType splittingScoreUpdate2 = EbmStatistics::ComputeNodeSplittingScore(
-                  ARRAY_TO_POINTER(pTotalsHigh->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, cHighInstancesInBucket);
-               EBM_ASSERT(std::isnan(splittingScoreUpdate2) || FloatEbmType { 0 } <= splittingScoreUpdate2);
-               splittingScore += splittingScoreUpdate2;
-            }
-            EBM_ASSERT(std::isnan(splittingScore) || FloatEbmType { 0 } <= splittingScore); // sumation of positive numbers should be positive
+      if(LIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/ !(k_illegalGain == splittingScore))) {
+         cuts.RecordScore(splittingScore);
 
-            // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons are 
-            // all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
-            // no big deal.  NaN values will get us soon and shut down boosting.
-            if(UNLIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/ !(splittingScore <= bestSplit))) {
-               bestSplit = splittingScore;
-               iBestCut = iBin;
-
-               ASSERT_BINNED_BUCKET_OK(
-                  cBytesPerHistogramBucket, 
-                  GetHistogramBucketByIndex<bClassification>(
-                     cBytesPerHistogramBucket, 
-                     pHistogramBucketBestAndTemp, 
-                     1
-                  ), 
-                  aHistogramBucketsEndDebug
-               );
-               ASSERT_BINNED_BUCKET_OK(
+         // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons are 
+         // all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
+         // no big deal.  NaN values will get us soon and shut down boosting.
+         if(UNLIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/ !(splittingScore <= bestSplit))) {
+            bestSplit = splittingScore;
+            iBestCut = iBin;
+
+            ASSERT_BINNED_BUCKET_OK(
+               cBytesPerHistogramBucket, 
+               GetHistogramBucketByIndex<bClassification>(
                   cBytesPerHistogramBucket, 
-                  GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pTotalsLow, 1),
-                  aHistogramBucketsEndDebug
-               );
-               memcpy(pHistogramBucketBestAndTemp, pTotalsLow, cBytesPerTwoHistogramBuckets); // this copies both pTotalsLow and pTotalsHigh
-            } else {
-               EBM_ASSERT(!std::isnan(splittingScore));
-            }
+                  pHistogramBucketBestAndTemp, 
+                  1
+               ), 
+               aHistogramBucketsEndDebug
+            );
+            ASSERT_BINNED_BUCKET_OK(
+               cBytesPerHistogramBucket, 
+               GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pTotalsLow, 1),
+               aHistogramBucketsEndDebug
+            );
+            memcpy(pHistogramBucketBestAndTemp, pTotalsLow, cBytesPerTwoHistogramBuckets); // this copies both pTotalsLow and pTotalsHigh
+         } else {
+            EBM_ASSERT(!std::isnan(splittingScore));
          }
       }
-      ++iBin;
-   } while(iBin < cBins - 1);
+   } while(cuts.Next());
    *piBestCut = iBestCut;
 
    EBM_ASSERT(std::isnan(bestSplit) || FloatEbmType { 0 } <= bestSplit); // sumation of positive numbers should be positive
@@ -1061,7 +1408,117 @@ FloatEbmType SweepMultiDiemensional(
    return bestSplit;
 }
 
-// TODO: Implement a far more efficient boosting algorithm for higher dimensional interactions.  The algorithm works as follows:
+// the number of adjacent dimension 0 cuts that SweepPairBlock handles together
+constexpr size_t k_cPairCutsPerBlock = 8;
+
+// our pair splitter fixes a cut on one dimension and then sweeps every cut of the other.  Our totals are row major with dimension 0 contiguous, so 
+// when the fixed cut is on dimension 0 each step of SweepMultiDiemensional jumps a whole row ahead and lands in a new cache line, and on large pairs 
+// we would pull the totals tensor from memory once for every dimension 0 cut.  This sweeps dimension 1 for cCuts adjacent dimension 0 cuts at once, 
+// so each row is visited once per block and the lookups for the block share cache lines, including the bucket at the end of the row that all of 
+// them need.  Every cut is scored and compared in the same order that SweepMultiDiemensional uses, so the results are identical.  For cut k of the 
+// block, the best totals below our dimension 0 cut go into buckets [4 * k] and [4 * k + 1] of pHistogramBucketBestAndTemp with their score and 
+// dimension 1 cut in aBestSplits[2 * k] and aiBestCuts[2 * k], and the best totals above it go into buckets [4 * k + 2] and [4 * k + 3] with 
+// aBestSplits[2 * k + 1] and aiBestCuts[2 * k + 1].  Buckets [4 * cCuts] and [4 * cCuts + 1] are temporary
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t countCompilerDimensions>
+void SweepPairBlock(
+   const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets, 
+   const FeatureCombination * const pFeatureCombination, 
+   const size_t iBin0First, 
+   const size_t cCuts, 
+   const size_t cInstancesRequiredForChildSplitMin, 
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses, 
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const pHistogramBucketBestAndTemp, 
+   FloatEbmType * const aBestSplits, 
+   size_t * const aiBestCuts
+#ifndef NDEBUG
+   , const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsDebugCopy, 
+   const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+   // don't LOG this!  It would create way too much chatter!
+
+   EBM_ASSERT(2 == pFeatureCombination->m_cFeatures);
+   EBM_ASSERT(1 <= cCuts);
+   EBM_ASSERT(cCuts <= k_cPairCutsPerBlock);
+   EBM_ASSERT(iBin0First + cCuts < ARRAY_TO_POINTER_CONST(pFeatureCombination->m_FeatureCombinationEntry)[0].m_pFeature->m_cBins);
+
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+   EBM_ASSERT(!IsMultiplyError(2, cBytesPerHistogramBucket)); // we're accessing allocated memory
+   const size_t cBytesPerTwoHistogramBuckets = cBytesPerHistogramBucket << 1;
+
+   const size_t cBins1 = ARRAY_TO_POINTER_CONST(pFeatureCombination->m_FeatureCombinationEntry)[1].m_pFeature->m_cBins;
+   EBM_ASSERT(2 <= cBins1);
+
+   HistogramBucket<bClassification> * const pTotalsLow =
+      GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pHistogramBucketBestAndTemp, cCuts << 2);
+   ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pTotalsLow, aHistogramBucketsEndDebug);
+
+#ifndef LEGACY_COMPATIBILITY
+   EBM_ASSERT(0 < cInstancesRequiredForChildSplitMin);
+#endif // LEGACY_COMPATIBILITY
+
+   for(size_t iBest = 0; iBest < cCuts << 1; ++iBest) {
+      aBestSplits[iBest] = k_illegalGain;
+      aiBestCuts[iBest] = 0;
+   }
+
+   size_t aiPoint[k_cDimensionsMax];
+   size_t iBin1 = 0;
+   do {
+      aiPoint[1] = iBin1;
+      for(size_t iCut = 0; iCut < cCuts; ++iCut) {
+         aiPoint[0] = iBin0First + iCut;
+         for(size_t iSide = 0; iSide < 2; ++iSide) {
+            const FloatEbmType splittingScore = ScoreSweepCut<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
+               aHistogramBuckets, 
+               pFeatureCombination, 
+               aiPoint, 
+               iSide, 
+               iSide | 0x2, 
+               cInstancesRequiredForChildSplitMin, 
+               runtimeLearningTypeOrCountTargetClasses, 
+               pTotalsLow
+#ifndef NDEBUG
+               , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
+#endif // NDEBUG
+            );
+            if(LIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/ !(k_illegalGain == splittingScore))) {
+               const size_t iBest = (iCut << 1) + iSide;
+               // the same NaN propagating comparison as SweepMultiDiemensional
+               if(UNLIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/ 
+                  !(splittingScore <= aBestSplits[iBest]))) 
+               {
+                  aBestSplits[iBest] = splittingScore;
+                  aiBestCuts[iBest] = iBin1;
+
+                  HistogramBucket<bClassification> * const pBest =
+                     GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pHistogramBucketBestAndTemp, iBest << 1);
+                  ASSERT_BINNED_BUCKET_OK(
+                     cBytesPerHistogramBucket, 
+                     GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pBest, 1),
+                     aHistogramBucketsEndDebug
+                  );
+                  memcpy(pBest, pTotalsLow, cBytesPerTwoHistogramBuckets); // this copies both the low and high totals
+               } else {
+                  EBM_ASSERT(!std::isnan(splittingScore));
+               }
+            }
+         }
+      }
+      ++iBin1;
+   } while(iBin1 < cBins1 - 1);
+}
+
+// SplitCornersMultiDimensional below implements the first step of the following algorithm (the best box from each of the 2^N corners against the rest 
+// of the volume).  The remaining steps are still TODO.  The algorithm works as follows:
 //   - instead of first calculating the sums at each point for the hyper-dimensional region from the origin to each point, and then later
 //     looking for cuts, we can do both at the same time.  We know the total sums for the entire hyper-dimensional region, and as we're doing our summing
 //     up, we can calcualte the gain at that point.  The catch is that we can only calculate the gain of the split between the hyper-dimensional region from
@@ -1166,6 +1623,334 @@ FloatEbmType SweepMultiDiemensional(
 WARNING_PUSH
 WARNING_DISABLE_UNINITIALIZED_LOCAL_VARIABLE
 
+// we need to reserve 4 PAST the pointer we pass into SweepMultiDiemensional!!!!.  We pass in index 20 at max, so we need 24.  After those we 
+// put the 4 best buckets of each cut in a SweepPairBlock block and its 2 temporary buckets
+// EbmBoostingState::Initialize also uses this to pre-size our histogram buffer
+constexpr size_t k_cAuxillaryBucketsForSplittingPairBlock = 24;
+constexpr size_t k_cAuxillaryBucketsForSplittingBoosting = k_cAuxillaryBucketsForSplittingPairBlock + (k_cPairCutsPerBlock << 2) + 2;
+// SplitCornersMultiDimensional needs the same tube accumulators as BuildFastTotals, followed by these buckets for the total, best box and remainder
+constexpr size_t k_cAuxillaryBucketsForSplittingCorners = 3;
+
+// the "sum while sweeping" splitter described above.  From each of the 2^N corners of our tensor we sweep all of our cells while accumulating the 
+// totals of the box from that corner to the current cell (with the same tube accumulators as BuildFastTotals), and we score the split between that 
+// box and the rest of the tensor as we go.  This costs 2^N * N bucket additions per cell and needs neither a totals tensor nor any region lookups.  
+// For comparison, our pair splitter costs 2 bucket additions per cell to build its totals and then performs 2 totals lookups (of up to 4 buckets 
+// each) for each of its (cBins1 - 1) * (cBins2 - 1) * 2 + (cBins2 - 1) * (cBins1 - 1) * 2 candidate cuts, but it has no N dimensional equivalent.  
+// aHistogramBuckets holds our binned buckets (not totals) and we leave them unchanged.  Returns true on error
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t countCompilerDimensions>
+bool SplitCornersMultiDimensional(
+   const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets, 
+   const FeatureCombination * const pFeatureCombination, 
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const pBucketAuxiliaryBuildZone, 
+   const size_t cInstancesRequiredForChildSplitMin, 
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses, 
+   SegmentedTensor * const pSmallChangeToModelOverwriteSingleSamplingSet, 
+   FloatEbmType * const pTotalGain
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+   LOG_0(TraceLevelVerbose, "Entered SplitCornersMultiDimensional");
+
+   const size_t cDimensions = GET_ATTRIBUTE_COMBINATION_DIMENSIONS(countCompilerDimensions, pFeatureCombination->m_cFeatures);
+   EBM_ASSERT(2 <= cDimensions);
+   EBM_ASSERT(cDimensions <= k_cDimensionsMax);
+
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+
+   // the tube accumulators of each dimension hold one bucket per cell of the lower dimensions, just like in BuildFastTotals.  
+   // apAccumulators[cDimensions] is the end of the last one
+   size_t acBins[k_cDimensionsMax];
+   size_t aMultiples[k_cDimensionsMax];
+   HistogramBucket<bClassification> * apAccumulators[k_cDimensionsMax + 1];
+   size_t cTotalBucketsMainSpace = 1;
+   HistogramBucket<bClassification> * pAuxiliary = pBucketAuxiliaryBuildZone;
+   for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+      const size_t cBins = ARRAY_TO_POINTER_CONST(pFeatureCombination->m_FeatureCombinationEntry)[iDimension].m_pFeature->m_cBins;
+      EBM_ASSERT(2 <= cBins);
+      acBins[iDimension] = cBins;
+      aMultiples[iDimension] = cTotalBucketsMainSpace;
+      apAccumulators[iDimension] = pAuxiliary;
+      pAuxiliary = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliary, cTotalBucketsMainSpace);
+      // our caller checked that the main space and the auxiliary buckets fit in memory
+      EBM_ASSERT(!IsMultiplyError(cTotalBucketsMainSpace, cBins));
+      cTotalBucketsMainSpace *= cBins;
+   }
+   apAccumulators[cDimensions] = pAuxiliary;
+
+   HistogramBucket<bClassification> * const pTotal = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliary, 0);
+   HistogramBucket<bClassification> * const pBoxBest = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliary, 1);
+   HistogramBucket<bClassification> * const pRemainder = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliary, 2);
+   ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pRemainder, aHistogramBucketsEndDebug);
+
+#ifndef NDEBUG
+   for(HistogramBucket<bClassification> * pAccumulatorDebug = pBucketAuxiliaryBuildZone; 
+      apAccumulators[cDimensions] != pAccumulatorDebug; 
+      pAccumulatorDebug = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAccumulatorDebug, 1)) 
+   {
+      pAccumulatorDebug->AssertZero(cVectorLength);
+   }
+#endif // NDEBUG
+
+   pTotal->Zero(cVectorLength);
+   for(size_t iBucket = 0; iBucket < cTotalBucketsMainSpace; ++iBucket) {
+      pTotal->Add(*GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBuckets, iBucket), cVectorLength);
+   }
+
+   FloatEbmType splittingScoreParent = FloatEbmType { 0 };
+   const FloatEbmType weightParent = pTotal->m_weightInBucket;
+   for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+      const FloatEbmType splittingScoreParentUpdate = EbmStatistics::ComputeNodeSplittingScore(
+         ARRAY_TO_POINTER(pTotal->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
+         weightParent
+      );
+      EBM_ASSERT(std::isnan(splittingScoreParentUpdate) || FloatEbmType { 0 } <= splittingScoreParentUpdate);
+      splittingScoreParent += splittingScoreParentUpdate;
+   }
+
+   FloatEbmType bestSplittingScore = k_illegalGain;
+   size_t directionVectorBest = 0;
+   size_t aiLastBest[k_cDimensionsMax];
+
+   // each bit of directionVector selects the high corner for that dimension, which we sweep backwards through memory
+   const size_t cCorners = size_t { 1 } << cDimensions;
+   for(size_t directionVector = 0; directionVector < cCorners; ++directionVector) {
+      size_t aiCur[k_cDimensionsMax];
+      HistogramBucket<bClassification> * apAccumulatorCur[k_cDimensionsMax];
+      size_t iBucket = 0;
+      for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+         aiCur[iDimension] = 0;
+         apAccumulatorCur[iDimension] = apAccumulators[iDimension];
+         if(0 != (size_t { 1 } & (directionVector >> iDimension))) {
+            iBucket += (acBins[iDimension] - 1) * aMultiples[iDimension];
+         }
+      }
+
+      // the last cell's box is our entire tensor, which isn't a split
+      size_t cCellsRemaining = cTotalBucketsMainSpace;
+      while(true) {
+         const HistogramBucket<bClassification> * pAddPrev = 
+            GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBuckets, iBucket);
+         ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pAddPrev, aHistogramBucketsEndDebug);
+         size_t iDimension = cDimensions;
+         do {
+            --iDimension;
+            HistogramBucket<bClassification> * const pAddTo = apAccumulatorCur[iDimension];
+            pAddTo->Add(*pAddPrev, cVectorLength);
+            pAddPrev = pAddTo;
+            HistogramBucket<bClassification> * pAddToNext = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAddTo, 1);
+            if(pAddToNext == apAccumulators[iDimension + 1]) {
+               pAddToNext = apAccumulators[iDimension];
+            }
+            apAccumulatorCur[iDimension] = pAddToNext;
+         } while(0 != iDimension);
+         // pAddPrev now holds the totals of the box from our corner to the current cell
+
+         --cCellsRemaining;
+         if(LIKELY(0 != cCellsRemaining) && 
+            LIKELY(static_cast<FloatEbmType>(cInstancesRequiredForChildSplitMin) <= pAddPrev->m_weightInBucket)) 
+         {
+            pRemainder->Copy(*pTotal, cVectorLength);
+            pRemainder->Subtract(*pAddPrev, cVectorLength);
+            if(LIKELY(static_cast<FloatEbmType>(cInstancesRequiredForChildSplitMin) <= pRemainder->m_weightInBucket)) {
+               FloatEbmType splittingScore = FloatEbmType { 0 };
+               const FloatEbmType weightBox = pAddPrev->m_weightInBucket;
+               const FloatEbmType weightRemainder = pRemainder->m_weightInBucket;
+               for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+                  const FloatEbmType splittingScoreUpdate1 = EbmStatistics::ComputeNodeSplittingScore(
+                     ARRAY_TO_POINTER_CONST(pAddPrev->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, weightBox);
+                  EBM_ASSERT(std::isnan(splittingScoreUpdate1) || FloatEbmType { 0 } <= splittingScoreUpdate1);
+                  splittingScore += splittingScoreUpdate1;
+                  const FloatEbmType splittingScoreUpdate2 = EbmStatistics::ComputeNodeSplittingScore(
+                     ARRAY_TO_POINTER(pRemainder->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, weightRemainder);
+                  EBM_ASSERT(std::isnan(splittingScoreUpdate2) || FloatEbmType { 0 } <= splittingScoreUpdate2);
+                  splittingScore += splittingScoreUpdate2;
+               }
+               EBM_ASSERT(std::isnan(splittingScore) || FloatEbmType { 0 } <= splittingScore); // sumation of positive numbers should be positive
+
+               // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons 
+               // are all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions 
+               // rules, no big deal.  NaN values will get us soon and shut down boosting.
+               if(UNLIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/ 
+                  !(splittingScore <= bestSplittingScore))) 
+               {
+                  bestSplittingScore = splittingScore;
+                  directionVectorBest = directionVector;
+                  memcpy(aiLastBest, aiCur, sizeof(aiCur[0]) * cDimensions);
+                  pBoxBest->Copy(*pAddPrev, cVectorLength);
+               } else {
+                  EBM_ASSERT(!std::isnan(splittingScore));
+               }
+            }
+         }
+
+         // move to the next cell in the direction of our sweep.  Once a dimension wraps, its accumulators are complete, so we zero them for the next 
+         // pass.  Once our last dimension wraps, all our accumulators are zeroed for our next corner
+         iDimension = 0;
+         while(true) {
+            const bool bBackwards = 0 != (size_t { 1 } & (directionVector >> iDimension));
+            ++aiCur[iDimension];
+            if(LIKELY(acBins[iDimension] != aiCur[iDimension])) {
+               iBucket = bBackwards ? iBucket - aMultiples[iDimension] : iBucket + aMultiples[iDimension];
+               break;
+            }
+            aiCur[iDimension] = 0;
+            const size_t cReturn = (acBins[iDimension] - 1) * aMultiples[iDimension];
+            iBucket = bBackwards ? iBucket + cReturn : iBucket - cReturn;
+            EBM_ASSERT(apAccumulators[iDimension] == apAccumulatorCur[iDimension]);
+            memset(
+               apAccumulators[iDimension], 
+               0, 
+               reinterpret_cast<char *>(apAccumulators[iDimension + 1]) - reinterpret_cast<char *>(apAccumulators[iDimension])
+            );
+            ++iDimension;
+            if(UNLIKELY(cDimensions == iDimension)) {
+               goto next_corner;
+            }
+         }
+      }
+   next_corner:;
+      EBM_ASSERT(0 == cCellsRemaining);
+   }
+
+   // if we get a NaN result for bestSplittingScore, we might as well do less work and just create a zero split update right now.  The rules 
+   // for NaN values say that non equality comparisons are all false so, let's flip this comparison such that it should be true for NaN values.  
+   // If the compiler violates NaN comparions rules, no big deal.  NaN values will get us soon and shut down boosting.
+   if(UNLIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/ !(k_illegalGain != bestSplittingScore))) {
+      // there were no good cuts found, or we hit a NaN value
+      for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+#ifndef NDEBUG
+         const bool bSetCountDivisions =
+#endif // NDEBUG
+            pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(iDimension, 0);
+         // we can't fail since we're setting this to zero, so no allocations.  We don't in fact need the division array at all
+         EBM_ASSERT(!bSetCountDivisions);
+      }
+
+      // we don't need to call pSmallChangeToModelOverwriteSingleSamplingSet->EnsureValueCapacity, 
+      // since our value capacity would be 1, which is pre-allocated
+      for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+         FloatEbmType prediction;
+         if(UNLIKELY(FloatEbmType { 0 } == pTotal->m_weightInBucket)) {
+            // every instance in this sampling set has a weight of zero, so there is nothing to learn from it
+            prediction = FloatEbmType { 0 };
+         } else if(bClassification) {
+            prediction = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
+               ARRAY_TO_POINTER(pTotal->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
+               ARRAY_TO_POINTER(pTotal->m_aHistogramBucketVectorEntry)[iVector].GetSumDenominator()
+            );
+         } else {
+            EBM_ASSERT(IsRegression(compilerLearningTypeOrCountTargetClasses));
+            prediction = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
+               ARRAY_TO_POINTER(pTotal->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
+               pTotal->m_weightInBucket
+            );
+         }
+         pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[iVector] = prediction;
+      }
+      *pTotalGain = FloatEbmType { 0 }; // no splits means no gain
+      LOG_0(TraceLevelVerbose, "Exited SplitCornersMultiDimensional no split");
+      return false;
+   }
+   EBM_ASSERT(!std::isnan(bestSplittingScore));
+   EBM_ASSERT(k_illegalGain != bestSplittingScore);
+
+   // dimensions where our box spans every bin have no division.  The others have a single division, and the box is on the low side of it if we 
+   // swept that dimension forwards
+   size_t cDivided = 0;
+   size_t aSegmentsBox[k_cDimensionsMax];
+   for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+      const size_t cBins = acBins[iDimension];
+      const size_t iLast = aiLastBest[iDimension];
+      EBM_ASSERT(iLast < cBins);
+      if(cBins - 1 == iLast) {
+         if(pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(iDimension, 0)) {
+            LOG_0(TraceLevelWarning, "WARNING SplitCornersMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(iDimension, 0)");
+            return true;
+         }
+      } else {
+         if(pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(iDimension, 1)) {
+            LOG_0(TraceLevelWarning, "WARNING SplitCornersMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(iDimension, 1)");
+            return true;
+         }
+         const bool bBackwards = 0 != (size_t { 1 } & (directionVectorBest >> iDimension));
+         // swept backwards, our box runs from bin (cBins - 1 - iLast) to the end, so the division is just before that bin
+         pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(iDimension)[0] = 
+            static_cast<ActiveDataType>(bBackwards ? cBins - 2 - iLast : iLast);
+         aSegmentsBox[cDivided] = bBackwards ? size_t { 1 } : size_t { 0 };
+         ++cDivided;
+      }
+   }
+   // our box doesn't span our entire tensor, so at least one dimension is divided
+   EBM_ASSERT(1 <= cDivided);
+   EBM_ASSERT(cDivided <= cDimensions);
+   const size_t cCells = size_t { 1 } << cDivided;
+   if(IsMultiplyError(cVectorLength, cCells)) {
+      LOG_0(TraceLevelWarning, "WARNING SplitCornersMultiDimensional IsMultiplyError(cVectorLength, cCells)");
+      return true;
+   }
+   if(pSmallChangeToModelOverwriteSingleSamplingSet->EnsureValueCapacity(cVectorLength * cCells)) {
+      LOG_0(TraceLevelWarning, "WARNING SplitCornersMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->EnsureValueCapacity(cVectorLength * cCells)");
+      return true;
+   }
+
+   pRemainder->Copy(*pTotal, cVectorLength);
+   pRemainder->Subtract(*pBoxBest, cVectorLength);
+   FloatEbmType * const aValues = pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer();
+   for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+      FloatEbmType predictionBox;
+      FloatEbmType predictionRemainder;
+      if(bClassification) {
+         predictionBox = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
+            ARRAY_TO_POINTER(pBoxBest->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
+            ARRAY_TO_POINTER(pBoxBest->m_aHistogramBucketVectorEntry)[iVector].GetSumDenominator()
+         );
+         predictionRemainder = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
+            ARRAY_TO_POINTER(pRemainder->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
+            ARRAY_TO_POINTER(pRemainder->m_aHistogramBucketVectorEntry)[iVector].GetSumDenominator()
+         );
+      } else {
+         EBM_ASSERT(IsRegression(compilerLearningTypeOrCountTargetClasses));
+         predictionBox = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
+            ARRAY_TO_POINTER(pBoxBest->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
+            pBoxBest->m_weightInBucket
+         );
+         predictionRemainder = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
+            ARRAY_TO_POINTER(pRemainder->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
+            pRemainder->m_weightInBucket
+         );
+      }
+      // our first divided dimension is contiguous in the tensor, and the cell is in our box only if it's on the box side of every division
+      for(size_t iCell = 0; iCell < cCells; ++iCell) {
+         bool bInBox = true;
+         for(size_t iDivided = 0; iDivided < cDivided; ++iDivided) {
+            if(aSegmentsBox[iDivided] != (size_t { 1 } & (iCell >> iDivided))) {
+               bInBox = false;
+               break;
+            }
+         }
+         aValues[iCell * cVectorLength + iVector] = bInBox ? predictionBox : predictionRemainder;
+      }
+   }
+
+   // for regression, bestSplittingScore and splittingScoreParent can be infinity.  See the equivalent note in BoostMultiDimensional
+   const FloatEbmType gain = bestSplittingScore - splittingScoreParent;
+   // within a set, no split should make our model worse.  It might in our validation set, but not within the training set
+   EBM_ASSERT(std::isnan(gain) || (!bClassification) && std::isinf(gain) || k_epsilonNegativeGainAllowed <= gain);
+   *pTotalGain = gain;
+
+   LOG_0(TraceLevelVerbose, "Exited SplitCornersMultiDimensional");
+   return false;
+}
+
 // TODO: consider adding controls to disallow cuts that would leave too few cases in a region (use the same minimum number of cases paraemter as the mains)
 // TODO: for higher dimensional spaces, we need to add/subtract individual cells alot and the denominator isn't required in order to make decisions about
 //   where to cut.  For dimensions higher than 2, we might want to copy the tensor to a new tensor AFTER binning that keeps only the residuals and then 
@@ -1180,7 +1965,15 @@ bool BoostMultiDimensional(
    SegmentedTensor * const pSmallChangeToModelOverwriteSingleSamplingSet, 
    const size_t cInstancesRequiredForChildSplitMin, 
    FloatEbmType * const pTotalGain, 
-   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   // SplitCornersMultiDimensional is our only splitter beyond pairs.  For pairs, this selects it instead of our pair specific sweeps
+   const bool bSplitCornersPairs,
+   // see CoarseToFineCuts.  0 makes our pair specific sweeps try every cut
+   const size_t cPairSuperBinBins,
+   // if true, our pair specific sweeps don't group dimension 0 cuts into blocks (see SweepPairBlock), which selects the same splits more slowly
+   const bool bSweepPairCutsSeparately,
+   // if our caller already binned this sampling set (see BinDataSetTrainingAllSamplingSets) we copy its buckets instead of binning here
+   const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsBinned
 ) {
    constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
 
@@ -1209,8 +2002,13 @@ bool BoostMultiDimensional(
       // if this wasn't true then we'd have to check IsAddError(cAuxillaryBucketsForBuildFastTotals, cTotalBucketsMainSpace) at runtime
       EBM_ASSERT(cAuxillaryBucketsForBuildFastTotals < cTotalBucketsMainSpace);
    }
-   // we need to reserve 4 PAST the pointer we pass into SweepMultiDiemensional!!!!.  We pass in index 20 at max, so we need 24
-   const size_t cAuxillaryBucketsForSplitting = 24;
+   const bool bSplitCorners = bSplitCornersPairs || 2 != cDimensions;
+   if(IsAddError(cAuxillaryBucketsForBuildFastTotals, k_cAuxillaryBucketsForSplittingCorners)) {
+      LOG_0(TraceLevelWarning, "WARNING BoostMultiDimensional IsAddError(cAuxillaryBucketsForBuildFastTotals, k_cAuxillaryBucketsForSplittingCorners)");
+      return true;
+   }
+   const size_t cAuxillaryBucketsForSplitting = bSplitCorners ? 
+      cAuxillaryBucketsForBuildFastTotals + k_cAuxillaryBucketsForSplittingCorners : k_cAuxillaryBucketsForSplittingBoosting;
    const size_t cAuxillaryBuckets = 
       cAuxillaryBucketsForBuildFastTotals < cAuxillaryBucketsForSplitting ? cAuxillaryBucketsForSplitting : cAuxillaryBucketsForBuildFastTotals;
    if(IsAddError(cTotalBucketsMainSpace, cAuxillaryBuckets)) {
@@ -1257,16 +2055,21 @@ bool BoostMultiDimensional(
    const unsigned char * const aHistogramBucketsEndDebug = reinterpret_cast<unsigned char *>(aHistogramBuckets) + cBytesBuffer;
 #endif // NDEBUG
 
-   RecursiveBinDataSetTraining<compilerLearningTypeOrCountTargetClasses, 2>::Recursive(
-      cDimensions, 
-      aHistogramBuckets, 
-      pFeatureCombination, 
-      pTrainingSet, 
-      runtimeLearningTypeOrCountTargetClasses
+   if(nullptr != aHistogramBucketsBinned) {
+      // our auxillary buckets come after the main space, which is all that our caller binned
+      memcpy(aHistogramBuckets, aHistogramBucketsBinned, cTotalBucketsMainSpace * cBytesPerHistogramBucket);
+   } else {
+      RecursiveBinDataSetTraining<compilerLearningTypeOrCountTargetClasses, 2>::Recursive(
+         cDimensions, 
+         aHistogramBuckets, 
+         pFeatureCombination, 
+         pTrainingSet, 
+         runtimeLearningTypeOrCountTargetClasses
 #ifndef NDEBUG
-      , aHistogramBucketsEndDebug
+         , aHistogramBucketsEndDebug
 #endif // NDEBUG
-   );
+      );
+   }
 
 #ifndef NDEBUG
    // make a copy of the original binned buckets for debugging purposes
@@ -1287,6 +2090,27 @@ bool BoostMultiDimensional(
    }
 #endif // NDEBUG
 
+   if(bSplitCorners) {
+      // SplitCornersMultiDimensional sums while it sweeps, so it doesn't need our totals
+      const bool bError = SplitCornersMultiDimensional<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
+         aHistogramBuckets, 
+         pFeatureCombination, 
+         pAuxiliaryBucketZone, 
+         cInstancesRequiredForChildSplitMin, 
+         runtimeLearningTypeOrCountTargetClasses, 
+         pSmallChangeToModelOverwriteSingleSamplingSet, 
+         pTotalGain
+#ifndef NDEBUG
+         , aHistogramBucketsEndDebug
+#endif // NDEBUG
+      );
+#ifndef NDEBUG
+      free(aHistogramBucketsDebugCopy);
+#endif // NDEBUG
+      LOG_0(TraceLevelVerbose, "Exited BoostMultiDimensional");
+      return bError;
+   }
+
    BuildFastTotals<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
       aHistogramBuckets, 
       runtimeLearningTypeOrCountTargetClasses, 
@@ -1438,48 +2262,90 @@ bool BoostMultiDimensional(
 
       FloatEbmType splittingScoreParent = FloatEbmType { 0 };
 #ifndef LEGACY_COMPATIBILITY
-      EBM_ASSERT(0 < pTotal->m_cInstancesInBucket);
+      EBM_ASSERT(0 < pTotal->m_weightInBucket);
 #endif // LEGACY_COMPATIBILITY
-      FloatEbmType cInstancesInParentBucket = static_cast<FloatEbmType>(pTotal->m_cInstancesInBucket);
+      FloatEbmType weightParent = pTotal->m_weightInBucket;
       for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
          // TODO : we can make this faster by doing the division in ComputeNodeSplittingScoreParent after we add all the numerators 
          // (but only do this after we've determined the best node splitting score for classification, and the NewtonRaphsonStep for gain
 
          const FloatEbmType splittingScoreParentUpdate = EbmStatistics::ComputeNodeSplittingScore(
             ARRAY_TO_POINTER_CONST(pTotal->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-            cInstancesInParentBucket
+            weightParent
          );
          EBM_ASSERT(std::isnan(splittingScoreParentUpdate) || FloatEbmType { 0 } <= splittingScoreParentUpdate);
          splittingScoreParent += splittingScoreParentUpdate;
       }
       EBM_ASSERT(std::isnan(splittingScoreParent) || FloatEbmType { 0 } <= splittingScoreParent); // sumation of positive numbers should be positive
 
+      // our coarse-to-fine cuts skip around, so we only sweep blocks of dimension 0 cuts together when every cut is tried
+      const bool bBlockCuts1 = 
+         !bSweepPairCutsSeparately && 
+         !CoarseToFineCuts::IsCoarseToFine(cPairSuperBinBins, cBinsDimension1) && 
+         !CoarseToFineCuts::IsCoarseToFine(cPairSuperBinBins, cBinsDimension2);
+      HistogramBucket<bClassification> * const pTotalsBlock = GetHistogramBucketByIndex<bClassification>(
+         cBytesPerHistogramBucket, 
+         pAuxiliaryBucketZone, 
+         k_cAuxillaryBucketsForSplittingPairBlock
+      );
+      FloatEbmType aBlockBestSplits[k_cPairCutsPerBlock << 1];
+      size_t aiBlockBestCuts[k_cPairCutsPerBlock << 1];
+
       LOG_0(TraceLevelVerbose, "BoostMultiDimensional Starting FIRST bin sweep loop");
-      size_t iBin1 = 0;
+      CoarseToFineCuts cuts1(cPairSuperBinBins, cBinsDimension1);
       do {
+         const size_t iBin1 = cuts1.GetCut();
          aiStart[0] = iBin1;
 
          splittingScore = FloatEbmType { 0 };
 
+         const size_t iBlockCut = iBin1 % k_cPairCutsPerBlock;
+         if(bBlockCuts1 && 0 == iBlockCut) {
+            const size_t cCutsRemaining = cBinsDimension1 - 1 - iBin1;
+            SweepPairBlock<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
+               aHistogramBuckets, 
+               pFeatureCombination, 
+               iBin1, 
+               cCutsRemaining < k_cPairCutsPerBlock ? cCutsRemaining : k_cPairCutsPerBlock, 
+               cInstancesRequiredForChildSplitMin, 
+               runtimeLearningTypeOrCountTargetClasses, 
+               pTotalsBlock, 
+               aBlockBestSplits, 
+               aiBlockBestCuts
+#ifndef NDEBUG
+               , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
+#endif // NDEBUG
+            );
+         }
+
          size_t cutSecond1LowBest;
          HistogramBucket<bClassification> * pTotals2LowLowBest =
             GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 4);
          HistogramBucket<bClassification> * pTotals2LowHighBest =
             GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 5);
-         const FloatEbmType splittingScoreNew1 = SweepMultiDiemensional<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
-            aHistogramBuckets, 
-            pFeatureCombination, 
-            aiStart, 
-            0x0, 
-            1, 
-            cInstancesRequiredForChildSplitMin, 
-            runtimeLearningTypeOrCountTargetClasses, 
-            pTotals2LowLowBest, 
-            &cutSecond1LowBest
+         FloatEbmType splittingScoreNew1;
+         if(bBlockCuts1) {
+            pTotals2LowLowBest = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pTotalsBlock, iBlockCut << 2);
+            pTotals2LowHighBest = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pTotals2LowLowBest, 1);
+            splittingScoreNew1 = aBlockBestSplits[iBlockCut << 1];
+            cutSecond1LowBest = aiBlockBestCuts[iBlockCut << 1];
+         } else {
+            splittingScoreNew1 = SweepMultiDiemensional<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
+               aHistogramBuckets, 
+               pFeatureCombination, 
+               aiStart, 
+               0x0, 
+               1, 
+               cInstancesRequiredForChildSplitMin, 
+               runtimeLearningTypeOrCountTargetClasses, 
+               cPairSuperBinBins, 
+               pTotals2LowLowBest, 
+               &cutSecond1LowBest
 #ifndef NDEBUG
-            , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
+               , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
 #endif // NDEBUG
             );
+         }
 
          // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons are all
          // false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, no big deal.  
@@ -1497,21 +2363,30 @@ bool BoostMultiDimensional(
                );
             HistogramBucket<bClassification> * pTotals2HighHighBest =
                GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 9);
-            const FloatEbmType splittingScoreNew2 = SweepMultiDiemensional<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
-               aHistogramBuckets, 
-               pFeatureCombination, 
-               aiStart, 
-               0x1, 
-               1, 
-               cInstancesRequiredForChildSplitMin, 
-               runtimeLearningTypeOrCountTargetClasses, 
-               pTotals2HighLowBest, 
-               &cutSecond1HighBest
+            FloatEbmType splittingScoreNew2;
+            if(bBlockCuts1) {
+               pTotals2HighLowBest = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pTotalsBlock, (iBlockCut << 2) + 2);
+               pTotals2HighHighBest = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pTotals2HighLowBest, 1);
+               splittingScoreNew2 = aBlockBestSplits[(iBlockCut << 1) + 1];
+               cutSecond1HighBest = aiBlockBestCuts[(iBlockCut << 1) + 1];
+            } else {
+               splittingScoreNew2 = SweepMultiDiemensional<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
+                  aHistogramBuckets, 
+                  pFeatureCombination, 
+                  aiStart, 
+                  0x1, 
+                  1, 
+                  cInstancesRequiredForChildSplitMin, 
+                  runtimeLearningTypeOrCountTargetClasses, 
+                  cPairSuperBinBins, 
+                  pTotals2HighLowBest, 
+                  &cutSecond1HighBest
 #ifndef NDEBUG
-               , aHistogramBucketsDebugCopy, 
-               aHistogramBucketsEndDebug
+                  , aHistogramBucketsDebugCopy, 
+                  aHistogramBucketsEndDebug
 #endif // NDEBUG
                );
+            }
             // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons are 
             // all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
             // no big deal.  NaN values will get us soon and shut down boosting.
@@ -1520,6 +2395,7 @@ bool BoostMultiDimensional(
             {
                EBM_ASSERT(std::isnan(splittingScoreNew2) || FloatEbmType { 0 } <= splittingScoreNew2);
                splittingScore += splittingScoreNew2;
+               cuts1.RecordScore(splittingScore);
 
                // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons 
                // are all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
@@ -1547,8 +2423,7 @@ bool BoostMultiDimensional(
             EBM_ASSERT(!std::isnan(splittingScoreNew1));
             EBM_ASSERT(k_illegalGain == splittingScoreNew1);
          }
-         ++iBin1;
-      } while(iBin1 < cBinsDimension1 - 1);
+      } while(cuts1.Next());
 
       bool bCutFirst2 = false;
 
@@ -1566,8 +2441,9 @@ bool BoostMultiDimensional(
          GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 15);
 
       LOG_0(TraceLevelVerbose, "BoostMultiDimensional Starting SECOND bin sweep loop");
-      size_t iBin2 = 0;
+      CoarseToFineCuts cuts2(cPairSuperBinBins, cBinsDimension2);
       do {
+         const size_t iBin2 = cuts2.GetCut();
          aiStart[1] = iBin2;
 
          splittingScore = FloatEbmType { 0 };
@@ -1585,6 +2461,7 @@ bool BoostMultiDimensional(
             0, 
             cInstancesRequiredForChildSplitMin, 
             runtimeLearningTypeOrCountTargetClasses, 
+            cPairSuperBinBins, 
             pTotals1LowLowBestInner, 
             &cutSecond2LowBest
 #ifndef NDEBUG
@@ -1613,6 +2490,7 @@ bool BoostMultiDimensional(
                0, 
                cInstancesRequiredForChildSplitMin, 
                runtimeLearningTypeOrCountTargetClasses, 
+               cPairSuperBinBins, 
                pTotals1HighLowBestInner, 
                &cutSecond2HighBest
 #ifndef NDEBUG
@@ -1628,6 +2506,7 @@ bool BoostMultiDimensional(
             {
                EBM_ASSERT(std::isnan(splittingScoreNew2) || FloatEbmType { 0 } <= splittingScoreNew2);
                splittingScore += splittingScoreNew2;
+               cuts2.RecordScore(splittingScore);
                // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons 
                // are all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
                // no big deal.  NaN values will get us soon and shut down boosting.
@@ -1656,8 +2535,7 @@ bool BoostMultiDimensional(
             EBM_ASSERT(!std::isnan(splittingScoreNew1));
             EBM_ASSERT(k_illegalGain == splittingScoreNew1);
          }
-         ++iBin2;
-      } while(iBin2 < cBinsDimension2 - 1);
+      } while(cuts2.Next());
       LOG_0(TraceLevelVerbose, "BoostMultiDimensional Done sweep loops");
 
       FloatEbmType gain;
@@ -1686,7 +2564,10 @@ bool BoostMultiDimensional(
          for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
             FloatEbmType prediction;
 
-            if(bClassification) {
+            if(UNLIKELY(FloatEbmType { 0 } == pTotal->m_weightInBucket)) {
+               // every instance in this sampling set has a weight of zero, so there is nothing to learn from it
+               prediction = FloatEbmType { 0 };
+            } else if(bClassification) {
                prediction = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
                   ARRAY_TO_POINTER(pTotal->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
                   ARRAY_TO_POINTER(pTotal->m_aHistogramBucketVectorEntry)[iVector].GetSumDenominator()
@@ -1695,7 +2576,7 @@ bool BoostMultiDimensional(
                EBM_ASSERT(IsRegression(compilerLearningTypeOrCountTargetClasses));
                prediction = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                   ARRAY_TO_POINTER(pTotal->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-                  static_cast<FloatEbmType>(pTotal->m_cInstancesInBucket)
+                  pTotal->m_weightInBucket
                );
             }
             pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[iVector] = prediction;
@@ -1804,19 +2685,19 @@ bool BoostMultiDimensional(
                   EBM_ASSERT(IsRegression(compilerLearningTypeOrCountTargetClasses));
                   predictionLowLow = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                      ARRAY_TO_POINTER(pTotals2LowLowBest->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-                     static_cast<FloatEbmType>(pTotals2LowLowBest->m_cInstancesInBucket)
+                     pTotals2LowLowBest->m_weightInBucket
                   );
                   predictionLowHigh = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                      ARRAY_TO_POINTER(pTotals2LowHighBest->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-                     static_cast<FloatEbmType>(pTotals2LowHighBest->m_cInstancesInBucket)
+                     pTotals2LowHighBest->m_weightInBucket
                   );
                   predictionHighLow = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                      ARRAY_TO_POINTER(pTotals2HighLowBest->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-                     static_cast<FloatEbmType>(pTotals2HighLowBest->m_cInstancesInBucket)
+                     pTotals2HighLowBest->m_weightInBucket
                   );
                   predictionHighHigh = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                      ARRAY_TO_POINTER(pTotals2HighHighBest->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-                     static_cast<FloatEbmType>(pTotals2HighHighBest->m_cInstancesInBucket)
+                     pTotals2HighHighBest->m_weightInBucket
                   );
                }
 
@@ -1941,19 +2822,19 @@ bool BoostMultiDimensional(
                   EBM_ASSERT(IsRegression(compilerLearningTypeOrCountTargetClasses));
                   predictionLowLow = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                      ARRAY_TO_POINTER(pTotals1LowLowBest->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-                     static_cast<FloatEbmType>(pTotals1LowLowBest->m_cInstancesInBucket)
+                     pTotals1LowLowBest->m_weightInBucket
                   );
                   predictionLowHigh = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                      ARRAY_TO_POINTER(pTotals1LowHighBest->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-                     static_cast<FloatEbmType>(pTotals1LowHighBest->m_cInstancesInBucket)
+                     pTotals1LowHighBest->m_weightInBucket
                   );
                   predictionHighLow = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                      ARRAY_TO_POINTER(pTotals1HighLowBest->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-                     static_cast<FloatEbmType>(pTotals1HighLowBest->m_cInstancesInBucket)
+                     pTotals1HighLowBest->m_weightInBucket
                   );
                   predictionHighHigh = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                      ARRAY_TO_POINTER(pTotals1HighHighBest->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-                     static_cast<FloatEbmType>(pTotals1HighHighBest->m_cInstancesInBucket)
+                     pTotals1HighHighBest->m_weightInBucket
                   );
                }
                if(cutFirst1LowBest < cutFirst1HighBest) {
@@ -1996,11 +2877,9 @@ bool BoostMultiDimensional(
       // making a pair where one of the dimensions duplicates values in the 0 and 1 bin.  Then the gain should be identical, if there is only 1 split allowed
       *pTotalGain = gain;
    } else {
-      LOG_0(TraceLevelWarning, "WARNING BoostMultiDimensional 2 != dimensions");
-  
-      // TODO: handle this better
-#ifndef NDEBUG
+      // we send everything beyond pairs to SplitCornersMultiDimensional above
       EBM_ASSERT(false);
+#ifndef NDEBUG
       free(aHistogramBucketsDebugCopy);
 #endif // NDEBUG
       return true;
@@ -2122,8 +3001,8 @@ WARNING_POP
 //
 //                  if(IS_REGRESSION(compilerLearningTypeOrCountTargetClasses)) {
 //                     // regression
-//                     predictionTarget = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsTarget->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsTarget->m_cInstancesInBucket);
-//                     predictionOther = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsOther->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsOther->m_cInstancesInBucket);
+//                     predictionTarget = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsTarget->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsTarget->m_weightInBucket);
+//                     predictionOther = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsOther->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsOther->m_weightInBucket);
 //                  } else {
 //                     EBM_ASSERT(IS_CLASSIFICATION(compilerLearningTypeOrCountTargetClasses));
 //                     // classification
@@ -2165,8 +3044,8 @@ WARNING_POP
 //
 //                  if(IS_REGRESSION(compilerLearningTypeOrCountTargetClasses)) {
 //                     // regression
-//                     predictionTarget = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsTarget->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsTarget->m_cInstancesInBucket);
-//                     predictionOther = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsOther->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsOther->m_cInstancesInBucket);
+//                     predictionTarget = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsTarget->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsTarget->m_weightInBucket);
+//                     predictionOther = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsOther->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsOther->m_weightInBucket);
 //                  } else {
 //                     EBM_ASSERT(IS_CLASSIFICATION(compilerLearningTypeOrCountTargetClasses));
 //                     // classification
@@ -2208,8 +3087,8 @@ WARNING_POP
 //
 //                  if(IS_REGRESSION(compilerLearningTypeOrCountTargetClasses)) {
 //                     // regression
-//                     predictionTarget = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsTarget->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsTarget->m_cInstancesInBucket);
-//                     predictionOther = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsOther->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsOther->m_cInstancesInBucket);
+//                     predictionTarget = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsTarget->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsTarget->m_weightInBucket);
+//                     predictionOther = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsOther->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsOther->m_weightInBucket);
 //                  } else {
 //                     EBM_ASSERT(IS_CLASSIFICATION(compilerLearningTypeOrCountTargetClasses));
 //                     // classification
@@ -2250,8 +3129,8 @@ WARNING_POP
 //
 //                  if(IS_REGRESSION(compilerLearningTypeOrCountTargetClasses)) {
 //                     // regression
-//                     predictionTarget = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsTarget->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsTarget->m_cInstancesInBucket);
-//                     predictionOther = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsOther->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsOther->m_cInstancesInBucket);
+//                     predictionTarget = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsTarget->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsTarget->m_weightInBucket);
+//                     predictionOther = ComputeSmallChangeForOneSegmentRegression(ARRAY_TO_POINTER(pTotalsOther->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, pTotalsOther->m_weightInBucket);
 //                  } else {
 //                     EBM_ASSERT(IS_CLASSIFICATION(compilerLearningTypeOrCountTargetClasses));
 //                     // classification
@@ -2299,7 +3178,8 @@ bool CalculateInteractionScore(
    const DataSetByFeature * const pDataSet, 
    const FeatureCombination * const pFeatureCombination, 
    const size_t cInstancesRequiredForChildSplitMin, 
-   FloatEbmType * const pInteractionScoreReturn
+   FloatEbmType * const pInteractionScoreReturn,
+   const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsBinned
 ) {
    // TODO : we NEVER use the denominator term in HistogramBucketVectorEntry when calculating interaction scores, but we're spending time calculating 
    // it, and it's taking up precious memory.  We should eliminate the denominator term HERE in our datastructures OR we should think whether we can 
@@ -2385,12 +3265,17 @@ bool CalculateInteractionScore(
 #endif // NDEBUG
 
    
-   // TODO : use the fancy recursive binner that we use in the boosting version of this function
-   BinDataSetInteraction<compilerLearningTypeOrCountTargetClasses>(aHistogramBuckets, pFeatureCombination, pDataSet, runtimeLearningTypeOrCountTargetClasses
+   if(nullptr != aHistogramBucketsBinned) {
+      // our caller binned this pair together with others that share its first feature.  Our auxillary buckets come after the main space
+      memcpy(aHistogramBuckets, aHistogramBucketsBinned, cTotalBucketsMainSpace * cBytesPerHistogramBucket);
+   } else {
+      // TODO : use the fancy recursive binner that we use in the boosting version of this function
+      BinDataSetInteraction<compilerLearningTypeOrCountTargetClasses>(aHistogramBuckets, pFeatureCombination, pDataSet, runtimeLearningTypeOrCountTargetClasses
 #ifndef NDEBUG
-      , aHistogramBucketsEndDebug
+         , aHistogramBucketsEndDebug
 #endif // NDEBUG
-      );
+         );
+   }
 
 #ifndef NDEBUG
    // make a copy of the original binned buckets for debugging purposes
@@ -2471,7 +3356,7 @@ bool CalculateInteractionScore(
                aHistogramBucketsEndDebug
 #endif // NDEBUG
                );
-            if(LIKELY(cInstancesRequiredForChildSplitMin <= pTotalsLowLow->m_cInstancesInBucket)) {
+            if(LIKELY(static_cast<FloatEbmType>(cInstancesRequiredForChildSplitMin) <= pTotalsLowLow->m_weightInBucket)) {
                GetTotals<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
                   aHistogramBuckets, 
                   pFeatureCombination, 
@@ -2484,7 +3369,7 @@ bool CalculateInteractionScore(
                   aHistogramBucketsEndDebug
 #endif // NDEBUG
                   );
-               if(LIKELY(cInstancesRequiredForChildSplitMin <= pTotalsLowHigh->m_cInstancesInBucket)) {
+               if(LIKELY(static_cast<FloatEbmType>(cInstancesRequiredForChildSplitMin) <= pTotalsLowHigh->m_weightInBucket)) {
                   GetTotals<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
                      aHistogramBuckets, 
                      pFeatureCombination, 
@@ -2496,7 +3381,7 @@ bool CalculateInteractionScore(
                      , aHistogramBucketsDebugCopy, aHistogramBucketsEndDebug
 #endif // NDEBUG
                      );
-                  if(LIKELY(cInstancesRequiredForChildSplitMin <= pTotalsHighLow->m_cInstancesInBucket)) {
+                  if(LIKELY(static_cast<FloatEbmType>(cInstancesRequiredForChildSplitMin) <= pTotalsHighLow->m_weightInBucket)) {
                      GetTotals<compilerLearningTypeOrCountTargetClasses, countCompilerDimensions>(
                         aHistogramBuckets, 
                         pFeatureCombination, 
@@ -2509,13 +3394,13 @@ bool CalculateInteractionScore(
                         aHistogramBucketsEndDebug
 #endif // NDEBUG
                         );
-                     if(LIKELY(cInstancesRequiredForChildSplitMin <= pTotalsHighHigh->m_cInstancesInBucket)) {
+                     if(LIKELY(static_cast<FloatEbmType>(cInstancesRequiredForChildSplitMin) <= pTotalsHighHigh->m_weightInBucket)) {
                         FloatEbmType splittingScore = 0;
 
-                        FloatEbmType cLowLowInstancesInBucket = static_cast<FloatEbmType>(pTotalsLowLow->m_cInstancesInBucket);
-                        FloatEbmType cLowHighInstancesInBucket = static_cast<FloatEbmType>(pTotalsLowHigh->m_cInstancesInBucket);
-                        FloatEbmType cHighLowInstancesInBucket = static_cast<FloatEbmType>(pTotalsHighLow->m_cInstancesInBucket);
-                        FloatEbmType cHighHighInstancesInBucket = static_cast<FloatEbmType>(pTotalsHighHigh->m_cInstancesInBucket);
+                        FloatEbmType weightLowLow = pTotalsLowLow->m_weightInBucket;
+                        FloatEbmType weightLowHigh = pTotalsLowHigh->m_weightInBucket;
+                        FloatEbmType weightHighLow = pTotalsHighLow->m_weightInBucket;
+                        FloatEbmType weightHighHigh = pTotalsHighHigh->m_weightInBucket;
 
                         for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
                            // TODO : we can make this faster by doing the division in ComputeNodeSplittingScore after we add all the numerators 
@@ -2523,20 +3408,20 @@ bool CalculateInteractionScore(
 
                            const FloatEbmType splittingScoreUpdate1 = EbmStatistics::ComputeNodeSplittingScore(
                               ARRAY_TO_POINTER(pTotalsLowLow->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, 
-                              cLowLowInstancesInBucket
+                              weightLowLow
                            );
                            EBM_ASSERT(std::isnan(splittingScoreUpdate1) || FloatEbmType { 0 } <= splittingScoreUpdate1);
                            splittingScore += splittingScoreUpdate1;
                            const FloatEbmType splittingScoreUpdate2 = EbmStatistics::ComputeNodeSplittingScore(
-                              ARRAY_TO_POINTER(pTotalsLowHigh->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, cLowHighInstancesInBucket);
+                              ARRAY_TO_POINTER(pTotalsLowHigh->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, weightLowHigh);
                            EBM_ASSERT(std::isnan(splittingScoreUpdate2) || FloatEbmType { 0 } <= splittingScoreUpdate2);
                            splittingScore += splittingScoreUpdate2;
                            const FloatEbmType splittingScoreUpdate3 = EbmStatistics::ComputeNodeSplittingScore(
-                              ARRAY_TO_POINTER(pTotalsHighLow->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, cHighLowInstancesInBucket);
+                              ARRAY_TO_POINTER(pTotalsHighLow->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, weightHighLow);
                            EBM_ASSERT(std::isnan(splittingScoreUpdate3) || FloatEbmType { 0 } <= splittingScoreUpdate3);
                            splittingScore += splittingScoreUpdate3;
                            const FloatEbmType splittingScoreUpdate4 = EbmStatistics::ComputeNodeSplittingScore(
-                              ARRAY_TO_POINTER(pTotalsHighHigh->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, cHighHighInstancesInBucket);
+                              ARRAY_TO_POINTER(pTotalsHighHigh->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError, weightHighHigh);
                            EBM_ASSERT(std::isnan(splittingScoreUpdate4) || FloatEbmType { 0 } <= splittingScoreUpdate4);
                            splittingScore += splittingScoreUpdate4;
                         }
@@ -14,7 +14,7 @@
 #include "EbmStatistics.h"
 #include "CachedThreadResources.h"
 #include "Feature.h"
-#include "SamplingWithReplacement.h"
+#include "SamplingMethod.h"
 #include "HistogramBucket.h"
 
 #include "TreeNode.h"
@@ -25,8 +25,8 @@
 
 template<bool bClassification>
 struct SweepTreeNode {
-   size_t m_cBestInstancesLeft;
-   const HistogramBucket<bClassification> * m_pBestHistogramBucketEntry;
+   FloatEbmType m_bestWeightLeft;
+   const HistogramBucket<bClassification> * const * m_ppBestHistogramBucketEntry;
    
    // use the "struct hack" since Flexible array member method is not available in C++
    // m_aHistogramBucketVectorEntry must be the last item in this struct
@@ -111,20 +111,20 @@ bool ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint(
       aSumResidualErrorsRight[iVector] = ARRAY_TO_POINTER_CONST(pTreeNode->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError;
    }
 
-   const HistogramBucket<bClassification> * pHistogramBucketEntryCur =
-      pTreeNode->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryFirst;
-   const HistogramBucket<bClassification> * const pHistogramBucketEntryLast =
-      pTreeNode->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryLast;
+   const HistogramBucket<bClassification> * const * ppHistogramBucketEntryCur =
+      pTreeNode->m_UNION.m_beforeExaminationForPossibleSplitting.m_ppHistogramBucketEntryFirst;
+   const HistogramBucket<bClassification> * const * const ppHistogramBucketEntryLast =
+      pTreeNode->m_UNION.m_beforeExaminationForPossibleSplitting.m_ppHistogramBucketEntryLast;
 
    EBM_ASSERT(!GetTreeNodeSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
    const size_t cBytesPerTreeNode = GetTreeNodeSize<bClassification>(cVectorLength);
 
    TreeNode<bClassification> * const pLeftChildInit =
       GetLeftTreeNodeChild<bClassification>(pTreeNodeChildrenAvailableStorageSpaceCur, cBytesPerTreeNode);
-   pLeftChildInit->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryFirst = pHistogramBucketEntryCur;
+   pLeftChildInit->m_UNION.m_beforeExaminationForPossibleSplitting.m_ppHistogramBucketEntryFirst = ppHistogramBucketEntryCur;
    TreeNode<bClassification> * const pRightChildInit =
       GetRightTreeNodeChild<bClassification>(pTreeNodeChildrenAvailableStorageSpaceCur, cBytesPerTreeNode);
-   pRightChildInit->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryLast = pHistogramBucketEntryLast;
+   pRightChildInit->m_UNION.m_beforeExaminationForPossibleSplitting.m_ppHistogramBucketEntryLast = ppHistogramBucketEntryLast;
 
    EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
    const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
@@ -135,30 +135,31 @@ bool ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint(
       static_cast<SweepTreeNode<bClassification> *>(pCachedThreadResources->m_aEquivalentSplits);
    SweepTreeNode<bClassification> * pSweepTreeNodeCur = pSweepTreeNodeStart;
 
-   size_t cInstancesRight = pTreeNode->GetInstances();
-   size_t cInstancesLeft = 0;
+   // a weight of k is equivalent to k duplicate instances, so our minimum instance counts apply to our weights
+   const FloatEbmType weightRequiredForChildSplitMin = static_cast<FloatEbmType>(cInstancesRequiredForChildSplitMin);
+   FloatEbmType weightRight = pTreeNode->GetWeight();
+   FloatEbmType weightLeft = FloatEbmType { 0 };
    FloatEbmType BEST_nodeSplittingScore = k_illegalGain;
 #ifndef LEGACY_COMPATIBILITY
    EBM_ASSERT(0 < cInstancesRequiredForChildSplitMin);
 #endif // LEGACY_COMPATIBILITY
-   EBM_ASSERT(pHistogramBucketEntryLast != pHistogramBucketEntryCur); // we wouldn't call this function on a non-splittable node
+   EBM_ASSERT(ppHistogramBucketEntryLast != ppHistogramBucketEntryCur); // we wouldn't call this function on a non-splittable node
    do {
+      const HistogramBucket<bClassification> * const pHistogramBucketEntryCur = *ppHistogramBucketEntryCur;
       ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucketEntryCur, aHistogramBucketsEndDebug);
 
-      const size_t CHANGE_cInstances = pHistogramBucketEntryCur->m_cInstancesInBucket;
-      cInstancesRight -= CHANGE_cInstances;
-      if(UNLIKELY(cInstancesRight < cInstancesRequiredForChildSplitMin)) {
+      const FloatEbmType CHANGE_weight = pHistogramBucketEntryCur->m_weightInBucket;
+      weightRight -= CHANGE_weight;
+      if(UNLIKELY(weightRight < weightRequiredForChildSplitMin)) {
          break; // we'll just keep subtracting if we continue, so there won't be any more splits, so we're done
       }
-      cInstancesLeft += CHANGE_cInstances;
-      if(LIKELY(cInstancesRequiredForChildSplitMin <= cInstancesLeft)) {
+      weightLeft += CHANGE_weight;
+      if(LIKELY(weightRequiredForChildSplitMin <= weightLeft)) {
 #ifndef LEGACY_COMPATIBILITY
-         EBM_ASSERT(0 < cInstancesRight);
-         EBM_ASSERT(0 < cInstancesLeft);
+         EBM_ASSERT(0 < weightRight);
+         EBM_ASSERT(0 < weightLeft);
 #endif // LEGACY_COMPATIBILITY
 
-         const FloatEbmType cInstancesRightFloatEbmType = static_cast<FloatEbmType>(cInstancesRight);
-         const FloatEbmType cInstancesLeftFloatEbmType = static_cast<FloatEbmType>(cInstancesLeft);
          FloatEbmType nodeSplittingScore = 0;
          for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
             const FloatEbmType CHANGE_sumResidualError = ARRAY_TO_POINTER_CONST(
@@ -169,7 +170,7 @@ bool ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint(
 
             // TODO : we can make this faster by doing the division in ComputeNodeSplittingScore after we add all the numerators 
             // (but only do this after we've determined the best node splitting score for classification, and the NewtonRaphsonStep for gain
-            const FloatEbmType nodeSplittingScoreRight = EbmStatistics::ComputeNodeSplittingScore(sumResidualErrorRight, cInstancesRightFloatEbmType);
+            const FloatEbmType nodeSplittingScoreRight = EbmStatistics::ComputeNodeSplittingScore(sumResidualErrorRight, weightRight);
             EBM_ASSERT(std::isnan(nodeSplittingScoreRight) || FloatEbmType { 0 } <= nodeSplittingScoreRight);
             nodeSplittingScore += nodeSplittingScoreRight;
 
@@ -178,7 +179,7 @@ bool ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint(
 
             // TODO : we can make this faster by doing the division in ComputeNodeSplittingScore after we add all the numerators 
             // (but only do this after we've determined the best node splitting score for classification, and the NewtonRaphsonStep for gain
-            const FloatEbmType nodeSplittingScoreLeft = EbmStatistics::ComputeNodeSplittingScore(sumResidualErrorLeft, cInstancesLeftFloatEbmType);
+            const FloatEbmType nodeSplittingScoreLeft = EbmStatistics::ComputeNodeSplittingScore(sumResidualErrorLeft, weightLeft);
             EBM_ASSERT(std::isnan(nodeSplittingScoreLeft) || FloatEbmType { 0 } <= nodeSplittingScoreLeft);
             nodeSplittingScore += nodeSplittingScoreLeft;
 
@@ -223,8 +224,8 @@ bool ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint(
             pSweepTreeNodeCur = UNPREDICTABLE(BEST_nodeSplittingScore == nodeSplittingScore) ? pSweepTreeNodeCur : pSweepTreeNodeStart;
             BEST_nodeSplittingScore = nodeSplittingScore;
 
-            pSweepTreeNodeCur->m_pBestHistogramBucketEntry = pHistogramBucketEntryCur;
-            pSweepTreeNodeCur->m_cBestInstancesLeft = cInstancesLeft;
+            pSweepTreeNodeCur->m_ppBestHistogramBucketEntry = ppHistogramBucketEntryCur;
+            pSweepTreeNodeCur->m_bestWeightLeft = weightLeft;
             memcpy(
                pSweepTreeNodeCur->m_aBestHistogramBucketVectorEntry, aSumHistogramBucketVectorEntryLeft, 
                sizeof(*aSumHistogramBucketVectorEntryLeft) * cVectorLength
@@ -247,8 +248,8 @@ bool ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint(
             }
          }
       }
-      pHistogramBucketEntryCur = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pHistogramBucketEntryCur, 1);
-   } while(pHistogramBucketEntryLast != pHistogramBucketEntryCur);
+      ++ppHistogramBucketEntryCur;
+   } while(ppHistogramBucketEntryLast != ppHistogramBucketEntryCur);
 
    if(UNLIKELY(UNLIKELY(pSweepTreeNodeStart == pSweepTreeNodeCur) || UNLIKELY(std::isnan(BEST_nodeSplittingScore)) || 
       UNLIKELY(std::isinf(BEST_nodeSplittingScore)))) 
@@ -275,27 +276,25 @@ bool ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint(
    TreeNode<bClassification> * const pLeftChild =
       GetLeftTreeNodeChild<bClassification>(pTreeNodeChildrenAvailableStorageSpaceCur, cBytesPerTreeNode);
 
-   const HistogramBucket<bClassification> * const BEST_pHistogramBucketEntry = pSweepTreeNodeStart->m_pBestHistogramBucketEntry;
-   pLeftChild->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryLast = BEST_pHistogramBucketEntry;
-   const size_t BEST_cInstancesLeft = pSweepTreeNodeStart->m_cBestInstancesLeft;
-   pLeftChild->SetInstances(BEST_cInstancesLeft);
+   const HistogramBucket<bClassification> * const * const BEST_ppHistogramBucketEntry = pSweepTreeNodeStart->m_ppBestHistogramBucketEntry;
+   pLeftChild->m_UNION.m_beforeExaminationForPossibleSplitting.m_ppHistogramBucketEntryLast = BEST_ppHistogramBucketEntry;
+   const FloatEbmType BEST_weightLeft = pSweepTreeNodeStart->m_bestWeightLeft;
+   pLeftChild->SetWeight(BEST_weightLeft);
 
-   const HistogramBucket<bClassification> * const BEST_pHistogramBucketEntryNext =
-      GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, BEST_pHistogramBucketEntry, 1);
-   ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, BEST_pHistogramBucketEntryNext, aHistogramBucketsEndDebug);
+   const HistogramBucket<bClassification> * const * const BEST_ppHistogramBucketEntryNext = BEST_ppHistogramBucketEntry + 1;
+   EBM_ASSERT(BEST_ppHistogramBucketEntryNext <= ppHistogramBucketEntryLast);
 
    TreeNode<bClassification> * const pRightChild = GetRightTreeNodeChild<bClassification>(pTreeNodeChildrenAvailableStorageSpaceCur, cBytesPerTreeNode);
 
-   pRightChild->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryFirst = BEST_pHistogramBucketEntryNext;
-   const size_t cInstancesParent = pTreeNode->GetInstances();
-   pRightChild->SetInstances(cInstancesParent - BEST_cInstancesLeft);
+   pRightChild->m_UNION.m_beforeExaminationForPossibleSplitting.m_ppHistogramBucketEntryFirst = BEST_ppHistogramBucketEntryNext;
+   const FloatEbmType weightParent = pTreeNode->GetWeight();
+   pRightChild->SetWeight(weightParent - BEST_weightLeft);
 
-   const FloatEbmType cInstancesParentFloatEbmType = static_cast<FloatEbmType>(cInstancesParent);
 #ifndef LEGACY_COMPATIBILITY
    // if the total instances is 0 then we should be using our specialty handling of that case
    // if the total instances if not 0, then our splitting code should never split any node that has zero on either the left or right, so no new 
    // parent should ever have zero instances
-   EBM_ASSERT(0 < cInstancesParent);
+   EBM_ASSERT(0 < weightParent);
 #endif // LEGACY_COMPATIBILITY
 
    // TODO: usually we've done this calculation for the parent already.  Why not keep the result arround to avoid extra work?
@@ -307,7 +306,7 @@ bool ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint(
       const FloatEbmType sumResidualErrorParent = ARRAY_TO_POINTER(pTreeNode->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError;
       ARRAY_TO_POINTER(pRightChild->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError = sumResidualErrorParent - BEST_sumResidualErrorLeft;
 
-      const FloatEbmType originalParentScoreUpdate = EbmStatistics::ComputeNodeSplittingScore(sumResidualErrorParent, cInstancesParentFloatEbmType);
+      const FloatEbmType originalParentScoreUpdate = EbmStatistics::ComputeNodeSplittingScore(sumResidualErrorParent, weightParent);
       EBM_ASSERT(std::isnan(originalParentScoreUpdate) || FloatEbmType { 0 } <= originalParentScoreUpdate);
       originalParentScore += originalParentScoreUpdate;
 
@@ -324,7 +323,7 @@ bool ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint(
 
 
    // IMPORTANT!! : we need to finish all our calls that use this->m_UNION.m_beforeExaminationForPossibleSplitting BEFORE setting anything in 
-   // m_UNION.m_afterExaminationForPossibleSplitting as we do below this comment!  The call above to this->GetInstances() needs to be done above 
+   // m_UNION.m_afterExaminationForPossibleSplitting as we do below this comment!  The call above to this->GetWeight() needs to be done above 
    // these lines because it uses m_UNION.m_beforeExaminationForPossibleSplitting for classification!
 
 
@@ -341,15 +340,21 @@ bool ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint(
    // within a set, no split should make our model worse.  It might in our validation set, but not within the training set
    EBM_ASSERT(std::isnan(splitGain) || (!bClassification) && std::isinf(splitGain) || k_epsilonNegativeGainAllowed <= splitGain);
    pTreeNode->m_UNION.m_afterExaminationForPossibleSplitting.m_splitGain = splitGain;
-#ifdef LEGACY_COMPATIBILITY
-   pTreeNode->m_UNION.m_afterExaminationForPossibleSplitting.m_divisionValue = 
-      (BEST_pHistogramBucketEntry->m_bucketValue + BEST_pHistogramBucketEntryNext->m_bucketValue) / 2;
-   UNUSED(aHistogramBucket);
-#else // LEGACY_COMPATIBILITY
+   const HistogramBucket<bClassification> * const BEST_pHistogramBucketEntry = *BEST_ppHistogramBucketEntry;
    EBM_ASSERT(reinterpret_cast<const char *>(aHistogramBucket) <= reinterpret_cast<const char *>(BEST_pHistogramBucketEntry));
    EBM_ASSERT(0 == (reinterpret_cast<const char *>(BEST_pHistogramBucketEntry) - reinterpret_cast<const char *>(aHistogramBucket)) % cBytesPerHistogramBucket);
-   pTreeNode->m_UNION.m_afterExaminationForPossibleSplitting.m_divisionValue = 
+   const size_t iBestBucket = 
       (reinterpret_cast<const char *>(BEST_pHistogramBucketEntry) - reinterpret_cast<const char *>(aHistogramBucket)) / cBytesPerHistogramBucket;
+#ifdef LEGACY_COMPATIBILITY
+   // the buckets between our best bucket and the next active bucket are empty, and we split halfway across them
+   const HistogramBucket<bClassification> * const BEST_pHistogramBucketEntryNext = *BEST_ppHistogramBucketEntryNext;
+   ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, BEST_pHistogramBucketEntryNext, aHistogramBucketsEndDebug);
+   const size_t iBestBucketNext = 
+      (reinterpret_cast<const char *>(BEST_pHistogramBucketEntryNext) - reinterpret_cast<const char *>(aHistogramBucket)) / cBytesPerHistogramBucket;
+   EBM_ASSERT(iBestBucket < iBestBucketNext);
+   pTreeNode->m_UNION.m_afterExaminationForPossibleSplitting.m_divisionValue = static_cast<ActiveDataType>((iBestBucket + iBestBucketNext) / 2);
+#else // LEGACY_COMPATIBILITY
+   pTreeNode->m_UNION.m_afterExaminationForPossibleSplitting.m_divisionValue = iBestBucket;
 #endif // LEGACY_COMPATIBILITY
 
    LOG_N(
@@ -367,9 +372,10 @@ bool GrowDecisionTree(
    RandomStream * const pRandomStream, 
    CachedBoostingThreadResources<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const pCachedThreadResources, 
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses, 
-   const size_t cHistogramBuckets, 
+   const size_t cHistogramBucketsActive, 
    const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucket, 
-   const size_t cInstancesTotal, 
+   const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const * const apHistogramBucketsActive, 
+   const FloatEbmType weightTotal, 
    const HistogramBucketVectorEntry<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aSumHistogramBucketVectorEntry, 
    const size_t cTreeSplitsMax, 
    const size_t cInstancesRequiredForParentSplitMin, 
@@ -391,16 +397,16 @@ bool GrowDecisionTree(
    const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
 
    EBM_ASSERT(nullptr != pTotalGain);
-   EBM_ASSERT(1 <= cInstancesTotal); // filter these out at the start where we can handle this case easily
-   // cHistogramBuckets could only be zero if cInstancesTotal.  We should filter out that special case at our entry point though!!
-   EBM_ASSERT(1 <= cHistogramBuckets);
-   // TODO: I think we can eliminate the check for 1 == cHistogramBuckets once we get ride of bucket compresssion (on zeros)
+   EBM_ASSERT(0 < weightTotal); // filter these out at the start where we can handle this case easily
+   // cHistogramBucketsActive could only be zero if weightTotal is zero.  We should filter out that special case at our entry point though!!
+   EBM_ASSERT(1 <= cHistogramBucketsActive);
+   // TODO: I think we can eliminate the check for 1 == cHistogramBucketsActive once we stop skipping empty buckets
    // TODO: do we already have a separate solution for no splits, which we could use for 0 == cTreeSplitsMax
-   if(UNLIKELY(cInstancesTotal < cInstancesRequiredForParentSplitMin || 1 == cHistogramBuckets || 0 == cTreeSplitsMax)) {
+   if(UNLIKELY(weightTotal < static_cast<FloatEbmType>(cInstancesRequiredForParentSplitMin) || 1 == cHistogramBucketsActive || 0 == cTreeSplitsMax)) {
       // there will be no splits at all
 
-      // TODO : this section can probably be eliminated in the future when we disable cInstancesRequiredForParentSplitMin, and butcket 
-      // compression (making 2 <= cHistogramBuckets), and 0 == cTreeSplitsMax can be handled by using our non-splitting specialty boosting function
+      // TODO : this section can probably be eliminated in the future when we disable cInstancesRequiredForParentSplitMin, and skipping 
+      // empty buckets (making 2 <= cHistogramBucketsActive), and 0 == cTreeSplitsMax can be handled by using our non-splitting specialty boosting function
 
    no_splits:;
 
@@ -422,7 +428,7 @@ bool GrowDecisionTree(
       } else {
          EBM_ASSERT(IsRegression(compilerLearningTypeOrCountTargetClasses));
          const FloatEbmType smallChangeToModel = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
-            aSumHistogramBucketVectorEntry[0].m_sumResidualError, static_cast<FloatEbmType>(cInstancesTotal)
+            aSumHistogramBucketVectorEntry[0].m_sumResidualError, weightTotal
          );
          FloatEbmType * pValues = pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer();
          pValues[0] = smallChangeToModel;
@@ -440,8 +446,6 @@ bool GrowDecisionTree(
       return true; // we haven't accessed this TreeNode memory yet, so we don't know if it overflows yet
    }
    const size_t cBytesPerTreeNode = GetTreeNodeSize<bClassification>(cVectorLength);
-   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
-   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
 
 retry_with_bigger_tree_node_children_array:
    size_t cBytesBuffer2 = pCachedThreadResources->GetThreadByteBuffer2Size();
@@ -461,15 +465,10 @@ retry_with_bigger_tree_node_children_array:
    TreeNode<bClassification> * pRootTreeNode =
       static_cast<TreeNode<bClassification> *>(pCachedThreadResources->GetThreadByteBuffer2());
 
-   pRootTreeNode->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryFirst = aHistogramBucket;
-   pRootTreeNode->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryLast = 
-      GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBucket, cHistogramBuckets - 1);
-   ASSERT_BINNED_BUCKET_OK(
-      cBytesPerHistogramBucket, 
-      pRootTreeNode->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryLast, 
-      aHistogramBucketsEndDebug
-   );
-   pRootTreeNode->SetInstances(cInstancesTotal);
+   pRootTreeNode->m_UNION.m_beforeExaminationForPossibleSplitting.m_ppHistogramBucketEntryFirst = apHistogramBucketsActive;
+   pRootTreeNode->m_UNION.m_beforeExaminationForPossibleSplitting.m_ppHistogramBucketEntryLast = 
+      apHistogramBucketsActive + (cHistogramBucketsActive - 1);
+   pRootTreeNode->SetWeight(weightTotal);
 
    // copying existing mem
    memcpy(
@@ -496,10 +495,10 @@ retry_with_bigger_tree_node_children_array:
          goto no_splits;
       }
 
-      if(UNPREDICTABLE(PREDICTABLE(1 == cTreeSplitsMax) || UNPREDICTABLE(2 == cHistogramBuckets))) {
+      if(UNPREDICTABLE(PREDICTABLE(1 == cTreeSplitsMax) || UNPREDICTABLE(2 == cHistogramBucketsActive))) {
          // there will be exactly 1 split, which is a special case that we can return faster without as much overhead as the multiple split case
 
-         EBM_ASSERT(2 != cHistogramBuckets || !GetLeftTreeNodeChild<bClassification>(
+         EBM_ASSERT(2 != cHistogramBucketsActive || !GetLeftTreeNodeChild<bClassification>(
             pRootTreeNode->m_UNION.m_afterExaminationForPossibleSplitting.m_pTreeNodeChildren, cBytesPerTreeNode)->IsSplittable(cInstancesRequiredForParentSplitMin) && 
             !GetRightTreeNodeChild<bClassification>(
                pRootTreeNode->m_UNION.m_afterExaminationForPossibleSplitting.m_pTreeNodeChildren, 
@@ -544,11 +543,11 @@ retry_with_bigger_tree_node_children_array:
             EBM_ASSERT(IsRegression(compilerLearningTypeOrCountTargetClasses));
             aValues[0] = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                ARRAY_TO_POINTER_CONST(pLeftChild->m_aHistogramBucketVectorEntry)[0].m_sumResidualError, 
-               static_cast<FloatEbmType>(pLeftChild->GetInstances())
+               pLeftChild->GetWeight()
             );
             aValues[1] = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
                ARRAY_TO_POINTER_CONST(pRightChild->m_aHistogramBucketVectorEntry)[0].m_sumResidualError, 
-               static_cast<FloatEbmType>(pRightChild->GetInstances())
+               pRightChild->GetWeight()
             );
          }
 
@@ -569,16 +568,13 @@ retry_with_bigger_tree_node_children_array:
       // to change this to an array scan because in theory the user can specify very deep trees, and we don't want to hang on an O(N^2) operation
       // if they do.  So, let's keep the priority queue, and only the priority queue since it handles all scenarios without any real cost and is simpler
       // than implementing an optional array scan PLUS a priority queue for deep trees.
-      std::priority_queue<
-         TreeNode<bClassification> *,
-         std::vector<TreeNode<bClassification> *>,
-         CompareTreeNodeSplittingGain<bClassification>
-      > * pBestTreeNodeToSplit = &pCachedThreadResources->m_bestTreeNodeToSplit.m_queue;
-
-      // it is ridiculous that we need to do this in order to clear the tree (there is no "clear" function), but inside this queue is a chunk of memory, 
-      // and we want to ensure that the chunk of memory stays in L1 cache, so we pop all the previous garbage off instead of allocating a new one!
-      while(!pBestTreeNodeToSplit->empty()) {
-         pBestTreeNodeToSplit->pop();
+      TreeNodeHeap<bClassification> * const pBestTreeNodeToSplit = &pCachedThreadResources->m_bestTreeNodeToSplit;
+      pBestTreeNodeToSplit->Clear();
+      // we only push TreeNodes after reserving space for their 2 children in ThreadByteBuffer2, and the root is never pushed, so this bounds our heap.
+      // EbmBoostingState::Initialize reserved this already, so this only allocates if ThreadByteBuffer2 needed to grow
+      if(pBestTreeNodeToSplit->Reserve(cBytesBuffer2 / cBytesPerTreeNode >> 1)) {
+         LOG_0(TraceLevelWarning, "WARNING GrowDecisionTree pBestTreeNodeToSplit->Reserve(cBytesBuffer2 / cBytesPerTreeNode >> 1)");
+         return true;
       }
 
       cSplits = 0;
@@ -593,8 +589,7 @@ retry_with_bigger_tree_node_children_array:
       goto skip_first_push_pop;
 
       do {
-         // there is no way to get the top and pop at the same time.. would be good to get a better queue, but our code isn't bottlenecked by it
-         pParentTreeNode = pBestTreeNodeToSplit->top();
+         pParentTreeNode = pBestTreeNodeToSplit->Top();
          // In theory we can have nodes with equal gain values here, but this is very very rare to occur in practice
          // We handle equal gain values in ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint because we 
          // can have zero instnaces in bins, in which case it occurs, but those equivalent situations have been cleansed by
@@ -604,7 +599,7 @@ retry_with_bigger_tree_node_children_array:
          // Even if all of these things are true, after one non-symetric cut, we won't see that scenario anymore since the residuals won't be
          // symetric anymore.  This is so rare, and limited to one cut, so we shouldn't bother to handle it since the complexity of doing so
          // outweights the benefits.
-         pBestTreeNodeToSplit->pop();
+         pBestTreeNodeToSplit->Pop();
 
       skip_first_push_pop:
 
@@ -649,7 +644,7 @@ retry_with_bigger_tree_node_children_array:
 #endif // NDEBUG
                )) {
                pTreeNodeChildrenAvailableStorageSpaceCur = pTreeNodeChildrenAvailableStorageSpaceNext;
-               pBestTreeNodeToSplit->push(pLeftChild);
+               pBestTreeNodeToSplit->Push(pLeftChild);
             } else {
                goto no_left_split;
             }
@@ -695,7 +690,7 @@ retry_with_bigger_tree_node_children_array:
 #endif // NDEBUG
                )) {
                pTreeNodeChildrenAvailableStorageSpaceCur = pTreeNodeChildrenAvailableStorageSpaceNext;
-               pBestTreeNodeToSplit->push(pRightChild);
+               pBestTreeNodeToSplit->Push(pRightChild);
             } else {
                goto no_right_split;
             }
@@ -709,7 +704,7 @@ retry_with_bigger_tree_node_children_array:
             pRightChild->INDICATE_THIS_NODE_EXAMINED_FOR_SPLIT_AND_REJECTED();
          }
          ++cSplits;
-      } while(cSplits < cTreeSplitsMax && UNLIKELY(!pBestTreeNodeToSplit->empty()));
+      } while(cSplits < cTreeSplitsMax && UNLIKELY(!pBestTreeNodeToSplit->IsEmpty()));
       // we DON'T need to call SetLeafAfterDone() on any items that remain in the pBestTreeNodeToSplit queue because everything in that queue has set 
       // a non-NaN nodeSplittingScore value
 
@@ -725,7 +720,6 @@ retry_with_bigger_tree_node_children_array:
       );
    } catch(...) {
       // ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint can throw exceptions from the random number generator, possibly (it's not documented)
-      // calling anything inside pBestTreeNodeToSplit can throw exceptions, possibly (it's not documented)
       LOG_0(TraceLevelWarning, "WARNING GrowDecisionTree exception");
       return true;
    }
@@ -765,7 +759,9 @@ bool BoostZeroDimensional(
    CachedBoostingThreadResources<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const pCachedThreadResources, 
    const SamplingMethod * const pTrainingSet, 
    SegmentedTensor * const pSmallChangeToModelOverwriteSingleSamplingSet, 
-   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   // if our caller already binned this sampling set (see BinDataSetTrainingAllSamplingSets) we use its bucket instead of binning here
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsBinned
 ) {
    constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
 
@@ -782,22 +778,29 @@ bool BoostZeroDimensional(
       return true;
    }
    const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
-   HistogramBucket<bClassification> * const pHistogramBucket =
-      static_cast<HistogramBucket<bClassification> *>(
-         pCachedThreadResources->GetThreadByteBuffer1(cBytesPerHistogramBucket)
-   );
-   if(UNLIKELY(nullptr == pHistogramBucket)) {
-      LOG_0(TraceLevelWarning, "WARNING nullptr == pHistogramBucket");
-      return true;
-   }
-   memset(pHistogramBucket, 0, cBytesPerHistogramBucket);
+   HistogramBucket<bClassification> * pHistogramBucket = aHistogramBucketsBinned;
+   if(nullptr == pHistogramBucket) {
+      pHistogramBucket = static_cast<HistogramBucket<bClassification> *>(pCachedThreadResources->GetThreadByteBuffer1(cBytesPerHistogramBucket));
+      if(UNLIKELY(nullptr == pHistogramBucket)) {
+         LOG_0(TraceLevelWarning, "WARNING nullptr == pHistogramBucket");
+         return true;
+      }
+      memset(pHistogramBucket, 0, cBytesPerHistogramBucket);
 
-   BinDataSetTrainingZeroDimensions<compilerLearningTypeOrCountTargetClasses>(pHistogramBucket, pTrainingSet, runtimeLearningTypeOrCountTargetClasses);
+      BinDataSetTrainingZeroDimensions<compilerLearningTypeOrCountTargetClasses>(
+         pHistogramBucket, 
+         pTrainingSet, 
+         runtimeLearningTypeOrCountTargetClasses
+      );
+   }
 
    const HistogramBucketVectorEntry<bClassification> * const aSumHistogramBucketVectorEntry =
       ARRAY_TO_POINTER(pHistogramBucket->m_aHistogramBucketVectorEntry);
    FloatEbmType * aValues = pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer();
-   if(bClassification) {
+   if(UNLIKELY(FloatEbmType { 0 } == pHistogramBucket->m_weightInBucket)) {
+      // every instance in this sampling set has a weight of zero, so there is nothing to learn from it
+      memset(aValues, 0, sizeof(*aValues) * cVectorLength); // can't overflow, accessing existing memory
+   } else if(bClassification) {
       for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
          const FloatEbmType smallChangeToModel = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
             aSumHistogramBucketVectorEntry[iVector].m_sumResidualError, 
@@ -809,7 +812,7 @@ bool BoostZeroDimensional(
       EBM_ASSERT(IsRegression(compilerLearningTypeOrCountTargetClasses));
       const FloatEbmType smallChangeToModel = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
          aSumHistogramBucketVectorEntry[0].m_sumResidualError, 
-         static_cast<FloatEbmType>(pHistogramBucket->m_cInstancesInBucket)
+         pHistogramBucket->m_weightInBucket
       );
       aValues[0] = smallChangeToModel;
    }
@@ -831,7 +834,9 @@ bool BoostSingleDimensional(
    const size_t cInstancesRequiredForChildSplitMin, 
    SegmentedTensor * const pSmallChangeToModelOverwriteSingleSamplingSet, 
    FloatEbmType * const pTotalGain, 
-   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   // if our caller already binned this sampling set (see BinDataSetTrainingAllSamplingSets) we use its buckets instead of binning here
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsBinned
 ) {
    constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
 
@@ -857,43 +862,52 @@ bool BoostSingleDimensional(
       return true;
    }
    const size_t cBytesBuffer = cTotalBuckets * cBytesPerHistogramBucket;
-   HistogramBucket<bClassification> * const aHistogramBuckets =
-      static_cast<HistogramBucket<bClassification> *>(pCachedThreadResources->GetThreadByteBuffer1(cBytesBuffer));
-   if(UNLIKELY(nullptr == aHistogramBuckets)) {
-      LOG_0(TraceLevelWarning, "WARNING BoostSingleDimensional nullptr == aHistogramBuckets");
-      return true;
+   HistogramBucket<bClassification> * aHistogramBuckets = aHistogramBucketsBinned;
+   if(nullptr == aHistogramBuckets) {
+      aHistogramBuckets = static_cast<HistogramBucket<bClassification> *>(pCachedThreadResources->GetThreadByteBuffer1(cBytesBuffer));
+      if(UNLIKELY(nullptr == aHistogramBuckets)) {
+         LOG_0(TraceLevelWarning, "WARNING BoostSingleDimensional nullptr == aHistogramBuckets");
+         return true;
+      }
+      // !!! VERY IMPORTANT: zero our one extra bucket for BuildFastTotals to use for multi-dimensional !!!!
+      memset(aHistogramBuckets, 0, cBytesBuffer);
    }
-   // !!! VERY IMPORTANT: zero our one extra bucket for BuildFastTotals to use for multi-dimensional !!!!
-   memset(aHistogramBuckets, 0, cBytesBuffer);
 
 #ifndef NDEBUG
    const unsigned char * const aHistogramBucketsEndDebug = reinterpret_cast<unsigned char *>(aHistogramBuckets) + cBytesBuffer;
 #endif // NDEBUG
 
-   BinDataSetTraining<compilerLearningTypeOrCountTargetClasses, 1>(
-      aHistogramBuckets, 
-      pFeatureCombination, 
-      pTrainingSet, 
-      runtimeLearningTypeOrCountTargetClasses
+   if(nullptr == aHistogramBucketsBinned) {
+      BinDataSetTraining<compilerLearningTypeOrCountTargetClasses, 1>(
+         aHistogramBuckets, 
+         pFeatureCombination, 
+         pTrainingSet, 
+         runtimeLearningTypeOrCountTargetClasses
 #ifndef NDEBUG
-      , aHistogramBucketsEndDebug
+         , aHistogramBucketsEndDebug
 #endif // NDEBUG
-   );
+      );
+   }
 
    HistogramBucketVectorEntry<bClassification> * const aSumHistogramBucketVectorEntry =
       pCachedThreadResources->m_aSumHistogramBucketVectorEntry;
    memset(aSumHistogramBucketVectorEntry, 0, sizeof(*aSumHistogramBucketVectorEntry) * cVectorLength); // can't overflow, accessing existing memory
 
-   size_t cHistogramBuckets = ARRAY_TO_POINTER_CONST(pFeatureCombination->m_FeatureCombinationEntry)[0].m_pFeature->m_cBins;
    // this function can handle 1 == cBins even though that's a degenerate case that shouldn't be boosted on 
    // (dimensions with 1 bin don't contribute anything since they always have the same value)
-   EBM_ASSERT(1 <= cHistogramBuckets);
-   size_t cInstancesTotal;
-   cHistogramBuckets = CompressHistogramBuckets<compilerLearningTypeOrCountTargetClasses>(
+   EBM_ASSERT(1 <= cTotalBuckets);
+   const HistogramBucket<bClassification> ** const apHistogramBucketsActive = pCachedThreadResources->GetHistogramBucketsActive(cTotalBuckets);
+   if(UNLIKELY(nullptr == apHistogramBucketsActive)) {
+      LOG_0(TraceLevelWarning, "WARNING BoostSingleDimensional nullptr == apHistogramBucketsActive");
+      return true;
+   }
+   FloatEbmType weightTotal;
+   const size_t cHistogramBucketsActive = ListActiveHistogramBuckets<compilerLearningTypeOrCountTargetClasses>(
       pTrainingSet, 
-      cHistogramBuckets, 
+      cTotalBuckets, 
       aHistogramBuckets, 
-      &cInstancesTotal, 
+      apHistogramBucketsActive, 
+      &weightTotal, 
       aSumHistogramBucketVectorEntry, 
       runtimeLearningTypeOrCountTargetClasses
 #ifndef NDEBUG
@@ -901,16 +915,31 @@ bool BoostSingleDimensional(
 #endif // NDEBUG
    );
 
-   EBM_ASSERT(1 <= cInstancesTotal);
-   EBM_ASSERT(1 <= cHistogramBuckets);
+   if(UNLIKELY(FloatEbmType { 0 } == weightTotal)) {
+      // every instance in this sampling set has a weight of zero, so there is nothing to learn from it.  Under LEGACY_COMPATIBILITY we would also
+      // have no active buckets, so handle this before growing any tree
+      if(UNLIKELY(pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(0, 0))) {
+         LOG_0(TraceLevelWarning, "WARNING BoostSingleDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(0, 0)");
+         return true;
+      }
+      // we don't need to call EnsureValueCapacity because by default we start with a value capacity of 2 * cVectorLength
+      FloatEbmType * const aValues = pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer();
+      memset(aValues, 0, sizeof(*aValues) * cVectorLength); // can't overflow, accessing existing memory
+      *pTotalGain = FloatEbmType { 0 };
+      LOG_0(TraceLevelVerbose, "Exited BoostSingleDimensional with zero weight");
+      return false;
+   }
+
+   EBM_ASSERT(1 <= cHistogramBucketsActive);
 
    bool bRet = GrowDecisionTree<compilerLearningTypeOrCountTargetClasses>(
       pRandomStream, 
       pCachedThreadResources, 
       runtimeLearningTypeOrCountTargetClasses, 
-      cHistogramBuckets, 
+      cHistogramBucketsActive, 
       aHistogramBuckets, 
-      cInstancesTotal, 
+      apHistogramBucketsActive, 
+      weightTotal, 
       aSumHistogramBucketVectorEntry, 
       cTreeSplitsMax, 
       cInstancesRequiredForParentSplitMin, 
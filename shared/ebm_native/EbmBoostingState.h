@@ -24,7 +24,18 @@
 // dataset depends on features
 #include "DataSetByFeatureCombination.h"
 // samples is somewhat independent from datasets, but relies on an indirect coupling with them
-#include "SamplingWithReplacement.h"
+#include "SamplingMethod.h"
+
+// the layout of optionalTempParams is documented in ebm_native.h, and GetTempParam reads them
+constexpr size_t k_iTempParamGradientOneSideTop = 1;
+constexpr size_t k_iTempParamGradientOneSideOther = 2;
+constexpr size_t k_iTempParamInnerBagSubsampleFraction = 3;
+constexpr size_t k_iTempParamSplitCornersPairs = 4;
+constexpr size_t k_iTempParamPairSuperBinBins = 5;
+constexpr size_t k_iTempParamBootstrapCountBits = 6;
+constexpr size_t k_iTempParamBinSamplingSetsSeparately = 7;
+constexpr size_t k_iTempParamSweepPairCutsSeparately = 8;
+constexpr size_t k_iTempParamStoreNewtonRaphsonSteps = 9;
 
 union CachedThreadResourcesUnion {
    CachedBoostingThreadResources<false> regression;
@@ -70,11 +81,56 @@ public:
    const size_t m_cSamplingSets;
 
    SamplingMethod ** m_apSamplingSets;
+
+   // our bootstrap inner bags are fixed after initialization and neither list nor gather their instances, so we can bin all of them in a single 
+   // pass over our training set.  This holds one count unpacker per sampling set, or it is nullptr if we bin each sampling set separately
+   CountOccurrencesUnpacker * m_aCountOccurrencesUnpackers;
+   // if true we never allocate m_aCountOccurrencesUnpackers, which lets tests compare our single pass binning against binning each sampling set
+   const bool m_bBinSamplingSetsSeparately;
+
+   // the bits per occurrence count that our bootstrap sampling sets start with before they switch to full counts on overflow
+   const size_t m_cBitsPerCountOccurrenceBootstrap;
+
+   // gradient-based one-side sampling is enabled if m_fractionGradientOneSideTop is non-zero.  m_aGradientMagnitudes is scratch space that we use
+   // to rank our training instances when we resample after each update
+   const FloatEbmType m_fractionGradientOneSideTop;
+   const FloatEbmType m_fractionGradientOneSideOther;
+   FloatEbmType * m_aGradientMagnitudes;
+
+   // if m_fractionInnerBagSubsample is non-zero, each inner bag samples that fraction of our training instances without replacement instead of 
+   // bootstrap sampling.  Those sampling sets gather our residuals into contiguous buffers, so we need to regather them after each update
+   const FloatEbmType m_fractionInnerBagSubsample;
+   bool m_bGatherResidualErrors;
+
+   // if true, we split pairs with SplitCornersMultiDimensional, which we always use for 3 or more dimensions
+   const bool m_bSplitCornersPairs;
+
+   // if non-zero, our pair specific splitter searches coarse-to-fine with super-bins of this many bins (see CoarseToFineCuts)
+   const size_t m_cPairSuperBinBins;
+
+   // if true, our pair specific splitter sweeps each dimension 0 cut on its own instead of in blocks (see SweepPairBlock)
+   const bool m_bSweepPairCutsSeparately;
+
+   // if true, our classification training set stores the Newton-Raphson step of each residual (see DataSetByFeatureCombination.h)
+   const bool m_bStoreNewtonRaphsonSteps;
+
    SegmentedTensor ** m_apCurrentModel;
    SegmentedTensor ** m_apBestModel;
 
+   // the feature combinations whose m_apCurrentModel tensors changed since we last copied them into m_apBestModel.  We list the indexes so that we 
+   // only visit the changed ones when our validation metric improves, and we flag them so that we don't list any feature combination twice
+   size_t * m_aiChangedFeatureCombinations;
+   bool * m_abChangedFeatureCombinations;
+   size_t m_cChangedFeatureCombinations;
+
    FloatEbmType m_bestModelMetric;
 
+   // BoostCyclic tells ApplyModelFeatureCombinationUpdate which feature combination it boosts next, so that the training pass that updates our 
+   // residuals can also bin them for that next step.  m_pFeatureCombinationBinned is the feature combination whose histograms for every sampling 
+   // set are already waiting in ThreadByteBuffer3, if any.  Both are nullptr outside of BoostCyclic
+   const FeatureCombination * m_pFeatureCombinationNext;
+   const FeatureCombination * m_pFeatureCombinationBinned;
+
    SegmentedTensor * const m_pSmallChangeToModelOverwriteSingleSamplingSet;
    SegmentedTensor * const m_pSmallChangeToModelAccumulatedFromSamplingSets;
 
@@ -106,9 +162,27 @@ public:
       , m_pValidationSet(nullptr)
       , m_cSamplingSets(cSamplingSets)
       , m_apSamplingSets(nullptr)
+      , m_aCountOccurrencesUnpackers(nullptr)
+      , m_bBinSamplingSetsSeparately(FloatEbmType { 0 } != GetTempParam(optionalTempParams, k_iTempParamBinSamplingSetsSeparately, FloatEbmType { 0 }))
+      , m_cBitsPerCountOccurrenceBootstrap(FloatEbmType { 1 } == GetTempParam(optionalTempParams, k_iTempParamBootstrapCountBits, FloatEbmType { 0 }) ? 
+         k_cBitsPerCountOccurrenceBit : k_cBitsPerCountOccurrenceByte)
+      , m_fractionGradientOneSideTop(GetTempParam(optionalTempParams, k_iTempParamGradientOneSideTop, FloatEbmType { 0 }))
+      , m_fractionGradientOneSideOther(GetTempParam(optionalTempParams, k_iTempParamGradientOneSideOther, FloatEbmType { 0 }))
+      , m_aGradientMagnitudes(nullptr)
+      , m_fractionInnerBagSubsample(GetTempParam(optionalTempParams, k_iTempParamInnerBagSubsampleFraction, FloatEbmType { 0 }))
+      , m_bGatherResidualErrors(false)
+      , m_bSplitCornersPairs(FloatEbmType { 0 } != GetTempParam(optionalTempParams, k_iTempParamSplitCornersPairs, FloatEbmType { 0 }))
+      , m_cPairSuperBinBins(GetPairSuperBinBins(optionalTempParams))
+      , m_bSweepPairCutsSeparately(FloatEbmType { 0 } != GetTempParam(optionalTempParams, k_iTempParamSweepPairCutsSeparately, FloatEbmType { 0 }))
+      , m_bStoreNewtonRaphsonSteps(FloatEbmType { 0 } != GetTempParam(optionalTempParams, k_iTempParamStoreNewtonRaphsonSteps, FloatEbmType { 0 }))
       , m_apCurrentModel(nullptr)
       , m_apBestModel(nullptr)
+      , m_aiChangedFeatureCombinations(nullptr)
+      , m_abChangedFeatureCombinations(nullptr)
+      , m_cChangedFeatureCombinations(0)
       , m_bestModelMetric(FloatEbmType { std::numeric_limits<FloatEbmType>::max() })
+      , m_pFeatureCombinationNext(nullptr)
+      , m_pFeatureCombinationBinned(nullptr)
       , m_pSmallChangeToModelOverwriteSingleSamplingSet(
          SegmentedTensor::Allocate(k_cDimensionsMax, GetVectorLength(runtimeLearningTypeOrCountTargetClasses)))
       , m_pSmallChangeToModelAccumulatedFromSamplingSets(
@@ -119,9 +193,20 @@ public:
       // we catch any errors in the constructor, so this should not be able to throw
       , m_cachedThreadResourcesUnion(runtimeLearningTypeOrCountTargetClasses) 
    {
-      // optionalTempParams isn't used by default.  It's meant to provide an easy way for python or other higher
-      // level languages to pass EXPERIMENTAL temporary parameters easily to the C++ code.
-      UNUSED(optionalTempParams);
+      // optionalTempParams is meant to provide an easy way for python or other higher level languages to pass EXPERIMENTAL temporary parameters 
+      // easily to the C++ code.  We read the ones that we use in our initializer list above
+   }
+
+   EBM_INLINE static size_t GetPairSuperBinBins(const FloatEbmType * const optionalTempParams) {
+      const FloatEbmType cBins = GetTempParam(optionalTempParams, k_iTempParamPairSuperBinBins, FloatEbmType { 0 });
+      // super-bins of 1 bin are the exhaustive search, and 0, negative and NaN values all keep our default of the exhaustive search
+      if(!(FloatEbmType { 2 } <= cBins)) {
+         return 0;
+      }
+      if(static_cast<FloatEbmType>(std::numeric_limits<size_t>::max()) <= cBins) {
+         return std::numeric_limits<size_t>::max();
+      }
+      return static_cast<size_t>(cBins);
    }
 
    EBM_INLINE ~EbmBoostingState() {
@@ -138,7 +223,9 @@ public:
          m_cachedThreadResourcesUnion.regression.~CachedBoostingThreadResources();
       }
 
-      SamplingWithReplacement::FreeSamplingSets(m_cSamplingSets, m_apSamplingSets);
+      SamplingMethod::FreeSamplingSets(m_cSamplingSets, m_apSamplingSets);
+      free(m_aCountOccurrencesUnpackers);
+      free(m_aGradientMagnitudes);
 
       delete m_pTrainingSet;
       delete m_pValidationSet;
@@ -149,6 +236,8 @@ public:
 
       DeleteSegmentedTensors(m_cFeatureCombinations, m_apCurrentModel);
       DeleteSegmentedTensors(m_cFeatureCombinations, m_apBestModel);
+      delete[] m_aiChangedFeatureCombinations;
+      delete[] m_abChangedFeatureCombinations;
       SegmentedTensor::Free(m_pSmallChangeToModelOverwriteSingleSamplingSet);
       SegmentedTensor::Free(m_pSmallChangeToModelAccumulatedFromSamplingSets);
 
@@ -172,7 +261,10 @@ public:
       const size_t cValidationInstances, 
       const void * const aValidationTargets, 
       const IntEbmType * const aValidationBinnedData, 
-      const FloatEbmType * const aValidationPredictorScores
+      const FloatEbmType * const aValidationPredictorScores,
+      const size_t cInstancesBinnedData,
+      const size_t * const aiTrainingInstances,
+      const size_t * const aiValidationInstances
    );
 };
 
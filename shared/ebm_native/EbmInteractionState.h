@@ -17,6 +17,13 @@
 // dataset depends on features
 #include "DataSetByFeature.h"
 
+// the layout of optionalTempParams is documented in ebm_native.h
+constexpr size_t k_iTempParamInteractionCellsBoundedMin = 1;
+
+// GetTopInteractionPairs bounds a pair before scoring it only if it has more tensor cells than this.  A bound needs its own pass over the data, which 
+// costs about as much as binning the pair exactly, and only the work on the tensors of pairs with many bins makes exact scoring several times dearer
+constexpr size_t k_cInteractionCellsBoundedMinDefault = 128 * 128;
+
 class EbmInteractionState {
 public:
    const ptrdiff_t m_runtimeLearningTypeOrCountTargetClasses;
@@ -29,6 +36,8 @@ public:
    unsigned int m_cLogEnterMessages;
    unsigned int m_cLogExitMessages;
 
+   const size_t m_cInteractionCellsBoundedMin;
+
    EBM_INLINE EbmInteractionState(
       const ptrdiff_t runtimeLearningTypeOrCountTargetClasses, 
       const size_t cFeatures, 
@@ -40,10 +49,21 @@ public:
       , m_pDataSet(nullptr)
       , m_cLogEnterMessages(1000)
       , m_cLogExitMessages(1000) 
+      , m_cInteractionCellsBoundedMin(GetCellsBoundedMin(optionalTempParams))
    {
-      // optionalTempParams isn't used by default.  It's meant to provide an easy way for python or other higher
-      // level languages to pass EXPERIMENTAL temporary parameters easily to the C++ code.
-      UNUSED(optionalTempParams);
+   }
+
+   // optionalTempParams provides an easy way for python or other higher level languages to pass EXPERIMENTAL temporary parameters to the C++ code
+   EBM_INLINE static size_t GetCellsBoundedMin(const FloatEbmType * const optionalTempParams) {
+      const FloatEbmType cCells = GetTempParam(optionalTempParams, k_iTempParamInteractionCellsBoundedMin, FloatEbmType { 0 });
+      // 0, negative and NaN values all keep our default
+      if(!(FloatEbmType { 1 } <= cCells)) {
+         return k_cInteractionCellsBoundedMinDefault;
+      }
+      if(static_cast<FloatEbmType>(std::numeric_limits<size_t>::max()) <= cCells) {
+         return std::numeric_limits<size_t>::max();
+      }
+      return static_cast<size_t>(cCells);
    }
 
    EBM_INLINE ~EbmInteractionState() {
@@ -60,7 +80,9 @@ public:
       const size_t cInstances, 
       const void * const aTargets, 
       const IntEbmType * const aBinnedData, 
-      const FloatEbmType * const aPredictorScores
+      const FloatEbmType * const aPredictorScores,
+      const size_t cInstancesBinnedData,
+      const size_t * const aiInstancesBinnedData
    ) {
       LOG_0(TraceLevelInfo, "Entered InitializeInteraction");
 
@@ -134,7 +156,9 @@ public:
             aTargets, 
             aPredictorScores, 
             m_runtimeLearningTypeOrCountTargetClasses,
-            aTempFloatVector
+            aTempFloatVector,
+            nullptr == aiInstancesBinnedData ? cInstances : cInstancesBinnedData,
+            aiInstancesBinnedData
          );
          delete[] aTempFloatVector;
          if(nullptr == m_pDataSet || m_pDataSet->IsError()) {
@@ -363,6 +363,18 @@ constexpr EBM_INLINE bool IsAddError(const size_t num1, const size_t num2) {
    return num1 + num2 < num1;
 }
 
+// reads an EXPERIMENTAL parameter from the optionalTempParams that our caller gave us, or our default if they didn't include it
+EBM_INLINE FloatEbmType GetTempParam(const FloatEbmType * const optionalTempParams, const size_t iParam, const FloatEbmType defaultValue) {
+   if(nullptr == optionalTempParams) {
+      return defaultValue;
+   }
+   // optionalTempParams[0] is the count of parameters that follow.  A NaN or negative count fails this check, so we use our default
+   if(!(static_cast<FloatEbmType>(iParam) <= optionalTempParams[0])) {
+      return defaultValue;
+   }
+   return optionalTempParams[iParam];
+}
+
 // TODO: use this a lot more.  std::nothrow on new apparently doesn't always work, so we should probably catch the allocation exceptions instead or use this
 EBM_INLINE void * SmartMalloc(size_t cItems, size_t cBytesPerItem) {
    if(IsMultiplyError(cItems, cBytesPerItem)) {
@@ -420,7 +420,8 @@ public:
 #ifdef LEGACY_COMPATIBILITY
       const FloatEbmType ret = LIKELY(FloatEbmType { 0 } != cInstances) ? sumResidualError / cInstances * sumResidualError : FloatEbmType { 0 };
 #else // LEGACY_COMPATIBILITY
-      EBM_ASSERT(FloatEbmType { 1 } <= cInstances); // we shouldn't be making splits with children with less than 1 instance
+      // cInstances is the sum of our instance weights, which can be fractional, but we shouldn't be making splits with children with no weight
+      EBM_ASSERT(FloatEbmType { 0 } < cInstances);
       const FloatEbmType ret = sumResidualError / cInstances * sumResidualError;
 #endif // LEGACY_COMPATIBILITY
 
@@ -536,7 +537,8 @@ public:
       // Then, on the next feature we boost on, we'll calculate an model update for some instances (inside this function) as 
       // +-infinity/cInstances, which will be +-infinity (of the same sign).  Then, when we go to find our new instance residuals, we'll
       // subtract +infinity-(+infinity) or -infinity-(-infinity), which will result in NaN.  After that, everything melts down to NaN.
-      EBM_ASSERT(FloatEbmType { 1 } <= cInstances); // we shouldn't be making splits with children with less than 1 instance
+      // cInstances is the sum of our instance weights, which can be fractional, but we shouldn't be making splits with children with no weight
+      EBM_ASSERT(FloatEbmType { 0 } < cInstances);
       return sumResidualError / cInstances;
 #endif // LEGACY_COMPATIBILITY
       
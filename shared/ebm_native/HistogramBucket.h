@@ -19,7 +19,7 @@
 #include "FeatureCombination.h"
 #include "DataSetByFeatureCombination.h"
 #include "DataSetByFeature.h"
-#include "SamplingWithReplacement.h"
+#include "SamplingMethod.h"
 
 // we don't need to handle multi-dimensional inputs with more than 64 bits total
 // the rational is that we need to bin this data, and our binning memory will be N1*N1*...*N(D-1)*N(D)
@@ -91,11 +91,9 @@ template<bool bClassification>
 struct HistogramBucket final : public HistogramBucketBase {
 public:
 
-   size_t m_cInstancesInBucket;
-
-#ifdef LEGACY_COMPATIBILITY
-   ActiveDataType m_bucketValue;
-#endif // LEGACY_COMPATIBILITY
+   // the sum of the weights of the instances in this bucket, where each occurrence in our sampling set adds the instance's weight again.  Without
+   // weights this is just the instance count, which our floating point type holds exactly.  A weight of k is equivalent to k duplicate instances
+   FloatEbmType m_weightInBucket;
 
    // use the "struct hack" since Flexible array member method is not available in C++
    // aHistogramBucketVectorEntry must be the last item in this struct
@@ -105,14 +103,14 @@ public:
    HistogramBucketVectorEntry<bClassification> m_aHistogramBucketVectorEntry[1];
 
    EBM_INLINE void Add(const HistogramBucket<bClassification> & other, const size_t cVectorLength) {
-      m_cInstancesInBucket += other.m_cInstancesInBucket;
+      m_weightInBucket += other.m_weightInBucket;
       for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
          ARRAY_TO_POINTER(m_aHistogramBucketVectorEntry)[iVector].Add(ARRAY_TO_POINTER_CONST(other.m_aHistogramBucketVectorEntry)[iVector]);
       }
    }
 
    EBM_INLINE void Subtract(const HistogramBucket<bClassification> & other, const size_t cVectorLength) {
-      m_cInstancesInBucket -= other.m_cInstancesInBucket;
+      m_weightInBucket -= other.m_weightInBucket;
       for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
          ARRAY_TO_POINTER(m_aHistogramBucketVectorEntry)[iVector].Subtract(ARRAY_TO_POINTER_CONST(other.m_aHistogramBucketVectorEntry)[iVector]);
       }
@@ -133,7 +131,7 @@ public:
    EBM_INLINE void AssertZero(const size_t cVectorLength) const {
       UNUSED(cVectorLength);
 #ifndef NDEBUG
-      EBM_ASSERT(0 == m_cInstancesInBucket);
+      EBM_ASSERT(0 == m_weightInBucket);
       for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
          ARRAY_TO_POINTER_CONST(m_aHistogramBucketVectorEntry)[iVector].AssertZero();
       }
@@ -143,6 +141,232 @@ public:
 static_assert(std::is_standard_layout<HistogramBucket<false>>::value && std::is_standard_layout<HistogramBucket<true>>::value, 
    "HistogramBucket uses the struct hack, so it needs to be standard layout class otherwise we can't depend on the layout!");
 
+// when our sampling method gathers the residuals and bin indexes of its listed instances into contiguous buffers (see SamplingMethod.h), we read
+// those buffers sequentially, which does work proportional to the number of included instances and avoids jumping around in our dataset.
+// pFeatureCombination is nullptr when we're building the single zero dimensional bucket
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
+void BinDataSetTrainingGathered(
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets,
+   const FeatureCombination * const pFeatureCombination,
+   const SamplingMethod * const pTrainingSet,
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+   LOG_0(TraceLevelVerbose, "Entered BinDataSetTrainingGathered");
+
+   EBM_ASSERT(nullptr != pTrainingSet->m_aiInstancesListed);
+   EBM_ASSERT(nullptr != pTrainingSet->m_aResidualErrorsGathered);
+   EBM_ASSERT(1 <= pTrainingSet->m_cInstancesListed);
+
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+
+   // with zero dimensions everything goes into our first bucket, so we don't read any input data
+   size_t cItemsPerBitPackedDataUnit = 1;
+   size_t cBitsPerItemMax = 0;
+   size_t maskBits = 0;
+   const StorageDataType * pInputData = nullptr;
+   if(nullptr != pFeatureCombination) {
+      cItemsPerBitPackedDataUnit = pFeatureCombination->m_cItemsPerBitPackedDataUnit;
+      EBM_ASSERT(1 <= cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(cItemsPerBitPackedDataUnit <= k_cBitsForStorageType);
+      cBitsPerItemMax = GetCountBits(cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(1 <= cBitsPerItemMax);
+      EBM_ASSERT(cBitsPerItemMax <= k_cBitsForStorageType);
+      maskBits = std::numeric_limits<size_t>::max() >> (k_cBitsForStorageType - cBitsPerItemMax);
+      EBM_ASSERT(nullptr != pTrainingSet->m_aaInputDataGathered);
+      pInputData = pTrainingSet->m_aaInputDataGathered[pFeatureCombination->m_iInputData];
+      EBM_ASSERT(nullptr != pInputData);
+   }
+
+   // nullptr if all our instances have a weight of 1.  Checking these is a perfectly predictable branch
+   const FloatEbmType * const aWeights = pTrainingSet->m_pOriginDataSet->GetWeights();
+   const FloatEbmType * const aInstanceMultipliers = pTrainingSet->m_aInstanceMultipliers;
+   const FloatEbmType * pResidualError = pTrainingSet->m_aResidualErrorsGathered;
+   const FloatEbmType * pNewtonRaphsonStep = bClassification ? pTrainingSet->m_aNewtonRaphsonStepsGathered : nullptr;
+
+   const size_t * const aiInstancesListed = pTrainingSet->m_aiInstancesListed;
+   const size_t cInstancesListed = pTrainingSet->m_cInstancesListed;
+   size_t iTensorBinCombined = 0;
+   size_t cItemsRemaining = 0;
+   for(size_t iListed = 0; iListed < cInstancesListed; ++iListed) {
+      size_t iTensorBin = 0;
+      if(nullptr != pInputData) {
+         if(0 == cItemsRemaining) {
+            // we store the already multiplied dimensional value in our packed input data
+            iTensorBinCombined = static_cast<size_t>(*pInputData);
+            ++pInputData;
+            cItemsRemaining = cItemsPerBitPackedDataUnit;
+         }
+         iTensorBin = maskBits & iTensorBinCombined;
+         iTensorBinCombined >>= cBitsPerItemMax;
+         --cItemsRemaining;
+      }
+      HistogramBucket<bClassification> * const pHistogramBucketEntry = GetHistogramBucketByIndex(
+         cBytesPerHistogramBucket,
+         aHistogramBuckets,
+         iTensorBin
+      );
+      ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucketEntry, aHistogramBucketsEndDebug);
+
+      FloatEbmType weight = nullptr == aInstanceMultipliers ? FloatEbmType { 1 } : aInstanceMultipliers[iListed];
+      if(nullptr != aWeights) {
+         weight *= aWeights[aiInstancesListed[iListed]];
+      }
+      pHistogramBucketEntry->m_weightInBucket += weight;
+
+      HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntry = ARRAY_TO_POINTER(
+         pHistogramBucketEntry->m_aHistogramBucketVectorEntry
+      );
+      size_t iVector = 0;
+      do {
+         const FloatEbmType residualError = *pResidualError;
+         pHistogramBucketVectorEntry[iVector].m_sumResidualError += weight * residualError;
+         if(bClassification) {
+            FloatEbmType denominator;
+            if(nullptr != pNewtonRaphsonStep) {
+               denominator = *pNewtonRaphsonStep;
+               ++pNewtonRaphsonStep;
+            } else {
+               denominator = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+            }
+            pHistogramBucketVectorEntry[iVector].SetSumDenominator(
+               pHistogramBucketVectorEntry[iVector].GetSumDenominator() + weight * denominator
+            );
+         }
+         ++pResidualError;
+         ++iVector;
+      } while(iVector < cVectorLength);
+   }
+
+   LOG_0(TraceLevelVerbose, "Exited BinDataSetTrainingGathered");
+}
+
+// our sampling method can list just the instances that it includes (see SamplingMethod.h), in which case we visit only those instances by index
+// instead of streaming through every instance.  This is a win when the sampling method includes a small fraction of the instances, like
+// SamplingGradientOneSide does.  pFeatureCombination is nullptr when we're building the single zero dimensional bucket
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
+void BinDataSetTrainingListedInstances(
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets,
+   const FeatureCombination * const pFeatureCombination,
+   const SamplingMethod * const pTrainingSet,
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+   LOG_0(TraceLevelVerbose, "Entered BinDataSetTrainingListedInstances");
+
+   EBM_ASSERT(nullptr != pTrainingSet->m_aiInstancesListed);
+
+   if(nullptr != pTrainingSet->m_aResidualErrorsGathered) {
+      BinDataSetTrainingGathered<compilerLearningTypeOrCountTargetClasses>(
+         aHistogramBuckets,
+         pFeatureCombination,
+         pTrainingSet,
+         runtimeLearningTypeOrCountTargetClasses
+#ifndef NDEBUG
+         , aHistogramBucketsEndDebug
+#endif // NDEBUG
+      );
+      LOG_0(TraceLevelVerbose, "Exited BinDataSetTrainingListedInstances");
+      return;
+   }
+
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+
+   // with zero dimensions everything goes into our first bucket, which we get by using 1 item per unit and masking off all the bits
+   size_t cItemsPerBitPackedDataUnit = 1;
+   size_t cBitsPerItemMax = 0;
+   size_t maskBits = 0;
+   const StorageDataType * aInputData = nullptr;
+   if(nullptr != pFeatureCombination) {
+      cItemsPerBitPackedDataUnit = pFeatureCombination->m_cItemsPerBitPackedDataUnit;
+      EBM_ASSERT(1 <= cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(cItemsPerBitPackedDataUnit <= k_cBitsForStorageType);
+      cBitsPerItemMax = GetCountBits(cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(1 <= cBitsPerItemMax);
+      EBM_ASSERT(cBitsPerItemMax <= k_cBitsForStorageType);
+      maskBits = std::numeric_limits<size_t>::max() >> (k_cBitsForStorageType - cBitsPerItemMax);
+      aInputData = pTrainingSet->m_pOriginDataSet->GetInputDataPointer(pFeatureCombination);
+   }
+
+   // nullptr if all our instances have a weight of 1.  Checking these is a perfectly predictable branch
+   const FloatEbmType * const aWeights = pTrainingSet->m_pOriginDataSet->GetWeights();
+   const FloatEbmType * const aInstanceMultipliers = pTrainingSet->m_aInstanceMultipliers;
+   const FloatEbmType * const aResidualErrors = pTrainingSet->m_pOriginDataSet->GetResidualPointer();
+   const FloatEbmType * const aNewtonRaphsonSteps = bClassification && pTrainingSet->m_pOriginDataSet->IsNewtonRaphsonStepsStored() ?
+      pTrainingSet->m_pOriginDataSet->GetNewtonRaphsonStepPointer() : nullptr;
+
+   const size_t * const aiInstancesListed = pTrainingSet->m_aiInstancesListed;
+   const size_t cInstancesListed = pTrainingSet->m_cInstancesListed;
+   for(size_t iListed = 0; iListed < cInstancesListed; ++iListed) {
+      const size_t iInstance = aiInstancesListed[iListed];
+      EBM_ASSERT(iInstance < pTrainingSet->m_pOriginDataSet->GetCountInstances());
+
+      size_t iTensorBin = 0;
+      if(nullptr != aInputData) {
+         // we store the already multiplied dimensional value in our packed input data
+         const size_t iTensorBinCombined = static_cast<size_t>(aInputData[iInstance / cItemsPerBitPackedDataUnit]);
+         iTensorBin = maskBits & (iTensorBinCombined >> (iInstance % cItemsPerBitPackedDataUnit * cBitsPerItemMax));
+      }
+      HistogramBucket<bClassification> * const pHistogramBucketEntry = GetHistogramBucketByIndex(
+         cBytesPerHistogramBucket,
+         aHistogramBuckets,
+         iTensorBin
+      );
+      ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucketEntry, aHistogramBucketsEndDebug);
+
+      FloatEbmType weight = nullptr == aInstanceMultipliers ? FloatEbmType { 1 } : aInstanceMultipliers[iListed];
+      if(nullptr != aWeights) {
+         weight *= aWeights[iInstance];
+      }
+      pHistogramBucketEntry->m_weightInBucket += weight;
+
+      HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntry = ARRAY_TO_POINTER(
+         pHistogramBucketEntry->m_aHistogramBucketVectorEntry
+      );
+      // this can't overflow since we're accessing existing memory
+      const size_t iResidualFirst = iInstance * cVectorLength;
+      size_t iVector = 0;
+      do {
+         const FloatEbmType residualError = aResidualErrors[iResidualFirst + iVector];
+         pHistogramBucketVectorEntry[iVector].m_sumResidualError += weight * residualError;
+         if(bClassification) {
+            FloatEbmType denominator;
+            if(nullptr != aNewtonRaphsonSteps) {
+               denominator = aNewtonRaphsonSteps[iResidualFirst + iVector];
+            } else {
+               denominator = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+            }
+            pHistogramBucketVectorEntry[iVector].SetSumDenominator(
+               pHistogramBucketVectorEntry[iVector].GetSumDenominator() + weight * denominator
+            );
+         }
+         ++iVector;
+      } while(iVector < cVectorLength);
+   }
+
+   LOG_0(TraceLevelVerbose, "Exited BinDataSetTrainingListedInstances");
+}
+
 template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
 void BinDataSetTrainingZeroDimensions(
    HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const pHistogramBucketEntry, 
@@ -160,12 +384,31 @@ void BinDataSetTrainingZeroDimensions(
    const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
    EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
 
+   if(nullptr != pTrainingSet->m_aiInstancesListed) {
+      BinDataSetTrainingListedInstances<compilerLearningTypeOrCountTargetClasses>(
+         pHistogramBucketEntry,
+         nullptr,
+         pTrainingSet,
+         runtimeLearningTypeOrCountTargetClasses
+#ifndef NDEBUG
+         , reinterpret_cast<const unsigned char *>(pHistogramBucketEntry) + GetHistogramBucketSize<bClassification>(cVectorLength)
+#endif // NDEBUG
+      );
+      LOG_0(TraceLevelVerbose, "Exited BinDataSetTrainingZeroDimensions");
+      return;
+   }
+
    const size_t cInstances = pTrainingSet->m_pOriginDataSet->GetCountInstances();
    EBM_ASSERT(0 < cInstances);
 
-   const SamplingWithReplacement * const pSamplingWithReplacement = static_cast<const SamplingWithReplacement *>(pTrainingSet);
-   const size_t * pCountOccurrences = pSamplingWithReplacement->m_aCountOccurrences;
-   const FloatEbmType * pResidualError = pSamplingWithReplacement->m_pOriginDataSet->GetResidualPointer();
+   // copy our unpacker onto the stack so that the compiler knows our histogram writes can't change it
+   const CountOccurrencesUnpacker countOccurrencesUnpacker = pTrainingSet->GetCountOccurrencesUnpacker();
+   size_t iInstance = 0;
+   // nullptr if all our instances have a weight of 1.  Checking this is a perfectly predictable branch
+   const FloatEbmType * const aWeights = pTrainingSet->m_pOriginDataSet->GetWeights();
+   const FloatEbmType * pResidualError = pTrainingSet->m_pOriginDataSet->GetResidualPointer();
+   const FloatEbmType * pNewtonRaphsonStep = bClassification && pTrainingSet->m_pOriginDataSet->IsNewtonRaphsonStepsStored() ?
+      pTrainingSet->m_pOriginDataSet->GetNewtonRaphsonStepPointer() : nullptr;
    // this shouldn't overflow since we're accessing existing memory
    const FloatEbmType * const pResidualErrorEnd = pResidualError + cVectorLength * cInstances;
 
@@ -181,13 +424,16 @@ void BinDataSetTrainingZeroDimensions(
       //   pressure related, and even then we could store the count for a single bit aleviating the memory pressure greatly, if we use the right 
       //   sampling method 
 
-      // TODO : try using a sampling method with non-repeating instances, and put the count into a bit.  Then unwind that loop either at the byte level 
-      //   (8 times) or the uint64_t level.  This can be done without branching and doesn't require random number generators
+      // our counts are bit packed (1 bit for SamplingWithoutReplacement, 1 byte for SamplingWithReplacement), and we unpack them without branching
+      // TODO : unwind this loop at the size_t unit level so that we load each packed unit of counts only once
 
-      const size_t cOccurences = *pCountOccurrences;
-      ++pCountOccurrences;
-      pHistogramBucketEntry->m_cInstancesInBucket += cOccurences;
-      const FloatEbmType cFloatOccurences = static_cast<FloatEbmType>(cOccurences);
+      const size_t cOccurences = countOccurrencesUnpacker.Get(iInstance);
+      FloatEbmType weight = static_cast<FloatEbmType>(cOccurences);
+      if(nullptr != aWeights) {
+         weight *= aWeights[iInstance];
+      }
+      ++iInstance;
+      pHistogramBucketEntry->m_weightInBucket += weight;
 
 #ifndef NDEBUG
 #ifdef EXPAND_BINARY_LOGITS
@@ -206,15 +452,18 @@ void BinDataSetTrainingZeroDimensions(
 #ifndef NDEBUG
          residualTotalDebug += residualError;
 #endif // NDEBUG
-         pHistogramBucketVectorEntry[iVector].m_sumResidualError += cFloatOccurences * residualError;
+         pHistogramBucketVectorEntry[iVector].m_sumResidualError += weight * residualError;
          if(bClassification) {
-            // TODO : this code gets executed for each SamplingWithReplacement set.  I could probably execute it once and then all the 
-            //   SamplingWithReplacement sets would have this value, but I would need to store the computation in a new memory place, and it might make 
-            //   more sense to calculate this values in the CPU rather than put more pressure on memory.  I think controlling this should be done in a 
-            //   MACRO and we should use a class to hold the residualError and this computation from that value and then comment out the computation if 
-            //   not necssary and access it through an accessor so that we can make the change entirely via macro
-            const FloatEbmType denominator = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
-            pHistogramBucketVectorEntry[iVector].SetSumDenominator(pHistogramBucketVectorEntry[iVector].GetSumDenominator() + cFloatOccurences * denominator);
+            // if we store the Newton-Raphson steps we read the value that our apply-update kernel computed once for all of our inner bags, 
+            // otherwise we recompute it here for each inner bag, which trades CPU for less memory pressure.  See DataSetByFeatureCombination.h
+            FloatEbmType denominator;
+            if(nullptr != pNewtonRaphsonStep) {
+               denominator = *pNewtonRaphsonStep;
+               ++pNewtonRaphsonStep;
+            } else {
+               denominator = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+            }
+            pHistogramBucketVectorEntry[iVector].SetSumDenominator(pHistogramBucketVectorEntry[iVector].GetSumDenominator() + weight * denominator);
          }
          ++pResidualError;
          ++iVector;
@@ -252,6 +501,20 @@ void BinDataSetTraining(HistogramBucket<IsClassification(
    EBM_ASSERT(cCompilerDimensions == pFeatureCombination->m_cFeatures);
    static_assert(1 <= cCompilerDimensions, "cCompilerDimensions must be 1 or greater");
 
+   if(nullptr != pTrainingSet->m_aiInstancesListed) {
+      BinDataSetTrainingListedInstances<compilerLearningTypeOrCountTargetClasses>(
+         aHistogramBuckets,
+         pFeatureCombination,
+         pTrainingSet,
+         runtimeLearningTypeOrCountTargetClasses
+#ifndef NDEBUG
+         , aHistogramBucketsEndDebug
+#endif // NDEBUG
+      );
+      LOG_0(TraceLevelVerbose, "Exited BinDataSetTraining");
+      return;
+   }
+
    const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
       compilerLearningTypeOrCountTargetClasses,
       runtimeLearningTypeOrCountTargetClasses
@@ -270,10 +533,15 @@ void BinDataSetTraining(HistogramBucket<IsClassification(
    const size_t cInstances = pTrainingSet->m_pOriginDataSet->GetCountInstances();
    EBM_ASSERT(0 < cInstances);
 
-   const SamplingWithReplacement * const pSamplingWithReplacement = static_cast<const SamplingWithReplacement *>(pTrainingSet);
-   const size_t * pCountOccurrences = pSamplingWithReplacement->m_aCountOccurrences;
-   const StorageDataType * pInputData = pSamplingWithReplacement->m_pOriginDataSet->GetInputDataPointer(pFeatureCombination);
-   const FloatEbmType * pResidualError = pSamplingWithReplacement->m_pOriginDataSet->GetResidualPointer();
+   // copy our unpacker onto the stack so that the compiler knows our histogram writes can't change it
+   const CountOccurrencesUnpacker countOccurrencesUnpacker = pTrainingSet->GetCountOccurrencesUnpacker();
+   size_t iInstance = 0;
+   // nullptr if all our instances have a weight of 1.  Checking this is a perfectly predictable branch
+   const FloatEbmType * const aWeights = pTrainingSet->m_pOriginDataSet->GetWeights();
+   const StorageDataType * pInputData = pTrainingSet->m_pOriginDataSet->GetInputDataPointer(pFeatureCombination);
+   const FloatEbmType * pResidualError = pTrainingSet->m_pOriginDataSet->GetResidualPointer();
+   const FloatEbmType * pNewtonRaphsonStep = bClassification && pTrainingSet->m_pOriginDataSet->IsNewtonRaphsonStepsStored() ?
+      pTrainingSet->m_pOriginDataSet->GetNewtonRaphsonStepPointer() : nullptr;
 
    // this shouldn't overflow since we're accessing existing memory
    const FloatEbmType * const pResidualErrorTrueEnd = pResidualError + cVectorLength * cInstances;
@@ -295,8 +563,8 @@ void BinDataSetTraining(HistogramBucket<IsClassification(
       // stored in memory if shouldn't increase the time spent fetching it by 2 times, unless our bottleneck when threading is overwhelmingly memory pressure
       // related, and even then we could store the count for a single bit aleviating the memory pressure greatly, if we use the right sampling method 
 
-      // TODO : try using a sampling method with non-repeating instances, and put the count into a bit.  Then unwind that loop either at the byte level 
-      //   (8 times) or the uint64_t level.  This can be done without branching and doesn't require random number generators
+      // our counts are bit packed (1 bit for SamplingWithoutReplacement, 1 byte for SamplingWithReplacement), and we unpack them without branching
+      // TODO : unwind this loop at the size_t unit level so that we load each packed unit of counts only once
 
       cItemsRemaining = cItemsPerBitPackedDataUnit;
       // TODO : jumping back into this loop and changing cItemsRemaining to a dynamic value that isn't compile time determinable
@@ -315,10 +583,13 @@ void BinDataSetTraining(HistogramBucket<IsClassification(
          );
 
          ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucketEntry, aHistogramBucketsEndDebug);
-         const size_t cOccurences = *pCountOccurrences;
-         ++pCountOccurrences;
-         pHistogramBucketEntry->m_cInstancesInBucket += cOccurences;
-         const FloatEbmType cFloatOccurences = static_cast<FloatEbmType>(cOccurences);
+         const size_t cOccurences = countOccurrencesUnpacker.Get(iInstance);
+         FloatEbmType weight = static_cast<FloatEbmType>(cOccurences);
+         if(nullptr != aWeights) {
+            weight *= aWeights[iInstance];
+         }
+         ++iInstance;
+         pHistogramBucketEntry->m_weightInBucket += weight;
          HistogramBucketVectorEntry<bClassification> * pHistogramBucketVectorEntry = ARRAY_TO_POINTER(
             pHistogramBucketEntry->m_aHistogramBucketVectorEntry
          );
@@ -343,16 +614,19 @@ void BinDataSetTraining(HistogramBucket<IsClassification(
 #ifndef NDEBUG
             residualTotalDebug += residualError;
 #endif // NDEBUG
-            pHistogramBucketVectorEntry[iVector].m_sumResidualError += cFloatOccurences * residualError;
+            pHistogramBucketVectorEntry[iVector].m_sumResidualError += weight * residualError;
             if(bClassification) {
-               // TODO : this code gets executed for each SamplingWithReplacement set.  I could probably execute it once and then all the
-               //   SamplingWithReplacement sets would have this value, but I would need to store the computation in a new memory place, and it might 
-               //   make more sense to calculate this values in the CPU rather than put more pressure on memory.  I think controlling this should be 
-               //   done in a MACRO and we should use a class to hold the residualError and this computation from that value and then comment out the 
-               //   computation if not necssary and access it through an accessor so that we can make the change entirely via macro
-               const FloatEbmType denominator = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+               // if we store the Newton-Raphson steps we read the value that our apply-update kernel computed once for all of our inner bags, 
+               // otherwise we recompute it here for each inner bag, which trades CPU for less memory pressure.  See DataSetByFeatureCombination.h
+               FloatEbmType denominator;
+               if(nullptr != pNewtonRaphsonStep) {
+                  denominator = *pNewtonRaphsonStep;
+                  ++pNewtonRaphsonStep;
+               } else {
+                  denominator = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+               }
                pHistogramBucketVectorEntry[iVector].SetSumDenominator(
-                  pHistogramBucketVectorEntry[iVector].GetSumDenominator() + cFloatOccurences * denominator
+                  pHistogramBucketVectorEntry[iVector].GetSumDenominator() + weight * denominator
                );
             }
             ++pResidualError;
@@ -466,6 +740,126 @@ public:
    }
 };
 
+// bins all of our inner bags in a single pass over our dataset.  Each instance's bin index, residuals and Newton-Raphson steps are read once and then 
+// scattered into the histograms of every inner bag, weighted by the number of times that each bag selected the instance.  aHistogramBuckets holds 
+// cSamplingSets consecutive histograms (bag major) of cBytesPerSamplingSet bytes each, so our memory traffic over the dataset doesn't grow with the 
+// number of inner bags.  This only handles sampling sets that neither list nor gather their instances, which our caller checks.  
+// aTempFloatVector needs to hold cVectorLength items
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
+void BinDataSetTrainingAllSamplingSets(
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets, 
+   const size_t cBytesPerSamplingSet,
+   const FeatureCombination * const pFeatureCombination, 
+   const DataSetByFeatureCombination * const pDataSet, 
+   const size_t cSamplingSets,
+   const CountOccurrencesUnpacker * const aCountOccurrencesUnpackers,
+   FloatEbmType * const aTempFloatVector,
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+   LOG_0(TraceLevelVerbose, "Entered BinDataSetTrainingAllSamplingSets");
+
+   EBM_ASSERT(1 <= cSamplingSets);
+   EBM_ASSERT(nullptr != aCountOccurrencesUnpackers);
+
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+
+   // zero dimensional feature combinations have a single bucket and no input data
+   const StorageDataType * pInputData = nullptr;
+   size_t cItemsPerBitPackedDataUnit = 1;
+   size_t cBitsPerItemMax = 0;
+   size_t maskBits = 0;
+   if(0 != pFeatureCombination->m_cFeatures) {
+      pInputData = pDataSet->GetInputDataPointer(pFeatureCombination);
+      cItemsPerBitPackedDataUnit = pFeatureCombination->m_cItemsPerBitPackedDataUnit;
+      EBM_ASSERT(1 <= cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(cItemsPerBitPackedDataUnit <= k_cBitsForStorageType);
+      cBitsPerItemMax = GetCountBits(cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(1 <= cBitsPerItemMax);
+      EBM_ASSERT(cBitsPerItemMax <= k_cBitsForStorageType);
+      maskBits = std::numeric_limits<size_t>::max() >> (k_cBitsForStorageType - cBitsPerItemMax);
+   }
+
+   const size_t cInstances = pDataSet->GetCountInstances();
+   EBM_ASSERT(0 < cInstances);
+
+   // nullptr if all our instances have a weight of 1.  Checking this is a perfectly predictable branch
+   const FloatEbmType * const aWeights = pDataSet->GetWeights();
+   const FloatEbmType * pResidualError = pDataSet->GetResidualPointer();
+   const FloatEbmType * pNewtonRaphsonStep = bClassification && pDataSet->IsNewtonRaphsonStepsStored() ? pDataSet->GetNewtonRaphsonStepPointer() : nullptr;
+
+   unsigned char * const pHistogramBucketsBytes = reinterpret_cast<unsigned char *>(aHistogramBuckets);
+   size_t iTensorBinCombined = 0;
+   size_t cItemsRemaining = 0;
+   for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
+      size_t iTensorBin = 0;
+      if(nullptr != pInputData) {
+         if(0 == cItemsRemaining) {
+            // we store the already multiplied dimensional value in *pInputData
+            iTensorBinCombined = static_cast<size_t>(*pInputData);
+            ++pInputData;
+            cItemsRemaining = cItemsPerBitPackedDataUnit;
+         }
+         iTensorBin = maskBits & iTensorBinCombined;
+         iTensorBinCombined >>= cBitsPerItemMax;
+         --cItemsRemaining;
+      }
+
+      if(bClassification) {
+         // every inner bag uses the same Newton-Raphson steps for this instance, so we only fetch or compute them once
+         for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+            aTempFloatVector[iVector] = nullptr != pNewtonRaphsonStep ? pNewtonRaphsonStep[iVector] : 
+               EbmStatistics::ComputeNewtonRaphsonStep(pResidualError[iVector]);
+         }
+         if(nullptr != pNewtonRaphsonStep) {
+            pNewtonRaphsonStep += cVectorLength;
+         }
+      }
+
+      unsigned char * pHistogramBucketBytes = pHistogramBucketsBytes + iTensorBin * cBytesPerHistogramBucket;
+      for(size_t iSamplingSet = 0; iSamplingSet < cSamplingSets; ++iSamplingSet) {
+         HistogramBucket<bClassification> * const pHistogramBucketEntry = reinterpret_cast<HistogramBucket<bClassification> *>(pHistogramBucketBytes);
+         ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucketEntry, aHistogramBucketsEndDebug);
+
+         // adding the zero weighted contributions of the instances that a bag didn't select is faster than branching on them
+         const size_t cOccurences = aCountOccurrencesUnpackers[iSamplingSet].Get(iInstance);
+         FloatEbmType weight = static_cast<FloatEbmType>(cOccurences);
+         if(nullptr != aWeights) {
+            weight *= aWeights[iInstance];
+         }
+         pHistogramBucketEntry->m_weightInBucket += weight;
+         HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntry = ARRAY_TO_POINTER(
+            pHistogramBucketEntry->m_aHistogramBucketVectorEntry
+         );
+         size_t iVector = 0;
+         do {
+            pHistogramBucketVectorEntry[iVector].m_sumResidualError += weight * pResidualError[iVector];
+            if(bClassification) {
+               pHistogramBucketVectorEntry[iVector].SetSumDenominator(
+                  pHistogramBucketVectorEntry[iVector].GetSumDenominator() + weight * aTempFloatVector[iVector]
+               );
+            }
+            ++iVector;
+         } while(iVector < cVectorLength);
+
+         pHistogramBucketBytes += cBytesPerSamplingSet;
+      }
+      pResidualError += cVectorLength;
+   }
+
+   LOG_0(TraceLevelVerbose, "Exited BinDataSetTrainingAllSamplingSets");
+}
+
 // TODO: make the number of dimensions (pFeatureCombination->m_cFeatures) a template parameter so that we don't have to have the inner loop that is 
 //   very bad for performance.  Since the data will be stored contiguously and have the same length in the future, we can just loop based on the 
 //   number of dimensions, so we might as well have a couple of different values
@@ -531,7 +925,7 @@ void BinDataSetInteraction(HistogramBucket<IsClassification(
       HistogramBucket<bClassification> * pHistogramBucketEntry =
          GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBuckets, iBucket);
       ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucketEntry, aHistogramBucketsEndDebug);
-      pHistogramBucketEntry->m_cInstancesInBucket += 1;
+      pHistogramBucketEntry->m_weightInBucket += FloatEbmType { 1 };
       for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
          const FloatEbmType residualError = *pResidualError;
          // residualError could be NaN
@@ -571,12 +965,112 @@ void BinDataSetInteraction(HistogramBucket<IsClassification(
    LOG_0(TraceLevelVerbose, "Exited BinDataSetInteraction");
 }
 
+// the most pair histograms that BinDataSetInteractionAnchored fills in one pass over the data.  Each partner is another column that we stream 
+// through, and past a handful of streams the hardware prefetchers stop keeping up
+constexpr size_t k_cInteractionPartnersPerPassMax = 8;
+
+// fills the histograms of the pairs (anchor, partner) for a block of partners in a single pass over the data.  The anchor's bins and the residuals 
+// are read once per instance instead of once per pair.  Each histogram is laid out exactly as BinDataSetInteraction would lay it out for the
+// FeatureCombination { anchor, partner } and the instances are summed in the same order, so the resulting histograms are identical
 template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
-size_t CompressHistogramBuckets(
+void BinDataSetInteractionAnchored(
+   const size_t cPartners,
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const * const apHistogramBucketsPartner,
+   const Feature * const pFeatureAnchor,
+   const Feature * const * const apFeaturesPartner,
+   const DataSetByFeature * const pDataSet, 
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+   LOG_0(TraceLevelVerbose, "Entered BinDataSetInteractionAnchored");
+
+   EBM_ASSERT(1 <= cPartners);
+   EBM_ASSERT(cPartners <= k_cInteractionPartnersPerPassMax);
+
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+
+   const size_t cBinsAnchor = pFeatureAnchor->m_cBins;
+   const StorageDataType * const aInputDataAnchor = pDataSet->GetInputDataPointer(pFeatureAnchor);
+   const StorageDataType * apInputDataPartner[k_cInteractionPartnersPerPassMax];
+   for(size_t iPartner = 0; iPartner < cPartners; ++iPartner) {
+      apInputDataPartner[iPartner] = pDataSet->GetInputDataPointer(apFeaturesPartner[iPartner]);
+   }
+   HistogramBucket<bClassification> * apHistogramBucketEntry[k_cInteractionPartnersPerPassMax];
+
+   const FloatEbmType * pResidualError = pDataSet->GetResidualPointer();
+   const FloatEbmType * const pResidualErrorEnd = pResidualError + cVectorLength * pDataSet->GetCountInstances();
+
+   for(size_t iInstance = 0; pResidualErrorEnd != pResidualError; ++iInstance) {
+      const StorageDataType iBinAnchorOriginal = aInputDataAnchor[iInstance];
+      EBM_ASSERT((IsNumberConvertable<size_t, StorageDataType>(iBinAnchorOriginal)));
+      const size_t iBinAnchor = static_cast<size_t>(iBinAnchorOriginal);
+      EBM_ASSERT(iBinAnchor < cBinsAnchor);
+
+      for(size_t iPartner = 0; iPartner < cPartners; ++iPartner) {
+         const StorageDataType iBinPartnerOriginal = apInputDataPartner[iPartner][iInstance];
+         EBM_ASSERT((IsNumberConvertable<size_t, StorageDataType>(iBinPartnerOriginal)));
+         const size_t iBinPartner = static_cast<size_t>(iBinPartnerOriginal);
+         EBM_ASSERT(iBinPartner < apFeaturesPartner[iPartner]->m_cBins);
+         HistogramBucket<bClassification> * const pHistogramBucketEntry = GetHistogramBucketByIndex<bClassification>(
+            cBytesPerHistogramBucket, 
+            apHistogramBucketsPartner[iPartner], 
+            iBinAnchor + cBinsAnchor * iBinPartner
+         );
+         ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucketEntry, aHistogramBucketsEndDebug);
+         pHistogramBucketEntry->m_weightInBucket += FloatEbmType { 1 };
+         apHistogramBucketEntry[iPartner] = pHistogramBucketEntry;
+      }
+
+      for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+         const FloatEbmType residualError = *pResidualError;
+         // residualError could be NaN
+         // for classification, residualError can be anything from -1 to +1 (it cannot be infinity!)
+         // for regression, residualError can be anything from +infinity or -infinity
+         if(bClassification) {
+            EBM_ASSERT(
+               std::isnan(residualError) || 
+               !std::isinf(residualError) && FloatEbmType { -1 } - k_epsilonResidualError <= residualError && residualError <= FloatEbmType { 1 }
+            );
+            // computed once per instance and shared between all the pairs of the block
+            const FloatEbmType denominator = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+            EBM_ASSERT(
+               std::isnan(denominator) || 
+               !std::isinf(denominator) && -k_epsilonResidualError <= denominator && denominator <= FloatEbmType { 0.25 }
+            );
+            for(size_t iPartner = 0; iPartner < cPartners; ++iPartner) {
+               HistogramBucketVectorEntry<bClassification> * const pEntry = 
+                  &ARRAY_TO_POINTER(apHistogramBucketEntry[iPartner]->m_aHistogramBucketVectorEntry)[iVector];
+               pEntry->m_sumResidualError += residualError;
+               pEntry->SetSumDenominator(pEntry->GetSumDenominator() + denominator);
+            }
+         } else {
+            for(size_t iPartner = 0; iPartner < cPartners; ++iPartner) {
+               ARRAY_TO_POINTER(apHistogramBucketEntry[iPartner]->m_aHistogramBucketVectorEntry)[iVector].m_sumResidualError += residualError;
+            }
+         }
+         ++pResidualError;
+      }
+   }
+   LOG_0(TraceLevelVerbose, "Exited BinDataSetInteractionAnchored");
+}
+
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
+size_t ListActiveHistogramBuckets(
    const SamplingMethod * const pTrainingSet, 
    const size_t cHistogramBuckets, 
-   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets, 
-   size_t * const pcInstancesTotal, 
+   const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets, 
+   const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> ** const apHistogramBucketsActive, 
+   FloatEbmType * const pWeightTotal, 
    HistogramBucketVectorEntry<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aSumHistogramBucketVectorEntry, 
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses
 #ifndef NDEBUG
@@ -585,13 +1079,11 @@ size_t CompressHistogramBuckets(
 ) {
    constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
 
-   LOG_0(TraceLevelVerbose, "Entered CompressHistogramBuckets");
+   LOG_0(TraceLevelVerbose, "Entered ListActiveHistogramBuckets");
 
    EBM_ASSERT(1 <= cHistogramBuckets);
 
-#ifndef NDEBUG
-   size_t cInstancesTotalDebug = 0;
-#endif // NDEBUG
+   FloatEbmType weightTotal = FloatEbmType { 0 };
 
    const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
       compilerLearningTypeOrCountTargetClasses,
@@ -601,51 +1093,20 @@ size_t CompressHistogramBuckets(
    EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
    const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
 
-   HistogramBucket<bClassification> * pCopyFrom = aHistogramBuckets;
-   HistogramBucket<bClassification> * pCopyFromEnd =
+   const HistogramBucket<bClassification> * pHistogramBucket = aHistogramBuckets;
+   const HistogramBucket<bClassification> * const pHistogramBucketEnd =
       GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBuckets, cHistogramBuckets);
 
-   // we do a lot more work in the GrowDecisionTree function per binned bucket entry, so if we can compress it by any amount, then it will probably be a win
-   // for binned bucket arrays that have a small set of labels, this loop will be fast and result in no movements.  For binned bucket arrays that are long 
-   // and have many different labels, we are more likley to find bins with zero items, and that's where we get a win by compressing it down to just the 
-   // non-zero binned buckets, even though this requires one more member variable in the binned bucket array
-#ifdef LEGACY_COMPATIBILITY
-   ActiveDataType iBucket = 0;
-#endif // LEGACY_COMPATIBILITY
+   // we do a lot more work in the GrowDecisionTree function per bucket, so we hand it a list of pointers to the buckets that it should sweep
+   // instead of the buckets themselves.  For features with many bins we are likely to find bins with zero items, and those are never split 
+   // points under LEGACY_COMPATIBILITY.  We used to move the non-empty buckets down over the empty ones, but that copied whole buckets for every
+   // empty bin that preceeded them.  Building the list costs one pointer store per bucket in this loop, which we need anyways for our totals
+   const HistogramBucket<bClassification> ** ppHistogramBucketActive = apHistogramBucketsActive;
    do {
-      ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pCopyFrom, aHistogramBucketsEndDebug);
-#ifdef LEGACY_COMPATIBILITY
-      if(UNLIKELY(0 == pCopyFrom->m_cInstancesInBucket)) {
-         HistogramBucket<bClassification> * pCopyTo = pCopyFrom;
-         goto skip_first_check;
-         do {
-            ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pCopyFrom, aHistogramBucketsEndDebug);
-            if(LIKELY(0 != pCopyFrom->m_cInstancesInBucket)) {
-#ifndef NDEBUG
-               cInstancesTotalDebug += pCopyFrom->m_cInstancesInBucket;
-#endif // NDEBUG
-               ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pCopyTo, aHistogramBucketsEndDebug);
-               memcpy(pCopyTo, pCopyFrom, cBytesPerHistogramBucket);
-
-               for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
-                  aSumHistogramBucketVectorEntry[iVector].Add(ARRAY_TO_POINTER(pCopyFrom->m_aHistogramBucketVectorEntry)[iVector]);
-               }
+      ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucket, aHistogramBucketsEndDebug);
 
-               pCopyTo->m_bucketValue = static_cast<ActiveDataType>(iBucket);
-               pCopyTo = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pCopyTo, 1);
-            }
-            skip_first_check:
-            ++iBucket;
-            pCopyFrom = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pCopyFrom, 1);
-         } while(pCopyFromEnd != pCopyFrom);
-         // TODO: eliminate this extra variable copy by making our outer loop use pCopyTo which is equal to pCopyFrom in the outer loop
-         pCopyFrom = pCopyTo;
-         break;
-      }
-#endif // LEGACY_COMPATIBILITY
-#ifndef NDEBUG
-      cInstancesTotalDebug += pCopyFrom->m_cInstancesInBucket;
-#endif // NDEBUG
+      const FloatEbmType weightInBucket = pHistogramBucket->m_weightInBucket;
+      weightTotal += weightInBucket;
       for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
          // when building a tree, we start from one end and sweep to the other.  In order to caluculate
          // gain on both sides, we need the sum on both sides, which means when starting from one end
@@ -657,33 +1118,32 @@ size_t CompressHistogramBuckets(
          // and that is if almost all bins have either 0 or 1 instances, which would happen if we didn't bin at all
          // beforehand.  We'll still want this per-bin sumation though since it's unlikley that all data
          // will be continuous in an ML problem.
-         aSumHistogramBucketVectorEntry[iVector].Add(ARRAY_TO_POINTER(pCopyFrom->m_aHistogramBucketVectorEntry)[iVector]);
+         aSumHistogramBucketVectorEntry[iVector].Add(ARRAY_TO_POINTER_CONST(pHistogramBucket->m_aHistogramBucketVectorEntry)[iVector]);
       }
 
+      // we always store the pointer and only advance past it if we keep it, which avoids a hard to predict branch on sparse features
+      *ppHistogramBucketActive = pHistogramBucket;
 #ifdef LEGACY_COMPATIBILITY
-      pCopyFrom->m_bucketValue = static_cast<ActiveDataType>(iBucket);
-      ++iBucket;
+      ppHistogramBucketActive += FloatEbmType { 0 } != weightInBucket ? size_t { 1 } : size_t { 0 };
+#else // LEGACY_COMPATIBILITY
+      ++ppHistogramBucketActive;
 #endif // LEGACY_COMPATIBILITY
 
-      pCopyFrom = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pCopyFrom, 1);
-   } while(pCopyFromEnd != pCopyFrom);
-   EBM_ASSERT(0 == (reinterpret_cast<char *>(pCopyFrom) - reinterpret_cast<char *>(aHistogramBuckets)) % cBytesPerHistogramBucket);
+      pHistogramBucket = GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pHistogramBucket, 1);
+   } while(pHistogramBucketEnd != pHistogramBucket);
 
-#ifdef LEGACY_COMPATIBILITY
-   const size_t cFinalItems = (reinterpret_cast<char *>(pCopyFrom) - reinterpret_cast<char *>(aHistogramBuckets)) / cBytesPerHistogramBucket;
-#else
-   // TODO : after we've eliminated the compression and removed LEGACY_COMPATIBILITY, we won't need to return cFinalItems, so we can return cInstancesTotal
-   //   directly instead of using a pointer
-   const size_t cFinalItems = cHistogramBuckets;
-#endif
+   const size_t cHistogramBucketsActive = ppHistogramBucketActive - apHistogramBucketsActive;
+   EBM_ASSERT(cHistogramBucketsActive <= cHistogramBuckets);
 
-   const size_t cInstancesTotal = pTrainingSet->GetTotalCountInstanceOccurrences();
-   EBM_ASSERT(cInstancesTotal == cInstancesTotalDebug);
+   // without weights or instance multipliers our bucket weights are exact instance counts
+   EBM_ASSERT(nullptr != pTrainingSet->m_pOriginDataSet->GetWeights() || !pTrainingSet->IsUnitMultiplier() ||
+      static_cast<FloatEbmType>(pTrainingSet->GetTotalCountInstanceOccurrences()) == weightTotal);
+   UNUSED(pTrainingSet);
 
-   *pcInstancesTotal = cInstancesTotal;
+   *pWeightTotal = weightTotal;
 
-   LOG_0(TraceLevelVerbose, "Exited CompressHistogramBuckets");
-   return cFinalItems;
+   LOG_0(TraceLevelVerbose, "Exited ListActiveHistogramBuckets");
+   return cHistogramBucketsActive;
 }
 
 #endif // HISTOGRAM_BUCKET_H
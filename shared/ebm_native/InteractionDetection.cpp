@@ -8,6 +8,8 @@
 #include <stdlib.h> // malloc, realloc, free
 #include <stddef.h> // size_t, ptrdiff_t
 #include <limits> // numeric_limits
+#include <algorithm> // sort
+#include <cmath> // isnan
 
 #include "ebm_native.h"
 #include "EbmInternal.h"
@@ -18,6 +20,8 @@
 #include "DataSetByFeature.h"
 // depends on the above
 #include "DimensionMultiple.h"
+#include "TrainValidationSplit.h"
+#include "DataSetShared.h"
 
 #include "EbmInteractionState.h"
 
@@ -32,7 +36,9 @@ EbmInteractionState * AllocateInteraction(
    const void * targets, 
    const IntEbmType * binnedData, 
    const FloatEbmType * predictorScores,
-   const FloatEbmType * const optionalTempParams
+   const FloatEbmType * const optionalTempParams,
+   const size_t cInstancesBinnedData,
+   const size_t * const aiInstancesBinnedData
 ) {
    // TODO : give AllocateInteraction the same calling parameter order as InitializeInteractionClassification
 
@@ -67,7 +73,8 @@ EbmInteractionState * AllocateInteraction(
       LOG_0(TraceLevelWarning, "WARNING AllocateInteraction nullptr == pEbmInteractionState");
       return nullptr;
    }
-   if(UNLIKELY(pEbmInteractionState->InitializeInteraction(features, cInstances, targets, binnedData, predictorScores))) {
+   if(UNLIKELY(pEbmInteractionState->InitializeInteraction(features, cInstances, targets, binnedData, predictorScores, 
+      cInstancesBinnedData, aiInstancesBinnedData))) {
       LOG_0(TraceLevelWarning, "WARNING AllocateInteraction pEbmInteractionState->InitializeInteraction");
       delete pEbmInteractionState;
       return nullptr;
@@ -119,7 +126,9 @@ EBM_NATIVE_IMPORT_EXPORT_BODY PEbmInteraction EBM_NATIVE_CALLING_CONVENTION Init
       targets, 
       binnedData, 
       predictorScores,
-      optionalTempParams
+      optionalTempParams,
+      0,
+      nullptr
    ));
    LOG_N(TraceLevelInfo, "Exited InitializeInteractionClassification %p", static_cast<void *>(pEbmInteraction));
    return pEbmInteraction;
@@ -152,12 +161,107 @@ EBM_NATIVE_IMPORT_EXPORT_BODY PEbmInteraction EBM_NATIVE_CALLING_CONVENTION Init
       targets, 
       binnedData, 
       predictorScores,
-      optionalTempParams
+      optionalTempParams,
+      0,
+      nullptr
    ));
    LOG_N(TraceLevelInfo, "Exited InitializeInteractionRegression %p", static_cast<void *>(pEbmInteraction));
    return pEbmInteraction;
 }
 
+// builds an interaction detection dataset from the training instances (those that aIsValidation doesn't select) of a shared dataset.  The binned data 
+// is read in place through the instance selection while our dataset makes its own copy, and only the targets and predictor scores are gathered into 
+// temporary buffers
+template<typename TTarget>
+static EbmInteractionState * AllocateInteractionSelection(
+   const DataSetSharedView * const pView,
+   const IntEbmType * const aIsValidation,
+   const FloatEbmType * const predictorScores,
+   const FloatEbmType * const optionalTempParams
+) {
+   const size_t cInstances = pView->m_cInstances;
+   const size_t cVectorLength = GetVectorLength(pView->m_runtimeLearningTypeOrCountTargetClasses);
+   if(IsMultiplyError(cVectorLength, cInstances) || IsMultiplyError(sizeof(FloatEbmType), cVectorLength * cInstances) || 
+      IsMultiplyError(sizeof(TTarget), cInstances) || IsMultiplyError(sizeof(size_t), cInstances)
+   ) {
+      LOG_0(TraceLevelWarning, "WARNING AllocateInteractionSelection IsMultiplyError");
+      return nullptr;
+   }
+
+   // malloc can return nullptr for zero bytes, so we always allocate at least 1 item
+   const size_t cInstancesAllocate = 0 == cInstances ? size_t { 1 } : cInstances;
+   size_t * const aiInstances = static_cast<size_t *>(malloc(sizeof(size_t) * cInstancesAllocate));
+   TTarget * const aTargets = static_cast<TTarget *>(malloc(sizeof(TTarget) * cInstancesAllocate));
+   FloatEbmType * const aPredictorScores = static_cast<FloatEbmType *>(malloc(sizeof(FloatEbmType) * cVectorLength * cInstancesAllocate));
+   EbmInteractionState * pEbmInteractionState = nullptr;
+   if(nullptr == aiInstances || nullptr == aTargets || nullptr == aPredictorScores) {
+      LOG_0(TraceLevelWarning, "WARNING AllocateInteractionSelection out of memory");
+   } else {
+      size_t cSelected = 0;
+      for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
+         if(nullptr == aIsValidation || 0 == aIsValidation[iInstance]) {
+            aiInstances[cSelected] = iInstance;
+            ++cSelected;
+         }
+      }
+      if(0 != cSelected) {
+         GatherInstances(cSelected, aiInstances, 1, static_cast<const TTarget *>(pView->m_aTargets), aTargets);
+         if(nullptr == predictorScores) {
+            memset(aPredictorScores, 0, sizeof(FloatEbmType) * cVectorLength * cSelected);
+         } else {
+            GatherInstances(cSelected, aiInstances, cVectorLength, predictorScores, aPredictorScores);
+         }
+      }
+      pEbmInteractionState = AllocateInteraction(
+         static_cast<IntEbmType>(pView->m_cFeatures), 
+         pView->m_aFeatures, 
+         pView->m_runtimeLearningTypeOrCountTargetClasses, 
+         static_cast<IntEbmType>(cSelected), 
+         aTargets, 
+         pView->m_aBinnedData, 
+         aPredictorScores,
+         optionalTempParams,
+         cInstances,
+         aiInstances
+      );
+   }
+
+   // our dataset made its own copies of everything that it needs
+   free(aiInstances);
+   free(aTargets);
+   free(aPredictorScores);
+   return pEbmInteractionState;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY PEbmInteraction EBM_NATIVE_CALLING_CONVENTION InitializeInteractionFromDataSet(
+   const void * dataSet,
+   const IntEbmType * isValidation,
+   const FloatEbmType * predictorScores,
+   const FloatEbmType * optionalTempParams
+) {
+   LOG_N(TraceLevelInfo, "Entered InitializeInteractionFromDataSet: dataSet=%p, isValidation=%p, predictorScores=%p, optionalTempParams=%p",
+      dataSet, 
+      static_cast<const void *>(isValidation), 
+      static_cast<const void *>(predictorScores),
+      static_cast<const void *>(optionalTempParams)
+   );
+   DataSetSharedView view;
+   if(GetDataSetSharedView(dataSet, &view)) {
+      LOG_0(TraceLevelWarning, "WARNING InitializeInteractionFromDataSet GetDataSetSharedView failed");
+      return nullptr;
+   }
+   EbmInteractionState * pEbmInteractionState;
+   if(IsClassification(view.m_runtimeLearningTypeOrCountTargetClasses)) {
+      pEbmInteractionState = AllocateInteractionSelection<IntEbmType>(&view, isValidation, predictorScores, optionalTempParams);
+   } else {
+      EBM_ASSERT(IsRegression(view.m_runtimeLearningTypeOrCountTargetClasses));
+      pEbmInteractionState = AllocateInteractionSelection<FloatEbmType>(&view, isValidation, predictorScores, optionalTempParams);
+   }
+   const PEbmInteraction pEbmInteraction = reinterpret_cast<PEbmInteraction>(pEbmInteractionState);
+   LOG_N(TraceLevelInfo, "Exited InitializeInteractionFromDataSet %p", static_cast<void *>(pEbmInteraction));
+   return pEbmInteraction;
+}
+
 template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
 static IntEbmType GetInteractionScorePerTargetClasses(
    EbmInteractionState * const pEbmInteractionState, 
@@ -177,7 +281,8 @@ static IntEbmType GetInteractionScorePerTargetClasses(
       pEbmInteractionState->m_pDataSet, 
       pFeatureCombination, 
       cInstancesRequiredForChildSplitMin, 
-      pInteractionScoreReturn
+      pInteractionScoreReturn,
+      nullptr
    )) {
       delete pCachedThreadResources;
       return 1;
@@ -395,6 +500,798 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GetIntera
    return ret;
 }
 
+// the most histogram bytes that we fill in one pass over the data.  Wider blocks read the anchor and residuals fewer times, but once the histograms 
+// stop fitting in the L2 cache the random writes into them cost more than the reads that we save
+constexpr size_t k_cBytesInteractionAnchoredPassMax = size_t { 1 } << 18;
+
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
+static IntEbmType GetInteractionScoresAnchoredPerTargetClasses(
+   EbmInteractionState * const pEbmInteractionState, 
+   const Feature * const pFeatureAnchor, 
+   const size_t cPartners, 
+   const IntEbmType * const aiFeaturesPartner, 
+   const size_t cInstancesRequiredForChildSplitMin, 
+   FloatEbmType * const aInteractionScoresReturn
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pEbmInteractionState->m_runtimeLearningTypeOrCountTargetClasses;
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   if(GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)) {
+      LOG_0(TraceLevelWarning, "WARNING GetInteractionScoresAnchoredPerTargetClasses GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)");
+      return 1;
+   }
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+   const size_t cBinsAnchor = pFeatureAnchor->m_cBins;
+   const Feature * const aFeatures = pEbmInteractionState->m_aFeatures;
+
+   CachedInteractionThreadResources * const pCachedThreadResources = new (std::nothrow) CachedInteractionThreadResources();
+   if(nullptr == pCachedThreadResources) {
+      return 1;
+   }
+
+   const Feature * apFeaturesPartner[k_cInteractionPartnersPerPassMax];
+   size_t aiPartnerReturn[k_cInteractionPartnersPerPassMax];
+   size_t aiByteHistogram[k_cInteractionPartnersPerPassMax];
+   HistogramBucket<bClassification> * apHistogramBucketsPartner[k_cInteractionPartnersPerPassMax];
+
+   char FeatureCombinationBuffer[k_cBytesFeatureCombinationMax];
+   FeatureCombination * const pFeatureCombination = reinterpret_cast<FeatureCombination *>(&FeatureCombinationBuffer);
+   pFeatureCombination->Initialize(2, 0);
+   ARRAY_TO_POINTER(pFeatureCombination->m_FeatureCombinationEntry)[0].m_pFeature = pFeatureAnchor;
+
+   size_t iPartnerNext = 0;
+   while(iPartnerNext < cPartners) {
+      // gather the next block of partners whose histograms fit together within our byte budget.  We always take at least one partner
+      size_t cBlock = 0;
+      size_t cBytesBlock = 0;
+      do {
+         const size_t iFeaturePartner = static_cast<size_t>(aiFeaturesPartner[iPartnerNext]);
+         EBM_ASSERT(iFeaturePartner < pEbmInteractionState->m_cFeatures);
+         const Feature * const pFeaturePartner = &aFeatures[iFeaturePartner];
+         if(pFeaturePartner->m_cBins <= 1) {
+            // a pair with a constant feature can't have an interaction, just as in GetInteractionScore
+            aInteractionScoresReturn[iPartnerNext] = FloatEbmType { 0 };
+         } else {
+            if(IsMultiplyError(cBinsAnchor, pFeaturePartner->m_cBins) || 
+               IsMultiplyError(cBinsAnchor * pFeaturePartner->m_cBins, cBytesPerHistogramBucket)
+            ) {
+               LOG_0(TraceLevelWarning, "WARNING GetInteractionScoresAnchoredPerTargetClasses IsMultiplyError");
+               delete pCachedThreadResources;
+               return 1;
+            }
+            const size_t cBytesHistogram = cBinsAnchor * pFeaturePartner->m_cBins * cBytesPerHistogramBucket;
+            if(0 != cBlock && (IsAddError(cBytesBlock, cBytesHistogram) || k_cBytesInteractionAnchoredPassMax < cBytesBlock + cBytesHistogram)) {
+               // leave this partner for the next block
+               break;
+            }
+            if(IsAddError(cBytesBlock, cBytesHistogram)) {
+               LOG_0(TraceLevelWarning, "WARNING GetInteractionScoresAnchoredPerTargetClasses IsAddError(cBytesBlock, cBytesHistogram)");
+               delete pCachedThreadResources;
+               return 1;
+            }
+            apFeaturesPartner[cBlock] = pFeaturePartner;
+            aiPartnerReturn[cBlock] = iPartnerNext;
+            aiByteHistogram[cBlock] = cBytesBlock;
+            cBytesBlock += cBytesHistogram;
+            ++cBlock;
+         }
+         ++iPartnerNext;
+      } while(iPartnerNext < cPartners && cBlock < k_cInteractionPartnersPerPassMax);
+
+      if(0 == cBlock) {
+         continue;
+      }
+      if(1 == cBlock) {
+         // with a single pair there's nothing to share, so let it bin straight into its own buffer rather than binning and then copying
+         ARRAY_TO_POINTER(pFeatureCombination->m_FeatureCombinationEntry)[1].m_pFeature = apFeaturesPartner[0];
+         if(CalculateInteractionScore<compilerLearningTypeOrCountTargetClasses, 0>(
+            runtimeLearningTypeOrCountTargetClasses, 
+            pCachedThreadResources, 
+            pEbmInteractionState->m_pDataSet, 
+            pFeatureCombination, 
+            cInstancesRequiredForChildSplitMin, 
+            &aInteractionScoresReturn[aiPartnerReturn[0]],
+            nullptr
+         )) {
+            delete pCachedThreadResources;
+            return 1;
+         }
+         continue;
+      }
+
+      unsigned char * const aBlockBytes = static_cast<unsigned char *>(pCachedThreadResources->GetThreadByteBuffer2(cBytesBlock));
+      if(UNLIKELY(nullptr == aBlockBytes)) {
+         LOG_0(TraceLevelWarning, "WARNING GetInteractionScoresAnchoredPerTargetClasses nullptr == aBlockBytes");
+         delete pCachedThreadResources;
+         return 1;
+      }
+      memset(aBlockBytes, 0, cBytesBlock);
+      for(size_t iBlock = 0; iBlock < cBlock; ++iBlock) {
+         apHistogramBucketsPartner[iBlock] = reinterpret_cast<HistogramBucket<bClassification> *>(aBlockBytes + aiByteHistogram[iBlock]);
+      }
+
+      BinDataSetInteractionAnchored<compilerLearningTypeOrCountTargetClasses>(
+         cBlock,
+         apHistogramBucketsPartner,
+         pFeatureAnchor,
+         apFeaturesPartner,
+         pEbmInteractionState->m_pDataSet,
+         runtimeLearningTypeOrCountTargetClasses
+#ifndef NDEBUG
+         , aBlockBytes + cBytesBlock
+#endif // NDEBUG
+      );
+
+      for(size_t iBlock = 0; iBlock < cBlock; ++iBlock) {
+         ARRAY_TO_POINTER(pFeatureCombination->m_FeatureCombinationEntry)[1].m_pFeature = apFeaturesPartner[iBlock];
+         if(CalculateInteractionScore<compilerLearningTypeOrCountTargetClasses, 0>(
+            runtimeLearningTypeOrCountTargetClasses, 
+            pCachedThreadResources, 
+            pEbmInteractionState->m_pDataSet, 
+            pFeatureCombination, 
+            cInstancesRequiredForChildSplitMin, 
+            &aInteractionScoresReturn[aiPartnerReturn[iBlock]],
+            apHistogramBucketsPartner[iBlock]
+         )) {
+            delete pCachedThreadResources;
+            return 1;
+         }
+      }
+   }
+   delete pCachedThreadResources;
+   return 0;
+}
+
+template<ptrdiff_t possibleCompilerLearningTypeOrCountTargetClasses>
+EBM_INLINE IntEbmType CompilerRecursiveGetInteractionScoresAnchored(
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses, 
+   EbmInteractionState * const pEbmInteractionState, 
+   const Feature * const pFeatureAnchor, 
+   const size_t cPartners, 
+   const IntEbmType * const aiFeaturesPartner, 
+   const size_t cInstancesRequiredForChildSplitMin, 
+   FloatEbmType * const aInteractionScoresReturn
+) {
+   static_assert(IsClassification(possibleCompilerLearningTypeOrCountTargetClasses), 
+      "possibleCompilerLearningTypeOrCountTargetClasses needs to be a classification");
+   EBM_ASSERT(IsClassification(runtimeLearningTypeOrCountTargetClasses));
+   if(runtimeLearningTypeOrCountTargetClasses == possibleCompilerLearningTypeOrCountTargetClasses) {
+      EBM_ASSERT(runtimeLearningTypeOrCountTargetClasses <= k_cCompilerOptimizedTargetClassesMax);
+      return GetInteractionScoresAnchoredPerTargetClasses<possibleCompilerLearningTypeOrCountTargetClasses>(
+         pEbmInteractionState, 
+         pFeatureAnchor, 
+         cPartners, 
+         aiFeaturesPartner, 
+         cInstancesRequiredForChildSplitMin, 
+         aInteractionScoresReturn
+      );
+   } else {
+      return CompilerRecursiveGetInteractionScoresAnchored<possibleCompilerLearningTypeOrCountTargetClasses + 1>(
+         runtimeLearningTypeOrCountTargetClasses, 
+         pEbmInteractionState, 
+         pFeatureAnchor, 
+         cPartners, 
+         aiFeaturesPartner, 
+         cInstancesRequiredForChildSplitMin, 
+         aInteractionScoresReturn
+      );
+   }
+}
+
+template<>
+EBM_INLINE IntEbmType CompilerRecursiveGetInteractionScoresAnchored<k_cCompilerOptimizedTargetClassesMax + 1>(
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses, 
+   EbmInteractionState * const pEbmInteractionState, 
+   const Feature * const pFeatureAnchor, 
+   const size_t cPartners, 
+   const IntEbmType * const aiFeaturesPartner, 
+   const size_t cInstancesRequiredForChildSplitMin, 
+   FloatEbmType * const aInteractionScoresReturn
+) {
+   UNUSED(runtimeLearningTypeOrCountTargetClasses);
+   static_assert(IsClassification(k_cCompilerOptimizedTargetClassesMax), "k_cCompilerOptimizedTargetClassesMax needs to be a classification");
+   EBM_ASSERT(IsClassification(runtimeLearningTypeOrCountTargetClasses));
+   EBM_ASSERT(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses);
+   return GetInteractionScoresAnchoredPerTargetClasses<k_DynamicClassification>(
+      pEbmInteractionState, 
+      pFeatureAnchor, 
+      cPartners, 
+      aiFeaturesPartner, 
+      cInstancesRequiredForChildSplitMin, 
+      aInteractionScoresReturn
+   );
+}
+
+// scores the pairs (iFeatureAnchor, aiFeaturesPartner[i]) for partner indexes that our caller has already checked
+static IntEbmType ScoreInteractionsAnchored(
+   EbmInteractionState * const pEbmInteractionState, 
+   const size_t iFeatureAnchor, 
+   const size_t cPartners, 
+   const IntEbmType * const aiFeaturesPartner, 
+   FloatEbmType * const aInteractionScoresReturn
+) {
+   EBM_ASSERT(iFeatureAnchor < pEbmInteractionState->m_cFeatures);
+   EBM_ASSERT(1 <= cPartners);
+   const Feature * const pFeatureAnchor = &pEbmInteractionState->m_aFeatures[iFeatureAnchor];
+   if(nullptr == pEbmInteractionState->m_pDataSet || pFeatureAnchor->m_cBins <= 1 || 
+      IsClassification(pEbmInteractionState->m_runtimeLearningTypeOrCountTargetClasses) && 
+      pEbmInteractionState->m_runtimeLearningTypeOrCountTargetClasses <= ptrdiff_t { 1 }
+   ) {
+      // zero instances, a constant anchor, or a target with 0/1 classes can't show interactions, which GetInteractionScore also reports as zero
+      LOG_0(TraceLevelInfo, "INFO ScoreInteractionsAnchored nothing to interact");
+      for(size_t iPartner = 0; iPartner < cPartners; ++iPartner) {
+         aInteractionScoresReturn[iPartner] = FloatEbmType { 0 };
+      }
+      return 0;
+   }
+
+   IntEbmType ret;
+   if(IsClassification(pEbmInteractionState->m_runtimeLearningTypeOrCountTargetClasses)) {
+      ret = CompilerRecursiveGetInteractionScoresAnchored<2>(
+         pEbmInteractionState->m_runtimeLearningTypeOrCountTargetClasses, 
+         pEbmInteractionState, 
+         pFeatureAnchor, 
+         cPartners, 
+         aiFeaturesPartner, 
+         TODO_REMOVE_THIS_DEFAULT_cInstancesRequiredForChildSplitMin, 
+         aInteractionScoresReturn
+      );
+   } else {
+      EBM_ASSERT(IsRegression(pEbmInteractionState->m_runtimeLearningTypeOrCountTargetClasses));
+      ret = GetInteractionScoresAnchoredPerTargetClasses<k_Regression>(
+         pEbmInteractionState, 
+         pFeatureAnchor, 
+         cPartners, 
+         aiFeaturesPartner, 
+         TODO_REMOVE_THIS_DEFAULT_cInstancesRequiredForChildSplitMin, 
+         aInteractionScoresReturn
+      );
+   }
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GetInteractionScoresAnchored(
+   PEbmInteraction ebmInteraction,
+   IntEbmType indexFeatureAnchor,
+   IntEbmType countPartners,
+   const IntEbmType * partnerFeatureIndexes,
+   FloatEbmType * interactionScoresReturn
+) {
+   LOG_COUNTED_N(
+      &g_cLogGetInteractionScoreParametersMessages, 
+      TraceLevelInfo, 
+      TraceLevelVerbose, 
+      "GetInteractionScoresAnchored parameters: ebmInteraction=%p, indexFeatureAnchor=%" IntEbmTypePrintf ", countPartners=%" IntEbmTypePrintf 
+      ", partnerFeatureIndexes=%p, interactionScoresReturn=%p", 
+      static_cast<void *>(ebmInteraction), 
+      indexFeatureAnchor, 
+      countPartners, 
+      static_cast<const void *>(partnerFeatureIndexes), 
+      static_cast<void *>(interactionScoresReturn)
+   );
+
+   EBM_ASSERT(nullptr != ebmInteraction);
+   EbmInteractionState * pEbmInteractionState = reinterpret_cast<EbmInteractionState *>(ebmInteraction);
+
+   LOG_COUNTED_0(&pEbmInteractionState->m_cLogEnterMessages, TraceLevelInfo, TraceLevelVerbose, "Entered GetInteractionScoresAnchored");
+
+   EBM_ASSERT(0 <= indexFeatureAnchor);
+   EBM_ASSERT(0 <= countPartners);
+   EBM_ASSERT(0 == countPartners || nullptr != partnerFeatureIndexes);
+   EBM_ASSERT(0 == countPartners || nullptr != interactionScoresReturn);
+
+   if(!IsNumberConvertable<size_t, IntEbmType>(indexFeatureAnchor)) {
+      LOG_0(TraceLevelWarning, "WARNING GetInteractionScoresAnchored !IsNumberConvertable<size_t, IntEbmType>(indexFeatureAnchor)");
+      return 1;
+   }
+   const size_t iFeatureAnchor = static_cast<size_t>(indexFeatureAnchor);
+   if(pEbmInteractionState->m_cFeatures <= iFeatureAnchor) {
+      LOG_0(TraceLevelError, "ERROR GetInteractionScoresAnchored indexFeatureAnchor is not a feature");
+      return 1;
+   }
+   if(!IsNumberConvertable<size_t, IntEbmType>(countPartners)) {
+      LOG_0(TraceLevelWarning, "WARNING GetInteractionScoresAnchored !IsNumberConvertable<size_t, IntEbmType>(countPartners)");
+      return 1;
+   }
+   const size_t cPartners = static_cast<size_t>(countPartners);
+   if(0 == cPartners) {
+      LOG_0(TraceLevelInfo, "INFO GetInteractionScoresAnchored no partners");
+      return 0;
+   }
+   if(nullptr == partnerFeatureIndexes || nullptr == interactionScoresReturn) {
+      LOG_0(TraceLevelError, "ERROR GetInteractionScoresAnchored partnerFeatureIndexes and interactionScoresReturn cannot be nullptr");
+      return 1;
+   }
+   for(size_t iPartner = 0; iPartner < cPartners; ++iPartner) {
+      const IntEbmType indexFeaturePartner = partnerFeatureIndexes[iPartner];
+      if(indexFeaturePartner < 0 || !IsNumberConvertable<size_t, IntEbmType>(indexFeaturePartner) || 
+         pEbmInteractionState->m_cFeatures <= static_cast<size_t>(indexFeaturePartner)
+      ) {
+         LOG_0(TraceLevelError, "ERROR GetInteractionScoresAnchored partnerFeatureIndexes contains an index that is not a feature");
+         return 1;
+      }
+   }
+
+   const IntEbmType ret = ScoreInteractionsAnchored(pEbmInteractionState, iFeatureAnchor, cPartners, partnerFeatureIndexes, interactionScoresReturn);
+   if(0 != ret) {
+      LOG_N(TraceLevelWarning, "WARNING GetInteractionScoresAnchored returned %" IntEbmTypePrintf, ret);
+   }
+   LOG_COUNTED_0(&pEbmInteractionState->m_cLogExitMessages, TraceLevelInfo, TraceLevelVerbose, "Exited GetInteractionScoresAnchored");
+   return ret;
+}
+
+// features with more bins than this are merged into this many coarse bins when bounding the interaction score of a pair
+constexpr size_t k_cInteractionBinsCoarse = 32;
+
+EBM_INLINE static bool IsInteractionPairBounded(const size_t cCellsBoundedMin, const size_t cBins1, const size_t cBins2) {
+   return 2 <= cBins1 && 2 <= cBins2 && cCellsBoundedMin / cBins2 < cBins1;
+}
+
+// our bounds are summed in a different order than the exact scores, so we only trust them to be upper bounds within this relative slack
+constexpr FloatEbmType k_interactionBoundSlack = FloatEbmType { 1e-7 };
+
+struct InteractionPairBound final {
+   FloatEbmType m_bound;
+   size_t m_iFeature1;
+   size_t m_iFeature2;
+};
+
+// orders pairs by descending bound, and then by their feature indexes so that our search is deterministic
+static bool IsInteractionPairBoundBefore(const InteractionPairBound & lhs, const InteractionPairBound & rhs) {
+   if(lhs.m_bound != rhs.m_bound) {
+      return rhs.m_bound < lhs.m_bound;
+   }
+   if(lhs.m_iFeature1 != rhs.m_iFeature1) {
+      return lhs.m_iFeature1 < rhs.m_iFeature1;
+   }
+   return lhs.m_iFeature2 < rhs.m_iFeature2;
+}
+
+// Σ S*S/n over the items of a histogram cell laid out as the count followed by the residual sum of each item of the vector
+EBM_INLINE static FloatEbmType SumSquaresOverCount(const FloatEbmType * const pCell, const size_t cVectorLength) {
+   FloatEbmType ret = FloatEbmType { 0 };
+   if(FloatEbmType { 0 } < pCell[0]) {
+      for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+         ret += pCell[1 + iVector] / pCell[0] * pCell[1 + iVector];
+      }
+   }
+   return ret;
+}
+
+// an upper bound on the interaction score of a pair, which is the best over quadrant cuts of Σ S*S/n over the 4 quadrants.  Refining a partition 
+// never lowers Σ S*S/n, so we refine any cut by a coarse grid.  Coarse cells that the cut doesn't cross lie whole within one quadrant.  The cells of 
+// the coarse row that the cut crosses are only cut along dimension 1, and from the histogram of fine bins of dimension 1 by coarse bins of 
+// dimension 2 we know their pieces exactly.  The same holds for the coarse column.  Only the single coarse cell in both, which the cut can split 4 
+// ways, is relaxed to the sum of its squared residuals.  Maximizing over the cuts within each coarse row and column separately keeps this a bound
+static FloatEbmType ComputeInteractionBoundCoarse(
+   const DataSetByFeature * const pDataSet,
+   const size_t cVectorLength,
+   const Feature * const pFeature1,
+   const size_t * const aiCoarse1,
+   const Feature * const pFeature2,
+   const size_t * const aiCoarse2,
+   FloatEbmType * const aBoundBuffer
+) {
+   const size_t cBins1 = pFeature1->m_cBins;
+   const size_t cBins2 = pFeature2->m_cBins;
+   const size_t cCoarse1 = k_cInteractionBinsCoarse < cBins1 ? k_cInteractionBinsCoarse : cBins1;
+   const size_t cCoarse2 = k_cInteractionBinsCoarse < cBins2 ? k_cInteractionBinsCoarse : cBins2;
+   // fine cells hold the count and then the residual sum of each item of the vector.  Coarse cells also hold the squared residual sums after that
+   const size_t cItemsFine = 1 + cVectorLength;
+   const size_t cItemsCoarse = 1 + 2 * cVectorLength;
+
+   // fine bins of dimension 1 by coarse bins of dimension 2, then fine bins of dimension 2 by coarse bins of dimension 1, then the coarse grid
+   FloatEbmType * const aFine1 = aBoundBuffer;
+   FloatEbmType * const aFine2 = &aFine1[cBins1 * cCoarse2 * cItemsFine];
+   FloatEbmType * const aCoarse = &aFine2[cBins2 * cCoarse1 * cItemsFine];
+   FloatEbmType * const aLeft = &aCoarse[cCoarse1 * cCoarse2 * cItemsCoarse];
+   FloatEbmType * const aPieces = &aLeft[k_cInteractionBinsCoarse * cItemsFine];
+   // the best over the cuts within each coarse row of the row's cells other than the one in the column given by the second index, then the same 
+   // for each coarse column
+   FloatEbmType * const aRowBest = &aPieces[k_cInteractionBinsCoarse];
+   FloatEbmType * const aColumnBest = &aRowBest[cCoarse1 * cCoarse2];
+   memset(aBoundBuffer, 0, sizeof(*aBoundBuffer) * (cItemsFine * (cBins1 * cCoarse2 + cBins2 * cCoarse1) + cItemsCoarse * cCoarse1 * cCoarse2));
+
+   const StorageDataType * const aInputData1 = pDataSet->GetInputDataPointer(pFeature1);
+   const StorageDataType * const aInputData2 = pDataSet->GetInputDataPointer(pFeature2);
+   const FloatEbmType * pResidualError = pDataSet->GetResidualPointer();
+   const size_t cInstances = pDataSet->GetCountInstances();
+   for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
+      const size_t iBin1 = static_cast<size_t>(aInputData1[iInstance]);
+      const size_t iBin2 = static_cast<size_t>(aInputData2[iInstance]);
+      EBM_ASSERT(iBin1 < cBins1);
+      EBM_ASSERT(iBin2 < cBins2);
+      const size_t iCoarse1 = aiCoarse1[iBin1];
+      const size_t iCoarse2 = aiCoarse2[iBin2];
+      FloatEbmType * const pFine1 = &aFine1[(iBin1 * cCoarse2 + iCoarse2) * cItemsFine];
+      FloatEbmType * const pFine2 = &aFine2[(iBin2 * cCoarse1 + iCoarse1) * cItemsFine];
+      FloatEbmType * const pCoarse = &aCoarse[(iCoarse1 + cCoarse1 * iCoarse2) * cItemsCoarse];
+      pFine1[0] += FloatEbmType { 1 };
+      pFine2[0] += FloatEbmType { 1 };
+      pCoarse[0] += FloatEbmType { 1 };
+      for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+         const FloatEbmType residualError = *pResidualError;
+         pFine1[1 + iVector] += residualError;
+         pFine2[1 + iVector] += residualError;
+         pCoarse[1 + iVector] += residualError;
+         pCoarse[1 + cVectorLength + iVector] += residualError * residualError;
+         ++pResidualError;
+      }
+   }
+
+   // sweep the cuts of one dimension.  Within each coarse bin we accumulate the pieces on the low side of the cut, and the high side is the rest of
+   // the coarse cell
+   for(size_t iDimension = 0; iDimension < 2; ++iDimension) {
+      const size_t cBinsSweep = 0 == iDimension ? cBins1 : cBins2;
+      const size_t * const aiCoarseSweep = 0 == iDimension ? aiCoarse1 : aiCoarse2;
+      const size_t cCoarseSweep = 0 == iDimension ? cCoarse1 : cCoarse2;
+      const size_t cCoarseOther = 0 == iDimension ? cCoarse2 : cCoarse1;
+      const FloatEbmType * const aFine = 0 == iDimension ? aFine1 : aFine2;
+      FloatEbmType * const aBest = 0 == iDimension ? aRowBest : aColumnBest;
+      for(size_t iBest = 0; iBest < cCoarseSweep * cCoarseOther; ++iBest) {
+         aBest[iBest] = -std::numeric_limits<FloatEbmType>::infinity();
+      }
+      // the last bin has nothing above it to cut from
+      for(size_t iBin = 0; iBin < cBinsSweep - 1; ++iBin) {
+         const size_t iCoarseSweep = aiCoarseSweep[iBin];
+         if(0 == iBin || aiCoarseSweep[iBin - 1] != iCoarseSweep) {
+            memset(aLeft, 0, sizeof(*aLeft) * cItemsFine * cCoarseOther);
+         }
+         FloatEbmType piecesAll = FloatEbmType { 0 };
+         for(size_t iCoarseOther = 0; iCoarseOther < cCoarseOther; ++iCoarseOther) {
+            FloatEbmType * const pLeft = &aLeft[iCoarseOther * cItemsFine];
+            const FloatEbmType * const pFine = &aFine[(iBin * cCoarseOther + iCoarseOther) * cItemsFine];
+            const FloatEbmType * const pCoarse = &aCoarse[(0 == iDimension ? 
+               iCoarseSweep + cCoarse1 * iCoarseOther : iCoarseOther + cCoarse1 * iCoarseSweep) * cItemsCoarse];
+            FloatEbmType pieces = FloatEbmType { 0 };
+            pLeft[0] += pFine[0];
+            const FloatEbmType cRight = pCoarse[0] - pLeft[0];
+            for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+               pLeft[1 + iVector] += pFine[1 + iVector];
+               if(FloatEbmType { 0 } < pLeft[0]) {
+                  pieces += pLeft[1 + iVector] / pLeft[0] * pLeft[1 + iVector];
+               }
+               if(FloatEbmType { 0 } < cRight) {
+                  const FloatEbmType sumRight = pCoarse[1 + iVector] - pLeft[1 + iVector];
+                  pieces += sumRight / cRight * sumRight;
+               }
+            }
+            aPieces[iCoarseOther] = pieces;
+            piecesAll += pieces;
+         }
+         FloatEbmType * const pBest = &aBest[iCoarseSweep * cCoarseOther];
+         for(size_t iCoarseOther = 0; iCoarseOther < cCoarseOther; ++iCoarseOther) {
+            const FloatEbmType piecesOther = piecesAll - aPieces[iCoarseOther];
+            pBest[iCoarseOther] = pBest[iCoarseOther] < piecesOther ? piecesOther : pBest[iCoarseOther];
+         }
+      }
+   }
+
+   // the whole coarse cells, summed over everything, over each coarse row, and over each coarse column
+   FloatEbmType * const aWholeRow = aLeft;
+   FloatEbmType * const aWholeColumn = aPieces;
+   memset(aWholeRow, 0, sizeof(*aWholeRow) * cCoarse1);
+   memset(aWholeColumn, 0, sizeof(*aWholeColumn) * cCoarse2);
+   FloatEbmType wholeAll = FloatEbmType { 0 };
+   for(size_t iCoarse2 = 0; iCoarse2 < cCoarse2; ++iCoarse2) {
+      for(size_t iCoarse1 = 0; iCoarse1 < cCoarse1; ++iCoarse1) {
+         const FloatEbmType whole = SumSquaresOverCount(&aCoarse[(iCoarse1 + cCoarse1 * iCoarse2) * cItemsCoarse], cVectorLength);
+         wholeAll += whole;
+         aWholeRow[iCoarse1] += whole;
+         aWholeColumn[iCoarse2] += whole;
+      }
+   }
+
+   FloatEbmType bound = FloatEbmType { 0 };
+   for(size_t iCoarse2 = 0; iCoarse2 < cCoarse2; ++iCoarse2) {
+      for(size_t iCoarse1 = 0; iCoarse1 < cCoarse1; ++iCoarse1) {
+         const FloatEbmType rowBest = aRowBest[iCoarse1 * cCoarse2 + iCoarse2];
+         const FloatEbmType columnBest = aColumnBest[iCoarse2 * cCoarse1 + iCoarse1];
+         if(-std::numeric_limits<FloatEbmType>::infinity() == rowBest || -std::numeric_limits<FloatEbmType>::infinity() == columnBest) {
+            // no cut falls within this coarse row or column
+            continue;
+         }
+         const FloatEbmType * const pCorner = &aCoarse[(iCoarse1 + cCoarse1 * iCoarse2) * cItemsCoarse];
+         FloatEbmType corner = FloatEbmType { 0 };
+         for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+            corner += pCorner[1 + cVectorLength + iVector];
+         }
+         const FloatEbmType outside = wholeAll - aWholeRow[iCoarse1] - aWholeColumn[iCoarse2] + SumSquaresOverCount(pCorner, cVectorLength);
+         const FloatEbmType boundCell = outside + rowBest + columnBest + corner;
+         bound = bound < boundCell ? boundCell : bound;
+      }
+   }
+   bound += bound * k_interactionBoundSlack;
+   if(UNLIKELY(std::isnan(bound))) {
+      // NaN or infinite residuals leave us without a bound, so we need to score this pair exactly
+      bound = std::numeric_limits<FloatEbmType>::infinity();
+   }
+   return bound;
+}
+
+// inserts a scored pair into the top list, which is ordered by descending score and then by feature indexes.  Returns the new count of pairs in the list
+static size_t InsertTopInteraction(
+   const size_t cPairsMax,
+   size_t cPairs,
+   IntEbmType * const aPairFeatureIndexes,
+   FloatEbmType * const aInteractionScores,
+   const FloatEbmType interactionScore,
+   const size_t iFeature1,
+   const size_t iFeature2
+) {
+   EBM_ASSERT(iFeature1 < iFeature2);
+   size_t iPosition = cPairs;
+   while(0 != iPosition) {
+      const FloatEbmType scoreBefore = aInteractionScores[iPosition - 1];
+      const size_t iFeature1Before = static_cast<size_t>(aPairFeatureIndexes[2 * (iPosition - 1)]);
+      const size_t iFeature2Before = static_cast<size_t>(aPairFeatureIndexes[2 * (iPosition - 1) + 1]);
+      if(interactionScore < scoreBefore || interactionScore == scoreBefore && 
+         (iFeature1Before < iFeature1 || iFeature1Before == iFeature1 && iFeature2Before < iFeature2)
+      ) {
+         break;
+      }
+      if(iPosition < cPairsMax) {
+         aInteractionScores[iPosition] = scoreBefore;
+         aPairFeatureIndexes[2 * iPosition] = aPairFeatureIndexes[2 * (iPosition - 1)];
+         aPairFeatureIndexes[2 * iPosition + 1] = aPairFeatureIndexes[2 * (iPosition - 1) + 1];
+      }
+      --iPosition;
+   }
+   if(iPosition < cPairsMax) {
+      aInteractionScores[iPosition] = interactionScore;
+      aPairFeatureIndexes[2 * iPosition] = static_cast<IntEbmType>(iFeature1);
+      aPairFeatureIndexes[2 * iPosition + 1] = static_cast<IntEbmType>(iFeature2);
+   }
+   return cPairs < cPairsMax ? cPairs + 1 : cPairs;
+}
+
+// scores the pairs with more than m_cInteractionCellsBoundedMin cells in order of their bounds, and stops once no remaining bound can reach the top 
+// list.  Returns true on error
+static bool SearchTopInteractionsBounded(
+   EbmInteractionState * const pEbmInteractionState,
+   const size_t cPairsMax,
+   size_t * const pcPairs,
+   IntEbmType * const aPairFeatureIndexes,
+   FloatEbmType * const aInteractionScores
+) {
+   const size_t cFeatures = pEbmInteractionState->m_cFeatures;
+   const Feature * const aFeatures = pEbmInteractionState->m_aFeatures;
+   const DataSetByFeature * const pDataSet = pEbmInteractionState->m_pDataSet;
+   EBM_ASSERT(nullptr != pDataSet);
+
+   size_t cPairsBounded = 0;
+   size_t cBinsTotal = 0;
+   for(size_t iFeature1 = 0; iFeature1 < cFeatures; ++iFeature1) {
+      const size_t cBins1 = aFeatures[iFeature1].m_cBins;
+      cBinsTotal += cBins1;
+      for(size_t iFeature2 = iFeature1 + 1; iFeature2 < cFeatures; ++iFeature2) {
+         const size_t cBins2 = aFeatures[iFeature2].m_cBins;
+         if(IsInteractionPairBounded(pEbmInteractionState->m_cInteractionCellsBoundedMin, cBins1, cBins2)) {
+            ++cPairsBounded;
+         }
+      }
+   }
+   if(0 == cPairsBounded) {
+      return false;
+   }
+
+   const size_t cVectorLength = GetVectorLength(pEbmInteractionState->m_runtimeLearningTypeOrCountTargetClasses);
+   // see ComputeInteractionBoundCoarse for the layout.  The fine by coarse histograms are sized for our widest feature
+   size_t cBinsMax = 0;
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      cBinsMax = cBinsMax < aFeatures[iFeature].m_cBins ? aFeatures[iFeature].m_cBins : cBinsMax;
+   }
+   constexpr size_t cCellsCoarseMax = k_cInteractionBinsCoarse * k_cInteractionBinsCoarse;
+   if(IsMultiplyError(cPairsBounded, sizeof(InteractionPairBound)) || IsMultiplyError(cBinsTotal, sizeof(size_t)) || 
+      IsAddError(size_t { 1 }, cVectorLength) || IsMultiplyError(size_t { 2 }, cVectorLength) || IsAddError(size_t { 1 }, 2 * cVectorLength) ||
+      IsMultiplyError(cBinsMax, 2 * k_cInteractionBinsCoarse) || IsMultiplyError(2 * k_cInteractionBinsCoarse * cBinsMax, 1 + cVectorLength) ||
+      IsMultiplyError(cCellsCoarseMax, 1 + 2 * cVectorLength)
+   ) {
+      LOG_0(TraceLevelWarning, "WARNING SearchTopInteractionsBounded IsMultiplyError");
+      return true;
+   }
+   const size_t cItemsFine = 2 * k_cInteractionBinsCoarse * cBinsMax * (1 + cVectorLength);
+   const size_t cItemsCoarse = cCellsCoarseMax * (1 + 2 * cVectorLength);
+   const size_t cItemsSweep = k_cInteractionBinsCoarse * (1 + cVectorLength) + k_cInteractionBinsCoarse + 2 * cCellsCoarseMax;
+   if(IsAddError(cItemsFine, cItemsCoarse) || IsAddError(cItemsFine + cItemsCoarse, cItemsSweep) || 
+      IsMultiplyError(sizeof(FloatEbmType), cItemsFine + cItemsCoarse + cItemsSweep)
+   ) {
+      LOG_0(TraceLevelWarning, "WARNING SearchTopInteractionsBounded IsAddError");
+      return true;
+   }
+   InteractionPairBound * const aPairBounds = static_cast<InteractionPairBound *>(malloc(sizeof(InteractionPairBound) * cPairsBounded));
+   size_t * const aiCoarse = static_cast<size_t *>(malloc(sizeof(size_t) * cBinsTotal));
+   FloatEbmType * const aBoundBuffer = static_cast<FloatEbmType *>(malloc(sizeof(FloatEbmType) * (cItemsFine + cItemsCoarse + cItemsSweep)));
+   size_t * const aiCoarseFeature = static_cast<size_t *>(malloc(sizeof(size_t) * cFeatures));
+   bool bError = true;
+   if(nullptr == aPairBounds || nullptr == aiCoarse || nullptr == aBoundBuffer || nullptr == aiCoarseFeature) {
+      LOG_0(TraceLevelWarning, "WARNING SearchTopInteractionsBounded out of memory");
+   } else {
+      // map each fine bin onto a coarse bin, keeping the coarse bins contiguous so that every quadrant cut falls within or between them
+      size_t iCoarseNext = 0;
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         const size_t cBins = aFeatures[iFeature].m_cBins;
+         aiCoarseFeature[iFeature] = iCoarseNext;
+         for(size_t iBin = 0; iBin < cBins; ++iBin) {
+            aiCoarse[iCoarseNext + iBin] = k_cInteractionBinsCoarse < cBins ? iBin * k_cInteractionBinsCoarse / cBins : iBin;
+         }
+         iCoarseNext += cBins;
+      }
+
+      size_t iPairBounded = 0;
+      for(size_t iFeature1 = 0; iFeature1 < cFeatures; ++iFeature1) {
+         const Feature * const pFeature1 = &aFeatures[iFeature1];
+         for(size_t iFeature2 = iFeature1 + 1; iFeature2 < cFeatures; ++iFeature2) {
+            const Feature * const pFeature2 = &aFeatures[iFeature2];
+            if(IsInteractionPairBounded(pEbmInteractionState->m_cInteractionCellsBoundedMin, pFeature1->m_cBins, pFeature2->m_cBins)) {
+               aPairBounds[iPairBounded].m_bound = ComputeInteractionBoundCoarse(
+                  pDataSet,
+                  cVectorLength,
+                  pFeature1,
+                  &aiCoarse[aiCoarseFeature[iFeature1]],
+                  pFeature2,
+                  &aiCoarse[aiCoarseFeature[iFeature2]],
+                  aBoundBuffer
+               );
+               aPairBounds[iPairBounded].m_iFeature1 = iFeature1;
+               aPairBounds[iPairBounded].m_iFeature2 = iFeature2;
+               ++iPairBounded;
+            }
+         }
+      }
+      EBM_ASSERT(cPairsBounded == iPairBounded);
+      std::sort(aPairBounds, aPairBounds + cPairsBounded, IsInteractionPairBoundBefore);
+
+      bError = false;
+      size_t cPairs = *pcPairs;
+      for(size_t iPair = 0; iPair < cPairsBounded; ++iPair) {
+         const InteractionPairBound * const pPairBound = &aPairBounds[iPair];
+         if(cPairsMax == cPairs && pPairBound->m_bound < aInteractionScores[cPairsMax - 1]) {
+            // the bounds are sorted, so none of the remaining pairs can reach our top list either
+            LOG_N(TraceLevelInfo, "INFO SearchTopInteractionsBounded pruned %zu of %zu bounded pairs", cPairsBounded - iPair, cPairsBounded);
+            break;
+         }
+         const IntEbmType iFeaturePartner = static_cast<IntEbmType>(pPairBound->m_iFeature2);
+         FloatEbmType interactionScore;
+         if(0 != ScoreInteractionsAnchored(pEbmInteractionState, pPairBound->m_iFeature1, 1, &iFeaturePartner, &interactionScore)) {
+            bError = true;
+            break;
+         }
+         EBM_ASSERT(interactionScore <= pPairBound->m_bound);
+         cPairs = InsertTopInteraction(
+            cPairsMax, 
+            cPairs, 
+            aPairFeatureIndexes, 
+            aInteractionScores, 
+            interactionScore, 
+            pPairBound->m_iFeature1, 
+            pPairBound->m_iFeature2
+         );
+      }
+      *pcPairs = cPairs;
+   }
+   free(aPairBounds);
+   free(aiCoarse);
+   free(aBoundBuffer);
+   free(aiCoarseFeature);
+   return bError;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GetTopInteractionPairs(
+   PEbmInteraction ebmInteraction,
+   IntEbmType countPairsMax,
+   IntEbmType * pairFeatureIndexesReturn,
+   FloatEbmType * interactionScoresReturn,
+   IntEbmType * countPairsReturn
+) {
+   LOG_N(
+      TraceLevelInfo, 
+      "Entered GetTopInteractionPairs: ebmInteraction=%p, countPairsMax=%" IntEbmTypePrintf 
+      ", pairFeatureIndexesReturn=%p, interactionScoresReturn=%p, countPairsReturn=%p", 
+      static_cast<void *>(ebmInteraction), 
+      countPairsMax, 
+      static_cast<void *>(pairFeatureIndexesReturn), 
+      static_cast<void *>(interactionScoresReturn),
+      static_cast<void *>(countPairsReturn)
+   );
+
+   EBM_ASSERT(nullptr != ebmInteraction);
+   EbmInteractionState * pEbmInteractionState = reinterpret_cast<EbmInteractionState *>(ebmInteraction);
+
+   if(nullptr == countPairsReturn) {
+      LOG_0(TraceLevelError, "ERROR GetTopInteractionPairs countPairsReturn cannot be nullptr");
+      return 1;
+   }
+   *countPairsReturn = 0;
+   if(countPairsMax <= 0) {
+      LOG_0(TraceLevelInfo, "INFO GetTopInteractionPairs no pairs requested");
+      return 0;
+   }
+   if(!IsNumberConvertable<size_t, IntEbmType>(countPairsMax)) {
+      LOG_0(TraceLevelWarning, "WARNING GetTopInteractionPairs !IsNumberConvertable<size_t, IntEbmType>(countPairsMax)");
+      return 1;
+   }
+   if(nullptr == pairFeatureIndexesReturn || nullptr == interactionScoresReturn) {
+      LOG_0(TraceLevelError, "ERROR GetTopInteractionPairs pairFeatureIndexesReturn and interactionScoresReturn cannot be nullptr");
+      return 1;
+   }
+   const size_t cFeatures = pEbmInteractionState->m_cFeatures;
+   // there are cFeatures * (cFeatures - 1) / 2 pairs.  We halve whichever of the two is even before multiplying
+   const size_t cHalf = 0 == cFeatures % 2 ? cFeatures / 2 : (cFeatures - 1) / 2;
+   const size_t cOther = 0 == cFeatures % 2 ? cFeatures - 1 : cFeatures;
+   if(cFeatures < 2) {
+      LOG_0(TraceLevelInfo, "INFO GetTopInteractionPairs fewer than 2 features");
+      return 0;
+   }
+   if(IsMultiplyError(cHalf, cOther)) {
+      LOG_0(TraceLevelWarning, "WARNING GetTopInteractionPairs IsMultiplyError(cHalf, cOther)");
+      return 1;
+   }
+   const size_t cPairsAll = cHalf * cOther;
+   const size_t cPairsMax = static_cast<size_t>(countPairsMax) < cPairsAll ? static_cast<size_t>(countPairsMax) : cPairsAll;
+
+   const Feature * const aFeatures = pEbmInteractionState->m_aFeatures;
+   const bool bBounded = nullptr != pEbmInteractionState->m_pDataSet && 
+      !(IsClassification(pEbmInteractionState->m_runtimeLearningTypeOrCountTargetClasses) && 
+      pEbmInteractionState->m_runtimeLearningTypeOrCountTargetClasses <= ptrdiff_t { 1 });
+
+   IntEbmType * const aiFeaturesPartner = static_cast<IntEbmType *>(malloc(sizeof(IntEbmType) * cFeatures));
+   FloatEbmType * const aScoresPartner = static_cast<FloatEbmType *>(malloc(sizeof(FloatEbmType) * cFeatures));
+   if(nullptr == aiFeaturesPartner || nullptr == aScoresPartner) {
+      LOG_0(TraceLevelWarning, "WARNING GetTopInteractionPairs out of memory");
+      free(aiFeaturesPartner);
+      free(aScoresPartner);
+      return 1;
+   }
+
+   // first we exactly score the pairs that would cost as much to bound as to score, which also gives us a threshold to prune the rest against
+   size_t cPairs = 0;
+   for(size_t iFeature1 = 0; iFeature1 < cFeatures; ++iFeature1) {
+      const size_t cBins1 = aFeatures[iFeature1].m_cBins;
+      size_t cPartners = 0;
+      for(size_t iFeature2 = iFeature1 + 1; iFeature2 < cFeatures; ++iFeature2) {
+         const size_t cBins2 = aFeatures[iFeature2].m_cBins;
+         if(!bBounded || !IsInteractionPairBounded(pEbmInteractionState->m_cInteractionCellsBoundedMin, cBins1, cBins2)) {
+            aiFeaturesPartner[cPartners] = static_cast<IntEbmType>(iFeature2);
+            ++cPartners;
+         }
+      }
+      if(0 != cPartners) {
+         if(0 != ScoreInteractionsAnchored(pEbmInteractionState, iFeature1, cPartners, aiFeaturesPartner, aScoresPartner)) {
+            free(aiFeaturesPartner);
+            free(aScoresPartner);
+            return 1;
+         }
+         for(size_t iPartner = 0; iPartner < cPartners; ++iPartner) {
+            cPairs = InsertTopInteraction(
+               cPairsMax, 
+               cPairs, 
+               pairFeatureIndexesReturn, 
+               interactionScoresReturn, 
+               aScoresPartner[iPartner], 
+               iFeature1, 
+               static_cast<size_t>(aiFeaturesPartner[iPartner])
+            );
+         }
+      }
+   }
+   free(aiFeaturesPartner);
+   free(aScoresPartner);
+
+   if(bBounded && SearchTopInteractionsBounded(pEbmInteractionState, cPairsMax, &cPairs, pairFeatureIndexesReturn, interactionScoresReturn)) {
+      return 1;
+   }
+   EBM_ASSERT(cPairsMax == cPairs);
+   *countPairsReturn = static_cast<IntEbmType>(cPairs);
+   LOG_0(TraceLevelInfo, "Exited GetTopInteractionPairs");
+   return 0;
+}
+
 EBM_NATIVE_IMPORT_EXPORT_BODY void EBM_NATIVE_CALLING_CONVENTION FreeInteraction(
    PEbmInteraction ebmInteraction
 ) {
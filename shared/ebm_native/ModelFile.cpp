@@ -0,0 +1,945 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <stddef.h> // size_t, ptrdiff_t
+#include <stdlib.h> // malloc, free
+#include <string.h> // memcpy, memset, memcmp
+#include <stdio.h> // FILE, fopen, fwrite, fclose
+#include <new> // std::nothrow
+#include <type_traits> // std::is_standard_layout
+#include <cmath> // std::isnan
+
+#ifdef _WIN32
+// we only need windows.h here to memory map our model files.  Keep it out of the precompiled header so that other files don't see it
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else // _WIN32
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <fcntl.h> // open
+#include <unistd.h> // close
+#endif // _WIN32
+
+#include "ebm_native.h"
+
+#include "EbmInternal.h"
+// very independent includes
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "Scoring.h"
+
+// Our model files are a flat image of the arrays that we score from, so we can memory map a file and point straight into it without copying or parsing
+// anything.  Many processes that load the same model file share the same pages in the OS page cache.  Everything is stored in our native
+// IntEbmType/UIntEbmType/FloatEbmType formats in little endian byte order.  The layout is:
+//
+//   ModelFileHeader
+//   EbmNativeFeature[cFeatures]
+//   UIntEbmType[cFeatures] file offsets of each feature's cut points (only if the model has cut points, zero for features without cut points)
+//   FloatEbmType[] cut points of each feature
+//   EbmNativeFeatureCombination[cFeatureCombinations]
+//   IntEbmType[cFeatureCombinationIndexes]
+//   UIntEbmType[cFeatureCombinations] file offsets of each model tensor
+//   FloatEbmType[] expanded model tensors
+//   FloatEbmType[cVectorLength] intercept (optional)
+//
+// Each section starts on a k_cBytesModelFileAlignment boundary.  Our memory mappings are page aligned, so our tensors start on cache line boundaries
+
+// the trailing 0x1A byte stops "type" on windows from dumping binary garbage to the console
+static constexpr char k_modelFileMagic[8] = { 'E', 'B', 'M', 'M', 'O', 'D', 'L', '\x1A' };
+constexpr UIntEbmType k_modelFileVersion = 1;
+constexpr size_t k_cBytesModelFileAlignment = 64;
+
+struct ModelFileHeader final {
+   char m_magic[8];
+   UIntEbmType m_version;
+   UIntEbmType m_cBytesFile;
+   IntEbmType m_runtimeLearningTypeOrCountTargetClasses;
+   UIntEbmType m_cFeatures;
+   UIntEbmType m_cFeatureCombinations;
+   UIntEbmType m_cFeatureCombinationIndexes;
+   UIntEbmType m_offsetFeatures;
+   // zero if the model was saved without cut points, in which case we can only score binned data
+   UIntEbmType m_offsetCutPointOffsets;
+   UIntEbmType m_offsetFeatureCombinations;
+   UIntEbmType m_offsetFeatureCombinationIndexes;
+   UIntEbmType m_offsetTensorOffsets;
+   // zero if the model was saved without an intercept
+   UIntEbmType m_offsetIntercept;
+   // keep the header a multiple of 8 bytes so that we can add fields in later versions without changing the alignment of what follows
+   UIntEbmType m_reserved[3];
+};
+
+static_assert(std::is_standard_layout<ModelFileHeader>::value, "we memcpy our ModelFileHeader to and from the file, so it should be standard layout");
+static_assert(sizeof(ModelFileHeader) == 16 * sizeof(UIntEbmType), "our ModelFileHeader should not have any padding");
+static_assert(sizeof(EbmNativeFeature) == 3 * sizeof(IntEbmType), "we store EbmNativeFeature directly in our model files");
+static_assert(sizeof(EbmNativeFeatureCombination) == sizeof(IntEbmType), "we store EbmNativeFeatureCombination directly in our model files");
+
+struct EbmModel final {
+   // the caller gets an opaque PEbmModel, so there's no need for this to be standard layout
+   const unsigned char * m_pFile;
+   size_t m_cBytesFile;
+#ifdef _WIN32
+   HANDLE m_hFileMapping;
+#endif // _WIN32
+
+   ptrdiff_t m_runtimeLearningTypeOrCountTargetClasses;
+   size_t m_cFeatures;
+   size_t m_cFeatureCombinations;
+   const EbmNativeFeature * m_aFeatures;
+   // nullptr if the model has no cut points
+   const FloatEbmType ** m_aaCutPoints;
+   const EbmNativeFeatureCombination * m_aFeatureCombinations;
+   const IntEbmType * m_aFeatureCombinationIndexes;
+   const FloatEbmType ** m_aaTensors;
+   const FloatEbmType * m_aIntercept;
+};
+
+static bool IsLittleEndian() {
+   const UIntEbmType one = 1;
+   unsigned char firstByte;
+   memcpy(&firstByte, &one, sizeof(firstByte));
+   return 1 == firstByte;
+}
+
+static EBM_INLINE size_t AlignModelFileOffset(const size_t offset) {
+   return (offset + (k_cBytesModelFileAlignment - 1)) & ~(k_cBytesModelFileAlignment - 1);
+}
+
+static EBM_INLINE bool IsAlignModelFileOffsetError(const size_t offset) {
+   return IsAddError(offset, k_cBytesModelFileAlignment - 1);
+}
+
+static EBM_INLINE size_t GetModelVectorLength(const ptrdiff_t runtimeLearningTypeOrCountTargetClasses) {
+   // with only 1 target class our models are empty
+   return IsClassification(runtimeLearningTypeOrCountTargetClasses) && runtimeLearningTypeOrCountTargetClasses <= ptrdiff_t { 1 } ?
+      size_t { 0 } : GetVectorLength(runtimeLearningTypeOrCountTargetClasses);
+}
+
+static bool GetCountCutPoints(const EbmNativeFeature * const pFeature, size_t * const pcCutPointsReturn) {
+   const IntEbmType countBins = pFeature->countBins;
+   const bool bMissing = EBM_FALSE != pFeature->hasMissing;
+   if(countBins < 0 || !IsNumberConvertable<size_t, IntEbmType>(countBins)) {
+      LOG_0(TraceLevelWarning, "WARNING GetCountCutPoints countBins is not a valid bin count");
+      return true;
+   }
+   const size_t cBins = static_cast<size_t>(countBins);
+   const size_t cNonCutBins = bMissing ? size_t { 2 } : size_t { 1 };
+   *pcCutPointsReturn = cBins < cNonCutBins ? size_t { 0 } : cBins - cNonCutBins;
+   return false;
+}
+
+// Discretize and our raw scoring binary search for each value's bin, which only works if the cut points are strictly increasing.  Returns true if 
+// they aren't, including if any of them is NaN
+static bool IsCutPointsInvalid(const size_t cCutPoints, const FloatEbmType * const aCutPoints) {
+   for(size_t iCutPoint = 0; iCutPoint < cCutPoints; ++iCutPoint) {
+      if(std::isnan(aCutPoints[iCutPoint]) || 0 != iCutPoint && !(aCutPoints[iCutPoint - 1] < aCutPoints[iCutPoint])) {
+         return true;
+      }
+   }
+   return false;
+}
+
+// returns the number of items in each feature combination's expanded tensor, or true on an error
+static bool GetTensorItemCounts(
+   const size_t cVectorLength,
+   const size_t cFeatures,
+   const EbmNativeFeature * const aFeatures,
+   const size_t cFeatureCombinations,
+   const EbmNativeFeatureCombination * const aFeatureCombinations,
+   const size_t cFeatureCombinationIndexes,
+   const IntEbmType * const aFeatureCombinationIndexes,
+   size_t * const acTensorItemsReturn
+) {
+   size_t iFeatureCombinationIndex = 0;
+   for(size_t iFeatureCombination = 0; iFeatureCombination < cFeatureCombinations; ++iFeatureCombination) {
+      const IntEbmType countFeaturesInCombination = aFeatureCombinations[iFeatureCombination].countFeaturesInCombination;
+      if(countFeaturesInCombination < 0 || !IsNumberConvertable<size_t, IntEbmType>(countFeaturesInCombination)) {
+         LOG_0(TraceLevelWarning, "WARNING GetTensorItemCounts countFeaturesInCombination is not a valid count");
+         return true;
+      }
+      const size_t cFeaturesInCombination = static_cast<size_t>(countFeaturesInCombination);
+      if(cFeatureCombinationIndexes - iFeatureCombinationIndex < cFeaturesInCombination) {
+         LOG_0(TraceLevelWarning, "WARNING GetTensorItemCounts not enough featureCombinationIndexes");
+         return true;
+      }
+      size_t cTensorItems = cVectorLength;
+      for(size_t iDimension = 0; iDimension < cFeaturesInCombination; ++iDimension) {
+         const IntEbmType indexFeature = aFeatureCombinationIndexes[iFeatureCombinationIndex];
+         ++iFeatureCombinationIndex;
+         if(indexFeature < 0 || !IsNumberConvertable<size_t, IntEbmType>(indexFeature) || cFeatures <= static_cast<size_t>(indexFeature)) {
+            LOG_0(TraceLevelWarning, "WARNING GetTensorItemCounts indexFeature is not a valid feature index");
+            return true;
+         }
+         const IntEbmType countBins = aFeatures[static_cast<size_t>(indexFeature)].countBins;
+         if(countBins < 0 || !IsNumberConvertable<size_t, IntEbmType>(countBins)) {
+            LOG_0(TraceLevelWarning, "WARNING GetTensorItemCounts countBins is not a valid bin count");
+            return true;
+         }
+         const size_t cBins = static_cast<size_t>(countBins);
+         if(0 == cBins) {
+            // a feature with 0 bins can't have any instances, and a tensor with no cells can't score anything
+            LOG_0(TraceLevelWarning, "WARNING GetTensorItemCounts a feature combination has a feature with 0 bins");
+            return true;
+         }
+         if(IsMultiplyError(cTensorItems, cBins)) {
+            LOG_0(TraceLevelWarning, "WARNING GetTensorItemCounts IsMultiplyError(cTensorItems, cBins)");
+            return true;
+         }
+         cTensorItems *= cBins;
+      }
+      acTensorItemsReturn[iFeatureCombination] = cTensorItems;
+   }
+   if(cFeatureCombinationIndexes != iFeatureCombinationIndex) {
+      LOG_0(TraceLevelWarning, "WARNING GetTensorItemCounts cFeatureCombinationIndexes != iFeatureCombinationIndex");
+      return true;
+   }
+   return false;
+}
+
+// reserves an aligned section of cItems * cBytesPerItem bytes at the end of our file layout and returns its offset, or true on an error
+static bool ReserveSection(const size_t cItems, const size_t cBytesPerItem, size_t * const pcBytesFile, size_t * const pOffsetReturn) {
+   if(IsAlignModelFileOffsetError(*pcBytesFile)) {
+      LOG_0(TraceLevelWarning, "WARNING ReserveSection IsAlignModelFileOffsetError(*pcBytesFile)");
+      return true;
+   }
+   const size_t offset = AlignModelFileOffset(*pcBytesFile);
+   if(IsMultiplyError(cItems, cBytesPerItem)) {
+      LOG_0(TraceLevelWarning, "WARNING ReserveSection IsMultiplyError(cItems, cBytesPerItem)");
+      return true;
+   }
+   const size_t cBytes = cItems * cBytesPerItem;
+   if(IsAddError(offset, cBytes)) {
+      LOG_0(TraceLevelWarning, "WARNING ReserveSection IsAddError(offset, cBytes)");
+      return true;
+   }
+   *pcBytesFile = offset + cBytes;
+   *pOffsetReturn = offset;
+   return false;
+}
+
+static IntEbmType SaveModel(
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   const IntEbmType countFeatures,
+   const EbmNativeFeature * const features,
+   const FloatEbmType * const * const cutPointsLowerBoundInclusive,
+   const IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * const featureCombinations,
+   const IntEbmType * const featureCombinationIndexes,
+   const FloatEbmType * const * const modelFeatureCombinationTensors,
+   const FloatEbmType * const intercept,
+   const char * const filePath
+) {
+   // cutPointsLowerBoundInclusive can be nullptr if the caller only wants to score binned data from this model
+   // intercept can be nullptr, in which case we start from zero
+
+   if(nullptr == filePath) {
+      LOG_0(TraceLevelError, "ERROR SaveModel nullptr == filePath");
+      return 1;
+   }
+   if(countFeatures < 0) {
+      LOG_0(TraceLevelError, "ERROR SaveModel countFeatures must be positive");
+      return 1;
+   }
+   if(0 != countFeatures && nullptr == features) {
+      LOG_0(TraceLevelError, "ERROR SaveModel features cannot be nullptr if 0 < countFeatures");
+      return 1;
+   }
+   if(countFeatureCombinations < 0) {
+      LOG_0(TraceLevelError, "ERROR SaveModel countFeatureCombinations must be positive");
+      return 1;
+   }
+   if(0 != countFeatureCombinations && nullptr == featureCombinations) {
+      LOG_0(TraceLevelError, "ERROR SaveModel featureCombinations cannot be nullptr if 0 < countFeatureCombinations");
+      return 1;
+   }
+   if(0 != countFeatureCombinations && nullptr == modelFeatureCombinationTensors) {
+      LOG_0(TraceLevelError, "ERROR SaveModel modelFeatureCombinationTensors cannot be nullptr if 0 < countFeatureCombinations");
+      return 1;
+   }
+   if(!IsLittleEndian()) {
+      LOG_0(TraceLevelWarning, "WARNING SaveModel our model files are little endian and this machine is not");
+      return 1;
+   }
+   if(!IsNumberConvertable<size_t, IntEbmType>(countFeatures)) {
+      LOG_0(TraceLevelWarning, "WARNING SaveModel !IsNumberConvertable<size_t, IntEbmType>(countFeatures)");
+      return 1;
+   }
+   if(!IsNumberConvertable<size_t, IntEbmType>(countFeatureCombinations)) {
+      LOG_0(TraceLevelWarning, "WARNING SaveModel !IsNumberConvertable<size_t, IntEbmType>(countFeatureCombinations)");
+      return 1;
+   }
+   const size_t cFeatures = static_cast<size_t>(countFeatures);
+   const size_t cFeatureCombinations = static_cast<size_t>(countFeatureCombinations);
+   const size_t cVectorLength = GetModelVectorLength(runtimeLearningTypeOrCountTargetClasses);
+
+   size_t cFeatureCombinationIndexes = 0;
+   for(size_t iFeatureCombination = 0; iFeatureCombination < cFeatureCombinations; ++iFeatureCombination) {
+      const IntEbmType countFeaturesInCombination = featureCombinations[iFeatureCombination].countFeaturesInCombination;
+      if(countFeaturesInCombination < 0 || !IsNumberConvertable<size_t, IntEbmType>(countFeaturesInCombination)) {
+         LOG_0(TraceLevelWarning, "WARNING SaveModel countFeaturesInCombination is not a valid count");
+         return 1;
+      }
+      if(IsAddError(cFeatureCombinationIndexes, static_cast<size_t>(countFeaturesInCombination))) {
+         LOG_0(TraceLevelWarning, "WARNING SaveModel IsAddError(cFeatureCombinationIndexes, countFeaturesInCombination)");
+         return 1;
+      }
+      cFeatureCombinationIndexes += static_cast<size_t>(countFeaturesInCombination);
+   }
+   if(0 != cFeatureCombinationIndexes && nullptr == featureCombinationIndexes) {
+      LOG_0(TraceLevelError, "ERROR SaveModel featureCombinationIndexes cannot be nullptr if there are features in our feature combinations");
+      return 1;
+   }
+
+   if(IsMultiplyError(sizeof(size_t) * 2, cFeatures + cFeatureCombinations)) {
+      LOG_0(TraceLevelWarning, "WARNING SaveModel IsMultiplyError(sizeof(size_t) * 2, cFeatures + cFeatureCombinations)");
+      return 1;
+   }
+   // we keep the counts and offsets of our variable sized cut point and tensor arrays in one allocation.  Add 1 so that we don't malloc zero bytes
+   size_t * const aSizes = static_cast<size_t *>(malloc(sizeof(size_t) * 2 * (cFeatures + cFeatureCombinations) + 1));
+   if(nullptr == aSizes) {
+      LOG_0(TraceLevelWarning, "WARNING SaveModel nullptr == aSizes");
+      return 1;
+   }
+   size_t * const acCutPoints = aSizes;
+   size_t * const aCutPointOffsets = acCutPoints + cFeatures;
+   size_t * const acTensorItems = aCutPointOffsets + cFeatures;
+   size_t * const aTensorOffsets = acTensorItems + cFeatureCombinations;
+
+   if(GetTensorItemCounts(
+      cVectorLength,
+      cFeatures,
+      features,
+      cFeatureCombinations,
+      featureCombinations,
+      cFeatureCombinationIndexes,
+      featureCombinationIndexes,
+      acTensorItems
+   )) {
+      free(aSizes);
+      return 1;
+   }
+
+   // first pass: lay out our sections so that we know the size of our file
+   size_t cBytesFile = sizeof(ModelFileHeader);
+   size_t offsetFeatures;
+   if(ReserveSection(cFeatures, sizeof(EbmNativeFeature), &cBytesFile, &offsetFeatures)) {
+      free(aSizes);
+      return 1;
+   }
+   size_t offsetCutPointOffsets = 0;
+   if(nullptr != cutPointsLowerBoundInclusive) {
+      if(ReserveSection(cFeatures, sizeof(UIntEbmType), &cBytesFile, &offsetCutPointOffsets)) {
+         free(aSizes);
+         return 1;
+      }
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         if(GetCountCutPoints(&features[iFeature], &acCutPoints[iFeature])) {
+            free(aSizes);
+            return 1;
+         }
+         aCutPointOffsets[iFeature] = 0;
+         if(0 != acCutPoints[iFeature]) {
+            if(nullptr == cutPointsLowerBoundInclusive[iFeature]) {
+               LOG_0(TraceLevelError, "ERROR SaveModel cutPointsLowerBoundInclusive cannot have nullptr for a feature with cut points");
+               free(aSizes);
+               return 1;
+            }
+            if(IsCutPointsInvalid(acCutPoints[iFeature], cutPointsLowerBoundInclusive[iFeature])) {
+               LOG_0(TraceLevelError, "ERROR SaveModel cut points must be strictly increasing");
+               free(aSizes);
+               return 1;
+            }
+            if(ReserveSection(acCutPoints[iFeature], sizeof(FloatEbmType), &cBytesFile, &aCutPointOffsets[iFeature])) {
+               free(aSizes);
+               return 1;
+            }
+         }
+      }
+   }
+   size_t offsetFeatureCombinations;
+   if(ReserveSection(cFeatureCombinations, sizeof(EbmNativeFeatureCombination), &cBytesFile, &offsetFeatureCombinations)) {
+      free(aSizes);
+      return 1;
+   }
+   size_t offsetFeatureCombinationIndexes;
+   if(ReserveSection(cFeatureCombinationIndexes, sizeof(IntEbmType), &cBytesFile, &offsetFeatureCombinationIndexes)) {
+      free(aSizes);
+      return 1;
+   }
+   size_t offsetTensorOffsets;
+   if(ReserveSection(cFeatureCombinations, sizeof(UIntEbmType), &cBytesFile, &offsetTensorOffsets)) {
+      free(aSizes);
+      return 1;
+   }
+   for(size_t iFeatureCombination = 0; iFeatureCombination < cFeatureCombinations; ++iFeatureCombination) {
+      if(0 != acTensorItems[iFeatureCombination] && nullptr == modelFeatureCombinationTensors[iFeatureCombination]) {
+         LOG_0(TraceLevelError, "ERROR SaveModel modelFeatureCombinationTensors cannot have nullptr for a non-empty tensor");
+         free(aSizes);
+         return 1;
+      }
+      if(ReserveSection(acTensorItems[iFeatureCombination], sizeof(FloatEbmType), &cBytesFile, &aTensorOffsets[iFeatureCombination])) {
+         free(aSizes);
+         return 1;
+      }
+   }
+   size_t offsetIntercept = 0;
+   if(nullptr != intercept && 0 != cVectorLength) {
+      if(ReserveSection(cVectorLength, sizeof(FloatEbmType), &cBytesFile, &offsetIntercept)) {
+         free(aSizes);
+         return 1;
+      }
+   }
+
+   // second pass: build the file image in memory, then write it out in one go.  Zeroing the buffer keeps our padding bytes deterministic
+   unsigned char * const pFile = static_cast<unsigned char *>(malloc(cBytesFile));
+   if(nullptr == pFile) {
+      LOG_0(TraceLevelWarning, "WARNING SaveModel nullptr == pFile");
+      free(aSizes);
+      return 1;
+   }
+   memset(pFile, 0, cBytesFile);
+
+   ModelFileHeader header;
+   memset(&header, 0, sizeof(header));
+   memcpy(header.m_magic, k_modelFileMagic, sizeof(header.m_magic));
+   header.m_version = k_modelFileVersion;
+   header.m_cBytesFile = static_cast<UIntEbmType>(cBytesFile);
+   header.m_runtimeLearningTypeOrCountTargetClasses = static_cast<IntEbmType>(runtimeLearningTypeOrCountTargetClasses);
+   header.m_cFeatures = static_cast<UIntEbmType>(cFeatures);
+   header.m_cFeatureCombinations = static_cast<UIntEbmType>(cFeatureCombinations);
+   header.m_cFeatureCombinationIndexes = static_cast<UIntEbmType>(cFeatureCombinationIndexes);
+   header.m_offsetFeatures = static_cast<UIntEbmType>(offsetFeatures);
+   header.m_offsetCutPointOffsets = static_cast<UIntEbmType>(offsetCutPointOffsets);
+   header.m_offsetFeatureCombinations = static_cast<UIntEbmType>(offsetFeatureCombinations);
+   header.m_offsetFeatureCombinationIndexes = static_cast<UIntEbmType>(offsetFeatureCombinationIndexes);
+   header.m_offsetTensorOffsets = static_cast<UIntEbmType>(offsetTensorOffsets);
+   header.m_offsetIntercept = static_cast<UIntEbmType>(offsetIntercept);
+   memcpy(pFile, &header, sizeof(header));
+
+   if(0 != cFeatures) {
+      memcpy(pFile + offsetFeatures, features, sizeof(EbmNativeFeature) * cFeatures);
+   }
+   if(nullptr != cutPointsLowerBoundInclusive) {
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         const UIntEbmType offsetCutPoints = static_cast<UIntEbmType>(aCutPointOffsets[iFeature]);
+         memcpy(pFile + offsetCutPointOffsets + sizeof(UIntEbmType) * iFeature, &offsetCutPoints, sizeof(offsetCutPoints));
+         if(0 != acCutPoints[iFeature]) {
+            memcpy(pFile + aCutPointOffsets[iFeature], cutPointsLowerBoundInclusive[iFeature], sizeof(FloatEbmType) * acCutPoints[iFeature]);
+         }
+      }
+   }
+   if(0 != cFeatureCombinations) {
+      memcpy(pFile + offsetFeatureCombinations, featureCombinations, sizeof(EbmNativeFeatureCombination) * cFeatureCombinations);
+   }
+   if(0 != cFeatureCombinationIndexes) {
+      memcpy(pFile + offsetFeatureCombinationIndexes, featureCombinationIndexes, sizeof(IntEbmType) * cFeatureCombinationIndexes);
+   }
+   for(size_t iFeatureCombination = 0; iFeatureCombination < cFeatureCombinations; ++iFeatureCombination) {
+      const UIntEbmType offsetTensor = static_cast<UIntEbmType>(aTensorOffsets[iFeatureCombination]);
+      memcpy(pFile + offsetTensorOffsets + sizeof(UIntEbmType) * iFeatureCombination, &offsetTensor, sizeof(offsetTensor));
+      if(0 != acTensorItems[iFeatureCombination]) {
+         memcpy(pFile + aTensorOffsets[iFeatureCombination], modelFeatureCombinationTensors[iFeatureCombination],
+            sizeof(FloatEbmType) * acTensorItems[iFeatureCombination]);
+      }
+   }
+   if(0 != offsetIntercept) {
+      memcpy(pFile + offsetIntercept, intercept, sizeof(FloatEbmType) * cVectorLength);
+   }
+   free(aSizes);
+
+   FILE * const pFileHandle = fopen(filePath, "wb");
+   if(nullptr == pFileHandle) {
+      LOG_0(TraceLevelWarning, "WARNING SaveModel nullptr == pFileHandle");
+      free(pFile);
+      return 1;
+   }
+   const size_t cBytesWritten = fwrite(pFile, 1, cBytesFile, pFileHandle);
+   free(pFile);
+   // fclose can fail when flushing our buffered bytes, so check it too
+   if(0 != fclose(pFileHandle) || cBytesFile != cBytesWritten) {
+      LOG_0(TraceLevelWarning, "WARNING SaveModel failed to write the model file");
+      return 1;
+   }
+   return 0;
+}
+
+// checks that a section of cItems * cBytesPerItem bytes at offset lies within our file and is aligned for its items
+static bool IsSectionInvalid(const UIntEbmType offset, const size_t cItems, const size_t cBytesPerItem, const size_t cBytesFile) {
+   if(!IsNumberConvertable<size_t, UIntEbmType>(offset)) {
+      return true;
+   }
+   const size_t offsetSection = static_cast<size_t>(offset);
+   if(0 != offsetSection % k_cBytesModelFileAlignment || offsetSection < sizeof(ModelFileHeader) || cBytesFile < offsetSection) {
+      return true;
+   }
+   if(IsMultiplyError(cItems, cBytesPerItem)) {
+      return true;
+   }
+   return cBytesFile - offsetSection < cItems * cBytesPerItem;
+}
+
+// points our model at the arrays within our mapped file.  We validate every count and offset, since model files come from outside our process
+static bool ConstructModel(EbmModel * const pModel) {
+   const unsigned char * const pFile = pModel->m_pFile;
+   const size_t cBytesFile = pModel->m_cBytesFile;
+
+   if(cBytesFile < sizeof(ModelFileHeader)) {
+      LOG_0(TraceLevelWarning, "WARNING ConstructModel cBytesFile < sizeof(ModelFileHeader)");
+      return true;
+   }
+   ModelFileHeader header;
+   memcpy(&header, pFile, sizeof(header));
+   if(0 != memcmp(header.m_magic, k_modelFileMagic, sizeof(header.m_magic))) {
+      LOG_0(TraceLevelWarning, "WARNING ConstructModel this is not an EBM model file");
+      return true;
+   }
+   if(k_modelFileVersion != header.m_version) {
+      LOG_0(TraceLevelWarning, "WARNING ConstructModel unsupported model file version");
+      return true;
+   }
+   if(header.m_cBytesFile != static_cast<UIntEbmType>(cBytesFile)) {
+      LOG_0(TraceLevelWarning, "WARNING ConstructModel the model file is truncated or has extra bytes");
+      return true;
+   }
+   if(!IsNumberConvertable<ptrdiff_t, IntEbmType>(header.m_runtimeLearningTypeOrCountTargetClasses) ||
+      header.m_runtimeLearningTypeOrCountTargetClasses < IntEbmType { k_Regression })
+   {
+      LOG_0(TraceLevelWarning, "WARNING ConstructModel invalid runtimeLearningTypeOrCountTargetClasses");
+      return true;
+   }
+   if(!IsNumberConvertable<size_t, UIntEbmType>(header.m_cFeatures) ||
+      !IsNumberConvertable<IntEbmType, UIntEbmType>(header.m_cFeatures) ||
+      !IsNumberConvertable<size_t, UIntEbmType>(header.m_cFeatureCombinations) ||
+      !IsNumberConvertable<IntEbmType, UIntEbmType>(header.m_cFeatureCombinations) ||
+      !IsNumberConvertable<size_t, UIntEbmType>(header.m_cFeatureCombinationIndexes))
+   {
+      LOG_0(TraceLevelWarning, "WARNING ConstructModel invalid counts");
+      return true;
+   }
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = static_cast<ptrdiff_t>(header.m_runtimeLearningTypeOrCountTargetClasses);
+   const size_t cFeatures = static_cast<size_t>(header.m_cFeatures);
+   const size_t cFeatureCombinations = static_cast<size_t>(header.m_cFeatureCombinations);
+   const size_t cFeatureCombinationIndexes = static_cast<size_t>(header.m_cFeatureCombinationIndexes);
+   const size_t cVectorLength = GetModelVectorLength(runtimeLearningTypeOrCountTargetClasses);
+
+   if(IsSectionInvalid(header.m_offsetFeatures, cFeatures, sizeof(EbmNativeFeature), cBytesFile) ||
+      IsSectionInvalid(header.m_offsetFeatureCombinations, cFeatureCombinations, sizeof(EbmNativeFeatureCombination), cBytesFile) ||
+      IsSectionInvalid(header.m_offsetFeatureCombinationIndexes, cFeatureCombinationIndexes, sizeof(IntEbmType), cBytesFile) ||
+      IsSectionInvalid(header.m_offsetTensorOffsets, cFeatureCombinations, sizeof(UIntEbmType), cBytesFile) ||
+      0 != header.m_offsetCutPointOffsets && IsSectionInvalid(header.m_offsetCutPointOffsets, cFeatures, sizeof(UIntEbmType), cBytesFile) ||
+      0 != header.m_offsetIntercept && IsSectionInvalid(header.m_offsetIntercept, cVectorLength, sizeof(FloatEbmType), cBytesFile))
+   {
+      LOG_0(TraceLevelWarning, "WARNING ConstructModel a model file section is out of bounds");
+      return true;
+   }
+
+   // our sections are aligned within the file and our mapping is page aligned, so we can point directly into the mapping
+   const EbmNativeFeature * const aFeatures = reinterpret_cast<const EbmNativeFeature *>(pFile + static_cast<size_t>(header.m_offsetFeatures));
+   const EbmNativeFeatureCombination * const aFeatureCombinations =
+      reinterpret_cast<const EbmNativeFeatureCombination *>(pFile + static_cast<size_t>(header.m_offsetFeatureCombinations));
+   const IntEbmType * const aFeatureCombinationIndexes =
+      reinterpret_cast<const IntEbmType *>(pFile + static_cast<size_t>(header.m_offsetFeatureCombinationIndexes));
+
+   if(IsMultiplyError(sizeof(size_t), cFeatureCombinations)) {
+      LOG_0(TraceLevelWarning, "WARNING ConstructModel IsMultiplyError(sizeof(size_t), cFeatureCombinations)");
+      return true;
+   }
+   // add 1 so that we don't call malloc with zero bytes if there are no feature combinations
+   size_t * const acTensorItems = static_cast<size_t *>(malloc(sizeof(size_t) * cFeatureCombinations + 1));
+   if(nullptr == acTensorItems) {
+      LOG_0(TraceLevelWarning, "WARNING ConstructModel nullptr == acTensorItems");
+      return true;
+   }
+   if(GetTensorItemCounts(
+      cVectorLength,
+      cFeatures,
+      aFeatures,
+      cFeatureCombinations,
+      aFeatureCombinations,
+      cFeatureCombinationIndexes,
+      aFeatureCombinationIndexes,
+      acTensorItems
+   )) {
+      free(acTensorItems);
+      return true;
+   }
+
+   // the only things we build on load are these two small pointer arrays, since our scoring interface takes arrays of pointers
+   // add 1 so that we don't call malloc with zero bytes if there are no feature combinations
+   const FloatEbmType ** const aaTensors = static_cast<const FloatEbmType **>(malloc(sizeof(FloatEbmType *) * cFeatureCombinations + 1));
+   if(nullptr == aaTensors) {
+      LOG_0(TraceLevelWarning, "WARNING ConstructModel nullptr == aaTensors");
+      free(acTensorItems);
+      return true;
+   }
+   const unsigned char * pTensorOffset = pFile + static_cast<size_t>(header.m_offsetTensorOffsets);
+   for(size_t iFeatureCombination = 0; iFeatureCombination < cFeatureCombinations; ++iFeatureCombination) {
+      UIntEbmType offsetTensor;
+      memcpy(&offsetTensor, pTensorOffset, sizeof(offsetTensor));
+      pTensorOffset += sizeof(offsetTensor);
+      if(IsSectionInvalid(offsetTensor, acTensorItems[iFeatureCombination], sizeof(FloatEbmType), cBytesFile)) {
+         LOG_0(TraceLevelWarning, "WARNING ConstructModel a model tensor is out of bounds");
+         free(aaTensors);
+         free(acTensorItems);
+         return true;
+      }
+      aaTensors[iFeatureCombination] = reinterpret_cast<const FloatEbmType *>(pFile + static_cast<size_t>(offsetTensor));
+   }
+   free(acTensorItems);
+
+   const FloatEbmType ** aaCutPoints = nullptr;
+   if(0 != header.m_offsetCutPointOffsets) {
+      // add 1 so that we don't call malloc with zero bytes if there are no features
+      aaCutPoints = static_cast<const FloatEbmType **>(malloc(sizeof(FloatEbmType *) * cFeatures + 1));
+      if(nullptr == aaCutPoints) {
+         LOG_0(TraceLevelWarning, "WARNING ConstructModel nullptr == aaCutPoints");
+         free(aaTensors);
+         return true;
+      }
+      const unsigned char * pCutPointOffset = pFile + static_cast<size_t>(header.m_offsetCutPointOffsets);
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         UIntEbmType offsetCutPoints;
+         memcpy(&offsetCutPoints, pCutPointOffset, sizeof(offsetCutPoints));
+         pCutPointOffset += sizeof(offsetCutPoints);
+         size_t cCutPoints;
+         if(GetCountCutPoints(&aFeatures[iFeature], &cCutPoints)) {
+            free(aaCutPoints);
+            free(aaTensors);
+            return true;
+         }
+         aaCutPoints[iFeature] = nullptr;
+         if(0 != cCutPoints) {
+            if(IsSectionInvalid(offsetCutPoints, cCutPoints, sizeof(FloatEbmType), cBytesFile)) {
+               LOG_0(TraceLevelWarning, "WARNING ConstructModel cut points are out of bounds");
+               free(aaCutPoints);
+               free(aaTensors);
+               return true;
+            }
+            const FloatEbmType * const aCutPoints = reinterpret_cast<const FloatEbmType *>(pFile + static_cast<size_t>(offsetCutPoints));
+            if(IsCutPointsInvalid(cCutPoints, aCutPoints)) {
+               LOG_0(TraceLevelWarning, "WARNING ConstructModel cut points are not strictly increasing");
+               free(aaCutPoints);
+               free(aaTensors);
+               return true;
+            }
+            aaCutPoints[iFeature] = aCutPoints;
+         }
+      }
+   }
+
+   pModel->m_runtimeLearningTypeOrCountTargetClasses = runtimeLearningTypeOrCountTargetClasses;
+   pModel->m_cFeatures = cFeatures;
+   pModel->m_cFeatureCombinations = cFeatureCombinations;
+   pModel->m_aFeatures = aFeatures;
+   pModel->m_aaCutPoints = aaCutPoints;
+   pModel->m_aFeatureCombinations = aFeatureCombinations;
+   pModel->m_aFeatureCombinationIndexes = aFeatureCombinationIndexes;
+   pModel->m_aaTensors = aaTensors;
+   pModel->m_aIntercept = 0 == header.m_offsetIntercept ? nullptr :
+      reinterpret_cast<const FloatEbmType *>(pFile + static_cast<size_t>(header.m_offsetIntercept));
+   return false;
+}
+
+static void UnmapModelFile(EbmModel * const pModel) {
+#ifdef _WIN32
+   UnmapViewOfFile(pModel->m_pFile);
+   CloseHandle(pModel->m_hFileMapping);
+#else // _WIN32
+   munmap(const_cast<unsigned char *>(pModel->m_pFile), pModel->m_cBytesFile);
+#endif // _WIN32
+}
+
+// maps the whole file read-only.  Returns true on an error
+static bool MapModelFile(const char * const filePath, EbmModel * const pModel) {
+#ifdef _WIN32
+   const HANDLE hFile = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+   if(INVALID_HANDLE_VALUE == hFile) {
+      LOG_0(TraceLevelWarning, "WARNING MapModelFile CreateFileA failed");
+      return true;
+   }
+   LARGE_INTEGER cBytesFile;
+   if(!GetFileSizeEx(hFile, &cBytesFile) || cBytesFile.QuadPart <= 0 || !IsNumberConvertable<size_t, LONGLONG>(cBytesFile.QuadPart)) {
+      LOG_0(TraceLevelWarning, "WARNING MapModelFile invalid file size");
+      CloseHandle(hFile);
+      return true;
+   }
+   const HANDLE hFileMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   // the mapping keeps the file open, so we can close our handle to the file now
+   CloseHandle(hFile);
+   if(nullptr == hFileMapping) {
+      LOG_0(TraceLevelWarning, "WARNING MapModelFile CreateFileMappingA failed");
+      return true;
+   }
+   const void * const pFile = MapViewOfFile(hFileMapping, FILE_MAP_READ, 0, 0, 0);
+   if(nullptr == pFile) {
+      LOG_0(TraceLevelWarning, "WARNING MapModelFile MapViewOfFile failed");
+      CloseHandle(hFileMapping);
+      return true;
+   }
+   pModel->m_hFileMapping = hFileMapping;
+   pModel->m_pFile = static_cast<const unsigned char *>(pFile);
+   pModel->m_cBytesFile = static_cast<size_t>(cBytesFile.QuadPart);
+#else // _WIN32
+   const int fd = open(filePath, O_RDONLY);
+   if(fd < 0) {
+      LOG_0(TraceLevelWarning, "WARNING MapModelFile open failed");
+      return true;
+   }
+   struct stat fileStatus;
+   if(0 != fstat(fd, &fileStatus) || fileStatus.st_size <= 0 || !IsNumberConvertable<size_t, off_t>(fileStatus.st_size)) {
+      LOG_0(TraceLevelWarning, "WARNING MapModelFile invalid file size");
+      close(fd);
+      return true;
+   }
+   const size_t cBytesFile = static_cast<size_t>(fileStatus.st_size);
+   void * const pFile = mmap(nullptr, cBytesFile, PROT_READ, MAP_SHARED, fd, 0);
+   // the mapping keeps the file open, so we can close our descriptor now
+   close(fd);
+   if(MAP_FAILED == pFile) {
+      LOG_0(TraceLevelWarning, "WARNING MapModelFile mmap failed");
+      return true;
+   }
+   pModel->m_pFile = static_cast<const unsigned char *>(pFile);
+   pModel->m_cBytesFile = cBytesFile;
+#endif // _WIN32
+   return false;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION SaveModelClassification(
+   IntEbmType countTargetClasses,
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   const FloatEbmType * const * cutPointsLowerBoundInclusive,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   const char * filePath
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered SaveModelClassification: countTargetClasses=%" IntEbmTypePrintf ", countFeatures=%" IntEbmTypePrintf
+      ", features=%p, cutPointsLowerBoundInclusive=%p, countFeatureCombinations=%" IntEbmTypePrintf ", featureCombinations=%p"
+      ", featureCombinationIndexes=%p, modelFeatureCombinationTensors=%p, intercept=%p, filePath=%p",
+      countTargetClasses,
+      countFeatures,
+      static_cast<const void *>(features),
+      static_cast<const void *>(cutPointsLowerBoundInclusive),
+      countFeatureCombinations,
+      static_cast<const void *>(featureCombinations),
+      static_cast<const void *>(featureCombinationIndexes),
+      static_cast<const void *>(modelFeatureCombinationTensors),
+      static_cast<const void *>(intercept),
+      static_cast<const void *>(filePath)
+   );
+   if(countTargetClasses < 0) {
+      LOG_0(TraceLevelError, "ERROR SaveModelClassification countTargetClasses can't be negative");
+      return 1;
+   }
+   if(!IsNumberConvertable<ptrdiff_t, IntEbmType>(countTargetClasses)) {
+      LOG_0(TraceLevelWarning, "WARNING SaveModelClassification !IsNumberConvertable<ptrdiff_t, IntEbmType>(countTargetClasses)");
+      return 1;
+   }
+   const IntEbmType ret = SaveModel(
+      static_cast<ptrdiff_t>(countTargetClasses),
+      countFeatures,
+      features,
+      cutPointsLowerBoundInclusive,
+      countFeatureCombinations,
+      featureCombinations,
+      featureCombinationIndexes,
+      modelFeatureCombinationTensors,
+      intercept,
+      filePath
+   );
+   LOG_N(TraceLevelInfo, "Exited SaveModelClassification %" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION SaveModelRegression(
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   const FloatEbmType * const * cutPointsLowerBoundInclusive,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   const char * filePath
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered SaveModelRegression: countFeatures=%" IntEbmTypePrintf ", features=%p, cutPointsLowerBoundInclusive=%p, countFeatureCombinations=%"
+      IntEbmTypePrintf ", featureCombinations=%p, featureCombinationIndexes=%p, modelFeatureCombinationTensors=%p, intercept=%p, filePath=%p",
+      countFeatures,
+      static_cast<const void *>(features),
+      static_cast<const void *>(cutPointsLowerBoundInclusive),
+      countFeatureCombinations,
+      static_cast<const void *>(featureCombinations),
+      static_cast<const void *>(featureCombinationIndexes),
+      static_cast<const void *>(modelFeatureCombinationTensors),
+      static_cast<const void *>(intercept),
+      static_cast<const void *>(filePath)
+   );
+   const IntEbmType ret = SaveModel(
+      k_Regression,
+      countFeatures,
+      features,
+      cutPointsLowerBoundInclusive,
+      countFeatureCombinations,
+      featureCombinations,
+      featureCombinationIndexes,
+      modelFeatureCombinationTensors,
+      intercept,
+      filePath
+   );
+   LOG_N(TraceLevelInfo, "Exited SaveModelRegression %" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY PEbmModel EBM_NATIVE_CALLING_CONVENTION LoadModel(const char * filePath) {
+   LOG_N(TraceLevelInfo, "Entered LoadModel: filePath=%p", static_cast<const void *>(filePath));
+   if(nullptr == filePath) {
+      LOG_0(TraceLevelError, "ERROR LoadModel nullptr == filePath");
+      return nullptr;
+   }
+   if(!IsLittleEndian()) {
+      LOG_0(TraceLevelWarning, "WARNING LoadModel our model files are little endian and this machine is not");
+      return nullptr;
+   }
+   EbmModel * const pModel = new (std::nothrow) EbmModel();
+   if(nullptr == pModel) {
+      LOG_0(TraceLevelWarning, "WARNING LoadModel nullptr == pModel");
+      return nullptr;
+   }
+   if(MapModelFile(filePath, pModel)) {
+      delete pModel;
+      LOG_0(TraceLevelInfo, "Exited LoadModel could not map the model file");
+      return nullptr;
+   }
+   if(ConstructModel(pModel)) {
+      UnmapModelFile(pModel);
+      delete pModel;
+      LOG_0(TraceLevelInfo, "Exited LoadModel invalid model file");
+      return nullptr;
+   }
+   LOG_N(TraceLevelInfo, "Exited LoadModel %p", static_cast<void *>(pModel));
+   return reinterpret_cast<PEbmModel>(pModel);
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY void EBM_NATIVE_CALLING_CONVENTION FreeModel(PEbmModel ebmModel) {
+   LOG_N(TraceLevelInfo, "Entered FreeModel: ebmModel=%p", static_cast<void *>(ebmModel));
+   EbmModel * const pModel = reinterpret_cast<EbmModel *>(ebmModel);
+   // it's legal to call free on nullptr, just like for free().  This is checked in the interface
+   if(nullptr != pModel) {
+      free(pModel->m_aaCutPoints);
+      free(pModel->m_aaTensors);
+      UnmapModelFile(pModel);
+      delete pModel;
+   }
+   LOG_0(TraceLevelInfo, "Exited FreeModel");
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GetModelCountTargetClasses(PEbmModel ebmModel) {
+   LOG_N(TraceLevelInfo, "Entered GetModelCountTargetClasses: ebmModel=%p", static_cast<void *>(ebmModel));
+   EBM_ASSERT(nullptr != ebmModel);
+   const EbmModel * const pModel = reinterpret_cast<const EbmModel *>(ebmModel);
+   const IntEbmType ret = static_cast<IntEbmType>(pModel->m_runtimeLearningTypeOrCountTargetClasses);
+   LOG_N(TraceLevelInfo, "Exited GetModelCountTargetClasses %" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreModelInstances(
+   PEbmModel ebmModel,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType isBinnedDataRowMajor,
+   IntEbmType isProbabilities,
+   FloatEbmType * scoresReturn
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered ScoreModelInstances parameters: ebmModel=%p, countInstances=%" IntEbmTypePrintf ", binnedData=%p, isBinnedDataRowMajor=%" IntEbmTypePrintf
+      ", isProbabilities=%" IntEbmTypePrintf ", scoresReturn=%p",
+      static_cast<void *>(ebmModel),
+      countInstances,
+      static_cast<const void *>(binnedData),
+      isBinnedDataRowMajor,
+      isProbabilities,
+      static_cast<void *>(scoresReturn)
+   );
+   EBM_ASSERT(nullptr != ebmModel);
+   EBM_ASSERT(EBM_FALSE == isBinnedDataRowMajor || EBM_TRUE == isBinnedDataRowMajor);
+   EBM_ASSERT(EBM_FALSE == isProbabilities || EBM_TRUE == isProbabilities);
+   const EbmModel * const pModel = reinterpret_cast<const EbmModel *>(ebmModel);
+   const IntEbmType ret = ScoreInstances(
+      pModel->m_runtimeLearningTypeOrCountTargetClasses,
+      static_cast<IntEbmType>(pModel->m_cFeatures),
+      pModel->m_aFeatures,
+      nullptr,
+      static_cast<IntEbmType>(pModel->m_cFeatureCombinations),
+      pModel->m_aFeatureCombinations,
+      pModel->m_aFeatureCombinationIndexes,
+      pModel->m_aaTensors,
+      pModel->m_aIntercept,
+      countInstances,
+      binnedData,
+      nullptr,
+      EBM_FALSE != isBinnedDataRowMajor,
+      IsClassification(pModel->m_runtimeLearningTypeOrCountTargetClasses) && EBM_FALSE != isProbabilities,
+      scoresReturn
+   );
+   LOG_N(TraceLevelInfo, "Exited ScoreModelInstances %" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreModelRawInstances(
+   PEbmModel ebmModel,
+   IntEbmType countInstances,
+   const FloatEbmType * rawData,
+   IntEbmType isRawDataRowMajor,
+   IntEbmType isProbabilities,
+   FloatEbmType * scoresReturn
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered ScoreModelRawInstances parameters: ebmModel=%p, countInstances=%" IntEbmTypePrintf ", rawData=%p, isRawDataRowMajor=%" IntEbmTypePrintf
+      ", isProbabilities=%" IntEbmTypePrintf ", scoresReturn=%p",
+      static_cast<void *>(ebmModel),
+      countInstances,
+      static_cast<const void *>(rawData),
+      isRawDataRowMajor,
+      isProbabilities,
+      static_cast<void *>(scoresReturn)
+   );
+   EBM_ASSERT(nullptr != ebmModel);
+   EBM_ASSERT(EBM_FALSE == isRawDataRowMajor || EBM_TRUE == isRawDataRowMajor);
+   EBM_ASSERT(EBM_FALSE == isProbabilities || EBM_TRUE == isProbabilities);
+   const EbmModel * const pModel = reinterpret_cast<const EbmModel *>(ebmModel);
+   if(nullptr == pModel->m_aaCutPoints) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreModelRawInstances the model was saved without cut points, so it can only score binned data");
+      return 1;
+   }
+   const IntEbmType ret = ScoreInstances(
+      pModel->m_runtimeLearningTypeOrCountTargetClasses,
+      static_cast<IntEbmType>(pModel->m_cFeatures),
+      pModel->m_aFeatures,
+      pModel->m_aaCutPoints,
+      static_cast<IntEbmType>(pModel->m_cFeatureCombinations),
+      pModel->m_aFeatureCombinations,
+      pModel->m_aFeatureCombinationIndexes,
+      pModel->m_aaTensors,
+      pModel->m_aIntercept,
+      countInstances,
+      nullptr,
+      rawData,
+      EBM_FALSE != isRawDataRowMajor,
+      IsClassification(pModel->m_runtimeLearningTypeOrCountTargetClasses) && EBM_FALSE != isProbabilities,
+      scoresReturn
+   );
+   LOG_N(TraceLevelInfo, "Exited ScoreModelRawInstances %" IntEbmTypePrintf, ret);
+   return ret;
+}
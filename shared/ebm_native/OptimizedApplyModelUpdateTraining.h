@@ -16,6 +16,8 @@
 #include "FeatureCombination.h"
 // dataset depends on features
 #include "DataSetByFeatureCombination.h"
+#include "SamplingMethod.h"
+#include "HistogramBucket.h"
 
 // C++ does not allow partial function specialization, so we need to use these cumbersome static class functions to do partial function specialization
 
@@ -45,6 +47,7 @@ public:
       EBM_ASSERT(0 < cInstances);
 
       FloatEbmType * pResidualError = pTrainingSet->GetResidualPointer();
+      FloatEbmType * pNewtonRaphsonStep = pTrainingSet->IsNewtonRaphsonStepsStored() ? pTrainingSet->GetNewtonRaphsonStepPointer() : nullptr;
       const StorageDataType * pTargetData = pTrainingSet->GetTargetDataPointer();
       FloatEbmType * pPredictorScores = pTrainingSet->GetPredictorScores();
       const FloatEbmType * const pPredictorScoresEnd = pPredictorScores + cInstances * cVectorLength;
@@ -88,6 +91,10 @@ public:
             ++pExpVector;
             *pResidualError = residualError;
             ++pResidualError;
+            if(nullptr != pNewtonRaphsonStep) {
+               *pNewtonRaphsonStep = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+               ++pNewtonRaphsonStep;
+            }
             ++iVector;
          } while(iVector < cVectorLength);
          // TODO: this works as a way to remove one parameter, but it obviously insn't as efficient as omitting the parameter
@@ -102,6 +109,9 @@ public:
          constexpr bool bZeroingResiduals = 0 <= k_iZeroResidual;
          if(bZeroingResiduals) {
             *(pResidualError - (cVectorLength - static_cast<size_t>(k_iZeroResidual))) = 0;
+            if(nullptr != pNewtonRaphsonStep) {
+               *(pNewtonRaphsonStep - (cVectorLength - static_cast<size_t>(k_iZeroResidual))) = 0;
+            }
          }
       } while(pPredictorScoresEnd != pPredictorScores);
    }
@@ -123,6 +133,7 @@ public:
       EBM_ASSERT(0 < cInstances);
 
       FloatEbmType * pResidualError = pTrainingSet->GetResidualPointer();
+      FloatEbmType * pNewtonRaphsonStep = pTrainingSet->IsNewtonRaphsonStepsStored() ? pTrainingSet->GetNewtonRaphsonStepPointer() : nullptr;
       const StorageDataType * pTargetData = pTrainingSet->GetTargetDataPointer();
       FloatEbmType * pPredictorScores = pTrainingSet->GetPredictorScores();
       const FloatEbmType * const pPredictorScoresEnd = pPredictorScores + cInstances;
@@ -137,6 +148,10 @@ public:
          const FloatEbmType residualError = EbmStatistics::ComputeResidualErrorBinaryClassification(predictorScore, targetData);
          *pResidualError = residualError;
          ++pResidualError;
+         if(nullptr != pNewtonRaphsonStep) {
+            *pNewtonRaphsonStep = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+            ++pNewtonRaphsonStep;
+         }
       } while(pPredictorScoresEnd != pPredictorScores);
    }
 };
@@ -212,6 +227,7 @@ public:
       const size_t maskBits = std::numeric_limits<size_t>::max() >> (k_cBitsForStorageType - cBitsPerItemMax);
 
       FloatEbmType * pResidualError = pTrainingSet->GetResidualPointer();
+      FloatEbmType * pNewtonRaphsonStep = pTrainingSet->IsNewtonRaphsonStepsStored() ? pTrainingSet->GetNewtonRaphsonStepPointer() : nullptr;
       const StorageDataType * pInputData = pTrainingSet->GetInputDataPointer(pFeatureCombination);
       const StorageDataType * pTargetData = pTrainingSet->GetTargetDataPointer();
       FloatEbmType * pPredictorScores = pTrainingSet->GetPredictorScores();
@@ -273,6 +289,10 @@ public:
                ++pExpVector;
                *pResidualError = residualError;
                ++pResidualError;
+               if(nullptr != pNewtonRaphsonStep) {
+                  *pNewtonRaphsonStep = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+                  ++pNewtonRaphsonStep;
+               }
                ++iVector;
             } while(iVector < cVectorLength);
             // TODO: this works as a way to remove one parameter, but it obviously insn't as efficient as omitting the parameter
@@ -287,6 +307,9 @@ public:
             constexpr bool bZeroingResiduals = 0 <= k_iZeroResidual;
             if(bZeroingResiduals) {
                *(pResidualError - (cVectorLength - static_cast<size_t>(k_iZeroResidual))) = 0;
+               if(nullptr != pNewtonRaphsonStep) {
+                  *(pNewtonRaphsonStep - (cVectorLength - static_cast<size_t>(k_iZeroResidual))) = 0;
+               }
             }
 
             iTensorBinCombined >>= cBitsPerItemMax;
@@ -332,6 +355,7 @@ public:
       const size_t maskBits = std::numeric_limits<size_t>::max() >> (k_cBitsForStorageType - cBitsPerItemMax);
 
       FloatEbmType * pResidualError = pTrainingSet->GetResidualPointer();
+      FloatEbmType * pNewtonRaphsonStep = pTrainingSet->IsNewtonRaphsonStepsStored() ? pTrainingSet->GetNewtonRaphsonStepPointer() : nullptr;
       const StorageDataType * pInputData = pTrainingSet->GetInputDataPointer(pFeatureCombination);
       const StorageDataType * pTargetData = pTrainingSet->GetTargetDataPointer();
       FloatEbmType * pPredictorScores = pTrainingSet->GetPredictorScores();
@@ -370,6 +394,10 @@ public:
 
             *pResidualError = residualError;
             ++pResidualError;
+            if(nullptr != pNewtonRaphsonStep) {
+               *pNewtonRaphsonStep = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+               ++pNewtonRaphsonStep;
+            }
 
             iTensorBinCombined >>= cBitsPerItemMax;
          } while(pPredictorScoresInnerEnd != pPredictorScores);
@@ -529,6 +557,8 @@ template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
 EBM_INLINE static void OptimizedApplyModelUpdateTraining(
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
    const bool bUseSIMD,
+   // if every tensor bin holds the same update, we apply the first bin to every instance without unpacking the binned data
+   const bool bConstantUpdate,
    const FeatureCombination * const pFeatureCombination,
    DataSetByFeatureCombination * const pTrainingSet,
    const FloatEbmType * const aModelFeatureCombinationUpdateTensor,
@@ -536,7 +566,7 @@ EBM_INLINE static void OptimizedApplyModelUpdateTraining(
 ) {
    LOG_0(TraceLevelVerbose, "Entered OptimizedApplyModelUpdateTraining");
 
-   if(0 == pFeatureCombination->m_cFeatures) {
+   if(0 == pFeatureCombination->m_cFeatures || bConstantUpdate) {
       OptimizedApplyModelUpdateTrainingZeroFeatures<compilerLearningTypeOrCountTargetClasses>::Func(
          runtimeLearningTypeOrCountTargetClasses,
          pTrainingSet,
@@ -588,4 +618,215 @@ EBM_INLINE static void OptimizedApplyModelUpdateTraining(
    LOG_0(TraceLevelVerbose, "Exited OptimizedApplyModelUpdateTraining");
 }
 
+// applies a model update to our training residuals the same way as OptimizedApplyModelUpdateTraining, and while each new residual is still in registers 
+// scatters it into the histograms of every sampling set for pFeatureCombinationNext, exactly as BinDataSetTrainingAllSamplingSets would at the start 
+// of the next step.  A cyclic step then makes one pass over the residuals instead of one pass to write them and another to read them back.  
+// aHistogramBuckets holds cSamplingSets consecutive zeroed histograms (bag major) of cBytesPerSamplingSet bytes each.  If bConstantUpdate, every 
+// tensor bin of the update holds the same values and we only read the first bin.  aTempFloatVector needs to hold cVectorLength items
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
+void OptimizedApplyModelUpdateTrainingAndBinAllSamplingSets(
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   const bool bConstantUpdate,
+   const FeatureCombination * const pFeatureCombination,
+   DataSetByFeatureCombination * const pTrainingSet,
+   const FloatEbmType * const aModelFeatureCombinationUpdateTensor,
+   FloatEbmType * const aTempFloatVector,
+   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets,
+   const size_t cBytesPerSamplingSet,
+   const FeatureCombination * const pFeatureCombinationNext,
+   const size_t cSamplingSets,
+   const CountOccurrencesUnpacker * const aCountOccurrencesUnpackers
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+#ifdef EXPAND_BINARY_LOGITS
+   constexpr bool bBinaryLogit = false;
+#else // EXPAND_BINARY_LOGITS
+   constexpr bool bBinaryLogit = IsBinaryClassification(compilerLearningTypeOrCountTargetClasses);
+#endif // EXPAND_BINARY_LOGITS
+
+   LOG_0(TraceLevelVerbose, "Entered OptimizedApplyModelUpdateTrainingAndBinAllSamplingSets");
+
+   EBM_ASSERT(1 <= cSamplingSets);
+   EBM_ASSERT(nullptr != aCountOccurrencesUnpackers);
+
+   FloatEbmType aLocalExpVector[
+      bClassification && !bBinaryLogit && k_DynamicClassification != compilerLearningTypeOrCountTargetClasses ? 
+         GetVectorLength(compilerLearningTypeOrCountTargetClasses) : 1
+   ];
+   FloatEbmType * const aExpVector = k_DynamicClassification == compilerLearningTypeOrCountTargetClasses ? aTempFloatVector : aLocalExpVector;
+
+   const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+      compilerLearningTypeOrCountTargetClasses,
+      runtimeLearningTypeOrCountTargetClasses
+   );
+   const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize<bClassification>(cVectorLength);
+
+   // zero dimensional feature combinations and constant updates don't need their input data
+   const StorageDataType * pInputData = nullptr;
+   size_t cItemsPerBitPackedDataUnit = 1;
+   size_t cBitsPerItemMax = 0;
+   size_t maskBits = 0;
+   if(0 != pFeatureCombination->m_cFeatures && !bConstantUpdate) {
+      pInputData = pTrainingSet->GetInputDataPointer(pFeatureCombination);
+      cItemsPerBitPackedDataUnit = pFeatureCombination->m_cItemsPerBitPackedDataUnit;
+      EBM_ASSERT(1 <= cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(cItemsPerBitPackedDataUnit <= k_cBitsForStorageType);
+      cBitsPerItemMax = GetCountBits(cItemsPerBitPackedDataUnit);
+      maskBits = std::numeric_limits<size_t>::max() >> (k_cBitsForStorageType - cBitsPerItemMax);
+   }
+   const StorageDataType * pInputDataNext = nullptr;
+   size_t cItemsPerBitPackedDataUnitNext = 1;
+   size_t cBitsPerItemMaxNext = 0;
+   size_t maskBitsNext = 0;
+   if(0 != pFeatureCombinationNext->m_cFeatures) {
+      pInputDataNext = pTrainingSet->GetInputDataPointer(pFeatureCombinationNext);
+      cItemsPerBitPackedDataUnitNext = pFeatureCombinationNext->m_cItemsPerBitPackedDataUnit;
+      EBM_ASSERT(1 <= cItemsPerBitPackedDataUnitNext);
+      EBM_ASSERT(cItemsPerBitPackedDataUnitNext <= k_cBitsForStorageType);
+      cBitsPerItemMaxNext = GetCountBits(cItemsPerBitPackedDataUnitNext);
+      maskBitsNext = std::numeric_limits<size_t>::max() >> (k_cBitsForStorageType - cBitsPerItemMaxNext);
+   }
+
+   const size_t cInstances = pTrainingSet->GetCountInstances();
+   EBM_ASSERT(0 < cInstances);
+
+   // nullptr if all our instances have a weight of 1.  Checking this is a perfectly predictable branch
+   const FloatEbmType * const aWeights = pTrainingSet->GetWeights();
+   FloatEbmType * pResidualError = pTrainingSet->GetResidualPointer();
+   FloatEbmType * pNewtonRaphsonStep = bClassification && pTrainingSet->IsNewtonRaphsonStepsStored() ? 
+      pTrainingSet->GetNewtonRaphsonStepPointer() : nullptr;
+   const StorageDataType * pTargetData = bClassification ? pTrainingSet->GetTargetDataPointer() : nullptr;
+   FloatEbmType * pPredictorScores = bClassification ? pTrainingSet->GetPredictorScores() : nullptr;
+
+   unsigned char * const pHistogramBucketsBytes = reinterpret_cast<unsigned char *>(aHistogramBuckets);
+   size_t iTensorBinCombined = 0;
+   size_t cItemsRemaining = 0;
+   size_t iTensorBinCombinedNext = 0;
+   size_t cItemsRemainingNext = 0;
+   for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
+      size_t iTensorBin = 0;
+      if(nullptr != pInputData) {
+         if(0 == cItemsRemaining) {
+            // we store the already multiplied dimensional value in *pInputData
+            iTensorBinCombined = static_cast<size_t>(*pInputData);
+            ++pInputData;
+            cItemsRemaining = cItemsPerBitPackedDataUnit;
+         }
+         iTensorBin = maskBits & iTensorBinCombined;
+         iTensorBinCombined >>= cBitsPerItemMax;
+         --cItemsRemaining;
+      }
+      size_t iTensorBinNext = 0;
+      if(nullptr != pInputDataNext) {
+         if(0 == cItemsRemainingNext) {
+            iTensorBinCombinedNext = static_cast<size_t>(*pInputDataNext);
+            ++pInputDataNext;
+            cItemsRemainingNext = cItemsPerBitPackedDataUnitNext;
+         }
+         iTensorBinNext = maskBitsNext & iTensorBinCombinedNext;
+         iTensorBinCombinedNext >>= cBitsPerItemMaxNext;
+         --cItemsRemainingNext;
+      }
+
+      const FloatEbmType * const pValues = &aModelFeatureCombinationUpdateTensor[iTensorBin * cVectorLength];
+      if(bClassification) {
+         const size_t targetData = static_cast<size_t>(*pTargetData);
+         ++pTargetData;
+         if(bBinaryLogit) {
+            // this will apply a small fix to our existing TrainingPredictorScores, either positive or negative, whichever is needed
+            const FloatEbmType predictorScore = *pPredictorScores + pValues[0];
+            *pPredictorScores = predictorScore;
+            ++pPredictorScores;
+            const FloatEbmType residualError = EbmStatistics::ComputeResidualErrorBinaryClassification(predictorScore, targetData);
+            pResidualError[0] = residualError;
+            if(nullptr != pNewtonRaphsonStep) {
+               pNewtonRaphsonStep[0] = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+            }
+         } else {
+            FloatEbmType sumExp = FloatEbmType { 0 };
+            size_t iVector = 0;
+            do {
+               const FloatEbmType predictorScore = pPredictorScores[iVector] + pValues[iVector];
+               pPredictorScores[iVector] = predictorScore;
+               const FloatEbmType oneExp = EbmExp(predictorScore);
+               aExpVector[iVector] = oneExp;
+               sumExp += oneExp;
+               ++iVector;
+            } while(iVector < cVectorLength);
+            pPredictorScores += cVectorLength;
+            iVector = 0;
+            do {
+               const FloatEbmType residualError = EbmStatistics::ComputeResidualErrorMulticlass(
+                  sumExp,
+                  aExpVector[iVector],
+                  targetData,
+                  iVector
+               );
+               pResidualError[iVector] = residualError;
+               if(nullptr != pNewtonRaphsonStep) {
+                  pNewtonRaphsonStep[iVector] = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
+               }
+               ++iVector;
+            } while(iVector < cVectorLength);
+            // see OptimizedApplyModelUpdateTrainingInternal for why we zero this residual
+            constexpr bool bZeroingResiduals = 0 <= k_iZeroResidual;
+            if(bZeroingResiduals) {
+               pResidualError[static_cast<size_t>(k_iZeroResidual)] = 0;
+               if(nullptr != pNewtonRaphsonStep) {
+                  pNewtonRaphsonStep[static_cast<size_t>(k_iZeroResidual)] = 0;
+               }
+            }
+         }
+         // every inner bag uses the same Newton-Raphson steps for this instance.  We're done with aExpVector, which might be aTempFloatVector
+         for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+            aTempFloatVector[iVector] = nullptr != pNewtonRaphsonStep ? pNewtonRaphsonStep[iVector] : 
+               EbmStatistics::ComputeNewtonRaphsonStep(pResidualError[iVector]);
+         }
+         if(nullptr != pNewtonRaphsonStep) {
+            pNewtonRaphsonStep += cVectorLength;
+         }
+      } else {
+         // this will apply a small fix to our existing TrainingPredictorScores, either positive or negative, whichever is needed
+         pResidualError[0] = EbmStatistics::ComputeResidualErrorRegression(pResidualError[0] - pValues[0]);
+      }
+
+      unsigned char * pHistogramBucketBytes = pHistogramBucketsBytes + iTensorBinNext * cBytesPerHistogramBucket;
+      for(size_t iSamplingSet = 0; iSamplingSet < cSamplingSets; ++iSamplingSet) {
+         HistogramBucket<bClassification> * const pHistogramBucketEntry = reinterpret_cast<HistogramBucket<bClassification> *>(pHistogramBucketBytes);
+         ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucketEntry, aHistogramBucketsEndDebug);
+
+         // adding the zero weighted contributions of the instances that a bag didn't select is faster than branching on them
+         const size_t cOccurences = aCountOccurrencesUnpackers[iSamplingSet].Get(iInstance);
+         FloatEbmType weight = static_cast<FloatEbmType>(cOccurences);
+         if(nullptr != aWeights) {
+            weight *= aWeights[iInstance];
+         }
+         pHistogramBucketEntry->m_weightInBucket += weight;
+         HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntry = ARRAY_TO_POINTER(
+            pHistogramBucketEntry->m_aHistogramBucketVectorEntry
+         );
+         size_t iVector = 0;
+         do {
+            pHistogramBucketVectorEntry[iVector].m_sumResidualError += weight * pResidualError[iVector];
+            if(bClassification) {
+               pHistogramBucketVectorEntry[iVector].SetSumDenominator(
+                  pHistogramBucketVectorEntry[iVector].GetSumDenominator() + weight * aTempFloatVector[iVector]
+               );
+            }
+            ++iVector;
+         } while(iVector < cVectorLength);
+
+         pHistogramBucketBytes += cBytesPerSamplingSet;
+      }
+      pResidualError += cVectorLength;
+   }
+
+   LOG_0(TraceLevelVerbose, "Exited OptimizedApplyModelUpdateTrainingAndBinAllSamplingSets");
+}
+
 #endif // OPTIMIZED_APPLY_MODEL_UPDATE_TRAINING_H
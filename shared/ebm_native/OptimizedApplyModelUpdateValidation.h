@@ -37,6 +37,8 @@ public:
       const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
       const size_t cInstances = pValidationSet->GetCountInstances();
       EBM_ASSERT(0 < cInstances);
+      // nullptr if every instance has a weight of 1.  A weight of k is equivalent to k duplicate instances
+      const FloatEbmType * pWeight = pValidationSet->GetWeights();
 
       FloatEbmType sumLogLoss = FloatEbmType { 0 };
       const StorageDataType * pTargetData = pValidationSet->GetTargetDataPointer();
@@ -71,10 +73,15 @@ public:
          );
 
          EBM_ASSERT(std::isnan(instanceLogLoss) || -k_epsilonLogLoss <= instanceLogLoss);
-         sumLogLoss += instanceLogLoss;
+         if(nullptr != pWeight) {
+            sumLogLoss += *pWeight * instanceLogLoss;
+            ++pWeight;
+         } else {
+            sumLogLoss += instanceLogLoss;
+         }
 
       } while(pPredictorScoresEnd != pPredictorScores);
-      return sumLogLoss / cInstances;
+      return sumLogLoss / pValidationSet->GetWeightTotal();
    }
 };
 
@@ -90,6 +97,8 @@ public:
       UNUSED(runtimeLearningTypeOrCountTargetClasses);
       const size_t cInstances = pValidationSet->GetCountInstances();
       EBM_ASSERT(0 < cInstances);
+      // nullptr if every instance has a weight of 1.  A weight of k is equivalent to k duplicate instances
+      const FloatEbmType * pWeight = pValidationSet->GetWeights();
 
       FloatEbmType sumLogLoss = 0;
       const StorageDataType * pTargetData = pValidationSet->GetTargetDataPointer();
@@ -105,9 +114,14 @@ public:
          ++pPredictorScores;
          const FloatEbmType instanceLogLoss = EbmStatistics::ComputeSingleInstanceLogLossBinaryClassification(predictorScore, targetData);
          EBM_ASSERT(std::isnan(instanceLogLoss) || FloatEbmType { 0 } <= instanceLogLoss);
-         sumLogLoss += instanceLogLoss;
+         if(nullptr != pWeight) {
+            sumLogLoss += *pWeight * instanceLogLoss;
+            ++pWeight;
+         } else {
+            sumLogLoss += instanceLogLoss;
+         }
       } while(pPredictorScoresEnd != pPredictorScores);
-      return sumLogLoss / cInstances;
+      return sumLogLoss / pValidationSet->GetWeightTotal();
    }
 };
 #endif // EXPAND_BINARY_LOGITS
@@ -123,6 +137,8 @@ public:
       UNUSED(runtimeLearningTypeOrCountTargetClasses);
       const size_t cInstances = pValidationSet->GetCountInstances();
       EBM_ASSERT(0 < cInstances);
+      // nullptr if every instance has a weight of 1.  A weight of k is equivalent to k duplicate instances
+      const FloatEbmType * pWeight = pValidationSet->GetWeights();
 
       FloatEbmType sumSquareError = FloatEbmType { 0 };
       FloatEbmType * pResidualError = pValidationSet->GetResidualPointer();
@@ -133,11 +149,16 @@ public:
          const FloatEbmType residualError = EbmStatistics::ComputeResidualErrorRegression(*pResidualError - smallChangeToPrediction);
          const FloatEbmType instanceSquaredError = EbmStatistics::ComputeSingleInstanceSquaredErrorRegression(residualError);
          EBM_ASSERT(std::isnan(instanceSquaredError) || FloatEbmType { 0 } <= instanceSquaredError);
-         sumSquareError += instanceSquaredError;
+         if(nullptr != pWeight) {
+            sumSquareError += *pWeight * instanceSquaredError;
+            ++pWeight;
+         } else {
+            sumSquareError += instanceSquaredError;
+         }
          *pResidualError = residualError;
          ++pResidualError;
       } while(pResidualErrorEnd != pResidualError);
-      return sumSquareError / cInstances;
+      return sumSquareError / pValidationSet->GetWeightTotal();
    }
 };
 
@@ -161,6 +182,8 @@ public:
       const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
       const size_t cInstances = pValidationSet->GetCountInstances();
       EBM_ASSERT(0 < cInstances);
+      // nullptr if every instance has a weight of 1.  A weight of k is equivalent to k duplicate instances
+      const FloatEbmType * pWeight = pValidationSet->GetWeights();
       EBM_ASSERT(0 < pFeatureCombination->m_cFeatures);
 
       const size_t cItemsPerBitPackedDataUnit = GET_COUNT_ITEMS_PER_BIT_PACKED_DATA_UNIT(
@@ -227,7 +250,12 @@ public:
             );
 
             EBM_ASSERT(std::isnan(instanceLogLoss) || -k_epsilonLogLoss <= instanceLogLoss);
-            sumLogLoss += instanceLogLoss;
+            if(nullptr != pWeight) {
+               sumLogLoss += *pWeight * instanceLogLoss;
+               ++pWeight;
+            } else {
+               sumLogLoss += instanceLogLoss;
+            }
             iTensorBinCombined >>= cBitsPerItemMax;
          } while(pPredictorScoresInnerEnd != pPredictorScores);
       } while(pPredictorScoresExit != pPredictorScores);
@@ -238,7 +266,7 @@ public:
          pPredictorScoresExit = pPredictorScoresTrueEnd;
          goto one_last_loop;
       }
-      return sumLogLoss / cInstances;
+      return sumLogLoss / pValidationSet->GetWeightTotal();
    }
 };
 
@@ -256,6 +284,8 @@ public:
       UNUSED(runtimeLearningTypeOrCountTargetClasses);
       const size_t cInstances = pValidationSet->GetCountInstances();
       EBM_ASSERT(0 < cInstances);
+      // nullptr if every instance has a weight of 1.  A weight of k is equivalent to k duplicate instances
+      const FloatEbmType * pWeight = pValidationSet->GetWeights();
       EBM_ASSERT(0 < pFeatureCombination->m_cFeatures);
 
       const size_t cItemsPerBitPackedDataUnit = GET_COUNT_ITEMS_PER_BIT_PACKED_DATA_UNIT(
@@ -307,7 +337,12 @@ public:
             const FloatEbmType instanceLogLoss = EbmStatistics::ComputeSingleInstanceLogLossBinaryClassification(predictorScore, targetData);
 
             EBM_ASSERT(std::isnan(instanceLogLoss) || FloatEbmType { 0 } <= instanceLogLoss);
-            sumLogLoss += instanceLogLoss;
+            if(nullptr != pWeight) {
+               sumLogLoss += *pWeight * instanceLogLoss;
+               ++pWeight;
+            } else {
+               sumLogLoss += instanceLogLoss;
+            }
 
             iTensorBinCombined >>= cBitsPerItemMax;
          } while(pPredictorScoresInnerEnd != pPredictorScores);
@@ -319,7 +354,7 @@ public:
          pPredictorScoresExit = pPredictorScoresTrueEnd;
          goto one_last_loop;
       }
-      return sumLogLoss / cInstances;
+      return sumLogLoss / pValidationSet->GetWeightTotal();
    }
 };
 #endif // EXPAND_BINARY_LOGITS
@@ -337,6 +372,8 @@ public:
       UNUSED(runtimeLearningTypeOrCountTargetClasses);
       const size_t cInstances = pValidationSet->GetCountInstances();
       EBM_ASSERT(0 < cInstances);
+      // nullptr if every instance has a weight of 1.  A weight of k is equivalent to k duplicate instances
+      const FloatEbmType * pWeight = pValidationSet->GetWeights();
       EBM_ASSERT(0 < pFeatureCombination->m_cFeatures);
 
       const size_t cItemsPerBitPackedDataUnit = GET_COUNT_ITEMS_PER_BIT_PACKED_DATA_UNIT(
@@ -382,7 +419,12 @@ public:
             const FloatEbmType residualError = EbmStatistics::ComputeResidualErrorRegression(*pResidualError - smallChangeToPrediction);
             const FloatEbmType instanceSquaredError = EbmStatistics::ComputeSingleInstanceSquaredErrorRegression(residualError);
             EBM_ASSERT(std::isnan(instanceSquaredError) || FloatEbmType { 0 } <= instanceSquaredError);
-            sumSquareError += instanceSquaredError;
+            if(nullptr != pWeight) {
+               sumSquareError += *pWeight * instanceSquaredError;
+               ++pWeight;
+            } else {
+               sumSquareError += instanceSquaredError;
+            }
             *pResidualError = residualError;
             ++pResidualError;
 
@@ -396,7 +438,7 @@ public:
          pResidualErrorExit = pResidualErrorTrueEnd;
          goto one_last_loop;
       }
-      return sumSquareError / cInstances;
+      return sumSquareError / pValidationSet->GetWeightTotal();
    }
 };
 
@@ -462,6 +504,8 @@ template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
 EBM_INLINE static FloatEbmType OptimizedApplyModelUpdateValidation(
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
    const bool bUseSIMD,
+   // if every tensor bin holds the same update, we apply the first bin to every instance without unpacking the binned data
+   const bool bConstantUpdate,
    const FeatureCombination * const pFeatureCombination,
    DataSetByFeatureCombination * const pValidationSet,
    const FloatEbmType * const aModelFeatureCombinationUpdateTensor
@@ -469,7 +513,7 @@ EBM_INLINE static FloatEbmType OptimizedApplyModelUpdateValidation(
    LOG_0(TraceLevelVerbose, "Entered OptimizedApplyModelUpdateValidation");
 
    FloatEbmType ret;
-   if(0 == pFeatureCombination->m_cFeatures) {
+   if(0 == pFeatureCombination->m_cFeatures || bConstantUpdate) {
       ret = OptimizedApplyModelUpdateValidationZeroFeatures<compilerLearningTypeOrCountTargetClasses>::Func(
          runtimeLearningTypeOrCountTargetClasses,
          pValidationSet,
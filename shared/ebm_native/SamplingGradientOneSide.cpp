@@ -0,0 +1,270 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <string.h> // memset
+#include <stdlib.h> // malloc, realloc, free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <cmath> // std::isnan, std::ceil, std::abs
+#include <algorithm> // std::nth_element
+#include <functional> // std::greater
+#include <limits> // numeric_limits
+
+#include "EbmInternal.h" // EBM_INLINE & UNLIKLEY
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "RandomStream.h" // our header didn't need the full definition, but we use the RandomStream in here, so we need it
+#include "DataSetByFeatureCombination.h"
+#include "SamplingGradientOneSide.h"
+
+// we rank our instances by the sum of the absolute residuals over all the classes.  NaN residuals are ranked above everything so that we keep them
+// and the comparisons in std::nth_element stay well ordered
+static EBM_INLINE FloatEbmType GetResidualMagnitude(
+   const FloatEbmType * const aResidualErrors, 
+   const size_t iInstance, 
+   const size_t cVectorLength
+) {
+   // this can't overflow since we're accessing existing memory
+   const FloatEbmType * pResidualError = aResidualErrors + iInstance * cVectorLength;
+   const FloatEbmType * const pResidualErrorEnd = pResidualError + cVectorLength;
+   FloatEbmType magnitude = FloatEbmType { 0 };
+   do {
+      magnitude += std::abs(*pResidualError);
+      ++pResidualError;
+   } while(pResidualErrorEnd != pResidualError);
+   return std::isnan(magnitude) ? std::numeric_limits<FloatEbmType>::infinity() : magnitude;
+}
+
+static EBM_INLINE size_t GetCountInstancesFromFraction(const FloatEbmType fraction, const size_t cInstances) {
+   // fraction is in the range [0, 1], so this can't overflow
+   const size_t cInstancesFraction = static_cast<size_t>(std::ceil(fraction * static_cast<FloatEbmType>(cInstances)));
+   return cInstances < cInstancesFraction ? cInstances : cInstancesFraction;
+}
+
+SamplingGradientOneSide::~SamplingGradientOneSide() {
+   LOG_0(TraceLevelInfo, "Entered ~SamplingGradientOneSide");
+   // our base class owns and frees the packed count array, but we own our instance list
+   free(m_aiInstancesListedWritable);
+   free(m_aInstanceMultipliersWritable);
+   LOG_0(TraceLevelInfo, "Exited ~SamplingGradientOneSide");
+}
+
+size_t SamplingGradientOneSide::GetTotalCountInstanceOccurrences() const {
+   // for SamplingGradientOneSide, each listed instance occurs exactly once
+   const size_t cTotalCountInstanceOccurrences = m_cInstancesListed;
+#ifndef NDEBUG
+   size_t cTotalCountInstanceOccurrencesDebug = 0;
+   for(size_t i = 0; i < m_pOriginDataSet->GetCountInstances(); ++i) {
+      cTotalCountInstanceOccurrencesDebug += GetCountOccurrences(i);
+   }
+   EBM_ASSERT(cTotalCountInstanceOccurrencesDebug == cTotalCountInstanceOccurrences);
+#endif // NDEBUG
+   return cTotalCountInstanceOccurrences;
+}
+
+bool SamplingGradientOneSide::Resample(
+   RandomStream * const pRandomStream,
+   const FloatEbmType * const aMagnitudes,
+   const FloatEbmType magnitudeThreshold,
+   const size_t cTiesAtThreshold
+) {
+   LOG_0(TraceLevelVerbose, "Entered SamplingGradientOneSide::Resample");
+
+   const size_t cInstances = m_pOriginDataSet->GetCountInstances();
+   EBM_ASSERT(0 < cInstances);
+   EBM_ASSERT(1 <= m_cInstancesTop);
+   EBM_ASSERT(m_cInstancesTop <= cInstances);
+   EBM_ASSERT(m_cInstancesOther <= cInstances - m_cInstancesTop);
+
+   memset(m_aCountOccurrencesPackedWritable, 0, sizeof(size_t) * GetCountOccurrencesUnits(cInstances, k_cBitsPerCountOccurrenceBit));
+
+   constexpr size_t cShiftUnitBit = CountBitsRequired(GetCountOccurrencesPerUnit(k_cBitsPerCountOccurrenceBit)) - 1;
+   constexpr size_t maskItemBit = GetCountOccurrencesPerUnit(k_cBitsPerCountOccurrenceBit) - 1;
+
+   const size_t cInstancesRest = cInstances - m_cInstancesTop;
+   // the instances that we randomly sample stand in for all of the instances outside of our top ones, so we scale them up to keep our sums unbiased
+   const FloatEbmType multiplierOther = 0 == m_cInstancesOther ? FloatEbmType { 0 } : 
+      static_cast<FloatEbmType>(cInstancesRest) / static_cast<FloatEbmType>(m_cInstancesOther);
+
+   size_t cTiesRemaining = cTiesAtThreshold;
+   size_t cInstancesOtherNeeded = m_cInstancesOther;
+   size_t cInstancesRestRemaining = cInstancesRest;
+   size_t cInstancesListed = 0;
+   try {
+      for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
+         const FloatEbmType magnitude = aMagnitudes[iInstance];
+         FloatEbmType multiplier;
+         if(magnitudeThreshold < magnitude) {
+            multiplier = FloatEbmType { 1 };
+         } else if(magnitudeThreshold == magnitude && 0 != cTiesRemaining) {
+            // we take the first of any instances that tie at our threshold until we have exactly m_cInstancesTop
+            --cTiesRemaining;
+            multiplier = FloatEbmType { 1 };
+         } else {
+            EBM_ASSERT(0 < cInstancesRestRemaining);
+            // selection sampling (Knuth's algorithm S), which is the same method that SamplingWithoutReplacement uses
+            const bool bInclude = 0 != cInstancesOtherNeeded && pRandomStream->Next(cInstancesRestRemaining) < cInstancesOtherNeeded;
+            --cInstancesRestRemaining;
+            if(!bInclude) {
+               continue;
+            }
+            --cInstancesOtherNeeded;
+            multiplier = multiplierOther;
+         }
+         m_aCountOccurrencesPackedWritable[iInstance >> cShiftUnitBit] |= size_t { 1 } << (iInstance & maskItemBit);
+         m_aiInstancesListedWritable[cInstancesListed] = iInstance;
+         m_aInstanceMultipliersWritable[cInstancesListed] = multiplier;
+         ++cInstancesListed;
+      }
+   } catch(...) {
+      // pRandomStream->Next can throw exceptions from the random number generator, possibly (it's not documented)
+      LOG_0(TraceLevelWarning, "WARNING SamplingGradientOneSide::Resample random number generator exception");
+      m_cInstancesListed = 0;
+      return true;
+   }
+   EBM_ASSERT(0 == cTiesRemaining);
+   EBM_ASSERT(0 == cInstancesOtherNeeded);
+   EBM_ASSERT(m_cInstancesTop + m_cInstancesOther == cInstancesListed);
+   m_cInstancesListed = cInstancesListed;
+
+   LOG_0(TraceLevelVerbose, "Exited SamplingGradientOneSide::Resample");
+   return false;
+}
+
+SamplingMethod ** SamplingGradientOneSide::GenerateSamplingSets(
+   const DataSetByFeatureCombination * const pOriginDataSet,
+   const size_t cSamplingSets,
+   const FloatEbmType fractionInstancesTop,
+   const FloatEbmType fractionInstancesOther
+) {
+   LOG_0(TraceLevelInfo, "Entered SamplingGradientOneSide::GenerateSamplingSets");
+
+   EBM_ASSERT(nullptr != pOriginDataSet);
+
+   if(std::isnan(fractionInstancesTop) || fractionInstancesTop <= FloatEbmType { 0 } || FloatEbmType { 1 } < fractionInstancesTop) {
+      LOG_0(TraceLevelWarning, "WARNING SamplingGradientOneSide::GenerateSamplingSets fractionInstancesTop must be in the range (0, 1]");
+      return nullptr;
+   }
+   if(std::isnan(fractionInstancesOther) || fractionInstancesOther < FloatEbmType { 0 } || FloatEbmType { 1 } < fractionInstancesOther) {
+      LOG_0(TraceLevelWarning, "WARNING SamplingGradientOneSide::GenerateSamplingSets fractionInstancesOther must be in the range [0, 1]");
+      return nullptr;
+   }
+
+   const size_t cInstances = pOriginDataSet->GetCountInstances();
+   EBM_ASSERT(0 < cInstances); // if there were no instances, we wouldn't be called
+
+   size_t cInstancesTop = GetCountInstancesFromFraction(fractionInstancesTop, cInstances);
+   // we always keep at least one instance
+   cInstancesTop = 0 == cInstancesTop ? size_t { 1 } : cInstancesTop;
+   const size_t cInstancesRest = cInstances - cInstancesTop;
+   size_t cInstancesOther = GetCountInstancesFromFraction(fractionInstancesOther, cInstances);
+   cInstancesOther = cInstancesRest < cInstancesOther ? cInstancesRest : cInstancesOther;
+   const size_t cInstancesIncluded = cInstancesTop + cInstancesOther;
+
+   // GOSS replaces our sampling sets, so without inner bagging we still need our single sampling set to be a GOSS one
+   const size_t cSamplingSetsAfterZero = 0 == cSamplingSets ? size_t { 1 } : cSamplingSets;
+
+   SamplingMethod ** apSamplingSets = new (std::nothrow) SamplingMethod *[cSamplingSetsAfterZero];
+   if(UNLIKELY(nullptr == apSamplingSets)) {
+      LOG_0(TraceLevelWarning, "WARNING SamplingGradientOneSide::GenerateSamplingSets nullptr == apSamplingSets");
+      return nullptr;
+   }
+   memset(apSamplingSets, 0, sizeof(*apSamplingSets) * cSamplingSetsAfterZero);
+
+   // cInstancesIncluded is no larger than cInstances, and we have a FloatEbmType per instance in our dataset already, so these can't overflow
+   EBM_ASSERT(!IsMultiplyError(sizeof(FloatEbmType), cInstancesIncluded));
+   EBM_ASSERT(!IsMultiplyError(sizeof(size_t), cInstancesIncluded));
+   for(size_t iSamplingSet = 0; iSamplingSet < cSamplingSetsAfterZero; ++iSamplingSet) {
+      size_t * const aCountOccurrencesPacked = AllocateCountOccurrencesPacked(cInstances, k_cBitsPerCountOccurrenceBit);
+      size_t * const aiInstancesListed = static_cast<size_t *>(malloc(sizeof(size_t) * cInstancesIncluded));
+      FloatEbmType * const aInstanceMultipliers = static_cast<FloatEbmType *>(malloc(sizeof(FloatEbmType) * cInstancesIncluded));
+      SamplingGradientOneSide * pSingleSamplingSet = nullptr;
+      if(LIKELY(nullptr != aCountOccurrencesPacked && nullptr != aiInstancesListed && nullptr != aInstanceMultipliers)) {
+         pSingleSamplingSet = new (std::nothrow) SamplingGradientOneSide(
+            pOriginDataSet,
+            aCountOccurrencesPacked,
+            aiInstancesListed,
+            aInstanceMultipliers,
+            cInstancesTop,
+            cInstancesOther
+         );
+      }
+      if(UNLIKELY(nullptr == pSingleSamplingSet)) {
+         LOG_0(TraceLevelWarning, "WARNING SamplingGradientOneSide::GenerateSamplingSets nullptr == pSingleSamplingSet");
+         free(aCountOccurrencesPacked);
+         free(aiInstancesListed);
+         free(aInstanceMultipliers);
+         SamplingMethod::FreeSamplingSets(cSamplingSets, apSamplingSets);
+         return nullptr;
+      }
+      apSamplingSets[iSamplingSet] = pSingleSamplingSet;
+   }
+   LOG_0(TraceLevelInfo, "Exited SamplingGradientOneSide::GenerateSamplingSets");
+   return apSamplingSets;
+}
+
+bool SamplingGradientOneSide::ResampleSamplingSets(
+   RandomStream * const pRandomStream,
+   const DataSetByFeatureCombination * const pOriginDataSet,
+   const size_t cVectorLength,
+   const size_t cSamplingSets,
+   SamplingMethod * const * const apSamplingSets,
+   FloatEbmType * const aMagnitudesScratch
+) {
+   LOG_0(TraceLevelVerbose, "Entered SamplingGradientOneSide::ResampleSamplingSets");
+
+   EBM_ASSERT(nullptr != pRandomStream);
+   EBM_ASSERT(nullptr != pOriginDataSet);
+   EBM_ASSERT(1 <= cVectorLength);
+   EBM_ASSERT(nullptr != apSamplingSets);
+   EBM_ASSERT(nullptr != aMagnitudesScratch);
+
+   const size_t cInstances = pOriginDataSet->GetCountInstances();
+   EBM_ASSERT(0 < cInstances);
+
+   // the first half of our scratch space holds the magnitudes in instance order, and the second half is a copy that std::nth_element reorders
+   FloatEbmType * const aMagnitudes = aMagnitudesScratch;
+   FloatEbmType * const aMagnitudesPartitioned = aMagnitudesScratch + cInstances;
+   const FloatEbmType * const aResidualErrors = pOriginDataSet->GetResidualPointer();
+   for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
+      const FloatEbmType magnitude = GetResidualMagnitude(aResidualErrors, iInstance, cVectorLength);
+      aMagnitudes[iInstance] = magnitude;
+      aMagnitudesPartitioned[iInstance] = magnitude;
+   }
+
+   // every one of our sampling sets keeps the same number of top instances, so we only need to find our threshold once.  std::nth_element 
+   // partitions our copy in linear time, after which everything before the threshold is at least as large as it
+   EBM_ASSERT(nullptr != apSamplingSets[0]);
+   const size_t cInstancesTop = static_cast<const SamplingGradientOneSide *>(apSamplingSets[0])->m_cInstancesTop;
+   EBM_ASSERT(1 <= cInstancesTop);
+   EBM_ASSERT(cInstancesTop <= cInstances);
+   std::nth_element(
+      aMagnitudesPartitioned, 
+      aMagnitudesPartitioned + (cInstancesTop - 1), 
+      aMagnitudesPartitioned + cInstances, 
+      std::greater<FloatEbmType>()
+   );
+   const FloatEbmType magnitudeThreshold = aMagnitudesPartitioned[cInstancesTop - 1];
+   size_t cAboveThreshold = 0;
+   for(size_t iTop = 0; iTop < cInstancesTop - 1; ++iTop) {
+      if(magnitudeThreshold < aMagnitudesPartitioned[iTop]) {
+         ++cAboveThreshold;
+      }
+   }
+   const size_t cTiesAtThreshold = cInstancesTop - cAboveThreshold;
+
+   const size_t cSamplingSetsAfterZero = 0 == cSamplingSets ? size_t { 1 } : cSamplingSets;
+   for(size_t iSamplingSet = 0; iSamplingSet < cSamplingSetsAfterZero; ++iSamplingSet) {
+      SamplingGradientOneSide * const pSamplingSet = static_cast<SamplingGradientOneSide *>(apSamplingSets[iSamplingSet]);
+      EBM_ASSERT(nullptr != pSamplingSet);
+      EBM_ASSERT(cInstancesTop == pSamplingSet->m_cInstancesTop);
+      if(UNLIKELY(pSamplingSet->Resample(pRandomStream, aMagnitudes, magnitudeThreshold, cTiesAtThreshold))) {
+         LOG_0(TraceLevelWarning, "WARNING SamplingGradientOneSide::ResampleSamplingSets pSamplingSet->Resample failed");
+         return true;
+      }
+   }
+
+   LOG_0(TraceLevelVerbose, "Exited SamplingGradientOneSide::ResampleSamplingSets");
+   return false;
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef SAMPLING_GRADIENT_ONE_SIDE_H
+#define SAMPLING_GRADIENT_ONE_SIDE_H
+
+#include <stddef.h> // size_t, ptrdiff_t
+
+#include "ebm_native.h" // FloatEbmType
+#include "EbmInternal.h" // EBM_INLINE
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "SamplingMethod.h"
+
+class RandomStream;
+class DataSetByFeatureCombination;
+
+// gradient-based one-side sampling (GOSS) keeps every instance whose residuals are among the largest, and randomly samples a fraction of the remaining 
+// instances, which it scales up so that their histogram sums stay unbiased.  Our residuals change after every update, so we resample after each 
+// update.  Since GOSS includes only a fraction of the instances, we list them so that our histogram kernels only visit the included instances
+class SamplingGradientOneSide final : public SamplingMethod {
+   size_t * const m_aCountOccurrencesPackedWritable;
+   size_t * const m_aiInstancesListedWritable;
+   FloatEbmType * const m_aInstanceMultipliersWritable;
+   const size_t m_cInstancesTop;
+   const size_t m_cInstancesOther;
+
+   bool Resample(
+      RandomStream * const pRandomStream,
+      const FloatEbmType * const aMagnitudes,
+      const FloatEbmType magnitudeThreshold,
+      const size_t cTiesAtThreshold
+   );
+
+public:
+   EBM_INLINE SamplingGradientOneSide(
+      const DataSetByFeatureCombination * const pOriginDataSet,
+      size_t * const aCountOccurrencesPacked,
+      size_t * const aiInstancesListed,
+      FloatEbmType * const aInstanceMultipliers,
+      const size_t cInstancesTop,
+      const size_t cInstancesOther
+   )
+      : SamplingMethod(pOriginDataSet, aCountOccurrencesPacked, k_cBitsPerCountOccurrenceBit)
+      , m_aCountOccurrencesPackedWritable(aCountOccurrencesPacked)
+      , m_aiInstancesListedWritable(aiInstancesListed)
+      , m_aInstanceMultipliersWritable(aInstanceMultipliers)
+      , m_cInstancesTop(cInstancesTop)
+      , m_cInstancesOther(cInstancesOther) {
+      // until our first resample we include no instances
+      m_aiInstancesListed = aiInstancesListed;
+      m_aInstanceMultipliers = aInstanceMultipliers;
+   }
+
+   virtual ~SamplingGradientOneSide() final override;
+   virtual size_t GetTotalCountInstanceOccurrences() const final override;
+
+   static SamplingMethod ** GenerateSamplingSets(
+      const DataSetByFeatureCombination * const pOriginDataSet,
+      const size_t cSamplingSets,
+      const FloatEbmType fractionInstancesTop,
+      const FloatEbmType fractionInstancesOther
+   );
+
+   // aMagnitudesScratch needs room for two FloatEbmType values per instance in pOriginDataSet
+   static bool ResampleSamplingSets(
+      RandomStream * const pRandomStream,
+      const DataSetByFeatureCombination * const pOriginDataSet,
+      const size_t cVectorLength,
+      const size_t cSamplingSets,
+      SamplingMethod * const * const apSamplingSets,
+      FloatEbmType * const aMagnitudesScratch
+   );
+};
+
+#endif // SAMPLING_GRADIENT_ONE_SIDE_H
@@ -0,0 +1,163 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef SAMPLING_METHOD_H
+#define SAMPLING_METHOD_H
+
+#include <type_traits> // std::is_standard_layout
+#include <stdlib.h> // malloc, free
+#include <string.h> // memset
+#include <stddef.h> // size_t, ptrdiff_t
+#include <limits> // numeric_limits
+
+#include "ebm_native.h" // FloatEbmType
+#include "EbmInternal.h" // EBM_INLINE
+#include "Logging.h" // EBM_ASSERT & LOG
+
+class DataSetByFeatureCombination;
+
+// Our occurrence counts are bit packed into size_t units in the same way that we bit pack our input data into StorageDataType units.
+// Bootstrap sampling selects any single instance more than a handful of times with vanishingly small probability, so we store those counts in a
+// single byte per instance, and we only fall back to a full size_t per instance in the (practically impossible) case that some instance is selected
+// more than 255 times.  Sampling without replacement and our flat sampling set (no inner bagging) only need to know if an instance is included,
+// so those use a single bit per instance.  Our histogram kernels read the counts with shifts and masks only, so they don't need to know which
+// format they were given.
+constexpr size_t k_cBitsPerCountOccurrenceBit = 1;
+constexpr size_t k_cBitsPerCountOccurrenceByte = 8;
+constexpr size_t k_cBitsPerCountOccurrenceFull = k_cBitsForSizeT;
+
+constexpr EBM_INLINE size_t GetCountOccurrencesPerUnit(const size_t cBitsPerCountOccurrence) {
+   return k_cBitsForSizeT / cBitsPerCountOccurrence;
+}
+constexpr EBM_INLINE size_t GetCountOccurrencesMax(const size_t cBitsPerCountOccurrence) {
+   return std::numeric_limits<size_t>::max() >> (k_cBitsForSizeT - cBitsPerCountOccurrence);
+}
+constexpr EBM_INLINE size_t GetCountOccurrencesUnits(const size_t cInstances, const size_t cBitsPerCountOccurrence) {
+   // this can't overflow since there are fewer units than instances
+   return cInstances / GetCountOccurrencesPerUnit(cBitsPerCountOccurrence) +
+      (0 == cInstances % GetCountOccurrencesPerUnit(cBitsPerCountOccurrence) ? size_t { 0 } : size_t { 1 });
+}
+
+// this is a small value object that our histogram kernels copy onto their stack so that the compiler knows that nothing can change it while we're
+// writing into the histogram buckets, which lets it keep all of these in registers
+struct CountOccurrencesUnpacker final {
+   const size_t * m_aCountOccurrencesPacked;
+   size_t m_cShiftUnit;
+   size_t m_maskItem;
+   size_t m_cShiftBits;
+   size_t m_maskCountOccurrence;
+
+   EBM_INLINE size_t Get(const size_t iInstance) const {
+      return (m_aCountOccurrencesPacked[iInstance >> m_cShiftUnit] >> ((iInstance & m_maskItem) << m_cShiftBits)) & m_maskCountOccurrence;
+   }
+};
+static_assert(std::is_standard_layout<CountOccurrencesUnpacker>::value, "CountOccurrencesUnpacker is copied to the stack in our kernels");
+
+class SamplingMethod {
+public:
+   const DataSetByFeatureCombination * const m_pOriginDataSet;
+   const size_t * const m_aCountOccurrencesPacked;
+   const size_t m_cBitsPerCountOccurrence;
+
+   // sampling methods that include only a few of our instances can also list them in increasing order, so that our histogram kernels visit just
+   // the listed instances instead of every instance.  m_aInstanceMultipliers is parallel to m_aiInstancesListed and scales the contribution of each
+   // listed instance, or it is nullptr if each listed instance counts once.  m_aiInstancesListed is nullptr if we don't list our instances.
+   // Our derived classes own this memory
+   const size_t * m_aiInstancesListed;
+   const FloatEbmType * m_aInstanceMultipliers;
+   size_t m_cInstancesListed;
+
+   // sampling methods that list their instances can also gather the residuals (and Newton-Raphson steps) and the bin indexes of the listed 
+   // instances into contiguous buffers that are parallel to m_aiInstancesListed, so that our histogram kernels read sequential memory instead of 
+   // jumping around in our dataset.  m_aaInputDataGathered is indexed by FeatureCombination::m_iInputData and is bit packed the same way as 
+   // DataSetByFeatureCombination.  These are nullptr if we don't gather.  Our derived classes own this memory
+   const FloatEbmType * m_aResidualErrorsGathered;
+   const FloatEbmType * m_aNewtonRaphsonStepsGathered;
+   const StorageDataType * const * m_aaInputDataGathered;
+
+   // we take owernship of the aCountOccurrencesPacked array.  We do not take ownership of the pOriginDataSet since many SamplingMethod objects will
+   // refer to the original one
+   EBM_INLINE SamplingMethod(
+      const DataSetByFeatureCombination * const pOriginDataSet,
+      const size_t * const aCountOccurrencesPacked,
+      const size_t cBitsPerCountOccurrence
+   )
+      : m_pOriginDataSet(pOriginDataSet)
+      , m_aCountOccurrencesPacked(aCountOccurrencesPacked)
+      , m_cBitsPerCountOccurrence(cBitsPerCountOccurrence)
+      , m_aiInstancesListed(nullptr)
+      , m_aInstanceMultipliers(nullptr)
+      , m_cInstancesListed(0)
+      , m_aResidualErrorsGathered(nullptr)
+      , m_aNewtonRaphsonStepsGathered(nullptr)
+      , m_aaInputDataGathered(nullptr) {
+      EBM_ASSERT(nullptr != pOriginDataSet);
+      EBM_ASSERT(nullptr != aCountOccurrencesPacked);
+      EBM_ASSERT(k_cBitsPerCountOccurrenceBit == cBitsPerCountOccurrence || k_cBitsPerCountOccurrenceByte == cBitsPerCountOccurrence ||
+         k_cBitsPerCountOccurrenceFull == cBitsPerCountOccurrence);
+   }
+
+   virtual ~SamplingMethod() {
+      free(const_cast<size_t *>(m_aCountOccurrencesPacked));
+   }
+
+   virtual size_t GetTotalCountInstanceOccurrences() const = 0;
+
+   // true if our histogram weights are exactly our instance occurrence counts
+   EBM_INLINE bool IsUnitMultiplier() const {
+      return nullptr == m_aInstanceMultipliers;
+   }
+
+   EBM_INLINE CountOccurrencesUnpacker GetCountOccurrencesUnpacker() const {
+      // all our formats have a power of two number of bits, so CountBitsRequired is just our log2 here
+      const size_t cShiftBits = CountBitsRequired(m_cBitsPerCountOccurrence) - 1;
+      const size_t cShiftUnit = CountBitsRequired(GetCountOccurrencesPerUnit(m_cBitsPerCountOccurrence)) - 1;
+      EBM_ASSERT(size_t { 1 } << cShiftBits == m_cBitsPerCountOccurrence);
+      EBM_ASSERT(size_t { 1 } << cShiftUnit == GetCountOccurrencesPerUnit(m_cBitsPerCountOccurrence));
+
+      CountOccurrencesUnpacker ret;
+      ret.m_aCountOccurrencesPacked = m_aCountOccurrencesPacked;
+      ret.m_cShiftUnit = cShiftUnit;
+      ret.m_maskItem = GetCountOccurrencesPerUnit(m_cBitsPerCountOccurrence) - 1;
+      ret.m_cShiftBits = cShiftBits;
+      ret.m_maskCountOccurrence = GetCountOccurrencesMax(m_cBitsPerCountOccurrence);
+      return ret;
+   }
+
+   EBM_INLINE size_t GetCountOccurrences(const size_t iInstance) const {
+      return GetCountOccurrencesUnpacker().Get(iInstance);
+   }
+
+   static EBM_INLINE size_t * AllocateCountOccurrencesPacked(const size_t cInstances, const size_t cBitsPerCountOccurrence) {
+      const size_t cUnits = GetCountOccurrencesUnits(cInstances, cBitsPerCountOccurrence);
+      EBM_ASSERT(1 <= cUnits);
+      if(IsMultiplyError(sizeof(size_t), cUnits)) {
+         LOG_0(TraceLevelWarning, "WARNING SamplingMethod::AllocateCountOccurrencesPacked IsMultiplyError(sizeof(size_t), cUnits)");
+         return nullptr;
+      }
+      const size_t cBytes = sizeof(size_t) * cUnits;
+      size_t * const aCountOccurrencesPacked = static_cast<size_t *>(malloc(cBytes));
+      if(nullptr == aCountOccurrencesPacked) {
+         LOG_0(TraceLevelWarning, "WARNING SamplingMethod::AllocateCountOccurrencesPacked nullptr == aCountOccurrencesPacked");
+         return nullptr;
+      }
+      // our kernels never read the unused items in the last unit, but zeroing them keeps our debug totals simple
+      memset(aCountOccurrencesPacked, 0, cBytes);
+      return aCountOccurrencesPacked;
+   }
+
+   static EBM_INLINE void FreeSamplingSets(const size_t cSamplingSets, SamplingMethod ** apSamplingSets) {
+      LOG_0(TraceLevelInfo, "Entered SamplingMethod::FreeSamplingSets");
+      if(LIKELY(nullptr != apSamplingSets)) {
+         const size_t cSamplingSetsAfterZero = 0 == cSamplingSets ? 1 : cSamplingSets;
+         for(size_t iSamplingSet = 0; iSamplingSet < cSamplingSetsAfterZero; ++iSamplingSet) {
+            delete apSamplingSets[iSamplingSet];
+         }
+         delete[] apSamplingSets;
+      }
+      LOG_0(TraceLevelInfo, "Exited SamplingMethod::FreeSamplingSets");
+   }
+};
+
+#endif // SAMPLING_METHOD_H
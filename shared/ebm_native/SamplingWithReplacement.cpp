@@ -7,6 +7,7 @@
 #include <string.h> // memset
 #include <stdlib.h> // malloc, realloc, free
 #include <stddef.h> // size_t, ptrdiff_t
+#include <limits> // numeric_limits
 
 #include "EbmInternal.h" // EBM_INLINE & UNLIKLEY
 #include "Logging.h" // EBM_ASSERT & LOG
@@ -16,7 +17,7 @@
 
 SamplingWithReplacement::~SamplingWithReplacement() {
    LOG_0(TraceLevelInfo, "Entered ~SamplingWithReplacement");
-   free(const_cast<size_t *>(m_aCountOccurrences));
+   // our base class owns and frees the packed count array
    LOG_0(TraceLevelInfo, "Exited ~SamplingWithReplacement");
 }
 
@@ -26,7 +27,7 @@ size_t SamplingWithReplacement::GetTotalCountInstanceOccurrences() const {
 #ifndef NDEBUG
    size_t cTotalCountInstanceOccurrencesDebug = 0;
    for(size_t i = 0; i < m_pOriginDataSet->GetCountInstances(); ++i) {
-      cTotalCountInstanceOccurrencesDebug += m_aCountOccurrences[i];
+      cTotalCountInstanceOccurrencesDebug += GetCountOccurrences(i);
    }
    EBM_ASSERT(cTotalCountInstanceOccurrencesDebug == cTotalCountInstanceOccurrences);
 #endif // NDEBUG
@@ -35,44 +36,74 @@ size_t SamplingWithReplacement::GetTotalCountInstanceOccurrences() const {
 
 SamplingWithReplacement * SamplingWithReplacement::GenerateSingleSamplingSet(
    RandomStream * const pRandomStream, 
-   const DataSetByFeatureCombination * const pOriginDataSet
+   const DataSetByFeatureCombination * const pOriginDataSet,
+   const size_t cBitsPerCountOccurrenceStart
 ) {
    LOG_0(TraceLevelVerbose, "Entered SamplingWithReplacement::GenerateSingleSamplingSet");
 
    EBM_ASSERT(nullptr != pRandomStream);
    EBM_ASSERT(nullptr != pOriginDataSet);
+   EBM_ASSERT(k_cBitsPerCountOccurrenceBit == cBitsPerCountOccurrenceStart || k_cBitsPerCountOccurrenceByte == cBitsPerCountOccurrenceStart);
 
    const size_t cInstances = pOriginDataSet->GetCountInstances();
    EBM_ASSERT(0 < cInstances); // if there were no instances, we wouldn't be called
 
-   if(IsMultiplyError(sizeof(size_t), cInstances)) {
-      LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateSingleSamplingSet IsMultiplyError(sizeof(size_t), cInstances)");
-      return nullptr;
-   }
-   const size_t cBytesData = sizeof(size_t) * cInstances;
-   size_t * const aCountOccurrences = static_cast<size_t *>(malloc(cBytesData));
-   if(nullptr == aCountOccurrences) {
-      LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateSingleSamplingSet nullptr == aCountOccurrences");
+   size_t cBitsPerCountOccurrence = cBitsPerCountOccurrenceStart;
+   size_t * aCountOccurrencesPacked = AllocateCountOccurrencesPacked(cInstances, cBitsPerCountOccurrence);
+   if(nullptr == aCountOccurrencesPacked) {
+      LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateSingleSamplingSet nullptr == aCountOccurrencesPacked");
       return nullptr;
    }
 
-   memset(aCountOccurrences, 0, cBytesData);
+   // our starting formats have a power of two number of bits, so CountBitsRequired is just our log2 here
+   const size_t cShiftUnitStart = CountBitsRequired(GetCountOccurrencesPerUnit(cBitsPerCountOccurrenceStart)) - 1;
+   const size_t maskItemStart = GetCountOccurrencesPerUnit(cBitsPerCountOccurrenceStart) - 1;
+   const size_t cShiftBitsStart = CountBitsRequired(cBitsPerCountOccurrenceStart) - 1;
+   const size_t countOccurrencesStartMax = GetCountOccurrencesMax(cBitsPerCountOccurrenceStart);
 
    try {
-      for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
-         const size_t iCountOccurrences = pRandomStream->Next(cInstances);
-         ++aCountOccurrences[iCountOccurrences];
+      size_t iDraw = 0;
+      for(; iDraw < cInstances; ++iDraw) {
+         const size_t iInstance = pRandomStream->Next(cInstances);
+         size_t * const pCountOccurrencesPacked = &aCountOccurrencesPacked[iInstance >> cShiftUnitStart];
+         const size_t cShift = (iInstance & maskItemStart) << cShiftBitsStart;
+         if(UNLIKELY(countOccurrencesStartMax == (countOccurrencesStartMax & (*pCountOccurrencesPacked >> cShift)))) {
+            // with byte counts this instance has been selected 255 times already.  This won't happen in practice, but if it does we switch to full 
+            // size_t counts for this sampling set and continue drawing from the same random stream, so our sampling distribution isn't changed
+            LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateSingleSamplingSet count overflow.  Switching to full counts");
+            size_t * const aCountOccurrencesFull = AllocateCountOccurrencesPacked(cInstances, k_cBitsPerCountOccurrenceFull);
+            if(nullptr == aCountOccurrencesFull) {
+               LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateSingleSamplingSet nullptr == aCountOccurrencesFull");
+               free(aCountOccurrencesPacked);
+               return nullptr;
+            }
+            for(size_t iInstanceCopy = 0; iInstanceCopy < cInstances; ++iInstanceCopy) {
+               aCountOccurrencesFull[iInstanceCopy] = countOccurrencesStartMax & 
+                  (aCountOccurrencesPacked[iInstanceCopy >> cShiftUnitStart] >> ((iInstanceCopy & maskItemStart) << cShiftBitsStart));
+            }
+            free(aCountOccurrencesPacked);
+            aCountOccurrencesPacked = aCountOccurrencesFull;
+            cBitsPerCountOccurrence = k_cBitsPerCountOccurrenceFull;
+
+            ++aCountOccurrencesPacked[iInstance];
+            for(++iDraw; iDraw < cInstances; ++iDraw) {
+               ++aCountOccurrencesPacked[pRandomStream->Next(cInstances)];
+            }
+            break;
+         }
+         *pCountOccurrencesPacked += size_t { 1 } << cShift;
       }
    } catch(...) {
       // pRandomStream->Next can throw exceptions from the random number generator, possibly (it's not documented)
       LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateSingleSamplingSet random number generator exception");
+      free(aCountOccurrencesPacked);
       return nullptr;
    }
 
-   SamplingWithReplacement * pRet = new (std::nothrow) SamplingWithReplacement(pOriginDataSet, aCountOccurrences);
+   SamplingWithReplacement * pRet = new (std::nothrow) SamplingWithReplacement(pOriginDataSet, aCountOccurrencesPacked, cBitsPerCountOccurrence);
    if(nullptr == pRet) {
       LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateSingleSamplingSet nullptr == pRet");
-      free(aCountOccurrences);
+      free(aCountOccurrencesPacked);
       return nullptr;
    }
 
@@ -88,43 +119,38 @@ SamplingWithReplacement * SamplingWithReplacement::GenerateFlatSamplingSet(const
    const size_t cInstances = pOriginDataSet->GetCountInstances();
    EBM_ASSERT(0 < cInstances); // if there were no instances, we wouldn't be called
 
-   const size_t cBytesData = sizeof(size_t) * cInstances;
-   size_t * const aCountOccurrences = static_cast<size_t *>(malloc(cBytesData));
-   if(nullptr == aCountOccurrences) {
-      LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateFlatSamplingSet nullptr == aCountOccurrences");
+   // every instance occurs exactly once, so we only need 1 bit per instance
+   size_t * const aCountOccurrencesPacked = AllocateCountOccurrencesPacked(cInstances, k_cBitsPerCountOccurrenceBit);
+   if(nullptr == aCountOccurrencesPacked) {
+      LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateFlatSamplingSet nullptr == aCountOccurrencesPacked");
       return nullptr;
    }
 
-   for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
-      aCountOccurrences[iInstance] = 1;
+   const size_t cUnits = GetCountOccurrencesUnits(cInstances, k_cBitsPerCountOccurrenceBit);
+   for(size_t iUnit = 0; iUnit < cUnits; ++iUnit) {
+      aCountOccurrencesPacked[iUnit] = std::numeric_limits<size_t>::max();
+   }
+   // clear the bits past the end so that the unused bits in our last unit are zero like our other formats
+   const size_t cInstancesLastUnit = cInstances % GetCountOccurrencesPerUnit(k_cBitsPerCountOccurrenceBit);
+   if(0 != cInstancesLastUnit) {
+      aCountOccurrencesPacked[cUnits - 1] = std::numeric_limits<size_t>::max() >> (k_cBitsForSizeT - cInstancesLastUnit);
    }
 
-   SamplingWithReplacement * pRet = new (std::nothrow) SamplingWithReplacement(pOriginDataSet, aCountOccurrences);
+   SamplingWithReplacement * pRet = new (std::nothrow) SamplingWithReplacement(pOriginDataSet, aCountOccurrencesPacked, k_cBitsPerCountOccurrenceBit);
    if(nullptr == pRet) {
       LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateFlatSamplingSet nullptr == pRet");
-      free(aCountOccurrences);
+      free(aCountOccurrencesPacked);
    }
 
    LOG_0(TraceLevelInfo, "Exited SamplingWithReplacement::GenerateFlatSamplingSet");
    return pRet;
 }
 
-void SamplingWithReplacement::FreeSamplingSets(const size_t cSamplingSets, SamplingMethod ** apSamplingSets) {
-   LOG_0(TraceLevelInfo, "Entered SamplingWithReplacement::FreeSamplingSets");
-   if(LIKELY(nullptr != apSamplingSets)) {
-      const size_t cSamplingSetsAfterZero = 0 == cSamplingSets ? 1 : cSamplingSets;
-      for(size_t iSamplingSet = 0; iSamplingSet < cSamplingSetsAfterZero; ++iSamplingSet) {
-         delete apSamplingSets[iSamplingSet];
-      }
-      delete[] apSamplingSets;
-   }
-   LOG_0(TraceLevelInfo, "Exited SamplingWithReplacement::FreeSamplingSets");
-}
-
 SamplingMethod ** SamplingWithReplacement::GenerateSamplingSets(
    RandomStream * const pRandomStream, 
    const DataSetByFeatureCombination * const pOriginDataSet, 
-   const size_t cSamplingSets
+   const size_t cSamplingSets,
+   const size_t cBitsPerCountOccurrenceStart
 ) {
    LOG_0(TraceLevelInfo, "Entered SamplingWithReplacement::GenerateSamplingSets");
 
@@ -142,17 +168,21 @@ SamplingMethod ** SamplingWithReplacement::GenerateSamplingSets(
       SamplingWithReplacement * const pSingleSamplingSet = GenerateFlatSamplingSet(pOriginDataSet);
       if(UNLIKELY(nullptr == pSingleSamplingSet)) {
          LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateSamplingSets nullptr == pSingleSamplingSet");
-         free(apSamplingSets);
+         delete[] apSamplingSets;
          return nullptr;
       }
       apSamplingSets[0] = pSingleSamplingSet;
    } else {
       memset(apSamplingSets, 0, sizeof(*apSamplingSets) * cSamplingSets);
       for(size_t iSamplingSet = 0; iSamplingSet < cSamplingSets; ++iSamplingSet) {
-         SamplingWithReplacement * const pSingleSamplingSet = GenerateSingleSamplingSet(pRandomStream, pOriginDataSet);
+         SamplingWithReplacement * const pSingleSamplingSet = GenerateSingleSamplingSet(
+            pRandomStream, 
+            pOriginDataSet, 
+            cBitsPerCountOccurrenceStart
+         );
          if(UNLIKELY(nullptr == pSingleSamplingSet)) {
             LOG_0(TraceLevelWarning, "WARNING SamplingWithReplacement::GenerateSamplingSets nullptr == pSingleSamplingSet");
-            FreeSamplingSets(cSamplingSets, apSamplingSets);
+            SamplingMethod::FreeSamplingSets(cSamplingSets, apSamplingSets);
             return nullptr;
          }
          apSamplingSets[iSamplingSet] = pSingleSamplingSet;
@@ -0,0 +1,301 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <string.h> // memset
+#include <stdlib.h> // malloc, realloc, free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <cmath> // std::isnan, std::ceil
+#include <limits> // numeric_limits
+
+#include "EbmInternal.h" // EBM_INLINE & UNLIKLEY
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "RandomStream.h" // our header didn't need the full definition, but we use the RandomStream in here, so we need it
+#include "FeatureCombination.h"
+#include "DataSetByFeatureCombination.h"
+#include "SamplingWithReplacement.h"
+#include "SamplingWithoutReplacement.h"
+
+void SamplingWithoutReplacement::FreeInputDataGathered(const size_t cFeatureCombinations, StorageDataType ** const aaInputDataGathered) {
+   if(nullptr != aaInputDataGathered) {
+      for(size_t iFeatureCombination = 0; iFeatureCombination < cFeatureCombinations; ++iFeatureCombination) {
+         free(aaInputDataGathered[iFeatureCombination]);
+      }
+      free(aaInputDataGathered);
+   }
+}
+
+SamplingWithoutReplacement::~SamplingWithoutReplacement() {
+   LOG_0(TraceLevelInfo, "Entered ~SamplingWithoutReplacement");
+   // our base class owns and frees the packed count array, but we own our instance list and our gathered buffers
+   free(m_aiInstancesListedWritable);
+   free(m_aResidualErrorsGatheredWritable);
+   free(m_aNewtonRaphsonStepsGatheredWritable);
+   FreeInputDataGathered(m_cFeatureCombinations, m_aaInputDataGatheredWritable);
+   LOG_0(TraceLevelInfo, "Exited ~SamplingWithoutReplacement");
+}
+
+void SamplingWithoutReplacement::GatherResidualErrors() {
+   LOG_0(TraceLevelVerbose, "Entered SamplingWithoutReplacement::GatherResidualErrors");
+
+   const FloatEbmType * const aResidualErrors = m_pOriginDataSet->GetResidualPointer();
+   const FloatEbmType * const aNewtonRaphsonSteps = m_pOriginDataSet->IsNewtonRaphsonStepsStored() ? 
+      m_pOriginDataSet->GetNewtonRaphsonStepPointer() : nullptr;
+   EBM_ASSERT((nullptr == aNewtonRaphsonSteps) == (nullptr == m_aNewtonRaphsonStepsGatheredWritable));
+   const size_t cVectorLength = m_cVectorLength;
+
+   FloatEbmType * pResidualErrorGathered = m_aResidualErrorsGatheredWritable;
+   FloatEbmType * pNewtonRaphsonStepGathered = m_aNewtonRaphsonStepsGatheredWritable;
+   const size_t * piInstance = m_aiInstancesListedWritable;
+   const size_t * const piInstanceEnd = piInstance + m_cInstancesIncluded;
+   do {
+      // this can't overflow since we're accessing existing memory
+      const size_t iResidualFirst = *piInstance * cVectorLength;
+      size_t iVector = 0;
+      do {
+         *pResidualErrorGathered = aResidualErrors[iResidualFirst + iVector];
+         ++pResidualErrorGathered;
+         ++iVector;
+      } while(iVector < cVectorLength);
+      if(nullptr != pNewtonRaphsonStepGathered) {
+         iVector = 0;
+         do {
+            *pNewtonRaphsonStepGathered = aNewtonRaphsonSteps[iResidualFirst + iVector];
+            ++pNewtonRaphsonStepGathered;
+            ++iVector;
+         } while(iVector < cVectorLength);
+      }
+      ++piInstance;
+   } while(piInstanceEnd != piInstance);
+
+   LOG_0(TraceLevelVerbose, "Exited SamplingWithoutReplacement::GatherResidualErrors");
+}
+
+size_t SamplingWithoutReplacement::GetTotalCountInstanceOccurrences() const {
+   // for SamplingWithoutReplacement, each included instance occurs exactly once
+   const size_t cTotalCountInstanceOccurrences = m_cInstancesIncluded;
+#ifndef NDEBUG
+   size_t cTotalCountInstanceOccurrencesDebug = 0;
+   for(size_t i = 0; i < m_pOriginDataSet->GetCountInstances(); ++i) {
+      cTotalCountInstanceOccurrencesDebug += GetCountOccurrences(i);
+   }
+   EBM_ASSERT(cTotalCountInstanceOccurrencesDebug == cTotalCountInstanceOccurrences);
+#endif // NDEBUG
+   return cTotalCountInstanceOccurrences;
+}
+
+SamplingWithoutReplacement * SamplingWithoutReplacement::GenerateSingleSamplingSet(
+   RandomStream * const pRandomStream,
+   const DataSetByFeatureCombination * const pOriginDataSet,
+   const size_t cInstancesIncluded,
+   const size_t cVectorLength,
+   const size_t cFeatureCombinations,
+   const FeatureCombination * const * const apFeatureCombinations
+) {
+   LOG_0(TraceLevelVerbose, "Entered SamplingWithoutReplacement::GenerateSingleSamplingSet");
+
+   EBM_ASSERT(nullptr != pRandomStream);
+   EBM_ASSERT(nullptr != pOriginDataSet);
+
+   const size_t cInstances = pOriginDataSet->GetCountInstances();
+   EBM_ASSERT(0 < cInstances); // if there were no instances, we wouldn't be called
+   EBM_ASSERT(1 <= cInstancesIncluded);
+   EBM_ASSERT(cInstancesIncluded <= cInstances);
+
+   size_t * const aCountOccurrencesPacked = AllocateCountOccurrencesPacked(cInstances, k_cBitsPerCountOccurrenceBit);
+   if(nullptr == aCountOccurrencesPacked) {
+      LOG_0(TraceLevelWarning, "WARNING SamplingWithoutReplacement::GenerateSingleSamplingSet nullptr == aCountOccurrencesPacked");
+      return nullptr;
+   }
+   // cInstancesIncluded is no larger than cInstances, and our dataset already holds cVectorLength FloatEbmType residuals per instance, so none of 
+   // these can overflow
+   EBM_ASSERT(!IsMultiplyError(sizeof(size_t), cInstancesIncluded));
+   size_t * const aiInstancesListed = static_cast<size_t *>(malloc(sizeof(size_t) * cInstancesIncluded));
+   if(nullptr == aiInstancesListed) {
+      LOG_0(TraceLevelWarning, "WARNING SamplingWithoutReplacement::GenerateSingleSamplingSet nullptr == aiInstancesListed");
+      free(aCountOccurrencesPacked);
+      return nullptr;
+   }
+
+   constexpr size_t cShiftUnitBit = CountBitsRequired(GetCountOccurrencesPerUnit(k_cBitsPerCountOccurrenceBit)) - 1;
+   constexpr size_t maskItemBit = GetCountOccurrencesPerUnit(k_cBitsPerCountOccurrenceBit) - 1;
+
+   try {
+      // selection sampling (Knuth's algorithm S).  We visit the instances in order and include each one with probability 
+      // (instances still needed) / (instances still available), which gives us exactly cInstancesIncluded instances, each subset being equally likely, 
+      // in a single sequential pass that requires one random number per instance just like our bootstrap sampling
+      size_t cInstancesNeeded = cInstancesIncluded;
+      size_t cInstancesRemaining = cInstances;
+      size_t iInstance = 0;
+      do {
+         if(pRandomStream->Next(cInstancesRemaining) < cInstancesNeeded) {
+            aCountOccurrencesPacked[iInstance >> cShiftUnitBit] |= size_t { 1 } << (iInstance & maskItemBit);
+            aiInstancesListed[cInstancesIncluded - cInstancesNeeded] = iInstance;
+            --cInstancesNeeded;
+         }
+         --cInstancesRemaining;
+         ++iInstance;
+      } while(0 != cInstancesNeeded);
+   } catch(...) {
+      // pRandomStream->Next can throw exceptions from the random number generator, possibly (it's not documented)
+      LOG_0(TraceLevelWarning, "WARNING SamplingWithoutReplacement::GenerateSingleSamplingSet random number generator exception");
+      free(aCountOccurrencesPacked);
+      free(aiInstancesListed);
+      return nullptr;
+   }
+
+   const size_t cResidualsGathered = cInstancesIncluded * cVectorLength;
+   EBM_ASSERT(!IsMultiplyError(sizeof(FloatEbmType), cResidualsGathered));
+   FloatEbmType * const aResidualErrorsGathered = static_cast<FloatEbmType *>(malloc(sizeof(FloatEbmType) * cResidualsGathered));
+   FloatEbmType * const aNewtonRaphsonStepsGathered = !pOriginDataSet->IsNewtonRaphsonStepsStored() ? nullptr : 
+      static_cast<FloatEbmType *>(malloc(sizeof(FloatEbmType) * cResidualsGathered));
+   StorageDataType ** aaInputDataGathered = nullptr;
+   if(0 != cFeatureCombinations) {
+      EBM_ASSERT(!IsMultiplyError(sizeof(*aaInputDataGathered), cFeatureCombinations)); // we already allocated our feature combinations
+      aaInputDataGathered = static_cast<StorageDataType **>(malloc(sizeof(*aaInputDataGathered) * cFeatureCombinations));
+      if(nullptr != aaInputDataGathered) {
+         // free will skip over the nullptr entries if we fail below, and zero dimensional feature combinations don't have any input data
+         memset(aaInputDataGathered, 0, sizeof(*aaInputDataGathered) * cFeatureCombinations);
+      }
+   }
+
+   SamplingWithoutReplacement * pRet = nullptr;
+   if(nullptr != aResidualErrorsGathered && 
+      (!pOriginDataSet->IsNewtonRaphsonStepsStored() || nullptr != aNewtonRaphsonStepsGathered) && 
+      (0 == cFeatureCombinations || nullptr != aaInputDataGathered)
+   ) {
+      pRet = new (std::nothrow) SamplingWithoutReplacement(
+         pOriginDataSet, 
+         aCountOccurrencesPacked, 
+         cInstancesIncluded, 
+         cVectorLength, 
+         cFeatureCombinations, 
+         aiInstancesListed, 
+         aResidualErrorsGathered, 
+         aNewtonRaphsonStepsGathered, 
+         aaInputDataGathered
+      );
+   }
+   if(nullptr == pRet) {
+      LOG_0(TraceLevelWarning, "WARNING SamplingWithoutReplacement::GenerateSingleSamplingSet nullptr == pRet");
+      free(aCountOccurrencesPacked);
+      free(aiInstancesListed);
+      free(aResidualErrorsGathered);
+      free(aNewtonRaphsonStepsGathered);
+      FreeInputDataGathered(cFeatureCombinations, aaInputDataGathered);
+      return nullptr;
+   }
+   // from here on our destructor frees everything
+
+   // our bin indexes never change, so we gather them just once.  We pack them the same way as DataSetByFeatureCombination does
+   for(size_t iFeatureCombination = 0; iFeatureCombination < cFeatureCombinations; ++iFeatureCombination) {
+      const FeatureCombination * const pFeatureCombination = apFeatureCombinations[iFeatureCombination];
+      EBM_ASSERT(nullptr != pFeatureCombination);
+      if(0 == pFeatureCombination->m_cFeatures) {
+         continue;
+      }
+      EBM_ASSERT(pFeatureCombination->m_iInputData < cFeatureCombinations);
+      const size_t cItemsPerBitPackedDataUnit = pFeatureCombination->m_cItemsPerBitPackedDataUnit;
+      EBM_ASSERT(1 <= cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(cItemsPerBitPackedDataUnit <= k_cBitsForStorageType);
+      const size_t cBitsPerItemMax = GetCountBits(cItemsPerBitPackedDataUnit);
+      const size_t maskBits = std::numeric_limits<size_t>::max() >> (k_cBitsForStorageType - cBitsPerItemMax);
+
+      const size_t cDataUnits = (cInstancesIncluded - 1) / cItemsPerBitPackedDataUnit + 1; // this can't overflow or underflow
+      StorageDataType * const aInputDataGathered = static_cast<StorageDataType *>(malloc(sizeof(StorageDataType) * cDataUnits));
+      if(nullptr == aInputDataGathered) {
+         LOG_0(TraceLevelWarning, "WARNING SamplingWithoutReplacement::GenerateSingleSamplingSet nullptr == aInputDataGathered");
+         delete pRet;
+         return nullptr;
+      }
+      memset(aInputDataGathered, 0, sizeof(StorageDataType) * cDataUnits);
+      aaInputDataGathered[pFeatureCombination->m_iInputData] = aInputDataGathered;
+
+      const StorageDataType * const aInputData = pOriginDataSet->GetInputDataPointer(pFeatureCombination);
+      for(size_t iListed = 0; iListed < cInstancesIncluded; ++iListed) {
+         const size_t iInstance = aiInstancesListed[iListed];
+         const size_t iTensorBinCombined = static_cast<size_t>(aInputData[iInstance / cItemsPerBitPackedDataUnit]);
+         const size_t iTensorBin = maskBits & (iTensorBinCombined >> (iInstance % cItemsPerBitPackedDataUnit * cBitsPerItemMax));
+         aInputDataGathered[iListed / cItemsPerBitPackedDataUnit] |= 
+            static_cast<StorageDataType>(iTensorBin << (iListed % cItemsPerBitPackedDataUnit * cBitsPerItemMax));
+      }
+   }
+
+   LOG_0(TraceLevelVerbose, "Exited SamplingWithoutReplacement::GenerateSingleSamplingSet");
+   return pRet;
+}
+
+SamplingMethod ** SamplingWithoutReplacement::GenerateSamplingSets(
+   RandomStream * const pRandomStream,
+   const DataSetByFeatureCombination * const pOriginDataSet,
+   const size_t cSamplingSets,
+   const FloatEbmType fractionInstancesIncluded,
+   const size_t cVectorLength,
+   const size_t cFeatureCombinations,
+   const FeatureCombination * const * const apFeatureCombinations
+) {
+   LOG_0(TraceLevelInfo, "Entered SamplingWithoutReplacement::GenerateSamplingSets");
+
+   EBM_ASSERT(nullptr != pRandomStream);
+   EBM_ASSERT(nullptr != pOriginDataSet);
+
+   if(0 == cSamplingSets) {
+      // without inner bagging we use every instance once, which is the same flat sampling set that SamplingWithReplacement uses
+      return SamplingWithReplacement::GenerateSamplingSets(pRandomStream, pOriginDataSet, 0, k_cBitsPerCountOccurrenceByte);
+   }
+
+   if(std::isnan(fractionInstancesIncluded) || fractionInstancesIncluded <= FloatEbmType { 0 } || FloatEbmType { 1 } < fractionInstancesIncluded) {
+      LOG_0(TraceLevelWarning, "WARNING SamplingWithoutReplacement::GenerateSamplingSets fractionInstancesIncluded must be in the range (0, 1]");
+      return nullptr;
+   }
+
+   const size_t cInstances = pOriginDataSet->GetCountInstances();
+   EBM_ASSERT(0 < cInstances); // if there were no instances, we wouldn't be called
+
+   // fractionInstancesIncluded is in the range (0, 1], so this can't overflow, and we round up to keep at least one instance in each set
+   size_t cInstancesIncluded = static_cast<size_t>(std::ceil(fractionInstancesIncluded * static_cast<FloatEbmType>(cInstances)));
+   cInstancesIncluded = cInstances < cInstancesIncluded ? cInstances : cInstancesIncluded;
+   cInstancesIncluded = 0 == cInstancesIncluded ? size_t { 1 } : cInstancesIncluded;
+
+   SamplingMethod ** apSamplingSets = new (std::nothrow) SamplingMethod *[cSamplingSets];
+   if(UNLIKELY(nullptr == apSamplingSets)) {
+      LOG_0(TraceLevelWarning, "WARNING SamplingWithoutReplacement::GenerateSamplingSets nullptr == apSamplingSets");
+      return nullptr;
+   }
+   memset(apSamplingSets, 0, sizeof(*apSamplingSets) * cSamplingSets);
+   for(size_t iSamplingSet = 0; iSamplingSet < cSamplingSets; ++iSamplingSet) {
+      SamplingWithoutReplacement * const pSingleSamplingSet = GenerateSingleSamplingSet(
+         pRandomStream, 
+         pOriginDataSet, 
+         cInstancesIncluded, 
+         cVectorLength, 
+         cFeatureCombinations, 
+         apFeatureCombinations
+      );
+      if(UNLIKELY(nullptr == pSingleSamplingSet)) {
+         LOG_0(TraceLevelWarning, "WARNING SamplingWithoutReplacement::GenerateSamplingSets nullptr == pSingleSamplingSet");
+         SamplingMethod::FreeSamplingSets(cSamplingSets, apSamplingSets);
+         return nullptr;
+      }
+      apSamplingSets[iSamplingSet] = pSingleSamplingSet;
+   }
+   LOG_0(TraceLevelInfo, "Exited SamplingWithoutReplacement::GenerateSamplingSets");
+   return apSamplingSets;
+}
+
+void SamplingWithoutReplacement::GatherResidualErrorsSamplingSets(const size_t cSamplingSets, SamplingMethod * const * const apSamplingSets) {
+   LOG_0(TraceLevelVerbose, "Entered SamplingWithoutReplacement::GatherResidualErrorsSamplingSets");
+
+   // without inner bagging we use the flat SamplingWithReplacement set, which doesn't gather
+   EBM_ASSERT(1 <= cSamplingSets);
+   EBM_ASSERT(nullptr != apSamplingSets);
+   for(size_t iSamplingSet = 0; iSamplingSet < cSamplingSets; ++iSamplingSet) {
+      SamplingWithoutReplacement * const pSamplingSet = static_cast<SamplingWithoutReplacement *>(apSamplingSets[iSamplingSet]);
+      EBM_ASSERT(nullptr != pSamplingSet);
+      pSamplingSet->GatherResidualErrors();
+   }
+
+   LOG_0(TraceLevelVerbose, "Exited SamplingWithoutReplacement::GatherResidualErrorsSamplingSets");
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef SAMPLING_WITHOUT_REPLACEMENT_H
+#define SAMPLING_WITHOUT_REPLACEMENT_H
+
+#include <stddef.h> // size_t, ptrdiff_t
+
+#include "ebm_native.h" // FloatEbmType
+#include "EbmInternal.h" // EBM_INLINE
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "SamplingMethod.h"
+
+class RandomStream;
+class DataSetByFeatureCombination;
+class FeatureCombination;
+
+// SamplingWithoutReplacement includes each instance at most once, so we only need 1 bit per instance to describe each sampling set, which uses 1/64th 
+// of the memory of a full size_t count per instance and greatly reduces the memory pressure in our histogram kernels.
+// We also list our included instances and gather their bin indexes (once, since they never change) and their residuals (after each update) into 
+// contiguous buffers, so that our histogram kernels read sequential memory and do work proportional to the number of included instances
+class SamplingWithoutReplacement final : public SamplingMethod {
+   const size_t m_cInstancesIncluded;
+   const size_t m_cVectorLength;
+   const size_t m_cFeatureCombinations;
+   size_t * const m_aiInstancesListedWritable;
+   FloatEbmType * const m_aResidualErrorsGatheredWritable;
+   FloatEbmType * const m_aNewtonRaphsonStepsGatheredWritable;
+   StorageDataType ** const m_aaInputDataGatheredWritable;
+
+   static void FreeInputDataGathered(const size_t cFeatureCombinations, StorageDataType ** const aaInputDataGathered);
+
+public:
+   EBM_INLINE SamplingWithoutReplacement(
+      const DataSetByFeatureCombination * const pOriginDataSet,
+      const size_t * const aCountOccurrencesPacked,
+      const size_t cInstancesIncluded,
+      const size_t cVectorLength,
+      const size_t cFeatureCombinations,
+      size_t * const aiInstancesListed,
+      FloatEbmType * const aResidualErrorsGathered,
+      FloatEbmType * const aNewtonRaphsonStepsGathered,
+      StorageDataType ** const aaInputDataGathered
+   )
+      : SamplingMethod(pOriginDataSet, aCountOccurrencesPacked, k_cBitsPerCountOccurrenceBit)
+      , m_cInstancesIncluded(cInstancesIncluded)
+      , m_cVectorLength(cVectorLength)
+      , m_cFeatureCombinations(cFeatureCombinations)
+      , m_aiInstancesListedWritable(aiInstancesListed)
+      , m_aResidualErrorsGatheredWritable(aResidualErrorsGathered)
+      , m_aNewtonRaphsonStepsGatheredWritable(aNewtonRaphsonStepsGathered)
+      , m_aaInputDataGatheredWritable(aaInputDataGathered) {
+      m_aiInstancesListed = aiInstancesListed;
+      m_cInstancesListed = cInstancesIncluded;
+      m_aResidualErrorsGathered = aResidualErrorsGathered;
+      m_aNewtonRaphsonStepsGathered = aNewtonRaphsonStepsGathered;
+      m_aaInputDataGathered = aaInputDataGathered;
+   }
+
+   virtual ~SamplingWithoutReplacement() final override;
+   virtual size_t GetTotalCountInstanceOccurrences() const final override;
+
+   // our residuals change after each update, so we need to call this before we build any histograms with the new residuals
+   void GatherResidualErrors();
+
+   static SamplingWithoutReplacement * GenerateSingleSamplingSet(
+      RandomStream * const pRandomStream,
+      const DataSetByFeatureCombination * const pOriginDataSet,
+      const size_t cInstancesIncluded,
+      const size_t cVectorLength,
+      const size_t cFeatureCombinations,
+      const FeatureCombination * const * const apFeatureCombinations
+   );
+
+   static SamplingMethod ** GenerateSamplingSets(
+      RandomStream * const pRandomStream,
+      const DataSetByFeatureCombination * const pOriginDataSet,
+      const size_t cSamplingSets,
+      const FloatEbmType fractionInstancesIncluded,
+      const size_t cVectorLength,
+      const size_t cFeatureCombinations,
+      const FeatureCombination * const * const apFeatureCombinations
+   );
+
+   static void GatherResidualErrorsSamplingSets(const size_t cSamplingSets, SamplingMethod * const * const apSamplingSets);
+};
+
+#endif // SAMPLING_WITHOUT_REPLACEMENT_H
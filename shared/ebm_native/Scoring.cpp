@@ -0,0 +1,1094 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <stddef.h> // size_t, ptrdiff_t
+#include <stdlib.h> // malloc, free
+#include <string.h> // memcpy
+#include <cmath> // std::exp
+#include <type_traits> // std::is_standard_layout
+#include <limits> // numeric_limits
+
+#include "ebm_native.h"
+
+#include "EbmInternal.h"
+// very independent includes
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "Scoring.h"
+
+// we score our instances in tiles of this many rows.  For each tile we visit every term in our model, so the per-row tensor indexes and the
+// per-row scores that we accumulate into stay in L1 cache while we sweep over the terms.  The tensors themselves tend to be small enough to stay in
+// L2 cache when we visit them tile after tile
+constexpr size_t k_cInstancesPerTile = 64;
+
+struct ScoringTerm final {
+   const FloatEbmType * m_aModelTensor;
+   // we drop dimensions with only 1 bin, since they always have a tensor index of zero
+   size_t m_cDimensions;
+   size_t m_aiFeatures[k_cDimensionsMax];
+   size_t m_aTensorMultiples[k_cDimensionsMax];
+   // the bins in each dimension, which we use to check our caller's binned values before we index into the tensor with them
+   size_t m_acBins[k_cDimensionsMax];
+};
+
+static_assert(std::is_standard_layout<ScoringTerm>::value,
+   "we use malloc to allocate our ScoringTerm array, so it should be standard layout");
+
+static bool ConstructScoringTerms(
+   const size_t cFeatures,
+   const EbmNativeFeature * const aFeatures,
+   const size_t cFeatureCombinations,
+   const EbmNativeFeatureCombination * const aFeatureCombinations,
+   const IntEbmType * const aFeatureCombinationIndexes,
+   const FloatEbmType * const * const aModelFeatureCombinationTensors,
+   ScoringTerm * const aScoringTerms,
+   bool * const abFeatureUsed // can be nullptr if our caller doesn't need to know which features are used
+) {
+   const IntEbmType * pFeatureCombinationIndex = aFeatureCombinationIndexes;
+   for(size_t iFeatureCombination = 0; iFeatureCombination < cFeatureCombinations; ++iFeatureCombination) {
+      ScoringTerm * const pScoringTerm = &aScoringTerms[iFeatureCombination];
+      pScoringTerm->m_aModelTensor = aModelFeatureCombinationTensors[iFeatureCombination];
+      if(nullptr == pScoringTerm->m_aModelTensor) {
+         LOG_0(TraceLevelWarning, "WARNING ConstructScoringTerms nullptr == pScoringTerm->m_aModelTensor");
+         return true;
+      }
+
+      const IntEbmType countFeaturesInCombination = aFeatureCombinations[iFeatureCombination].countFeaturesInCombination;
+      if(countFeaturesInCombination < 0) {
+         LOG_0(TraceLevelWarning, "WARNING ConstructScoringTerms countFeaturesInCombination < 0");
+         return true;
+      }
+      if(!IsNumberConvertable<size_t, IntEbmType>(countFeaturesInCombination)) {
+         LOG_0(TraceLevelWarning, "WARNING ConstructScoringTerms !IsNumberConvertable<size_t, IntEbmType>(countFeaturesInCombination)");
+         return true;
+      }
+      const size_t cFeaturesInCombination = static_cast<size_t>(countFeaturesInCombination);
+      if(0 != cFeaturesInCombination && nullptr == aFeatureCombinationIndexes) {
+         LOG_0(TraceLevelWarning, "WARNING ConstructScoringTerms 0 != cFeaturesInCombination && nullptr == aFeatureCombinationIndexes");
+         return true;
+      }
+
+      size_t cDimensions = 0;
+      size_t cTensorBins = 1;
+      const IntEbmType * const pFeatureCombinationIndexEnd = pFeatureCombinationIndex + cFeaturesInCombination;
+      while(pFeatureCombinationIndexEnd != pFeatureCombinationIndex) {
+         const IntEbmType indexFeature = *pFeatureCombinationIndex;
+         ++pFeatureCombinationIndex;
+         if(indexFeature < 0) {
+            LOG_0(TraceLevelWarning, "WARNING ConstructScoringTerms indexFeature < 0");
+            return true;
+         }
+         if(!IsNumberConvertable<size_t, IntEbmType>(indexFeature) || cFeatures <= static_cast<size_t>(indexFeature)) {
+            LOG_0(TraceLevelWarning, "WARNING ConstructScoringTerms cFeatures <= indexFeature");
+            return true;
+         }
+         const size_t iFeature = static_cast<size_t>(indexFeature);
+         const IntEbmType countBins = aFeatures[iFeature].countBins;
+         if(countBins <= 1) {
+            // a feature with 0 bins can't have any instances, and a feature with 1 bin contributes nothing to the tensor index, so we don't need 
+            // to look at the data for these at all
+            continue;
+         }
+         if(!IsNumberConvertable<size_t, IntEbmType>(countBins)) {
+            LOG_0(TraceLevelWarning, "WARNING ConstructScoringTerms !IsNumberConvertable<size_t, IntEbmType>(countBins)");
+            return true;
+         }
+         if(k_cDimensionsMax <= cDimensions) {
+            LOG_0(TraceLevelWarning, "WARNING ConstructScoringTerms k_cDimensionsMax <= cDimensions");
+            return true;
+         }
+         const size_t cBins = static_cast<size_t>(countBins);
+         pScoringTerm->m_aiFeatures[cDimensions] = iFeature;
+         pScoringTerm->m_acBins[cDimensions] = cBins;
+         if(nullptr != abFeatureUsed) {
+            abFeatureUsed[iFeature] = true;
+         }
+         pScoringTerm->m_aTensorMultiples[cDimensions] = cTensorBins;
+         ++cDimensions;
+         if(IsMultiplyError(cTensorBins, cBins)) {
+            LOG_0(TraceLevelWarning, "WARNING ConstructScoringTerms IsMultiplyError(cTensorBins, cBins)");
+            return true;
+         }
+         cTensorBins *= cBins;
+      }
+      pScoringTerm->m_cDimensions = cDimensions;
+   }
+   return false;
+}
+
+// binned data uses -1 for missing values in features without a missing bin, which also becomes this value when we cast to size_t
+constexpr size_t k_iBinIllegal = std::numeric_limits<size_t>::max();
+
+static EBM_INLINE size_t GetBinIndex(const IntEbmType binnedValue) {
+   return static_cast<size_t>(binnedValue);
+}
+
+static EBM_INLINE size_t GetBinIndex(const size_t iBin) {
+   return iBin;
+}
+
+static EBM_INLINE size_t DiscretizeValue(
+   const FloatEbmType value,
+   const FloatEbmType * const aCutPointsLowerBoundInclusive,
+   const size_t cCutPoints,
+   const bool bMissing
+) {
+   // this gives the same bins as Discretize
+   if(UNLIKELY(std::isnan(value))) {
+      return bMissing ? size_t { 0 } : k_iBinIllegal;
+   }
+   size_t low = 0;
+   size_t high = cCutPoints;
+   while(low < high) {
+      const size_t middle = (low + high) >> 1;
+      const bool bAbove = aCutPointsLowerBoundInclusive[middle] <= value;
+      low = UNPREDICTABLE(bAbove) ? middle + size_t { 1 } : low;
+      high = UNPREDICTABLE(bAbove) ? high : middle;
+   }
+   // we bump up all indexes to allow missing to be 0
+   return bMissing ? low + size_t { 1 } : low;
+}
+
+// TBin is IntEbmType when we read our caller's binned data directly, or size_t when we read the bins that we computed for this tile from raw values
+template<typename TBin>
+static bool ComputeTensorIndexes(
+   const ScoringTerm * const pScoringTerm,
+   const TBin * const aTileBins,
+   const size_t cInstanceStride,
+   const size_t cFeatureStride,
+   const size_t cTileInstances,
+   size_t * const aTensorIndexes
+) {
+   const size_t cDimensions = pScoringTerm->m_cDimensions;
+   if(0 == cDimensions) {
+      // every instance falls into the single tensor cell
+      for(size_t iInstance = 0; iInstance < cTileInstances; ++iInstance) {
+         aTensorIndexes[iInstance] = 0;
+      }
+      return false;
+   }
+   // we compute the tensor indexes one dimension at a time so that we read each feature's column sequentially when our data is
+   // feature major, and then our callers gather from the tensor in a separate loop that the compiler can keep free of index arithmetic
+   for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+      const TBin * pTileBin = &aTileBins[pScoringTerm->m_aiFeatures[iDimension] * cFeatureStride];
+      const size_t tensorMultiple = pScoringTerm->m_aTensorMultiples[iDimension];
+      for(size_t iInstance = 0; iInstance < cTileInstances; ++iInstance) {
+         const size_t iBin = GetBinIndex(*pTileBin);
+         pTileBin += cInstanceStride;
+         if(UNLIKELY(k_iBinIllegal == iBin)) {
+            LOG_0(TraceLevelWarning, "WARNING ComputeTensorIndexes missing value in a feature without a missing bin");
+            return true;
+         }
+         if(UNLIKELY(pScoringTerm->m_acBins[iDimension] <= iBin)) {
+            // our caller's binned data or model came from outside, so a bad bin would otherwise index past the end of the tensor
+            LOG_0(TraceLevelWarning, "WARNING ComputeTensorIndexes binned value out of range");
+            return true;
+         }
+         const size_t tensorIndexPartial = tensorMultiple * iBin;
+         aTensorIndexes[iInstance] = 0 == iDimension ? tensorIndexPartial : aTensorIndexes[iInstance] + tensorIndexPartial;
+      }
+   }
+   return false;
+}
+
+template<typename TBin>
+static bool AddTermsToTile(
+   const ScoringTerm * const aScoringTerms,
+   const ScoringTerm * const pScoringTermsEnd,
+   const TBin * const aTileBins,
+   const size_t cInstanceStride,
+   const size_t cFeatureStride,
+   const size_t cTileInstances,
+   const size_t cVectorLength,
+   FloatEbmType * const aTileScores
+) {
+   size_t aTensorIndexes[k_cInstancesPerTile];
+   const size_t cTileScores = cVectorLength * cTileInstances;
+   for(const ScoringTerm * pScoringTerm = aScoringTerms; pScoringTermsEnd != pScoringTerm; ++pScoringTerm) {
+      const FloatEbmType * const aModelTensor = pScoringTerm->m_aModelTensor;
+      if(0 == pScoringTerm->m_cDimensions) {
+         // every instance falls into the single tensor cell
+         for(size_t iTileScore = 0; iTileScore < cTileScores; iTileScore += cVectorLength) {
+            for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+               aTileScores[iTileScore + iVector] += aModelTensor[iVector];
+            }
+         }
+         continue;
+      }
+
+      if(ComputeTensorIndexes<TBin>(pScoringTerm, aTileBins, cInstanceStride, cFeatureStride, cTileInstances, aTensorIndexes)) {
+         return true;
+      }
+
+      if(1 == cVectorLength) {
+         for(size_t iInstance = 0; iInstance < cTileInstances; ++iInstance) {
+            aTileScores[iInstance] += aModelTensor[aTensorIndexes[iInstance]];
+         }
+      } else {
+         FloatEbmType * pTileScores = aTileScores;
+         for(size_t iInstance = 0; iInstance < cTileInstances; ++iInstance) {
+            const FloatEbmType * const pModelScores = &aModelTensor[aTensorIndexes[iInstance] * cVectorLength];
+            for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+               pTileScores[iVector] += pModelScores[iVector];
+            }
+            pTileScores += cVectorLength;
+         }
+      }
+   }
+   return false;
+}
+
+static void FinishTile(
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   const bool bProbabilities,
+   const size_t cVectorLength,
+   const size_t cTileInstances,
+   const FloatEbmType * const aTileScores,
+   FloatEbmType * const aScoresOut
+) {
+   UNUSED(runtimeLearningTypeOrCountTargetClasses); // we only use this in our asserts
+   if(!bProbabilities) {
+      memcpy(aScoresOut, aTileScores, sizeof(*aTileScores) * cVectorLength * cTileInstances);
+      return;
+   }
+   EBM_ASSERT(IsClassification(runtimeLearningTypeOrCountTargetClasses));
+   if(1 == cVectorLength) {
+      // our binary models keep only the logit for the 1 class (unless EXPAND_BINARY_LOGITS is set), so we expand the output to both classes
+      EBM_ASSERT(IsBinaryClassification(runtimeLearningTypeOrCountTargetClasses));
+      for(size_t iInstance = 0; iInstance < cTileInstances; ++iInstance) {
+         const FloatEbmType probability = FloatEbmType { 1 } / (FloatEbmType { 1 } + std::exp(-aTileScores[iInstance]));
+         aScoresOut[iInstance << 1] = FloatEbmType { 1 } - probability;
+         aScoresOut[(iInstance << 1) + 1] = probability;
+      }
+   } else {
+      EBM_ASSERT(static_cast<size_t>(runtimeLearningTypeOrCountTargetClasses) == cVectorLength);
+      const FloatEbmType * pTileScores = aTileScores;
+      FloatEbmType * pScoresOut = aScoresOut;
+      const FloatEbmType * const pTileScoresEnd = aTileScores + cVectorLength * cTileInstances;
+      do {
+         // subtract the largest logit before taking our exp so that we can't overflow, which is also what our python softmax does
+         FloatEbmType logitMax = pTileScores[0];
+         for(size_t iVector = 1; iVector < cVectorLength; ++iVector) {
+            logitMax = logitMax < pTileScores[iVector] ? pTileScores[iVector] : logitMax;
+         }
+         FloatEbmType sumExp = FloatEbmType { 0 };
+         for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+            const FloatEbmType oneExp = std::exp(pTileScores[iVector] - logitMax);
+            pScoresOut[iVector] = oneExp;
+            sumExp += oneExp;
+         }
+         const FloatEbmType sumExpInverted = FloatEbmType { 1 } / sumExp;
+         for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+            pScoresOut[iVector] *= sumExpInverted;
+         }
+         pTileScores += cVectorLength;
+         pScoresOut += cVectorLength;
+      } while(pTileScoresEnd != pTileScores);
+   }
+}
+
+// we take either binnedData, or rawData along with the cutPointsLowerBoundInclusive to bin it
+extern IntEbmType ScoreInstances(
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   const IntEbmType countFeatures,
+   const EbmNativeFeature * const features,
+   const FloatEbmType * const * const cutPointsLowerBoundInclusive,
+   const IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * const featureCombinations,
+   const IntEbmType * const featureCombinationIndexes,
+   const FloatEbmType * const * const modelFeatureCombinationTensors,
+   const FloatEbmType * const intercept,
+   const IntEbmType countInstances,
+   const IntEbmType * const binnedData,
+   const FloatEbmType * const rawData,
+   const bool bDataRowMajor,
+   const bool bProbabilities,
+   FloatEbmType * const scoresReturn
+) {
+   // intercept can be nullptr, in which case we start from zero
+   // cutPointsLowerBoundInclusive can hold nullptr for features that have no cut points
+
+   // IsNumberConvertable rejects negative counts
+   if(!IsNumberConvertable<size_t, IntEbmType>(countFeatures)) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances !IsNumberConvertable<size_t, IntEbmType>(countFeatures)");
+      return 1;
+   }
+   if(!IsNumberConvertable<size_t, IntEbmType>(countFeatureCombinations)) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances !IsNumberConvertable<size_t, IntEbmType>(countFeatureCombinations)");
+      return 1;
+   }
+   if(!IsNumberConvertable<size_t, IntEbmType>(countInstances)) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances !IsNumberConvertable<size_t, IntEbmType>(countInstances)");
+      return 1;
+   }
+   const size_t cFeatures = static_cast<size_t>(countFeatures);
+   const size_t cFeatureCombinations = static_cast<size_t>(countFeatureCombinations);
+   const size_t cInstances = static_cast<size_t>(countInstances);
+
+   if(0 != cFeatures && nullptr == features) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances 0 != cFeatures && nullptr == features");
+      return 1;
+   }
+   if(0 != cFeatureCombinations && (nullptr == featureCombinations || nullptr == modelFeatureCombinationTensors)) {
+      LOG_0(TraceLevelWarning, 
+         "WARNING ScoreInstances 0 != cFeatureCombinations && (nullptr == featureCombinations || nullptr == modelFeatureCombinationTensors)");
+      return 1;
+   }
+   if(nullptr != binnedData && nullptr != rawData) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances nullptr != binnedData && nullptr != rawData");
+      return 1;
+   }
+
+   if(0 == cInstances) {
+      LOG_0(TraceLevelInfo, "INFO ScoreInstances zero instances");
+      return 0;
+   }
+   if(nullptr == scoresReturn) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances nullptr == scoresReturn");
+      return 1;
+   }
+   if(0 != cFeatures && nullptr == binnedData && nullptr == rawData) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances 0 != cFeatures && nullptr == binnedData && nullptr == rawData");
+      return 1;
+   }
+   if(nullptr != rawData && 0 != cFeatures && nullptr == cutPointsLowerBoundInclusive) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances nullptr != rawData && 0 != cFeatures && nullptr == cutPointsLowerBoundInclusive");
+      return 1;
+   }
+
+   if(IsClassification(runtimeLearningTypeOrCountTargetClasses) && runtimeLearningTypeOrCountTargetClasses <= ptrdiff_t { 1 }) {
+      // with only 1 target class our models are empty and we predict that class with 100% certainty.  Our logits have zero items per instance
+      LOG_0(TraceLevelInfo, "INFO ScoreInstances runtimeLearningTypeOrCountTargetClasses <= ptrdiff_t { 1 }");
+      if(bProbabilities && ptrdiff_t { 1 } == runtimeLearningTypeOrCountTargetClasses) {
+         for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
+            scoresReturn[iInstance] = FloatEbmType { 1 };
+         }
+      }
+      return 0;
+   }
+
+   const size_t cVectorLength = GetVectorLength(runtimeLearningTypeOrCountTargetClasses);
+   // our binary probabilities have 2 outputs per instance, so check that too even though it's not required for logits
+   if(IsMultiplyError(cVectorLength + 1, cInstances)) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances IsMultiplyError(cVectorLength + 1, cInstances)");
+      return 1;
+   }
+   // the python caller gives us their data as [feature][instance], but data coming from a row oriented source is [instance][feature], so we handle
+   // both by indexing with a pair of strides
+   const size_t cInstanceStride = bDataRowMajor ? cFeatures : size_t { 1 };
+   const size_t cFeatureStride = bDataRowMajor ? size_t { 1 } : cInstances;
+
+   if(IsMultiplyError(sizeof(ScoringTerm), cFeatureCombinations)) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances IsMultiplyError(sizeof(ScoringTerm), cFeatureCombinations)");
+      return 1;
+   }
+   // add 1 so that we don't call malloc with zero bytes if there are no feature combinations
+   ScoringTerm * const aScoringTerms = static_cast<ScoringTerm *>(malloc(sizeof(ScoringTerm) * cFeatureCombinations + 1));
+   if(nullptr == aScoringTerms) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances nullptr == aScoringTerms");
+      return 1;
+   }
+   // add 1 so that we don't call malloc with zero bytes if there are no features
+   bool * const abFeatureUsed = static_cast<bool *>(malloc(sizeof(bool) * cFeatures + 1));
+   if(nullptr == abFeatureUsed) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances nullptr == abFeatureUsed");
+      free(aScoringTerms);
+      return 1;
+   }
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      abFeatureUsed[iFeature] = false;
+   }
+   if(ConstructScoringTerms(
+      cFeatures,
+      features,
+      cFeatureCombinations,
+      featureCombinations,
+      featureCombinationIndexes,
+      modelFeatureCombinationTensors,
+      aScoringTerms,
+      abFeatureUsed
+   )) {
+      free(abFeatureUsed);
+      free(aScoringTerms);
+      return 1;
+   }
+   if(nullptr != rawData) {
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         // ConstructScoringTerms only marks features with 2 or more bins as used, and those have cut points unless 1 of the bins is missing
+         if(abFeatureUsed[iFeature] && nullptr == cutPointsLowerBoundInclusive[iFeature] && 
+            (EBM_FALSE == features[iFeature].hasMissing || IntEbmType { 2 } < features[iFeature].countBins)) {
+            LOG_0(TraceLevelWarning, "WARNING ScoreInstances nullptr == cutPointsLowerBoundInclusive[iFeature] for a feature with cut points");
+            free(abFeatureUsed);
+            free(aScoringTerms);
+            return 1;
+         }
+      }
+   }
+
+   FloatEbmType * const aTileScores = static_cast<FloatEbmType *>(malloc(sizeof(FloatEbmType) * cVectorLength * k_cInstancesPerTile));
+   // when we score raw values we bin each feature once per tile and then every term that uses that feature reads the bins from here.  This holds 
+   // a tile's worth of rows, so it stays in cache, and we never build the full binned matrix
+   size_t * aTileBins = nullptr;
+   if(nullptr != rawData) {
+      if(IsMultiplyError(sizeof(size_t) * k_cInstancesPerTile, cFeatures)) {
+         LOG_0(TraceLevelWarning, "WARNING ScoreInstances IsMultiplyError(sizeof(size_t) * k_cInstancesPerTile, cFeatures)");
+         free(aTileScores);
+         free(abFeatureUsed);
+         free(aScoringTerms);
+         return 1;
+      }
+      aTileBins = static_cast<size_t *>(malloc(sizeof(size_t) * k_cInstancesPerTile * cFeatures + 1));
+   }
+   if(nullptr == aTileScores || nullptr != rawData && nullptr == aTileBins) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstances nullptr == aTileScores || nullptr != rawData && nullptr == aTileBins");
+      free(aTileBins);
+      free(aTileScores);
+      free(abFeatureUsed);
+      free(aScoringTerms);
+      return 1;
+   }
+
+   const size_t cOutputsPerInstance = bProbabilities && IsBinaryClassification(runtimeLearningTypeOrCountTargetClasses) ? size_t { 2 } : cVectorLength;
+   const ScoringTerm * const pScoringTermsEnd = aScoringTerms + cFeatureCombinations;
+
+   size_t iTileStart = 0;
+   do {
+      const size_t cTileInstances = k_cInstancesPerTile < cInstances - iTileStart ? k_cInstancesPerTile : cInstances - iTileStart;
+      const size_t cTileScores = cVectorLength * cTileInstances;
+
+      if(nullptr == intercept) {
+         for(size_t iTileScore = 0; iTileScore < cTileScores; ++iTileScore) {
+            aTileScores[iTileScore] = FloatEbmType { 0 };
+         }
+      } else {
+         for(size_t iTileScore = 0; iTileScore < cTileScores; iTileScore += cVectorLength) {
+            for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+               aTileScores[iTileScore + iVector] = intercept[iVector];
+            }
+         }
+      }
+
+      bool bError;
+      if(nullptr != rawData) {
+         for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+            if(!abFeatureUsed[iFeature]) {
+               continue;
+            }
+            const bool bMissing = EBM_FALSE != features[iFeature].hasMissing;
+            // ConstructScoringTerms only marks features with 2 or more bins as used, so this can't underflow
+            const size_t cCutPoints = static_cast<size_t>(features[iFeature].countBins) - (bMissing ? size_t { 2 } : size_t { 1 });
+            const FloatEbmType * const aCutPoints = cutPointsLowerBoundInclusive[iFeature];
+            // we checked this before our first tile
+            EBM_ASSERT(0 == cCutPoints || nullptr != aCutPoints);
+            const FloatEbmType * pRawData = &rawData[iTileStart * cInstanceStride + iFeature * cFeatureStride];
+            size_t * const aFeatureTileBins = &aTileBins[iFeature * k_cInstancesPerTile];
+            for(size_t iInstance = 0; iInstance < cTileInstances; ++iInstance) {
+               aFeatureTileBins[iInstance] = DiscretizeValue(*pRawData, aCutPoints, cCutPoints, bMissing);
+               pRawData += cInstanceStride;
+            }
+         }
+         bError = AddTermsToTile<size_t>(aScoringTerms, pScoringTermsEnd, aTileBins, size_t { 1 }, k_cInstancesPerTile, cTileInstances,
+            cVectorLength, aTileScores);
+      } else {
+         bError = AddTermsToTile<IntEbmType>(aScoringTerms, pScoringTermsEnd, &binnedData[iTileStart * cInstanceStride], cInstanceStride, 
+            cFeatureStride, cTileInstances, cVectorLength, aTileScores);
+      }
+      if(bError) {
+         free(aTileBins);
+         free(aTileScores);
+         free(abFeatureUsed);
+         free(aScoringTerms);
+         return 1;
+      }
+
+      FinishTile(
+         runtimeLearningTypeOrCountTargetClasses,
+         bProbabilities,
+         cVectorLength,
+         cTileInstances,
+         aTileScores,
+         &scoresReturn[iTileStart * cOutputsPerInstance]
+      );
+
+      iTileStart += cTileInstances;
+   } while(cInstances != iTileStart);
+
+   free(aTileBins);
+   free(aTileScores);
+   free(abFeatureUsed);
+   free(aScoringTerms);
+   return 0;
+}
+
+static void InsertTopTerm(
+   const size_t cTopTerms,
+   const size_t cVectorLength,
+   const IntEbmType indexTerm,
+   const FloatEbmType magnitude,
+   const FloatEbmType * const aContributions,
+   size_t * const pcTopTermsFilled,
+   FloatEbmType * const aTopMagnitudes,
+   IntEbmType * const aTopTermIndexes,
+   FloatEbmType * const aTopContributions
+) {
+   // we keep our top terms sorted by decreasing magnitude directly in our caller's output, so we only need k slots per row.  k is normally small
+   // so an insertion sort beats a heap here, and it leaves the output already sorted.  Ties keep the earlier term
+   size_t iPosition;
+   if(cTopTerms == *pcTopTermsFilled) {
+      if(!(aTopMagnitudes[cTopTerms - 1] < magnitude)) {
+         return;
+      }
+      iPosition = cTopTerms - 1;
+   } else {
+      iPosition = *pcTopTermsFilled;
+      ++*pcTopTermsFilled;
+   }
+   while(0 != iPosition && aTopMagnitudes[iPosition - 1] < magnitude) {
+      aTopMagnitudes[iPosition] = aTopMagnitudes[iPosition - 1];
+      aTopTermIndexes[iPosition] = aTopTermIndexes[iPosition - 1];
+      memcpy(&aTopContributions[iPosition * cVectorLength], &aTopContributions[(iPosition - 1) * cVectorLength], sizeof(FloatEbmType) * cVectorLength);
+      --iPosition;
+   }
+   aTopMagnitudes[iPosition] = magnitude;
+   aTopTermIndexes[iPosition] = indexTerm;
+   memcpy(&aTopContributions[iPosition * cVectorLength], aContributions, sizeof(FloatEbmType) * cVectorLength);
+}
+
+static IntEbmType GetTermContributions(
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   const IntEbmType countFeatures,
+   const EbmNativeFeature * const features,
+   const IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * const featureCombinations,
+   const IntEbmType * const featureCombinationIndexes,
+   const FloatEbmType * const * const modelFeatureCombinationTensors,
+   const IntEbmType countInstances,
+   const IntEbmType * const binnedData,
+   const bool bBinnedDataRowMajor,
+   const IntEbmType countTopTerms,
+   IntEbmType * const termIndexesReturn,
+   FloatEbmType * const contributionsReturn
+) {
+   EBM_ASSERT(0 <= countFeatures);
+   EBM_ASSERT(0 == countFeatures || nullptr != features);
+   EBM_ASSERT(0 <= countFeatureCombinations);
+   EBM_ASSERT(0 == countFeatureCombinations || nullptr != featureCombinations);
+   EBM_ASSERT(0 == countFeatureCombinations || nullptr != modelFeatureCombinationTensors);
+   EBM_ASSERT(0 <= countInstances);
+   EBM_ASSERT(0 == countInstances || 0 == countFeatures || nullptr != binnedData);
+   EBM_ASSERT(0 <= countTopTerms);
+   EBM_ASSERT(0 == countInstances || 0 == countTopTerms || nullptr != termIndexesReturn);
+   EBM_ASSERT(0 == countInstances || nullptr != contributionsReturn);
+
+   if(!IsNumberConvertable<size_t, IntEbmType>(countFeatures)) {
+      LOG_0(TraceLevelWarning, "WARNING GetTermContributions !IsNumberConvertable<size_t, IntEbmType>(countFeatures)");
+      return 1;
+   }
+   if(!IsNumberConvertable<size_t, IntEbmType>(countFeatureCombinations)) {
+      LOG_0(TraceLevelWarning, "WARNING GetTermContributions !IsNumberConvertable<size_t, IntEbmType>(countFeatureCombinations)");
+      return 1;
+   }
+   if(!IsNumberConvertable<size_t, IntEbmType>(countInstances)) {
+      LOG_0(TraceLevelWarning, "WARNING GetTermContributions !IsNumberConvertable<size_t, IntEbmType>(countInstances)");
+      return 1;
+   }
+   if(!IsNumberConvertable<size_t, IntEbmType>(countTopTerms)) {
+      LOG_0(TraceLevelWarning, "WARNING GetTermContributions !IsNumberConvertable<size_t, IntEbmType>(countTopTerms)");
+      return 1;
+   }
+   const size_t cFeatures = static_cast<size_t>(countFeatures);
+   const size_t cFeatureCombinations = static_cast<size_t>(countFeatureCombinations);
+   const size_t cInstances = static_cast<size_t>(countInstances);
+   const size_t cTopTerms = static_cast<size_t>(countTopTerms);
+
+   if(0 == cInstances) {
+      LOG_0(TraceLevelInfo, "INFO GetTermContributions zero instances");
+      return 0;
+   }
+
+   // with only 1 target class our models are empty, so every term contributes nothing
+   const size_t cVectorLength = IsClassification(runtimeLearningTypeOrCountTargetClasses) && 
+      runtimeLearningTypeOrCountTargetClasses <= ptrdiff_t { 1 } ? size_t { 0 } : GetVectorLength(runtimeLearningTypeOrCountTargetClasses);
+
+   // 0 == cTopTerms means that we return every term's contribution
+   const size_t cTermsOut = 0 == cTopTerms ? cFeatureCombinations : cTopTerms;
+   if(IsMultiplyError(cTermsOut, cVectorLength) || IsMultiplyError(cTermsOut * cVectorLength, cInstances)) {
+      LOG_0(TraceLevelWarning, "WARNING GetTermContributions IsMultiplyError(cTermsOut * cVectorLength, cInstances)");
+      return 1;
+   }
+   const size_t cContributionsPerInstance = cTermsOut * cVectorLength;
+   if(0 != cTopTerms && IsMultiplyError(cTopTerms, cInstances)) {
+      LOG_0(TraceLevelWarning, "WARNING GetTermContributions IsMultiplyError(cTopTerms, cInstances)");
+      return 1;
+   }
+
+   const size_t cInstanceStride = bBinnedDataRowMajor ? cFeatures : size_t { 1 };
+   const size_t cFeatureStride = bBinnedDataRowMajor ? size_t { 1 } : cInstances;
+
+   if(IsMultiplyError(sizeof(ScoringTerm), cFeatureCombinations)) {
+      LOG_0(TraceLevelWarning, "WARNING GetTermContributions IsMultiplyError(sizeof(ScoringTerm), cFeatureCombinations)");
+      return 1;
+   }
+   // add 1 so that we don't call malloc with zero bytes if there are no feature combinations
+   ScoringTerm * const aScoringTerms = static_cast<ScoringTerm *>(malloc(sizeof(ScoringTerm) * cFeatureCombinations + 1));
+   if(nullptr == aScoringTerms) {
+      LOG_0(TraceLevelWarning, "WARNING GetTermContributions nullptr == aScoringTerms");
+      return 1;
+   }
+   if(ConstructScoringTerms(
+      cFeatures,
+      features,
+      cFeatureCombinations,
+      featureCombinations,
+      featureCombinationIndexes,
+      modelFeatureCombinationTensors,
+      aScoringTerms,
+      nullptr
+   )) {
+      free(aScoringTerms);
+      return 1;
+   }
+
+   FloatEbmType * aTopMagnitudes = nullptr;
+   if(0 != cTopTerms) {
+      if(IsMultiplyError(sizeof(FloatEbmType) * k_cInstancesPerTile, cTopTerms)) {
+         LOG_0(TraceLevelWarning, "WARNING GetTermContributions IsMultiplyError(sizeof(FloatEbmType) * k_cInstancesPerTile, cTopTerms)");
+         free(aScoringTerms);
+         return 1;
+      }
+      aTopMagnitudes = static_cast<FloatEbmType *>(malloc(sizeof(FloatEbmType) * k_cInstancesPerTile * cTopTerms));
+      if(nullptr == aTopMagnitudes) {
+         LOG_0(TraceLevelWarning, "WARNING GetTermContributions nullptr == aTopMagnitudes");
+         free(aScoringTerms);
+         return 1;
+      }
+   }
+
+   size_t aTensorIndexes[k_cInstancesPerTile];
+   size_t acTopTermsFilled[k_cInstancesPerTile];
+   size_t iTileStart = 0;
+   do {
+      const size_t cTileInstances = k_cInstancesPerTile < cInstances - iTileStart ? k_cInstancesPerTile : cInstances - iTileStart;
+      FloatEbmType * const aTileContributions = &contributionsReturn[iTileStart * cContributionsPerInstance];
+      for(size_t iInstance = 0; iInstance < cTileInstances; ++iInstance) {
+         acTopTermsFilled[iInstance] = 0;
+      }
+
+      for(size_t iTerm = 0; iTerm < cFeatureCombinations; ++iTerm) {
+         const ScoringTerm * const pScoringTerm = &aScoringTerms[iTerm];
+         if(ComputeTensorIndexes<IntEbmType>(pScoringTerm, &binnedData[iTileStart * cInstanceStride], cInstanceStride, cFeatureStride, 
+            cTileInstances, aTensorIndexes)) 
+         {
+            free(aTopMagnitudes);
+            free(aScoringTerms);
+            return 1;
+         }
+         const FloatEbmType * const aModelTensor = pScoringTerm->m_aModelTensor;
+         if(0 == cTopTerms) {
+            FloatEbmType * pContributions = &aTileContributions[iTerm * cVectorLength];
+            for(size_t iInstance = 0; iInstance < cTileInstances; ++iInstance) {
+               const FloatEbmType * const pModelScores = &aModelTensor[aTensorIndexes[iInstance] * cVectorLength];
+               for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+                  pContributions[iVector] = pModelScores[iVector];
+               }
+               pContributions += cContributionsPerInstance;
+            }
+         } else {
+            for(size_t iInstance = 0; iInstance < cTileInstances; ++iInstance) {
+               const FloatEbmType * const pModelScores = &aModelTensor[aTensorIndexes[iInstance] * cVectorLength];
+               // for multiclass we rank terms by the sum of their absolute logit contributions over all classes
+               FloatEbmType magnitude = FloatEbmType { 0 };
+               for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+                  magnitude += std::abs(pModelScores[iVector]);
+               }
+               InsertTopTerm(
+                  cTopTerms,
+                  cVectorLength,
+                  static_cast<IntEbmType>(iTerm),
+                  magnitude,
+                  pModelScores,
+                  &acTopTermsFilled[iInstance],
+                  &aTopMagnitudes[iInstance * cTopTerms],
+                  &termIndexesReturn[(iTileStart + iInstance) * cTopTerms],
+                  &aTileContributions[iInstance * cContributionsPerInstance]
+               );
+            }
+         }
+      }
+
+      if(0 != cTopTerms) {
+         // if we have fewer terms than our caller asked for, we mark the leftover slots with an index of -1 and no contribution
+         for(size_t iInstance = 0; iInstance < cTileInstances; ++iInstance) {
+            for(size_t iTop = acTopTermsFilled[iInstance]; iTop < cTopTerms; ++iTop) {
+               termIndexesReturn[(iTileStart + iInstance) * cTopTerms + iTop] = IntEbmType { -1 };
+               for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+                  aTileContributions[iInstance * cContributionsPerInstance + iTop * cVectorLength + iVector] = FloatEbmType { 0 };
+               }
+            }
+         }
+      }
+
+      iTileStart += cTileInstances;
+   } while(cInstances != iTileStart);
+
+   free(aTopMagnitudes);
+   free(aScoringTerms);
+   return 0;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreInstancesClassification(
+   IntEbmType countTargetClasses,
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType isBinnedDataRowMajor,
+   IntEbmType isProbabilities,
+   FloatEbmType * scoresReturn
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered ScoreInstancesClassification: countTargetClasses=%" IntEbmTypePrintf ", countFeatures=%" IntEbmTypePrintf
+      ", features=%p, countFeatureCombinations=%" IntEbmTypePrintf ", featureCombinations=%p, featureCombinationIndexes=%p"
+      ", modelFeatureCombinationTensors=%p, intercept=%p, countInstances=%" IntEbmTypePrintf ", binnedData=%p, isBinnedDataRowMajor=%"
+      IntEbmTypePrintf ", isProbabilities=%" IntEbmTypePrintf ", scoresReturn=%p",
+      countTargetClasses,
+      countFeatures,
+      static_cast<const void *>(features),
+      countFeatureCombinations,
+      static_cast<const void *>(featureCombinations),
+      static_cast<const void *>(featureCombinationIndexes),
+      static_cast<const void *>(modelFeatureCombinationTensors),
+      static_cast<const void *>(intercept),
+      countInstances,
+      static_cast<const void *>(binnedData),
+      isBinnedDataRowMajor,
+      isProbabilities,
+      static_cast<void *>(scoresReturn)
+   );
+   if(countTargetClasses < 0) {
+      LOG_0(TraceLevelError, "ERROR ScoreInstancesClassification countTargetClasses can't be negative");
+      return 1;
+   }
+   if(!IsNumberConvertable<ptrdiff_t, IntEbmType>(countTargetClasses)) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreInstancesClassification !IsNumberConvertable<ptrdiff_t, IntEbmType>(countTargetClasses)");
+      return 1;
+   }
+   EBM_ASSERT(EBM_FALSE == isBinnedDataRowMajor || EBM_TRUE == isBinnedDataRowMajor);
+   EBM_ASSERT(EBM_FALSE == isProbabilities || EBM_TRUE == isProbabilities);
+   const IntEbmType ret = ScoreInstances(
+      static_cast<ptrdiff_t>(countTargetClasses),
+      countFeatures,
+      features,
+      nullptr,
+      countFeatureCombinations,
+      featureCombinations,
+      featureCombinationIndexes,
+      modelFeatureCombinationTensors,
+      intercept,
+      countInstances,
+      binnedData,
+      nullptr,
+      EBM_FALSE != isBinnedDataRowMajor,
+      EBM_FALSE != isProbabilities,
+      scoresReturn
+   );
+   LOG_N(TraceLevelInfo, "Exited ScoreInstancesClassification %" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreInstancesRegression(
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType isBinnedDataRowMajor,
+   FloatEbmType * scoresReturn
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered ScoreInstancesRegression: countFeatures=%" IntEbmTypePrintf ", features=%p, countFeatureCombinations=%" IntEbmTypePrintf
+      ", featureCombinations=%p, featureCombinationIndexes=%p, modelFeatureCombinationTensors=%p, intercept=%p, countInstances=%" IntEbmTypePrintf
+      ", binnedData=%p, isBinnedDataRowMajor=%" IntEbmTypePrintf ", scoresReturn=%p",
+      countFeatures,
+      static_cast<const void *>(features),
+      countFeatureCombinations,
+      static_cast<const void *>(featureCombinations),
+      static_cast<const void *>(featureCombinationIndexes),
+      static_cast<const void *>(modelFeatureCombinationTensors),
+      static_cast<const void *>(intercept),
+      countInstances,
+      static_cast<const void *>(binnedData),
+      isBinnedDataRowMajor,
+      static_cast<void *>(scoresReturn)
+   );
+   EBM_ASSERT(EBM_FALSE == isBinnedDataRowMajor || EBM_TRUE == isBinnedDataRowMajor);
+   const IntEbmType ret = ScoreInstances(
+      k_Regression,
+      countFeatures,
+      features,
+      nullptr,
+      countFeatureCombinations,
+      featureCombinations,
+      featureCombinationIndexes,
+      modelFeatureCombinationTensors,
+      intercept,
+      countInstances,
+      binnedData,
+      nullptr,
+      EBM_FALSE != isBinnedDataRowMajor,
+      false,
+      scoresReturn
+   );
+   LOG_N(TraceLevelInfo, "Exited ScoreInstancesRegression %" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreRawInstancesClassification(
+   IntEbmType countTargetClasses,
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   const FloatEbmType * const * cutPointsLowerBoundInclusive,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   IntEbmType countInstances,
+   const FloatEbmType * rawData,
+   IntEbmType isRawDataRowMajor,
+   IntEbmType isProbabilities,
+   FloatEbmType * scoresReturn
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered ScoreRawInstancesClassification: countTargetClasses=%" IntEbmTypePrintf ", countFeatures=%" IntEbmTypePrintf
+      ", features=%p, cutPointsLowerBoundInclusive=%p, countFeatureCombinations=%" IntEbmTypePrintf ", featureCombinations=%p"
+      ", featureCombinationIndexes=%p, modelFeatureCombinationTensors=%p, intercept=%p, countInstances=%" IntEbmTypePrintf ", rawData=%p"
+      ", isRawDataRowMajor=%" IntEbmTypePrintf ", isProbabilities=%" IntEbmTypePrintf ", scoresReturn=%p",
+      countTargetClasses,
+      countFeatures,
+      static_cast<const void *>(features),
+      static_cast<const void *>(cutPointsLowerBoundInclusive),
+      countFeatureCombinations,
+      static_cast<const void *>(featureCombinations),
+      static_cast<const void *>(featureCombinationIndexes),
+      static_cast<const void *>(modelFeatureCombinationTensors),
+      static_cast<const void *>(intercept),
+      countInstances,
+      static_cast<const void *>(rawData),
+      isRawDataRowMajor,
+      isProbabilities,
+      static_cast<void *>(scoresReturn)
+   );
+   if(countTargetClasses < 0) {
+      LOG_0(TraceLevelError, "ERROR ScoreRawInstancesClassification countTargetClasses can't be negative");
+      return 1;
+   }
+   if(!IsNumberConvertable<ptrdiff_t, IntEbmType>(countTargetClasses)) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreRawInstancesClassification !IsNumberConvertable<ptrdiff_t, IntEbmType>(countTargetClasses)");
+      return 1;
+   }
+   EBM_ASSERT(EBM_FALSE == isRawDataRowMajor || EBM_TRUE == isRawDataRowMajor);
+   EBM_ASSERT(EBM_FALSE == isProbabilities || EBM_TRUE == isProbabilities);
+   const IntEbmType ret = ScoreInstances(
+      static_cast<ptrdiff_t>(countTargetClasses),
+      countFeatures,
+      features,
+      cutPointsLowerBoundInclusive,
+      countFeatureCombinations,
+      featureCombinations,
+      featureCombinationIndexes,
+      modelFeatureCombinationTensors,
+      intercept,
+      countInstances,
+      nullptr,
+      rawData,
+      EBM_FALSE != isRawDataRowMajor,
+      EBM_FALSE != isProbabilities,
+      scoresReturn
+   );
+   LOG_N(TraceLevelInfo, "Exited ScoreRawInstancesClassification %" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreRawInstancesRegression(
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   const FloatEbmType * const * cutPointsLowerBoundInclusive,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   IntEbmType countInstances,
+   const FloatEbmType * rawData,
+   IntEbmType isRawDataRowMajor,
+   FloatEbmType * scoresReturn
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered ScoreRawInstancesRegression: countFeatures=%" IntEbmTypePrintf ", features=%p, cutPointsLowerBoundInclusive=%p"
+      ", countFeatureCombinations=%" IntEbmTypePrintf ", featureCombinations=%p, featureCombinationIndexes=%p, modelFeatureCombinationTensors=%p"
+      ", intercept=%p, countInstances=%" IntEbmTypePrintf ", rawData=%p, isRawDataRowMajor=%" IntEbmTypePrintf ", scoresReturn=%p",
+      countFeatures,
+      static_cast<const void *>(features),
+      static_cast<const void *>(cutPointsLowerBoundInclusive),
+      countFeatureCombinations,
+      static_cast<const void *>(featureCombinations),
+      static_cast<const void *>(featureCombinationIndexes),
+      static_cast<const void *>(modelFeatureCombinationTensors),
+      static_cast<const void *>(intercept),
+      countInstances,
+      static_cast<const void *>(rawData),
+      isRawDataRowMajor,
+      static_cast<void *>(scoresReturn)
+   );
+   EBM_ASSERT(EBM_FALSE == isRawDataRowMajor || EBM_TRUE == isRawDataRowMajor);
+   const IntEbmType ret = ScoreInstances(
+      k_Regression,
+      countFeatures,
+      features,
+      cutPointsLowerBoundInclusive,
+      countFeatureCombinations,
+      featureCombinations,
+      featureCombinationIndexes,
+      modelFeatureCombinationTensors,
+      intercept,
+      countInstances,
+      nullptr,
+      rawData,
+      EBM_FALSE != isRawDataRowMajor,
+      false,
+      scoresReturn
+   );
+   LOG_N(TraceLevelInfo, "Exited ScoreRawInstancesRegression %" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GetTermContributionsClassification(
+   IntEbmType countTargetClasses,
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType isBinnedDataRowMajor,
+   IntEbmType countTopTerms,
+   IntEbmType * termIndexesReturn,
+   FloatEbmType * contributionsReturn
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered GetTermContributionsClassification: countTargetClasses=%" IntEbmTypePrintf ", countFeatures=%" IntEbmTypePrintf
+      ", features=%p, countFeatureCombinations=%" IntEbmTypePrintf ", featureCombinations=%p, featureCombinationIndexes=%p"
+      ", modelFeatureCombinationTensors=%p, countInstances=%" IntEbmTypePrintf ", binnedData=%p, isBinnedDataRowMajor=%" IntEbmTypePrintf
+      ", countTopTerms=%" IntEbmTypePrintf ", termIndexesReturn=%p, contributionsReturn=%p",
+      countTargetClasses,
+      countFeatures,
+      static_cast<const void *>(features),
+      countFeatureCombinations,
+      static_cast<const void *>(featureCombinations),
+      static_cast<const void *>(featureCombinationIndexes),
+      static_cast<const void *>(modelFeatureCombinationTensors),
+      countInstances,
+      static_cast<const void *>(binnedData),
+      isBinnedDataRowMajor,
+      countTopTerms,
+      static_cast<void *>(termIndexesReturn),
+      static_cast<void *>(contributionsReturn)
+   );
+   if(countTargetClasses < 0) {
+      LOG_0(TraceLevelError, "ERROR GetTermContributionsClassification countTargetClasses can't be negative");
+      return 1;
+   }
+   if(!IsNumberConvertable<ptrdiff_t, IntEbmType>(countTargetClasses)) {
+      LOG_0(TraceLevelWarning, "WARNING GetTermContributionsClassification !IsNumberConvertable<ptrdiff_t, IntEbmType>(countTargetClasses)");
+      return 1;
+   }
+   EBM_ASSERT(EBM_FALSE == isBinnedDataRowMajor || EBM_TRUE == isBinnedDataRowMajor);
+   const IntEbmType ret = GetTermContributions(
+      static_cast<ptrdiff_t>(countTargetClasses),
+      countFeatures,
+      features,
+      countFeatureCombinations,
+      featureCombinations,
+      featureCombinationIndexes,
+      modelFeatureCombinationTensors,
+      countInstances,
+      binnedData,
+      EBM_FALSE != isBinnedDataRowMajor,
+      countTopTerms,
+      termIndexesReturn,
+      contributionsReturn
+   );
+   LOG_N(TraceLevelInfo, "Exited GetTermContributionsClassification %" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GetTermContributionsRegression(
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType isBinnedDataRowMajor,
+   IntEbmType countTopTerms,
+   IntEbmType * termIndexesReturn,
+   FloatEbmType * contributionsReturn
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered GetTermContributionsRegression: countFeatures=%" IntEbmTypePrintf ", features=%p, countFeatureCombinations=%" IntEbmTypePrintf
+      ", featureCombinations=%p, featureCombinationIndexes=%p, modelFeatureCombinationTensors=%p, countInstances=%" IntEbmTypePrintf
+      ", binnedData=%p, isBinnedDataRowMajor=%" IntEbmTypePrintf ", countTopTerms=%" IntEbmTypePrintf ", termIndexesReturn=%p, contributionsReturn=%p",
+      countFeatures,
+      static_cast<const void *>(features),
+      countFeatureCombinations,
+      static_cast<const void *>(featureCombinations),
+      static_cast<const void *>(featureCombinationIndexes),
+      static_cast<const void *>(modelFeatureCombinationTensors),
+      countInstances,
+      static_cast<const void *>(binnedData),
+      isBinnedDataRowMajor,
+      countTopTerms,
+      static_cast<void *>(termIndexesReturn),
+      static_cast<void *>(contributionsReturn)
+   );
+   EBM_ASSERT(EBM_FALSE == isBinnedDataRowMajor || EBM_TRUE == isBinnedDataRowMajor);
+   const IntEbmType ret = GetTermContributions(
+      k_Regression,
+      countFeatures,
+      features,
+      countFeatureCombinations,
+      featureCombinations,
+      featureCombinationIndexes,
+      modelFeatureCombinationTensors,
+      countInstances,
+      binnedData,
+      EBM_FALSE != isBinnedDataRowMajor,
+      countTopTerms,
+      termIndexesReturn,
+      contributionsReturn
+   );
+   LOG_N(TraceLevelInfo, "Exited GetTermContributionsRegression %" IntEbmTypePrintf, ret);
+   return ret;
+}
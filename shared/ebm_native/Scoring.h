@@ -0,0 +1,32 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef SCORING_H
+#define SCORING_H
+
+#include <stddef.h> // size_t, ptrdiff_t
+
+#include "ebm_native.h"
+
+// ScoreInstances is shared by our batch scoring exports and by models that we score straight out of a loaded model file.  Exactly one of binnedData 
+// or rawData should be non-null.  cutPointsLowerBoundInclusive is only needed for rawData
+extern IntEbmType ScoreInstances(
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   const IntEbmType countFeatures,
+   const EbmNativeFeature * const features,
+   const FloatEbmType * const * const cutPointsLowerBoundInclusive,
+   const IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * const featureCombinations,
+   const IntEbmType * const featureCombinationIndexes,
+   const FloatEbmType * const * const modelFeatureCombinationTensors,
+   const FloatEbmType * const intercept,
+   const IntEbmType countInstances,
+   const IntEbmType * const binnedData,
+   const FloatEbmType * const rawData,
+   const bool bDataRowMajor,
+   const bool bProbabilities,
+   FloatEbmType * const scoresReturn
+);
+
+#endif // SCORING_H
@@ -253,25 +253,23 @@ public:
       m_bExpanded = false;
    }
 
-   EBM_INLINE bool SetCountDivisions(const size_t iDimension, const size_t cDivisions) {
-      EBM_ASSERT(iDimension < m_cDimensions);
+   EBM_INLINE bool EnsureDivisionCapacity(const size_t iDimension, const size_t cDivisions) {
+      EBM_ASSERT(iDimension < m_cDimensionsMax);
       DimensionInfo * const pDimension = &ARRAY_TO_POINTER(m_aDimensions)[iDimension];
-      // we shouldn't be able to expand our length after we're been expanded since expanded should be the maximum size already
-      EBM_ASSERT(!m_bExpanded || cDivisions <= pDimension->m_cDivisions);
       if(UNLIKELY(pDimension->m_cDivisionCapacity < cDivisions)) {
          EBM_ASSERT(!m_bExpanded); // we shouldn't be able to expand our length after we're been expanded since expanded should be the maximum size already
 
          if(IsAddError(cDivisions, cDivisions >> 1)) {
-            LOG_0(TraceLevelWarning, "WARNING SetCountDivisions IsAddError(cDivisions, cDivisions >> 1)");
+            LOG_0(TraceLevelWarning, "WARNING EnsureDivisionCapacity IsAddError(cDivisions, cDivisions >> 1)");
             return true;
          }
          // just increase it by 50% since we don't expect to grow our divisions often after an initial period, 
          // and realloc takes some of the cost of growing away
          size_t cNewDivisionCapacity = cDivisions + (cDivisions >> 1);
-         LOG_N(TraceLevelInfo, "SetCountDivisions Growing to size %zu", cNewDivisionCapacity);
+         LOG_N(TraceLevelInfo, "EnsureDivisionCapacity Growing to size %zu", cNewDivisionCapacity);
 
          if(IsMultiplyError(sizeof(ActiveDataType), cNewDivisionCapacity)) {
-            LOG_0(TraceLevelWarning, "WARNING SetCountDivisions IsMultiplyError(sizeof(ActiveDataType), cNewDivisionCapacity)");
+            LOG_0(TraceLevelWarning, "WARNING EnsureDivisionCapacity IsMultiplyError(sizeof(ActiveDataType), cNewDivisionCapacity)");
             return true;
          }
          size_t cBytes = sizeof(ActiveDataType) * cNewDivisionCapacity;
@@ -279,12 +277,24 @@ public:
          if(UNLIKELY(nullptr == aNewDivisions)) {
             // according to the realloc spec, if realloc fails to allocate the new memory, it returns nullptr BUT the old memory is valid.
             // we leave m_aThreadByteBuffer1 alone in this instance and will free that memory later in the destructor
-            LOG_0(TraceLevelWarning, "WARNING SetCountDivisions nullptr == aNewDivisions");
+            LOG_0(TraceLevelWarning, "WARNING EnsureDivisionCapacity nullptr == aNewDivisions");
             return true;
          }
          pDimension->m_aDivisions = aNewDivisions;
          pDimension->m_cDivisionCapacity = cNewDivisionCapacity;
       } // never shrink our array unless the user chooses to Trim()
+      return false;
+   }
+
+   EBM_INLINE bool SetCountDivisions(const size_t iDimension, const size_t cDivisions) {
+      EBM_ASSERT(iDimension < m_cDimensions);
+      DimensionInfo * const pDimension = &ARRAY_TO_POINTER(m_aDimensions)[iDimension];
+      // we shouldn't be able to expand our length after we're been expanded since expanded should be the maximum size already
+      EBM_ASSERT(!m_bExpanded || cDivisions <= pDimension->m_cDivisions);
+      if(UNLIKELY(EnsureDivisionCapacity(iDimension, cDivisions))) {
+         LOG_0(TraceLevelWarning, "WARNING SetCountDivisions EnsureDivisionCapacity(iDimension, cDivisions)");
+         return true;
+      }
       pDimension->m_cDivisions = cDivisions;
       return false;
    }
@@ -0,0 +1,194 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <string.h> // memset
+#include <stdlib.h> // malloc, realloc, free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <cmath> // std::isnan, std::ceil
+
+#include "ebm_native.h"
+#include "EbmInternal.h" // EBM_INLINE & UNLIKLEY
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "RandomStream.h"
+#include "TrainValidationSplit.h"
+
+bool GenerateTrainValidationSplitInternal(
+   RandomStream * const pRandomStream,
+   const size_t cTargetClasses,
+   const size_t cInstances,
+   const IntEbmType * const aTargets,
+   const FloatEbmType validationFraction,
+   IntEbmType * const aIsValidationOut
+) {
+   LOG_0(TraceLevelInfo, "Entered GenerateTrainValidationSplitInternal");
+
+   EBM_ASSERT(nullptr != pRandomStream);
+   EBM_ASSERT(0 == cTargetClasses || 0 == cInstances || nullptr != aTargets);
+   EBM_ASSERT(0 == cInstances || nullptr != aIsValidationOut);
+
+   if(std::isnan(validationFraction) || validationFraction < FloatEbmType { 0 } || FloatEbmType { 1 } < validationFraction) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateTrainValidationSplitInternal validationFraction must be in the range [0, 1]");
+      return true;
+   }
+   if(0 == cInstances) {
+      LOG_0(TraceLevelInfo, "Exited GenerateTrainValidationSplitInternal with zero instances");
+      return false;
+   }
+
+   // validationFraction is in the range [0, 1], so this can't overflow.  We round up like sklearn's train_test_split
+   size_t cValidationInstances = static_cast<size_t>(std::ceil(validationFraction * static_cast<FloatEbmType>(cInstances)));
+   cValidationInstances = cInstances < cValidationInstances ? cInstances : cValidationInstances;
+
+   // for stratification we track the number of validation instances each class still needs and the number of its instances that we haven't 
+   // visited yet.  Without stratification we treat all of our instances as belonging to a single class
+   const size_t cGroups = 0 == cTargetClasses ? size_t { 1 } : cTargetClasses;
+   if(IsMultiplyError(sizeof(size_t) * 2, cGroups)) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateTrainValidationSplitInternal IsMultiplyError(sizeof(size_t) * 2, cGroups)");
+      return true;
+   }
+   size_t * const aCountNeeded = static_cast<size_t *>(malloc(sizeof(size_t) * 2 * cGroups));
+   if(nullptr == aCountNeeded) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateTrainValidationSplitInternal nullptr == aCountNeeded");
+      return true;
+   }
+   size_t * const aCountRemaining = aCountNeeded + cGroups;
+   memset(aCountNeeded, 0, sizeof(size_t) * 2 * cGroups);
+
+   if(0 == cTargetClasses) {
+      aCountRemaining[0] = cInstances;
+      aCountNeeded[0] = cValidationInstances;
+   } else {
+      for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
+         const IntEbmType target = aTargets[iInstance];
+         if(target < IntEbmType { 0 } || !IsNumberConvertable<size_t, IntEbmType>(target) || cTargetClasses <= static_cast<size_t>(target)) {
+            LOG_0(TraceLevelWarning, "WARNING GenerateTrainValidationSplitInternal target value out of range");
+            free(aCountNeeded);
+            return true;
+         }
+         ++aCountRemaining[static_cast<size_t>(target)];
+      }
+
+      // each class gets its proportional share of our validation instances rounded down, and then we hand out the leftovers one at a time to the 
+      // classes with the largest remainders, so that our total is exact (the largest remainder method).  Ties go to the lowest class index
+      size_t cAssigned = 0;
+      for(size_t iClass = 0; iClass < cTargetClasses; ++iClass) {
+         const size_t cClassInstances = aCountRemaining[iClass];
+         size_t cClassValidation;
+         if(!IsMultiplyError(cValidationInstances, cClassInstances)) {
+            cClassValidation = cValidationInstances * cClassInstances / cInstances;
+         } else {
+            cClassValidation = static_cast<size_t>(static_cast<FloatEbmType>(cValidationInstances) * 
+               static_cast<FloatEbmType>(cClassInstances) / static_cast<FloatEbmType>(cInstances));
+            cClassValidation = cClassInstances < cClassValidation ? cClassInstances : cClassValidation;
+         }
+         aCountNeeded[iClass] = cClassValidation;
+         cAssigned += cClassValidation;
+      }
+      EBM_ASSERT(cAssigned <= cValidationInstances);
+      while(cAssigned < cValidationInstances) {
+         size_t iBest = cTargetClasses;
+         FloatEbmType remainderBest = FloatEbmType { -1 };
+         for(size_t iClass = 0; iClass < cTargetClasses; ++iClass) {
+            if(aCountNeeded[iClass] < aCountRemaining[iClass]) {
+               const FloatEbmType remainder = static_cast<FloatEbmType>(cValidationInstances) * 
+                  static_cast<FloatEbmType>(aCountRemaining[iClass]) / static_cast<FloatEbmType>(cInstances) - 
+                  static_cast<FloatEbmType>(aCountNeeded[iClass]);
+               if(remainderBest < remainder) {
+                  remainderBest = remainder;
+                  iBest = iClass;
+               }
+            }
+         }
+         // we have fewer validation instances than total instances, so some class must have room left
+         EBM_ASSERT(iBest < cTargetClasses);
+         ++aCountNeeded[iBest];
+         ++cAssigned;
+      }
+   }
+
+   try {
+      // selection sampling (Knuth's algorithm S) within each class, which gives us exactly aCountNeeded[iClass] validation instances in each class
+      // in a single sequential pass, with each subset being equally likely
+      for(size_t iInstance = 0; iInstance < cInstances; ++iInstance) {
+         const size_t iGroup = 0 == cTargetClasses ? size_t { 0 } : static_cast<size_t>(aTargets[iInstance]);
+         EBM_ASSERT(0 < aCountRemaining[iGroup]);
+         IntEbmType isValidation = 0;
+         if(0 != aCountNeeded[iGroup] && pRandomStream->Next(aCountRemaining[iGroup]) < aCountNeeded[iGroup]) {
+            --aCountNeeded[iGroup];
+            isValidation = 1;
+         }
+         --aCountRemaining[iGroup];
+         aIsValidationOut[iInstance] = isValidation;
+      }
+   } catch(...) {
+      // pRandomStream->Next can throw exceptions from the random number generator, possibly (it's not documented)
+      LOG_0(TraceLevelWarning, "WARNING GenerateTrainValidationSplitInternal random number generator exception");
+      free(aCountNeeded);
+      return true;
+   }
+
+   free(aCountNeeded);
+   LOG_0(TraceLevelInfo, "Exited GenerateTrainValidationSplitInternal");
+   return false;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateTrainValidationSplit(
+   IntEbmType randomSeed,
+   IntEbmType countTargetClasses,
+   IntEbmType countInstances,
+   const IntEbmType * targets,
+   FloatEbmType validationFraction,
+   IntEbmType * isValidationOut
+) {
+   LOG_N(TraceLevelInfo, "Entered GenerateTrainValidationSplit: randomSeed=%" IntEbmTypePrintf ", countTargetClasses=%" IntEbmTypePrintf 
+      ", countInstances=%" IntEbmTypePrintf ", targets=%p, validationFraction=%" FloatEbmTypePrintf ", isValidationOut=%p",
+      randomSeed,
+      countTargetClasses,
+      countInstances,
+      static_cast<const void *>(targets),
+      validationFraction,
+      static_cast<void *>(isValidationOut)
+   );
+
+   if(countTargetClasses < IntEbmType { 0 } || !IsNumberConvertable<size_t, IntEbmType>(countTargetClasses)) {
+      LOG_0(TraceLevelError, "ERROR GenerateTrainValidationSplit countTargetClasses must be zero (no stratification) or positive");
+      return 1;
+   }
+   if(countInstances < IntEbmType { 0 } || !IsNumberConvertable<size_t, IntEbmType>(countInstances)) {
+      LOG_0(TraceLevelError, "ERROR GenerateTrainValidationSplit countInstances must be zero or positive");
+      return 1;
+   }
+   if(IntEbmType { 0 } != countInstances) {
+      if(nullptr == isValidationOut) {
+         LOG_0(TraceLevelError, "ERROR GenerateTrainValidationSplit nullptr == isValidationOut");
+         return 1;
+      }
+      if(IntEbmType { 0 } != countTargetClasses && nullptr == targets) {
+         LOG_0(TraceLevelError, "ERROR GenerateTrainValidationSplit nullptr == targets");
+         return 1;
+      }
+   }
+
+   RandomStream randomStream(randomSeed);
+   if(!randomStream.IsSuccess()) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateTrainValidationSplit !randomStream.IsSuccess()");
+      return 1;
+   }
+   if(GenerateTrainValidationSplitInternal(
+      &randomStream,
+      static_cast<size_t>(countTargetClasses),
+      static_cast<size_t>(countInstances),
+      targets,
+      validationFraction,
+      isValidationOut
+   )) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateTrainValidationSplit GenerateTrainValidationSplitInternal failed");
+      return 1;
+   }
+
+   LOG_0(TraceLevelInfo, "Exited GenerateTrainValidationSplit");
+   return 0;
+}
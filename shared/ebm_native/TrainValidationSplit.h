@@ -0,0 +1,50 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef TRAIN_VALIDATION_SPLIT_H
+#define TRAIN_VALIDATION_SPLIT_H
+
+#include <stddef.h> // size_t, ptrdiff_t
+
+#include "ebm_native.h" // FloatEbmType
+#include "EbmInternal.h" // EBM_INLINE
+#include "Logging.h" // EBM_ASSERT & LOG
+
+class RandomStream;
+
+// fills aIsValidationOut with 1 for each validation instance and 0 for each training instance.  If cTargetClasses is non-zero we select the same 
+// fraction of each class (rounded so that the total is exact), otherwise aTargets can be nullptr and we select uniformly.  Returns true on error
+bool GenerateTrainValidationSplitInternal(
+   RandomStream * const pRandomStream,
+   const size_t cTargetClasses,
+   const size_t cInstances,
+   const IntEbmType * const aTargets,
+   const FloatEbmType validationFraction,
+   IntEbmType * const aIsValidationOut
+);
+
+// copies the selected instances of aFrom (each of which has cItemsPerInstance items) into aTo in the order given by aiSelected
+template<typename T>
+EBM_INLINE void GatherInstances(
+   const size_t cSelected, 
+   const size_t * const aiSelected, 
+   const size_t cItemsPerInstance, 
+   const T * const aFrom, 
+   T * const aTo
+) {
+   EBM_ASSERT(1 <= cItemsPerInstance);
+   T * pTo = aTo;
+   for(size_t iSelected = 0; iSelected < cSelected; ++iSelected) {
+      // this can't overflow since we're accessing existing memory
+      const T * pFrom = aFrom + aiSelected[iSelected] * cItemsPerInstance;
+      const T * const pFromEnd = pFrom + cItemsPerInstance;
+      do {
+         *pTo = *pFrom;
+         ++pTo;
+         ++pFrom;
+      } while(pFromEnd != pFrom);
+   }
+}
+
+#endif // TRAIN_VALIDATION_SPLIT_H
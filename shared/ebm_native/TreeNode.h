@@ -50,9 +50,10 @@ struct TreeNodeData<true> {
 public:
 
    struct BeforeExaminationForPossibleSplitting {
-      const HistogramBucket<true> * m_pHistogramBucketEntryFirst;
-      const HistogramBucket<true> * m_pHistogramBucketEntryLast;
-      size_t m_cInstances;
+      // these point into the list of active buckets that ListActiveHistogramBuckets builds, not into the histogram itself
+      const HistogramBucket<true> * const * m_ppHistogramBucketEntryFirst;
+      const HistogramBucket<true> * const * m_ppHistogramBucketEntryLast;
+      FloatEbmType m_weight;
    };
 
    struct AfterExaminationForPossibleSplitting {
@@ -84,11 +85,11 @@ public:
    // (either the parent or child) if the class is derrived
    HistogramBucketVectorEntry<true> m_aHistogramBucketVectorEntry[1];
 
-   EBM_INLINE size_t GetInstances() const {
-      return m_UNION.m_beforeExaminationForPossibleSplitting.m_cInstances;
+   EBM_INLINE FloatEbmType GetWeight() const {
+      return m_UNION.m_beforeExaminationForPossibleSplitting.m_weight;
    }
-   EBM_INLINE void SetInstances(size_t cInstances) {
-      m_UNION.m_beforeExaminationForPossibleSplitting.m_cInstances = cInstances;
+   EBM_INLINE void SetWeight(FloatEbmType weight) {
+      m_UNION.m_beforeExaminationForPossibleSplitting.m_weight = weight;
    }
 };
 static_assert(std::is_standard_layout<TreeNodeData<true>>::value,
@@ -100,8 +101,9 @@ struct TreeNodeData<false> {
 public:
 
    struct BeforeExaminationForPossibleSplitting {
-      const HistogramBucket<false> * m_pHistogramBucketEntryFirst;
-      const HistogramBucket<false> * m_pHistogramBucketEntryLast;
+      // these point into the list of active buckets that ListActiveHistogramBuckets builds, not into the histogram itself
+      const HistogramBucket<false> * const * m_ppHistogramBucketEntryFirst;
+      const HistogramBucket<false> * const * m_ppHistogramBucketEntryLast;
    };
 
    struct AfterExaminationForPossibleSplitting {
@@ -129,7 +131,7 @@ public:
 
    TreeNodeDataUnion m_UNION;
 
-   size_t m_cInstances;
+   FloatEbmType m_weight;
    // use the "struct hack" since Flexible array member method is not available in C++
    // aHistogramBucketVectorEntry must be the last item in this struct
    // AND this class must be "is_standard_layout" since otherwise we can't guarantee that this item is placed at the bottom
@@ -137,11 +139,11 @@ public:
    // (either the parent or child) if the class is derrived
    HistogramBucketVectorEntry<false> m_aHistogramBucketVectorEntry[1];
 
-   EBM_INLINE size_t GetInstances() const {
-      return m_cInstances;
+   EBM_INLINE FloatEbmType GetWeight() const {
+      return m_weight;
    }
-   EBM_INLINE void SetInstances(size_t cInstances) {
-      m_cInstances = cInstances;
+   EBM_INLINE void SetWeight(FloatEbmType weight) {
+      m_weight = weight;
    }
 };
 static_assert(std::is_standard_layout<TreeNodeData<false>>::value,
@@ -155,8 +157,10 @@ struct TreeNode final : public TreeNodeData<bClassification> {
 public:
 
    EBM_INLINE bool IsSplittable(size_t cInstancesRequiredForParentSplitMin) const {
-      return this->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryLast != 
-         this->m_UNION.m_beforeExaminationForPossibleSplitting.m_pHistogramBucketEntryFirst && cInstancesRequiredForParentSplitMin <= this->GetInstances();
+      // our weights are instance counts when unweighted, and a weight of k counts as k instances, so we compare the minimum against our weight
+      return this->m_UNION.m_beforeExaminationForPossibleSplitting.m_ppHistogramBucketEntryLast != 
+         this->m_UNION.m_beforeExaminationForPossibleSplitting.m_ppHistogramBucketEntryFirst && 
+         static_cast<FloatEbmType>(cInstancesRequiredForParentSplitMin) <= this->GetWeight();
    }
 
    EBM_INLINE FloatEbmType EXTRACT_GAIN_BEFORE_SPLITTING() {
@@ -213,7 +217,7 @@ public:
                   pHistogramBucketVectorEntry->m_sumResidualError, pHistogramBucketVectorEntry->GetSumDenominator());
             } else {
                smallChangeToModel = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
-                  pHistogramBucketVectorEntry->m_sumResidualError, static_cast<FloatEbmType>(this->GetInstances()));
+                  pHistogramBucketVectorEntry->m_sumResidualError, this->GetWeight());
             }
             *pValuesCur = smallChangeToModel;
 
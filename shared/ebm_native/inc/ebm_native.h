@@ -93,6 +93,10 @@ typedef struct _EbmInteraction {
    // they try to mix these pointer types.
    char unused;
 } *PEbmInteraction;
+typedef struct _EbmModel {
+   // this struct is to enforce that our caller doesn't mix EbmModel pointers with our other handle types
+   char unused;
+} *PEbmModel;
 
 #ifndef PRId64
 // this should really be defined, but some compilers aren't compliant
@@ -296,6 +300,28 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION SetTraceLeve
 //       - if missing is in the 0th bin, we can do any cuts at the beginning of processing a range, and that means any cut in the model would be the first, 
 //         so we can initialze it by writing the cut model directly without bothering to handle inserting into the tree at the end
 
+// optionalTempParams holds EXPERIMENTAL parameters that can change between versions.  It is either nullptr, or optionalTempParams[0] holds the 
+// count of parameters that follow it.  Parameters that aren't included keep their defaults.  Currently:
+//   optionalTempParams[1] - gradient-based one-side sampling (GOSS): the fraction of instances with the largest residuals that each inner bag 
+//                           keeps after each update, in the range (0, 1].  0 (the default) disables GOSS
+//   optionalTempParams[2] - GOSS: the fraction of all instances that each inner bag randomly samples from the remaining instances, in [0, 1]
+//   optionalTempParams[3] - the fraction of instances that each inner bag samples without replacement instead of bootstrap sampling, in the 
+//                           range (0, 1].  0 (the default) keeps bootstrap sampling.  Ignored without inner bags or if GOSS is enabled
+//   optionalTempParams[4] - non-zero to split pairs by sweeping from each corner of the tensor, which we always do for 3 or more dimensions.  
+//                           0 (the default) uses our pair specific splitter
+//   optionalTempParams[5] - if 2 or more, our pair specific splitter first tries only the cuts between super-bins of this many bins, and then 
+//                           every cut inside the super-bins next to the best of those.  Much faster on features with thousands of bins, but the 
+//                           cuts can differ from the exhaustive search.  0 (the default) tries every cut
+//   optionalTempParams[6] - 1 to start bootstrap inner bags with 1 bit occurrence counts instead of 1 byte.  Nearly every inner bag then draws 
+//                           some instance twice and switches to full counts, which exercises the switch that byte counts make if an instance is 
+//                           drawn more than 255 times.  Models are unchanged.  Any other value keeps byte counts
+//   optionalTempParams[7] - non-zero to bin each bootstrap inner bag in its own pass over the data instead of binning all of them together.  
+//                           Models are unchanged.  0 (the default) bins them together
+//   optionalTempParams[8] - non-zero to have our pair specific splitter sweep each cut of the first dimension on its own instead of in blocks 
+//                           of adjacent cuts.  Models are unchanged, but large pairs are slower.  0 (the default) sweeps in blocks
+//   optionalTempParams[9] - non-zero to store the Newton-Raphson step of each classification residual when we update it, instead of recomputing 
+//                           it for every inner bag when we bin.  Uses an extra float per training instance and class, and only helps with many 
+//                           inner bags.  Models are unchanged.  0 (the default) recomputes it
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE PEbmBoosting EBM_NATIVE_CALLING_CONVENTION InitializeBoostingClassification(
    IntEbmType countTargetClasses,
    IntEbmType countFeatures,
@@ -333,6 +359,54 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE PEbmBoosting EBM_NATIVE_CALLING_CONVENTION Init
    IntEbmType randomSeed,
    const FloatEbmType * optionalTempParams
 );
+// splits countInstances rows of a single binned data matrix into training and validation sets (stratified by target class), and builds both 
+// datasets directly from it.  The split is the same one that GenerateTrainValidationSplit returns for the same randomSeed.
+// predictorScores can be nullptr, in which case all instances start from zero scores
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE PEbmBoosting EBM_NATIVE_CALLING_CONVENTION InitializeBoostingClassificationSplit(
+   IntEbmType countTargetClasses,
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   const IntEbmType * targets,
+   const FloatEbmType * predictorScores,
+   FloatEbmType validationFraction,
+   IntEbmType countInnerBags,
+   IntEbmType randomSeed,
+   const FloatEbmType * optionalTempParams
+);
+// the regression split is unstratified
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE PEbmBoosting EBM_NATIVE_CALLING_CONVENTION InitializeBoostingRegressionSplit(
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   const FloatEbmType * targets,
+   const FloatEbmType * predictorScores,
+   FloatEbmType validationFraction,
+   IntEbmType countInnerBags,
+   IntEbmType randomSeed,
+   const FloatEbmType * optionalTempParams
+);
+// sets isValidationOut[i] to 1 for the instances that go into the validation set and 0 for training.  countTargetClasses of 0 means 
+// unstratified (regression), otherwise each class contributes validationFraction of its instances, rounded so the total is exact
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateTrainValidationSplit(
+   IntEbmType randomSeed,
+   IntEbmType countTargetClasses,
+   IntEbmType countInstances,
+   const IntEbmType * targets,
+   FloatEbmType validationFraction,
+   IntEbmType * isValidationOut
+);
+// trainingWeights and validationWeights are optional per-instance weights (nullptr weights every instance by 1).  A weight of k is equivalent to k 
+// duplicate instances.  Weights must be finite and non-negative with a positive sum.  The validation weights also apply to the validation metric 
+// returned by the following ApplyModelFeatureCombinationUpdate, so they need to remain valid until that call returns.
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE FloatEbmType * EBM_NATIVE_CALLING_CONVENTION GenerateModelFeatureCombinationUpdate(
    PEbmBoosting ebmBoosting, 
    IntEbmType indexFeatureCombination, 
@@ -359,6 +433,26 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION Boosti
    const FloatEbmType * validationWeights,
    FloatEbmType * validationMetricReturn
 );
+// BoostCyclic runs BoostingStep countStepsPerFeatureCombination times for each of the feature combinations in featureCombinationIndexes, in order, 
+// and repeats that for up to countRoundsMax rounds.  It stops early after earlyStoppingRunLength rounds in a row fail to improve the best validation 
+// metric by more than earlyStoppingTolerance (a negative earlyStoppingRunLength disables early stopping).  The best model is kept exactly as it is 
+// with BoostingStep, so GetBestModelFeatureCombination can be called afterwards.
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION BoostCyclic(
+   PEbmBoosting ebmBoosting,
+   IntEbmType countFeatureCombinationsToBoost,
+   const IntEbmType * featureCombinationIndexes,
+   IntEbmType countRoundsMax,
+   IntEbmType countStepsPerFeatureCombination,
+   FloatEbmType learningRate,
+   IntEbmType countTreeSplitsMax,
+   IntEbmType countInstancesRequiredForParentSplitMin,
+   const FloatEbmType * trainingWeights,
+   const FloatEbmType * validationWeights,
+   IntEbmType earlyStoppingRunLength,
+   FloatEbmType earlyStoppingTolerance,
+   IntEbmType * countRoundsReturn,
+   FloatEbmType * bestValidationMetricReturn
+);
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE FloatEbmType * EBM_NATIVE_CALLING_CONVENTION GetBestModelFeatureCombination(
    PEbmBoosting ebmBoosting, 
    IntEbmType indexFeatureCombination
@@ -372,6 +466,156 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION FreeBoosting
 );
 
 
+// ScoreInstances* sum our model tensors over a batch of binned instances.  binnedData is [feature][instance] like the binned data that we boost on, 
+// or [instance][feature] if isBinnedDataRowMajor is EBM_TRUE.  modelFeatureCombinationTensors holds one tensor per feature combination in the 
+// same layout that GetBestModelFeatureCombination returns, and intercept (which can be nullptr) holds one value per logit.  scoresReturn receives
+// the logits for each instance, or for classification with isProbabilities set, the probability of each target class (2 values for binary).
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreInstancesClassification(
+   IntEbmType countTargetClasses,
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType isBinnedDataRowMajor,
+   IntEbmType isProbabilities,
+   FloatEbmType * scoresReturn
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreInstancesRegression(
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType isBinnedDataRowMajor,
+   FloatEbmType * scoresReturn
+);
+
+// ScoreRawInstances* are like ScoreInstances*, but they take raw values and bin them as we go with the same cut points that we pass to Discretize.
+// cutPointsLowerBoundInclusive holds one cut point array per feature, each with countBins - 1 - hasMissing items.  We bin one tile of instances at 
+// a time, so we never build the full binned matrix.
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreRawInstancesClassification(
+   IntEbmType countTargetClasses,
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   const FloatEbmType * const * cutPointsLowerBoundInclusive,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   IntEbmType countInstances,
+   const FloatEbmType * rawData,
+   IntEbmType isRawDataRowMajor,
+   IntEbmType isProbabilities,
+   FloatEbmType * scoresReturn
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreRawInstancesRegression(
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   const FloatEbmType * const * cutPointsLowerBoundInclusive,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   IntEbmType countInstances,
+   const FloatEbmType * rawData,
+   IntEbmType isRawDataRowMajor,
+   FloatEbmType * scoresReturn
+);
+// GetTermContributions* write each term's logit contribution for each instance, which is what we show in our local explanations.  If countTopTerms 
+// is zero, contributionsReturn receives [instance][term][logit] for every term.  Otherwise, we keep only the countTopTerms terms with the largest 
+// absolute contributions for each instance (summed over the logits for multiclass), sorted from largest to smallest.  termIndexesReturn receives 
+// [instance][countTopTerms] term indexes and contributionsReturn receives [instance][countTopTerms][logit].  Unused slots get a term index of -1.
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GetTermContributionsClassification(
+   IntEbmType countTargetClasses,
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType isBinnedDataRowMajor,
+   IntEbmType countTopTerms,
+   IntEbmType * termIndexesReturn,
+   FloatEbmType * contributionsReturn
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GetTermContributionsRegression(
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType isBinnedDataRowMajor,
+   IntEbmType countTopTerms,
+   IntEbmType * termIndexesReturn,
+   FloatEbmType * contributionsReturn
+);
+// SaveModel* write a versioned, flat, little endian model file that LoadModel can memory map and score from without copying or parsing.
+// cutPointsLowerBoundInclusive can be nullptr, in which case the loaded model can only score binned data.  intercept can be nullptr
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION SaveModelClassification(
+   IntEbmType countTargetClasses,
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   const FloatEbmType * const * cutPointsLowerBoundInclusive,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   const char * filePath
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION SaveModelRegression(
+   IntEbmType countFeatures,
+   const EbmNativeFeature * features,
+   const FloatEbmType * const * cutPointsLowerBoundInclusive,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * const * modelFeatureCombinationTensors,
+   const FloatEbmType * intercept,
+   const char * filePath
+);
+// returns nullptr if the file can't be mapped or isn't a valid model file.  The file must not be modified while the model is loaded
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE PEbmModel EBM_NATIVE_CALLING_CONVENTION LoadModel(const char * filePath);
+// returns the countTargetClasses of a classification model, or -1 for a regression model
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GetModelCountTargetClasses(PEbmModel ebmModel);
+// these score exactly like ScoreInstances* and ScoreRawInstances*.  isProbabilities is ignored for regression models
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreModelInstances(
+   PEbmModel ebmModel,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType isBinnedDataRowMajor,
+   IntEbmType isProbabilities,
+   FloatEbmType * scoresReturn
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION ScoreModelRawInstances(
+   PEbmModel ebmModel,
+   IntEbmType countInstances,
+   const FloatEbmType * rawData,
+   IntEbmType isRawDataRowMajor,
+   IntEbmType isProbabilities,
+   FloatEbmType * scoresReturn
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION FreeModel(PEbmModel ebmModel);
+
+// optionalTempParams holds EXPERIMENTAL parameters, laid out as for boosting above.  Currently:
+//   optionalTempParams[1] - GetTopInteractionPairs bounds the pairs with more tensor cells than this before scoring them exactly, and scores the rest 
+//                           exactly right away.  0 (the default) uses 128 * 128 cells
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE PEbmInteraction EBM_NATIVE_CALLING_CONVENTION InitializeInteractionClassification(
    IntEbmType countTargetClasses,
    IntEbmType countFeatures,
@@ -397,6 +641,25 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GetInt
    const IntEbmType * featureIndexes, 
    FloatEbmType * interactionScoreReturn
 );
+// scores the pairs (indexFeatureAnchor, partnerFeatureIndexes[i]) into interactionScoresReturn[i].  Each score equals what GetInteractionScore 
+// returns for the same pair, but the data is read once for a block of partners instead of once per pair, so screening all pairs is much cheaper
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GetInteractionScoresAnchored(
+   PEbmInteraction ebmInteraction,
+   IntEbmType indexFeatureAnchor,
+   IntEbmType countPartners,
+   const IntEbmType * partnerFeatureIndexes,
+   FloatEbmType * interactionScoresReturn
+);
+// finds the countPairsMax pairs of features with the highest interaction scores, ordered by descending score and then by feature indexes.  The result 
+// is the same as scoring every pair with GetInteractionScore, but pairs whose coarse upper bound can't reach the top are never scored exactly.  
+// pairFeatureIndexesReturn receives 2 indexes per pair, with the lower index first
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GetTopInteractionPairs(
+   PEbmInteraction ebmInteraction,
+   IntEbmType countPairsMax,
+   IntEbmType * pairFeatureIndexesReturn,
+   FloatEbmType * interactionScoresReturn,
+   IntEbmType * countPairsReturn
+);
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION FreeInteraction(
    PEbmInteraction ebmInteraction
 );
@@ -443,6 +706,70 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION Discretize(
 );
 
 
+// A shared dataset is built in caller allocated memory in two passes, so that it can live in a RawArray or other shared memory block and be read by 
+// many processes.  First sum SizeDataSetHeader, SizeFeature for each feature, and SizeClassificationTarget or SizeRegressionTarget to get the number 
+// of bytes to allocate.  Then call FillDataSetHeader, FillFeature for each feature in order, and lastly FillClassificationTarget or 
+// FillRegressionTarget, which completes the dataset.  The memory holds only offsets and no pointers, so it can be mapped at different addresses.
+// The Size* functions return a negative number on error
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION SizeDataSetHeader(IntEbmType countFeatures);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION SizeFeature(IntEbmType countBins, IntEbmType countInstances);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION SizeClassificationTarget(
+   IntEbmType countTargetClasses, 
+   IntEbmType countInstances
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION SizeRegressionTarget(IntEbmType countInstances);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION FillDataSetHeader(
+   IntEbmType countFeatures,
+   IntEbmType countInstances,
+   IntEbmType countBytesAllocated,
+   unsigned char * fillMem
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION FillFeature(
+   IntEbmType featureType,
+   IntEbmType hasMissing,
+   IntEbmType countBins,
+   IntEbmType countInstances,
+   const IntEbmType * binnedData,
+   IntEbmType countBytesAllocated,
+   unsigned char * fillMem
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION FillClassificationTarget(
+   IntEbmType countTargetClasses,
+   IntEbmType countInstances,
+   const IntEbmType * targets,
+   IntEbmType countBytesAllocated,
+   unsigned char * fillMem
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION FillRegressionTarget(
+   IntEbmType countInstances,
+   const FloatEbmType * targets,
+   IntEbmType countBytesAllocated,
+   unsigned char * fillMem
+);
+// these read a completed shared dataset in place and never modify it, so several processes can initialize from the same block without each one parsing 
+// and binning its own copy of the raw data.  Boosting and interaction detection still copy the binned columns that they use into their own private 
+// memory (boosting bit packs them per feature combination), so each one holds a copy of the binned data that it trains on.  isValidation can come from 
+// GenerateTrainValidationSplit, and instances where it is non-zero go into the boosting validation set and are left out of interaction 
+// detection.  nullptr isValidation means every instance is used for training.  predictorScores are in the original instance order and can be nullptr 
+// for zero initial scores
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE PEbmBoosting EBM_NATIVE_CALLING_CONVENTION InitializeBoostingFromDataSet(
+   const void * dataSet,
+   const IntEbmType * isValidation,
+   IntEbmType countFeatureCombinations,
+   const EbmNativeFeatureCombination * featureCombinations,
+   const IntEbmType * featureCombinationIndexes,
+   const FloatEbmType * predictorScores,
+   IntEbmType countInnerBags,
+   IntEbmType randomSeed,
+   const FloatEbmType * optionalTempParams
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE PEbmInteraction EBM_NATIVE_CALLING_CONVENTION InitializeInteractionFromDataSet(
+   const void * dataSet,
+   const IntEbmType * isValidation,
+   const FloatEbmType * predictorScores,
+   const FloatEbmType * optionalTempParams
+);
+
 // TODO PK Implement the following for memory efficiency and speed of initialization :
 //   - NOTE: FOR RawArray ->  import multiprocessing ++ from multiprocessing import RawArray ++ RawArray(ct.c_ubyte, memory_size) ++ ct.POINTER(ct.c_ubyte)
 //   - OBSERVATION: passing in data one feature at a time is also nice since some languages (C# for instance) in some configurations don't like arrays 
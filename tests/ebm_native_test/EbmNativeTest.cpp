@@ -790,7 +790,10 @@ public:
       m_stage = Stage::ValidationAdded;
    }
 
-   void InitializeBoosting(const IntEbmType countInnerBags = k_countInnerBagsDefault) {
+   void InitializeBoosting(
+      const IntEbmType countInnerBags = k_countInnerBagsDefault, 
+      const std::vector<FloatEbmType> optionalTempParams = {}
+   ) {
       if(Stage::ValidationAdded != m_stage) {
          exit(1);
       }
@@ -823,7 +826,7 @@ public:
             0 == m_validationClassificationTargets.size() ? nullptr : &m_validationPredictionScores[0], 
             countInnerBags, 
             randomSeed,
-            nullptr
+            0 == optionalTempParams.size() ? nullptr : &optionalTempParams[0]
          );
       } else if(k_learningTypeRegression == m_learningTypeOrCountTargetClasses) {
          if(m_bNullTrainingPredictionScores) {
@@ -848,7 +851,7 @@ public:
             0 == m_validationRegressionTargets.size() ? nullptr : &m_validationPredictionScores[0], 
             countInnerBags, 
             randomSeed,
-            nullptr
+            0 == optionalTempParams.size() ? nullptr : &optionalTempParams[0]
          );
       } else {
          exit(1);
@@ -901,6 +904,45 @@ public:
       return validationMetricReturn;
    }
 
+   IntEbmType BoostCyclic(const std::vector<IntEbmType> featureCombinationIndexes, const IntEbmType countRoundsMax, const IntEbmType earlyStoppingRunLength, const FloatEbmType earlyStoppingTolerance, FloatEbmType * const pBestValidationMetricReturn) {
+      if(Stage::InitializedBoosting != m_stage) {
+         exit(1);
+      }
+      for(const IntEbmType indexFeatureCombination : featureCombinationIndexes) {
+         if(indexFeatureCombination < IntEbmType { 0 }) {
+            exit(1);
+         }
+         if(m_featureCombinations.size() <= static_cast<size_t>(indexFeatureCombination)) {
+            exit(1);
+         }
+      }
+      if(countRoundsMax < IntEbmType { 0 }) {
+         exit(1);
+      }
+
+      IntEbmType countRoundsReturn = IntEbmType { 0 };
+      const IntEbmType ret = ::BoostCyclic(
+         m_pEbmBoosting,
+         static_cast<IntEbmType>(featureCombinationIndexes.size()),
+         0 == featureCombinationIndexes.size() ? nullptr : &featureCombinationIndexes[0],
+         countRoundsMax,
+         1,
+         k_learningRateDefault,
+         k_countTreeSplitsMaxDefault,
+         k_countInstancesRequiredForParentSplitMinDefault,
+         nullptr,
+         nullptr,
+         earlyStoppingRunLength,
+         earlyStoppingTolerance,
+         &countRoundsReturn,
+         pBestValidationMetricReturn
+      );
+      if(0 != ret) {
+         exit(1);
+      }
+      return countRoundsReturn;
+   }
+
    FloatEbmType GetBestModelPredictorScore(const size_t iFeatureCombination, const std::vector<size_t> indexes, const size_t iScore) const {
       if(Stage::InitializedBoosting != m_stage) {
          exit(1);
@@ -1182,6 +1224,137 @@ public:
    }
 };
 
+// a small multiclass problem on 3 x 2 bins.  The weights are integers so that tests can compare them against duplicated instances
+class WeightedMulticlassInstances final {
+public:
+   const std::vector<FeatureTest> m_features { FeatureTest(3), FeatureTest(2) };
+   const std::vector<ClassificationInstance> m_training { 
+      ClassificationInstance(0, { 0, 1 }), ClassificationInstance(1, { 1, 0 }), ClassificationInstance(2, { 2, 1 }), 
+      ClassificationInstance(1, { 0, 0 }), ClassificationInstance(2, { 1, 1 }), ClassificationInstance(0, { 2, 0 })
+   };
+   const std::vector<FloatEbmType> m_trainingWeights { 1, 3, 2, 1, 4, 2 };
+   const std::vector<ClassificationInstance> m_validation { 
+      ClassificationInstance(2, { 0, 0 }), ClassificationInstance(0, { 1, 1 }), ClassificationInstance(1, { 2, 0 })
+   };
+   const std::vector<FloatEbmType> m_validationWeights { 2, 1, 3 };
+};
+
+// fills training and validation with cInstances instances on 5 x 4 bins, holding out every 4th instance for validation.  
+// targetFunction(i, iBin0, iBin1) returns the target of instance i
+template<typename TInstance, typename TTargetFunction>
+static void AddGridInstances(
+   const size_t cInstances, 
+   const TTargetFunction targetFunction, 
+   std::vector<TInstance> * const pTraining, 
+   std::vector<TInstance> * const pValidation
+) {
+   for(size_t i = 0; i < cInstances; ++i) {
+      const IntEbmType iBin0 = static_cast<IntEbmType>(i % 5);
+      const IntEbmType iBin1 = static_cast<IntEbmType>(i / 5 % 4);
+      const TInstance instance(targetFunction(i, iBin0, iBin1), { iBin0, iBin1 });
+      if(0 == i % 4) {
+         pValidation->push_back(instance);
+      } else {
+         pTraining->push_back(instance);
+      }
+   }
+}
+
+// a learnable regression problem on 5 x 4 bins with a little noise
+static void AddGridRegressionInstances(std::vector<RegressionInstance> * const pTraining, std::vector<RegressionInstance> * const pValidation) {
+   AddGridInstances(
+      200, 
+      [](const size_t i, const IntEbmType iBin0, const IntEbmType iBin1) {
+         return static_cast<FloatEbmType>(iBin0) * FloatEbmType { 1.5 } - static_cast<FloatEbmType>(iBin1) + 
+            static_cast<FloatEbmType>(i % 7) * FloatEbmType { 0.1 };
+      }, 
+      pTraining, 
+      pValidation
+   );
+}
+
+// a regression problem with one instance in each cell of a tensor of cBins[iDimension] bins.  The target is 10 inside the box where 
+// iBinLow[iDimension] <= iBin < iBinHigh[iDimension] in every dimension, and 0 elsewhere.  Boosting the whole tensor once with a learning rate 
+// of 1 recovers the targets exactly if our splitter finds the cuts around the box
+class BoxRegressionProblem final {
+   const std::vector<size_t> m_cBins;
+   const std::vector<size_t> m_iBinLow;
+   const std::vector<size_t> m_iBinHigh;
+
+   // moves aiBins to the next cell with dimension 0 changing fastest, and returns false after the last cell
+   bool NextCell(std::vector<size_t> & aiBins) const {
+      for(size_t iDimension = 0; iDimension < m_cBins.size(); ++iDimension) {
+         ++aiBins[iDimension];
+         if(aiBins[iDimension] != m_cBins[iDimension]) {
+            return true;
+         }
+         aiBins[iDimension] = 0;
+      }
+      return false;
+   }
+
+public:
+   BoxRegressionProblem(const std::vector<size_t> cBins, const std::vector<size_t> iBinLow, const std::vector<size_t> iBinHigh) :
+      m_cBins(cBins),
+      m_iBinLow(iBinLow),
+      m_iBinHigh(iBinHigh) {
+   }
+
+   std::vector<FeatureTest> GetFeatures() const {
+      std::vector<FeatureTest> features;
+      for(const size_t cBins : m_cBins) {
+         features.push_back(FeatureTest(static_cast<IntEbmType>(cBins)));
+      }
+      return features;
+   }
+
+   FloatEbmType GetTarget(const std::vector<size_t> & aiBins) const {
+      for(size_t iDimension = 0; iDimension < m_cBins.size(); ++iDimension) {
+         if(aiBins[iDimension] < m_iBinLow[iDimension] || m_iBinHigh[iDimension] <= aiBins[iDimension]) {
+            return FloatEbmType { 0 };
+         }
+      }
+      return FloatEbmType { 10 };
+   }
+
+   std::vector<RegressionInstance> GetInstances() const {
+      std::vector<RegressionInstance> instances;
+      std::vector<size_t> aiBins(m_cBins.size(), 0);
+      do {
+         std::vector<IntEbmType> binnedData;
+         for(const size_t iBin : aiBins) {
+            binnedData.push_back(static_cast<IntEbmType>(iBin));
+         }
+         instances.push_back(RegressionInstance(GetTarget(aiBins), binnedData));
+      } while(NextCell(aiBins));
+      return instances;
+   }
+
+   // adds our features, a single feature combination of all of them, and our instances as both the training and validation sets
+   void AddTo(TestApi & test) const {
+      std::vector<size_t> featureCombination;
+      for(size_t iDimension = 0; iDimension < m_cBins.size(); ++iDimension) {
+         featureCombination.push_back(iDimension);
+      }
+      const std::vector<RegressionInstance> instances = GetInstances();
+      test.AddFeatures(GetFeatures());
+      test.AddFeatureCombinations({ featureCombination });
+      test.AddTrainingInstances(instances);
+      test.AddValidationInstances(instances);
+   }
+
+   // true if every cell of feature combination 0 in our current model holds its target
+   bool IsModelRecovered(const TestApi & test) const {
+      std::vector<size_t> aiBins(m_cBins.size(), 0);
+      do {
+         if(!IsApproxEqual(test.GetCurrentModelPredictorScore(0, aiBins, 0), GetTarget(aiBins), double { 1e-6 })) {
+            return false;
+         }
+      } while(NextCell(aiBins));
+      return true;
+   }
+};
+
 #ifndef LEGACY_COMPATIBILITY
 TEST_CASE("test random number generator equivalency") {
    TestApi test = TestApi(2);
@@ -3200,6 +3373,1749 @@ TEST_CASE("zero countTreeSplitsMax, boosting, regression") {
    CHECK_APPROX(modelValue, test.GetCurrentModelPredictorScore(0, { 1 }, 0));
 }
 
+TEST_CASE("inner bagging, boosting, regression") {
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(2) });
+   test.AddFeatureCombinations({ { 0 } });
+
+   // every instance has the same target, so every inner bag should generate the same update regardless of which instances it samples
+   std::vector<RegressionInstance> instances;
+   for(int i = 0; i < 300; ++i) {
+      instances.push_back(RegressionInstance(10, { i % 2 }));
+   }
+   test.AddTrainingInstances(instances);
+   test.AddValidationInstances({ RegressionInstance(12, { 1 }) });
+   test.InitializeBoosting(3);
+
+   FloatEbmType validationMetric = test.Boost(0);
+   CHECK_APPROX(validationMetric, 141.61);
+   FloatEbmType modelValue;
+   modelValue = test.GetCurrentModelPredictorScore(0, { 0 }, 0);
+   CHECK_APPROX(modelValue, 0.1000000000000000);
+   CHECK_APPROX(modelValue, test.GetCurrentModelPredictorScore(0, { 1 }, 0));
+}
+
+TEST_CASE("inner bags that switch to full occurrence counts boost the same as byte counts, multiclass") {
+   // starting our bootstrap counts at 1 bit makes nearly every inner bag overflow and switch to full counts, which byte counts only do if an 
+   // instance is drawn more than 255 times.  The switch keeps drawing from the same random stream, so the models should be identical
+   std::vector<ClassificationInstance> instances;
+   for(IntEbmType i = 0; i < 60; ++i) {
+      instances.push_back(ClassificationInstance((i * 7 + i / 3) % 3, { i % 4, i / 4 % 3 }));
+   }
+
+   TestApi testByte = TestApi(3);
+   TestApi testOverflow = TestApi(3);
+   for(TestApi * pTest : { &testByte, &testOverflow }) {
+      pTest->AddFeatures({ FeatureTest(4), FeatureTest(3) });
+      pTest->AddFeatureCombinations({ { 0 }, { 1 }, { 0, 1 } });
+      pTest->AddTrainingInstances(instances);
+      pTest->AddValidationInstances(instances);
+   }
+   testByte.InitializeBoosting(3);
+   testOverflow.InitializeBoosting(3, { 6, 0, 0, 0, 0, 0, 1 });
+
+   for(int iEpoch = 0; iEpoch < 20; ++iEpoch) {
+      for(size_t iFeatureCombination = 0; iFeatureCombination < testByte.GetFeatureCombinationsCount(); ++iFeatureCombination) {
+         const FloatEbmType validationMetricByte = testByte.Boost(iFeatureCombination);
+         const FloatEbmType validationMetricOverflow = testOverflow.Boost(iFeatureCombination);
+         CHECK_APPROX(validationMetricByte, validationMetricOverflow);
+      }
+   }
+   for(size_t iBin0 = 0; iBin0 < 4; ++iBin0) {
+      for(size_t iBin1 = 0; iBin1 < 3; ++iBin1) {
+         for(size_t iScore = 0; iScore < 3; ++iScore) {
+            CHECK_APPROX(testByte.GetCurrentModelPredictorScore(2, { iBin0, iBin1 }, iScore), 
+               testOverflow.GetCurrentModelPredictorScore(2, { iBin0, iBin1 }, iScore));
+         }
+      }
+   }
+}
+
+TEST_CASE("storing Newton-Raphson steps boosts the same as recomputing them, binary and multiclass") {
+   // each row is { countInnerBags, GOSS top, GOSS other, subsample fraction, bin separately }, which covers each histogram kernel that reads 
+   // the Newton-Raphson steps: no inner bags, all bootstrap inner bags binned together, each bootstrap inner bag binned separately, subsampled 
+   // inner bags that gather their residuals, and GOSS inner bags that list their instances.  BoostCyclic then covers the training pass that 
+   // bins the next step while it updates the residuals
+   const std::vector<std::vector<FloatEbmType>> configs { 
+      { 0, 0, 0, 0, 0 }, 
+      { 3, 0, 0, 0, 0 }, 
+      { 3, 0, 0, 0, 1 }, 
+      { 3, 0, 0, 0.5, 0 }, 
+      { 3, 0.5, 0.25, 0, 0 } 
+   };
+   for(const std::vector<FloatEbmType> & config : configs) {
+      for(const ptrdiff_t cClasses : { ptrdiff_t { 2 }, ptrdiff_t { 3 } }) {
+         std::vector<ClassificationInstance> instances;
+         for(IntEbmType i = 0; i < 90; ++i) {
+            instances.push_back(ClassificationInstance((i * 7 + i / 3) % cClasses, { i % 4, i / 4 % 3 }));
+         }
+
+         TestApi testRecompute = TestApi(cClasses);
+         TestApi testStore = TestApi(cClasses);
+         for(TestApi * pTest : { &testRecompute, &testStore }) {
+            pTest->AddFeatures({ FeatureTest(4), FeatureTest(3) });
+            pTest->AddFeatureCombinations({ { 0 }, { 1 }, { 0, 1 } });
+            pTest->AddTrainingInstances(instances);
+            pTest->AddValidationInstances(instances);
+         }
+         const IntEbmType countInnerBags = static_cast<IntEbmType>(config[0]);
+         testRecompute.InitializeBoosting(countInnerBags, { 7, config[1], config[2], config[3], 0, 0, 0, config[4] });
+         testStore.InitializeBoosting(countInnerBags, { 9, config[1], config[2], config[3], 0, 0, 0, config[4], 0, 1 });
+
+         for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+            for(size_t iFeatureCombination = 0; iFeatureCombination < testRecompute.GetFeatureCombinationsCount(); ++iFeatureCombination) {
+               const FloatEbmType validationMetricRecompute = testRecompute.Boost(iFeatureCombination);
+               const FloatEbmType validationMetricStore = testStore.Boost(iFeatureCombination);
+               CHECK_APPROX(validationMetricRecompute, validationMetricStore);
+            }
+         }
+
+         FloatEbmType bestValidationMetricRecompute;
+         FloatEbmType bestValidationMetricStore;
+         CHECK(10 == testRecompute.BoostCyclic({ 2, 0, 1 }, 10, -1, 0, &bestValidationMetricRecompute));
+         CHECK(10 == testStore.BoostCyclic({ 2, 0, 1 }, 10, -1, 0, &bestValidationMetricStore));
+         CHECK_APPROX(bestValidationMetricRecompute, bestValidationMetricStore);
+
+         const size_t cScores = ptrdiff_t { 2 } == cClasses ? 1 : 3;
+         for(size_t iBin0 = 0; iBin0 < 4; ++iBin0) {
+            for(size_t iBin1 = 0; iBin1 < 3; ++iBin1) {
+               for(size_t iScore = 0; iScore < cScores; ++iScore) {
+                  CHECK_APPROX(testRecompute.GetCurrentModelPredictorScore(2, { iBin0, iBin1 }, iScore), 
+                     testStore.GetCurrentModelPredictorScore(2, { iBin0, iBin1 }, iScore));
+               }
+            }
+         }
+      }
+   }
+}
+
+TEST_CASE("BoostCyclic matches BoostingStep, boosting, binary") {
+   std::vector<ClassificationInstance> trainingInstances;
+   std::vector<ClassificationInstance> validationInstances;
+   for(int i = 0; i < 100; ++i) {
+      trainingInstances.push_back(ClassificationInstance(0 == i % 3 ? 1 : 0, { i % 4, i % 5 }));
+      validationInstances.push_back(ClassificationInstance(0 == i % 7 ? 1 : 0, { i % 4, (i + 1) % 5 }));
+   }
+
+   TestApi testStep = TestApi(2);
+   testStep.AddFeatures({ FeatureTest(4), FeatureTest(5) });
+   testStep.AddFeatureCombinations({ { 0 }, { 1 } });
+   testStep.AddTrainingInstances(trainingInstances);
+   testStep.AddValidationInstances(validationInstances);
+   testStep.InitializeBoosting();
+
+   FloatEbmType bestValidationMetricStep = std::numeric_limits<FloatEbmType>::infinity();
+   for(int iRound = 0; iRound < 20; ++iRound) {
+      bestValidationMetricStep = std::min(bestValidationMetricStep, testStep.Boost(1));
+      bestValidationMetricStep = std::min(bestValidationMetricStep, testStep.Boost(0));
+   }
+
+   TestApi testCyclic = TestApi(2);
+   testCyclic.AddFeatures({ FeatureTest(4), FeatureTest(5) });
+   testCyclic.AddFeatureCombinations({ { 0 }, { 1 } });
+   testCyclic.AddTrainingInstances(trainingInstances);
+   testCyclic.AddValidationInstances(validationInstances);
+   testCyclic.InitializeBoosting();
+
+   FloatEbmType bestValidationMetricCyclic;
+   const IntEbmType countRounds = testCyclic.BoostCyclic({ 1, 0 }, 20, -1, 0, &bestValidationMetricCyclic);
+   CHECK(20 == countRounds);
+   CHECK_APPROX(bestValidationMetricCyclic, bestValidationMetricStep);
+   for(size_t iBin = 0; iBin < 4; ++iBin) {
+      CHECK_APPROX(testCyclic.GetBestModelPredictorScore(0, { iBin }, 1), testStep.GetBestModelPredictorScore(0, { iBin }, 1));
+   }
+   for(size_t iBin = 0; iBin < 5; ++iBin) {
+      CHECK_APPROX(testCyclic.GetBestModelPredictorScore(1, { iBin }, 1), testStep.GetBestModelPredictorScore(1, { iBin }, 1));
+   }
+}
+
+TEST_CASE("BoostCyclic with and without inner bags matches BoostingStep, boosting, multiclass and regression") {
+   // with 2 or more inner bags each cyclic step bins its new residuals for the following step while it updates them, which must not change any 
+   // result.  Our BoostingStep loop bins each sampling set in its own pass, so it never goes through that path.  Without inner bags or with one, 
+   // both take the same path.  Both paths add the same values in the same order, but under -ffast-math the compiler can contract or reorder 
+   // the fused loop differently, so we allow for rounding
+   const std::vector<FloatEbmType> tempParamsBinSeparately { 7, 0, 0, 0, 0, 0, 0, 1 };
+   for(const IntEbmType countInnerBags : { IntEbmType { 0 }, IntEbmType { 1 }, IntEbmType { 3 } }) {
+      for(const ptrdiff_t learningTypeOrCountTargetClasses : { ptrdiff_t { 3 }, k_learningTypeRegression }) {
+         std::vector<ClassificationInstance> trainingInstances;
+         std::vector<ClassificationInstance> validationInstances;
+         std::vector<RegressionInstance> trainingInstancesRegression;
+         std::vector<RegressionInstance> validationInstancesRegression;
+         for(int i = 0; i < 200; ++i) {
+            trainingInstances.push_back(ClassificationInstance(i % 3 == i % 4 ? 2 : i % 2, { i % 4, i % 5, i % 7 }));
+            validationInstances.push_back(ClassificationInstance(i % 3, { i % 4, (i + 1) % 5, (i + 3) % 7 }));
+            trainingInstancesRegression.push_back(RegressionInstance(static_cast<FloatEbmType>(i % 4 * (i % 5)), { i % 4, i % 5, i % 7 }));
+            validationInstancesRegression.push_back(RegressionInstance(static_cast<FloatEbmType>(i % 6), { i % 4, (i + 1) % 5, (i + 3) % 7 }));
+         }
+         TestApi testStep = TestApi(learningTypeOrCountTargetClasses);
+         TestApi testCyclic = TestApi(learningTypeOrCountTargetClasses);
+         for(TestApi * const pTest : { &testStep, &testCyclic }) {
+            TestApi & test = *pTest;
+            test.AddFeatures({ FeatureTest(4), FeatureTest(5), FeatureTest(7) });
+            test.AddFeatureCombinations({ { 0 }, {}, { 1, 2 }, { 2 } });
+            if(k_learningTypeRegression == learningTypeOrCountTargetClasses) {
+               test.AddTrainingInstances(trainingInstancesRegression);
+               test.AddValidationInstances(validationInstancesRegression);
+            } else {
+               test.AddTrainingInstances(trainingInstances);
+               test.AddValidationInstances(validationInstances);
+            }
+         }
+         testStep.InitializeBoosting(countInnerBags, tempParamsBinSeparately);
+         testCyclic.InitializeBoosting(countInnerBags);
+
+         const std::vector<IntEbmType> featureCombinationIndexes { 2, 0, 1, 3, 0 };
+         FloatEbmType bestValidationMetricStep = std::numeric_limits<FloatEbmType>::infinity();
+         for(int iRound = 0; iRound < 10; ++iRound) {
+            for(const IntEbmType indexFeatureCombination : featureCombinationIndexes) {
+               bestValidationMetricStep = std::min(bestValidationMetricStep, testStep.Boost(indexFeatureCombination));
+            }
+         }
+
+         FloatEbmType bestValidationMetricCyclic;
+         const IntEbmType countRounds = testCyclic.BoostCyclic(featureCombinationIndexes, 10, -1, 0, &bestValidationMetricCyclic);
+         CHECK(10 == countRounds);
+         CHECK_APPROX(bestValidationMetricCyclic, bestValidationMetricStep);
+         const size_t cScores = k_learningTypeRegression == learningTypeOrCountTargetClasses ? 1 : 3;
+         for(size_t iScore = 0; iScore < cScores; ++iScore) {
+            CHECK_APPROX(testCyclic.GetBestModelPredictorScore(1, {}, iScore), testStep.GetBestModelPredictorScore(1, {}, iScore));
+            for(size_t iBin0 = 0; iBin0 < 4; ++iBin0) {
+               CHECK_APPROX(testCyclic.GetBestModelPredictorScore(0, { iBin0 }, iScore), testStep.GetBestModelPredictorScore(0, { iBin0 }, iScore));
+            }
+            for(size_t iBin2 = 0; iBin2 < 7; ++iBin2) {
+               CHECK_APPROX(testCyclic.GetBestModelPredictorScore(3, { iBin2 }, iScore), testStep.GetBestModelPredictorScore(3, { iBin2 }, iScore));
+               for(size_t iBin1 = 0; iBin1 < 5; ++iBin1) {
+                  CHECK_APPROX(testCyclic.GetBestModelPredictorScore(2, { iBin1, iBin2 }, iScore),
+                     testStep.GetBestModelPredictorScore(2, { iBin1, iBin2 }, iScore));
+               }
+            }
+         }
+      }
+   }
+}
+
+TEST_CASE("BoostCyclic early stopping, boosting, regression") {
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(2) });
+   test.AddFeatureCombinations({ { 0 } });
+   test.AddTrainingInstances({ RegressionInstance(10, { 1 }) });
+   test.AddValidationInstances({ RegressionInstance(12, { 1 }) });
+   test.InitializeBoosting();
+
+   // the validation metric keeps improving by more than our tolerance at first, but once our model approaches 10 the improvements shrink 
+   // below 1 per round and we stop 3 rounds after that
+   FloatEbmType bestValidationMetric;
+   const IntEbmType countRounds = test.BoostCyclic({ 0 }, 1000, 3, FloatEbmType { 1 }, &bestValidationMetric);
+   CHECK(3 <= countRounds);
+   CHECK(countRounds < 1000);
+   CHECK(bestValidationMetric < FloatEbmType { 144 });
+
+   // zero rounds leaves our metric at infinity
+   const IntEbmType countRoundsZero = test.BoostCyclic({ 0 }, 0, 3, FloatEbmType { 1 }, &bestValidationMetric);
+   CHECK(0 == countRoundsZero);
+   CHECK(std::isinf(bestValidationMetric));
+}
+
+TEST_CASE("BoostCyclic rejects bad arguments, boosting, regression") {
+   EbmNativeFeatureCombination combinations[1];
+   combinations->countFeaturesInCombination = 0;
+
+   PEbmBoosting pEbmBoosting = InitializeBoostingRegression(
+      0, 
+      nullptr, 
+      1, 
+      combinations, 
+      nullptr, 
+      0, 
+      nullptr, 
+      nullptr, 
+      nullptr, 
+      0, 
+      nullptr, 
+      nullptr, 
+      nullptr, 
+      0, 
+      randomSeed,
+      nullptr
+   );
+   CHECK(nullptr != pEbmBoosting);
+
+   const FloatEbmType nan = std::numeric_limits<FloatEbmType>::quiet_NaN();
+   const IntEbmType indexesGood[] { 0, 0 };
+   const IntEbmType indexesTooLarge[] { 0, 1 };
+   const IntEbmType indexesNegative[] { -1, 0 };
+   const auto boostCyclic = [&](
+      const PEbmBoosting ebmBoosting, 
+      const IntEbmType countFeatureCombinationsToBoost, 
+      const IntEbmType * const featureCombinationIndexes, 
+      const IntEbmType countRoundsMax, 
+      const IntEbmType countStepsPerFeatureCombination, 
+      const FloatEbmType earlyStoppingTolerance
+   ) {
+      IntEbmType countRounds = -1;
+      FloatEbmType bestValidationMetric = nan;
+      const IntEbmType ret = BoostCyclic(
+         ebmBoosting, 
+         countFeatureCombinationsToBoost, 
+         featureCombinationIndexes, 
+         countRoundsMax, 
+         countStepsPerFeatureCombination, 
+         k_learningRateDefault, 
+         k_countTreeSplitsMaxDefault, 
+         k_countInstancesRequiredForParentSplitMinDefault, 
+         nullptr, 
+         nullptr, 
+         -1, 
+         earlyStoppingTolerance, 
+         &countRounds, 
+         &bestValidationMetric
+      );
+      // on error we get zeros instead of whatever was there before
+      CHECK(0 == ret || (0 == countRounds && FloatEbmType { 0 } == bestValidationMetric));
+      return ret;
+   };
+
+   CHECK(1 == boostCyclic(nullptr, 2, indexesGood, 3, 1, 0));
+   CHECK(1 == boostCyclic(pEbmBoosting, -1, indexesGood, 3, 1, 0));
+   CHECK(1 == boostCyclic(pEbmBoosting, 2, nullptr, 3, 1, 0));
+   CHECK(1 == boostCyclic(pEbmBoosting, 2, indexesTooLarge, 3, 1, 0));
+   CHECK(1 == boostCyclic(pEbmBoosting, 2, indexesNegative, 3, 1, 0));
+   CHECK(1 == boostCyclic(pEbmBoosting, 2, indexesGood, -1, 1, 0));
+   CHECK(1 == boostCyclic(pEbmBoosting, 2, indexesGood, 3, -1, 0));
+   CHECK(1 == boostCyclic(pEbmBoosting, 2, indexesGood, 3, 1, nan));
+   CHECK(0 == boostCyclic(pEbmBoosting, 2, indexesGood, 3, 1, 0));
+
+   FreeBoosting(pEbmBoosting);
+}
+
+TEST_CASE("ScoreInstances matches model tensors, multiclass") {
+   constexpr IntEbmType k_countClasses = 3;
+   const std::vector<IntEbmType> countBins { 3, 1, 4 };
+   TestApi test = TestApi(k_countClasses);
+   test.AddFeatures({ FeatureTest(countBins[0]), FeatureTest(countBins[1]), FeatureTest(countBins[2]) });
+   test.AddFeatureCombinations({ { 0 }, { 1, 2 }, { 0, 2 }, {} });
+   std::vector<ClassificationInstance> instances;
+   // use more instances than fit in one scoring tile
+   constexpr size_t k_cInstances = 150;
+   std::vector<IntEbmType> binnedDataColumnMajor(3 * k_cInstances);
+   std::vector<IntEbmType> binnedDataRowMajor(3 * k_cInstances);
+   for(size_t i = 0; i < k_cInstances; ++i) {
+      const std::vector<IntEbmType> binned { static_cast<IntEbmType>(i % 3), 0, static_cast<IntEbmType>(i * 7 % 4) };
+      instances.push_back(ClassificationInstance(static_cast<IntEbmType>(i * 5 % 3), binned));
+      for(size_t iFeature = 0; iFeature < 3; ++iFeature) {
+         binnedDataColumnMajor[iFeature * k_cInstances + i] = binned[iFeature];
+         binnedDataRowMajor[i * 3 + iFeature] = binned[iFeature];
+      }
+   }
+   test.AddTrainingInstances(instances);
+   test.AddValidationInstances(instances);
+   test.InitializeBoosting();
+   for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+      for(size_t iFeatureCombination = 0; iFeatureCombination < test.GetFeatureCombinationsCount(); ++iFeatureCombination) {
+         test.Boost(iFeatureCombination);
+      }
+   }
+
+   EbmNativeFeature features[3];
+   for(size_t iFeature = 0; iFeature < 3; ++iFeature) {
+      features[iFeature].featureType = FeatureTypeOrdinal;
+      features[iFeature].hasMissing = EBM_FALSE;
+      features[iFeature].countBins = countBins[iFeature];
+   }
+   EbmNativeFeatureCombination featureCombinations[4];
+   featureCombinations[0].countFeaturesInCombination = 1;
+   featureCombinations[1].countFeaturesInCombination = 2;
+   featureCombinations[2].countFeaturesInCombination = 2;
+   featureCombinations[3].countFeaturesInCombination = 0;
+   const IntEbmType featureCombinationIndexes[] { 0, 1, 2, 0, 2 };
+   const FloatEbmType * modelFeatureCombinationTensors[4];
+   for(size_t iFeatureCombination = 0; iFeatureCombination < 4; ++iFeatureCombination) {
+      modelFeatureCombinationTensors[iFeatureCombination] = test.GetCurrentModelFeatureCombinationRaw(iFeatureCombination);
+   }
+   const FloatEbmType intercept[] { 0.5, -0.25, 0.125 };
+
+   std::vector<FloatEbmType> logits(k_countClasses * k_cInstances);
+   IntEbmType ret = ScoreInstancesClassification(k_countClasses, 3, features, 4, featureCombinations, featureCombinationIndexes,
+      modelFeatureCombinationTensors, intercept, k_cInstances, &binnedDataColumnMajor[0], EBM_FALSE, EBM_FALSE, &logits[0]);
+   CHECK(0 == ret);
+   std::vector<FloatEbmType> logitsRowMajor(k_countClasses * k_cInstances);
+   ret = ScoreInstancesClassification(k_countClasses, 3, features, 4, featureCombinations, featureCombinationIndexes,
+      modelFeatureCombinationTensors, intercept, k_cInstances, &binnedDataRowMajor[0], EBM_TRUE, EBM_FALSE, &logitsRowMajor[0]);
+   CHECK(0 == ret);
+   std::vector<FloatEbmType> probabilities(k_countClasses * k_cInstances);
+   ret = ScoreInstancesClassification(k_countClasses, 3, features, 4, featureCombinations, featureCombinationIndexes,
+      modelFeatureCombinationTensors, intercept, k_cInstances, &binnedDataColumnMajor[0], EBM_FALSE, EBM_TRUE, &probabilities[0]);
+   CHECK(0 == ret);
+
+   for(size_t i = 0; i < k_cInstances; ++i) {
+      const size_t iBin0 = i % 3;
+      const size_t iBin2 = i * 7 % 4;
+      FloatEbmType sumExp = 0;
+      for(size_t iClass = 0; iClass < static_cast<size_t>(k_countClasses); ++iClass) {
+         const FloatEbmType expected = intercept[iClass] + 
+            modelFeatureCombinationTensors[0][iBin0 * k_countClasses + iClass] + 
+            modelFeatureCombinationTensors[1][iBin2 * k_countClasses + iClass] + 
+            modelFeatureCombinationTensors[2][(iBin0 + iBin2 * 3) * k_countClasses + iClass] + 
+            modelFeatureCombinationTensors[3][iClass];
+         CHECK_APPROX(logits[i * k_countClasses + iClass], expected);
+         CHECK(logits[i * k_countClasses + iClass] == logitsRowMajor[i * k_countClasses + iClass]);
+         sumExp += std::exp(expected);
+      }
+      for(size_t iClass = 0; iClass < static_cast<size_t>(k_countClasses); ++iClass) {
+         CHECK_APPROX(probabilities[i * k_countClasses + iClass], std::exp(logits[i * k_countClasses + iClass]) / sumExp);
+      }
+   }
+}
+
+TEST_CASE("ScoreInstances probabilities, binary") {
+   EbmNativeFeature features[1];
+   features[0].featureType = FeatureTypeOrdinal;
+   features[0].hasMissing = EBM_FALSE;
+   features[0].countBins = 2;
+   EbmNativeFeatureCombination featureCombinations[1];
+   featureCombinations[0].countFeaturesInCombination = 1;
+   const IntEbmType featureCombinationIndexes[] { 0 };
+   const FloatEbmType tensor[] { -1, 2 };
+   const FloatEbmType * modelFeatureCombinationTensors[] { tensor };
+   const FloatEbmType intercept[] { 0.5 };
+   const IntEbmType binnedData[] { 1, 0, 1 };
+
+   FloatEbmType scores[6];
+   IntEbmType ret = ScoreInstancesClassification(2, 1, features, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, intercept, 3, binnedData, EBM_FALSE, EBM_TRUE, scores);
+   CHECK(0 == ret);
+   CHECK_APPROX(scores[1], 1 / (1 + std::exp(-2.5)));
+   CHECK_APPROX(scores[0] + scores[1], 1);
+   CHECK_APPROX(scores[3], 1 / (1 + std::exp(0.5)));
+   CHECK_APPROX(scores[0], scores[4]);
+
+   ret = ScoreInstancesRegression(1, features, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, 3, binnedData, EBM_FALSE, scores);
+   CHECK(0 == ret);
+   CHECK_APPROX(scores[0], 2);
+   CHECK_APPROX(scores[1], -1);
+   CHECK_APPROX(scores[2], 2);
+}
+
+TEST_CASE("ScoreInstances rejects out of range bins and missing arrays, regression") {
+   EbmNativeFeature features[1];
+   features[0].featureType = FeatureTypeOrdinal;
+   features[0].hasMissing = EBM_FALSE;
+   features[0].countBins = 3;
+   EbmNativeFeatureCombination featureCombinations[1];
+   featureCombinations[0].countFeaturesInCombination = 1;
+   const IntEbmType featureCombinationIndexes[] { 0 };
+   const FloatEbmType tensor[] { 1, 2, 3 };
+   const FloatEbmType * modelFeatureCombinationTensors[] { tensor };
+   const FloatEbmType cutPoints[] { 0.5, 1.5 };
+   const FloatEbmType * cutPointsLowerBoundInclusive[] { cutPoints };
+   const FloatEbmType * cutPointsMissing[] { nullptr };
+   const FloatEbmType rawData[] { 0, 1, 2 };
+
+   FloatEbmType scores[3];
+   // the last bin is fine, one past it and negative bins other than -1 would read outside of our tensor, and -1 is missing without a missing bin
+   const IntEbmType binnedDataGood[] { 0, 1, 2 };
+   IntEbmType ret = ScoreInstancesRegression(1, features, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, 3, binnedDataGood, EBM_FALSE, scores);
+   CHECK(0 == ret);
+   CHECK_APPROX(scores[2], 3);
+   for(const IntEbmType binBad : { IntEbmType { 3 }, IntEbmType { 1000000 }, IntEbmType { -2 }, IntEbmType { -1 } }) {
+      const IntEbmType binnedDataBad[] { 0, binBad, 2 };
+      ret = ScoreInstancesRegression(1, features, 1, featureCombinations, featureCombinationIndexes, 
+         modelFeatureCombinationTensors, nullptr, 3, binnedDataBad, EBM_FALSE, scores);
+      CHECK(1 == ret);
+   }
+
+   ret = ScoreInstancesRegression(-1, features, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, 3, binnedDataGood, EBM_FALSE, scores);
+   CHECK(1 == ret);
+   ret = ScoreInstancesRegression(1, features, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, -3, binnedDataGood, EBM_FALSE, scores);
+   CHECK(1 == ret);
+   ret = ScoreInstancesRegression(1, nullptr, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, 3, binnedDataGood, EBM_FALSE, scores);
+   CHECK(1 == ret);
+   ret = ScoreInstancesRegression(1, features, 1, nullptr, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, 3, binnedDataGood, EBM_FALSE, scores);
+   CHECK(1 == ret);
+   ret = ScoreInstancesRegression(1, features, 1, featureCombinations, nullptr, 
+      modelFeatureCombinationTensors, nullptr, 3, binnedDataGood, EBM_FALSE, scores);
+   CHECK(1 == ret);
+   ret = ScoreInstancesRegression(1, features, 1, featureCombinations, featureCombinationIndexes, 
+      nullptr, nullptr, 3, binnedDataGood, EBM_FALSE, scores);
+   CHECK(1 == ret);
+   ret = ScoreInstancesRegression(1, features, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, 3, nullptr, EBM_FALSE, scores);
+   CHECK(1 == ret);
+   ret = ScoreInstancesRegression(1, features, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, 3, binnedDataGood, EBM_FALSE, nullptr);
+   CHECK(1 == ret);
+
+   ret = ScoreRawInstancesRegression(1, features, cutPointsLowerBoundInclusive, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, 3, rawData, EBM_FALSE, scores);
+   CHECK(0 == ret);
+   CHECK_APPROX(scores[2], 3);
+   ret = ScoreRawInstancesRegression(1, features, nullptr, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, 3, rawData, EBM_FALSE, scores);
+   CHECK(1 == ret);
+   ret = ScoreRawInstancesRegression(1, features, cutPointsMissing, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, 3, rawData, EBM_FALSE, scores);
+   CHECK(1 == ret);
+}
+
+TEST_CASE("ScoreRawInstances matches Discretize then ScoreInstances, multiclass") {
+   constexpr IntEbmType k_countClasses = 3;
+   constexpr size_t k_cInstances = 100;
+   const FloatEbmType cutPoints0[] { -1, 0.5, 2 };
+   const FloatEbmType cutPoints1[] { 10, 20 };
+   const FloatEbmType * const cutPointsLowerBoundInclusive[] { cutPoints0, cutPoints1 };
+
+   EbmNativeFeature features[2];
+   features[0].featureType = FeatureTypeOrdinal;
+   features[0].hasMissing = EBM_TRUE;
+   features[0].countBins = 5;
+   features[1].featureType = FeatureTypeOrdinal;
+   features[1].hasMissing = EBM_FALSE;
+   features[1].countBins = 3;
+   EbmNativeFeatureCombination featureCombinations[2];
+   featureCombinations[0].countFeaturesInCombination = 1;
+   featureCombinations[1].countFeaturesInCombination = 2;
+   const IntEbmType featureCombinationIndexes[] { 0, 0, 1 };
+   std::vector<FloatEbmType> tensor0(5 * k_countClasses);
+   std::vector<FloatEbmType> tensor1(15 * k_countClasses);
+   for(size_t i = 0; i < tensor0.size(); ++i) {
+      tensor0[i] = static_cast<FloatEbmType>(i) * 0.1;
+   }
+   for(size_t i = 0; i < tensor1.size(); ++i) {
+      tensor1[i] = static_cast<FloatEbmType>(i % 7) * -0.05;
+   }
+   const FloatEbmType * modelFeatureCombinationTensors[] { &tensor0[0], &tensor1[0] };
+
+   std::vector<FloatEbmType> raw(2 * k_cInstances);
+   for(size_t i = 0; i < k_cInstances; ++i) {
+      raw[i] = 0 == i % 9 ? std::numeric_limits<FloatEbmType>::quiet_NaN() : static_cast<FloatEbmType>(i % 11) * 0.5 - 2;
+      raw[k_cInstances + i] = static_cast<FloatEbmType>(i % 13) * 2.5;
+   }
+   std::vector<IntEbmType> binned(2 * k_cInstances);
+   Discretize(EBM_TRUE, 3, cutPoints0, k_cInstances, &raw[0], &binned[0]);
+   Discretize(EBM_FALSE, 2, cutPoints1, k_cInstances, &raw[k_cInstances], &binned[k_cInstances]);
+
+   std::vector<FloatEbmType> expected(k_countClasses * k_cInstances);
+   IntEbmType ret = ScoreInstancesClassification(k_countClasses, 2, features, 2, featureCombinations, featureCombinationIndexes,
+      modelFeatureCombinationTensors, nullptr, k_cInstances, &binned[0], EBM_FALSE, EBM_TRUE, &expected[0]);
+   CHECK(0 == ret);
+   std::vector<FloatEbmType> actual(k_countClasses * k_cInstances);
+   ret = ScoreRawInstancesClassification(k_countClasses, 2, features, cutPointsLowerBoundInclusive, 2, featureCombinations, 
+      featureCombinationIndexes, modelFeatureCombinationTensors, nullptr, k_cInstances, &raw[0], EBM_FALSE, EBM_TRUE, &actual[0]);
+   CHECK(0 == ret);
+   for(size_t i = 0; i < actual.size(); ++i) {
+      CHECK(expected[i] == actual[i]);
+   }
+
+   // a missing value in a feature without a missing bin can't be scored
+   raw[k_cInstances + 5] = std::numeric_limits<FloatEbmType>::quiet_NaN();
+   ret = ScoreRawInstancesClassification(k_countClasses, 2, features, cutPointsLowerBoundInclusive, 2, featureCombinations,
+      featureCombinationIndexes, modelFeatureCombinationTensors, nullptr, k_cInstances, &raw[0], EBM_FALSE, EBM_TRUE, &actual[0]);
+   CHECK(0 != ret);
+}
+
+TEST_CASE("GetTermContributions full and top terms, multiclass") {
+   constexpr IntEbmType k_countClasses = 3;
+   constexpr size_t k_cTerms = 3;
+   // use more instances than fit in one scoring tile
+   constexpr size_t k_cInstances = 100;
+
+   EbmNativeFeature features[2];
+   features[0].featureType = FeatureTypeOrdinal;
+   features[0].hasMissing = EBM_FALSE;
+   features[0].countBins = 4;
+   features[1].featureType = FeatureTypeOrdinal;
+   features[1].hasMissing = EBM_FALSE;
+   features[1].countBins = 3;
+   EbmNativeFeatureCombination featureCombinations[k_cTerms];
+   featureCombinations[0].countFeaturesInCombination = 1;
+   featureCombinations[1].countFeaturesInCombination = 1;
+   featureCombinations[2].countFeaturesInCombination = 2;
+   const IntEbmType featureCombinationIndexes[] { 0, 1, 0, 1 };
+   std::vector<FloatEbmType> tensor0(4 * k_countClasses);
+   std::vector<FloatEbmType> tensor1(3 * k_countClasses);
+   std::vector<FloatEbmType> tensor2(12 * k_countClasses);
+   for(size_t i = 0; i < tensor0.size(); ++i) {
+      tensor0[i] = static_cast<FloatEbmType>(i % 5) * 0.25 - 0.5;
+   }
+   for(size_t i = 0; i < tensor1.size(); ++i) {
+      tensor1[i] = static_cast<FloatEbmType>(i % 4) * -0.3;
+   }
+   for(size_t i = 0; i < tensor2.size(); ++i) {
+      tensor2[i] = static_cast<FloatEbmType>(i % 7) * 0.1 - 0.2;
+   }
+   const FloatEbmType * modelFeatureCombinationTensors[] { &tensor0[0], &tensor1[0], &tensor2[0] };
+
+   std::vector<IntEbmType> binned(2 * k_cInstances);
+   for(size_t i = 0; i < k_cInstances; ++i) {
+      binned[i] = static_cast<IntEbmType>(i % 4);
+      binned[k_cInstances + i] = static_cast<IntEbmType>(i * 5 % 3);
+   }
+
+   std::vector<FloatEbmType> contributions(k_cInstances * k_cTerms * k_countClasses);
+   IntEbmType ret = GetTermContributionsClassification(k_countClasses, 2, features, k_cTerms, featureCombinations, featureCombinationIndexes,
+      modelFeatureCombinationTensors, k_cInstances, &binned[0], EBM_FALSE, 0, nullptr, &contributions[0]);
+   CHECK(0 == ret);
+
+   constexpr size_t k_cTopTerms = 2;
+   std::vector<IntEbmType> topTermIndexes(k_cInstances * k_cTopTerms);
+   std::vector<FloatEbmType> topContributions(k_cInstances * k_cTopTerms * k_countClasses);
+   ret = GetTermContributionsClassification(k_countClasses, 2, features, k_cTerms, featureCombinations, featureCombinationIndexes,
+      modelFeatureCombinationTensors, k_cInstances, &binned[0], EBM_FALSE, k_cTopTerms, &topTermIndexes[0], &topContributions[0]);
+   CHECK(0 == ret);
+
+   for(size_t i = 0; i < k_cInstances; ++i) {
+      const size_t iBin0 = i % 4;
+      const size_t iBin1 = i * 5 % 3;
+      FloatEbmType magnitudes[k_cTerms];
+      for(size_t iTerm = 0; iTerm < k_cTerms; ++iTerm) {
+         magnitudes[iTerm] = 0;
+      }
+      for(size_t iClass = 0; iClass < static_cast<size_t>(k_countClasses); ++iClass) {
+         const FloatEbmType expected[k_cTerms] {
+            tensor0[iBin0 * k_countClasses + iClass],
+            tensor1[iBin1 * k_countClasses + iClass],
+            tensor2[(iBin0 + iBin1 * 4) * k_countClasses + iClass]
+         };
+         for(size_t iTerm = 0; iTerm < k_cTerms; ++iTerm) {
+            CHECK(expected[iTerm] == contributions[(i * k_cTerms + iTerm) * k_countClasses + iClass]);
+            magnitudes[iTerm] += std::abs(expected[iTerm]);
+         }
+      }
+
+      // the top terms come out sorted by magnitude, with ties going to the earlier term
+      std::vector<size_t> order { 0, 1, 2 };
+      std::stable_sort(order.begin(), order.end(), [&magnitudes](size_t a, size_t b) { return magnitudes[b] < magnitudes[a]; });
+      for(size_t iTop = 0; iTop < k_cTopTerms; ++iTop) {
+         CHECK(static_cast<IntEbmType>(order[iTop]) == topTermIndexes[i * k_cTopTerms + iTop]);
+         for(size_t iClass = 0; iClass < static_cast<size_t>(k_countClasses); ++iClass) {
+            CHECK(contributions[(i * k_cTerms + order[iTop]) * k_countClasses + iClass] == 
+               topContributions[(i * k_cTopTerms + iTop) * k_countClasses + iClass]);
+         }
+      }
+   }
+
+   // asking for more terms than we have fills the extra slots with -1
+   IntEbmType extraTermIndexes[4];
+   FloatEbmType extraContributions[4];
+   ret = GetTermContributionsRegression(2, features, 1, featureCombinations, featureCombinationIndexes, modelFeatureCombinationTensors, 
+      2, &binned[0], EBM_TRUE, 2, extraTermIndexes, extraContributions);
+   CHECK(0 == ret);
+   CHECK(0 == extraTermIndexes[0]);
+   CHECK(-1 == extraTermIndexes[1]);
+   CHECK(tensor0[0] == extraContributions[0]);
+   CHECK(0 == extraContributions[1]);
+   CHECK(0 == extraTermIndexes[2]);
+   CHECK(-1 == extraTermIndexes[3]);
+   CHECK(tensor0[2] == extraContributions[2]);
+}
+
+TEST_CASE("SaveModel then LoadModel scores the same as the original model, multiclass") {
+   constexpr IntEbmType k_countClasses = 3;
+   constexpr size_t k_cInstances = 100;
+   const FloatEbmType cutPoints0[] { -1, 0.5, 2 };
+   const FloatEbmType cutPoints1[] { 10, 20 };
+   const FloatEbmType * const cutPointsLowerBoundInclusive[] { cutPoints0, cutPoints1 };
+
+   EbmNativeFeature features[2];
+   features[0].featureType = FeatureTypeOrdinal;
+   features[0].hasMissing = EBM_TRUE;
+   features[0].countBins = 5;
+   features[1].featureType = FeatureTypeOrdinal;
+   features[1].hasMissing = EBM_FALSE;
+   features[1].countBins = 3;
+   EbmNativeFeatureCombination featureCombinations[2];
+   featureCombinations[0].countFeaturesInCombination = 1;
+   featureCombinations[1].countFeaturesInCombination = 2;
+   const IntEbmType featureCombinationIndexes[] { 0, 0, 1 };
+   std::vector<FloatEbmType> tensor0(5 * k_countClasses);
+   std::vector<FloatEbmType> tensor1(15 * k_countClasses);
+   for(size_t i = 0; i < tensor0.size(); ++i) {
+      tensor0[i] = static_cast<FloatEbmType>(i) * 0.1;
+   }
+   for(size_t i = 0; i < tensor1.size(); ++i) {
+      tensor1[i] = static_cast<FloatEbmType>(i % 7) * -0.05;
+   }
+   const FloatEbmType * modelFeatureCombinationTensors[] { &tensor0[0], &tensor1[0] };
+   const FloatEbmType intercept[] { 0.5, -0.25, 0.125 };
+
+   std::vector<FloatEbmType> raw(2 * k_cInstances);
+   for(size_t i = 0; i < k_cInstances; ++i) {
+      raw[i] = 0 == i % 9 ? std::numeric_limits<FloatEbmType>::quiet_NaN() : static_cast<FloatEbmType>(i % 11) * 0.5 - 2;
+      raw[k_cInstances + i] = static_cast<FloatEbmType>(i % 13) * 2.5;
+   }
+   std::vector<IntEbmType> binned(2 * k_cInstances);
+   Discretize(EBM_TRUE, 3, cutPoints0, k_cInstances, &raw[0], &binned[0]);
+   Discretize(EBM_FALSE, 2, cutPoints1, k_cInstances, &raw[k_cInstances], &binned[k_cInstances]);
+
+   std::vector<FloatEbmType> expected(k_countClasses * k_cInstances);
+   IntEbmType ret = ScoreInstancesClassification(k_countClasses, 2, features, 2, featureCombinations, featureCombinationIndexes,
+      modelFeatureCombinationTensors, intercept, k_cInstances, &binned[0], EBM_FALSE, EBM_TRUE, &expected[0]);
+   CHECK(0 == ret);
+
+   const char * const filePath = "ebm_native_test_model.ebm";
+   ret = SaveModelClassification(k_countClasses, 2, features, cutPointsLowerBoundInclusive, 2, featureCombinations, featureCombinationIndexes,
+      modelFeatureCombinationTensors, intercept, filePath);
+   CHECK(0 == ret);
+   PEbmModel ebmModel = LoadModel(filePath);
+   CHECK(nullptr != ebmModel);
+   if(nullptr != ebmModel) {
+      CHECK(k_countClasses == GetModelCountTargetClasses(ebmModel));
+      std::vector<FloatEbmType> actual(k_countClasses * k_cInstances);
+      ret = ScoreModelInstances(ebmModel, k_cInstances, &binned[0], EBM_FALSE, EBM_TRUE, &actual[0]);
+      CHECK(0 == ret);
+      for(size_t i = 0; i < actual.size(); ++i) {
+         CHECK(expected[i] == actual[i]);
+      }
+      ret = ScoreModelRawInstances(ebmModel, k_cInstances, &raw[0], EBM_FALSE, EBM_TRUE, &actual[0]);
+      CHECK(0 == ret);
+      for(size_t i = 0; i < actual.size(); ++i) {
+         CHECK(expected[i] == actual[i]);
+      }
+      FreeModel(ebmModel);
+   }
+
+   // without cut points we can still score binned data, but not raw data
+   ret = SaveModelRegression(2, features, nullptr, 2, featureCombinations, featureCombinationIndexes, modelFeatureCombinationTensors, 
+      nullptr, filePath);
+   CHECK(0 == ret);
+   ebmModel = LoadModel(filePath);
+   CHECK(nullptr != ebmModel);
+   if(nullptr != ebmModel) {
+      CHECK(-1 == GetModelCountTargetClasses(ebmModel));
+      std::vector<FloatEbmType> scores(k_cInstances);
+      ret = ScoreModelInstances(ebmModel, k_cInstances, &binned[0], EBM_FALSE, EBM_FALSE, &scores[0]);
+      CHECK(0 == ret);
+      for(size_t i = 0; i < k_cInstances; ++i) {
+         const size_t iBin0 = static_cast<size_t>(binned[i]);
+         const size_t iBin1 = static_cast<size_t>(binned[k_cInstances + i]);
+         CHECK_APPROX(scores[i], tensor0[iBin0] + tensor1[iBin0 + iBin1 * 5]);
+      }
+      ret = ScoreModelRawInstances(ebmModel, k_cInstances, &raw[0], EBM_FALSE, EBM_FALSE, &scores[0]);
+      CHECK(0 != ret);
+      FreeModel(ebmModel);
+   }
+
+   // a truncated file is rejected
+   FILE * pFile = fopen(filePath, "wb");
+   CHECK(nullptr != pFile);
+   if(nullptr != pFile) {
+      fwrite("EBMMODL", 1, 8, pFile);
+      fclose(pFile);
+   }
+   CHECK(nullptr == LoadModel(filePath));
+   remove(filePath);
+   CHECK(nullptr == LoadModel(filePath));
+}
+
+TEST_CASE("SaveModel and LoadModel reject unordered cut points, empty tensors and missing arrays, regression") {
+   const FloatEbmType cutPoints0[] { -1, 0.5, 2 };
+   const FloatEbmType cutPointsUnordered[] { -1, 2, 0.5 };
+   const FloatEbmType * const cutPointsLowerBoundInclusive[] { cutPoints0 };
+   const FloatEbmType * const cutPointsLowerBoundInclusiveUnordered[] { cutPointsUnordered };
+
+   EbmNativeFeature features[1];
+   features[0].featureType = FeatureTypeOrdinal;
+   features[0].hasMissing = EBM_FALSE;
+   features[0].countBins = 4;
+   EbmNativeFeatureCombination featureCombinations[1];
+   featureCombinations[0].countFeaturesInCombination = 1;
+   const IntEbmType featureCombinationIndexes[] { 0 };
+   const FloatEbmType tensor0[] { 1, 2, 3, 4 };
+   const FloatEbmType * modelFeatureCombinationTensors[] { tensor0 };
+
+   const char * const filePath = "ebm_native_test_model.ebm";
+
+   // bad arguments are runtime errors on save
+   CHECK(0 != SaveModelRegression(1, features, cutPointsLowerBoundInclusiveUnordered, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, filePath));
+   CHECK(0 != SaveModelRegression(1, nullptr, cutPointsLowerBoundInclusive, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, filePath));
+   CHECK(0 != SaveModelRegression(-1, features, cutPointsLowerBoundInclusive, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, filePath));
+   CHECK(0 != SaveModelRegression(1, features, cutPointsLowerBoundInclusive, 1, featureCombinations, nullptr, 
+      modelFeatureCombinationTensors, nullptr, filePath));
+   CHECK(0 != SaveModelRegression(1, features, cutPointsLowerBoundInclusive, 1, featureCombinations, featureCombinationIndexes, 
+      nullptr, nullptr, filePath));
+
+   CHECK(0 == SaveModelRegression(1, features, cutPointsLowerBoundInclusive, 1, featureCombinations, featureCombinationIndexes, 
+      modelFeatureCombinationTensors, nullptr, filePath));
+   std::vector<unsigned char> file;
+   FILE * pFile = fopen(filePath, "rb");
+   CHECK(nullptr != pFile);
+   if(nullptr != pFile) {
+      int byte;
+      while(EOF != (byte = fgetc(pFile))) {
+         file.push_back(static_cast<unsigned char>(byte));
+      }
+      fclose(pFile);
+   }
+   PEbmModel ebmModel = LoadModel(filePath);
+   CHECK(nullptr != ebmModel);
+   FreeModel(ebmModel);
+
+   // we patch copies of a good file, finding our arrays by their contents since the layout is private to the model file code
+   const auto findBytes = [&file](const void * const pBytes, const size_t cBytes) {
+      const unsigned char * const pBegin = static_cast<const unsigned char *>(pBytes);
+      return std::search(file.begin(), file.end(), pBegin, pBegin + cBytes) - file.begin();
+   };
+   const auto loadPatched = [&](const std::vector<unsigned char> & patched) {
+      FILE * const pFilePatched = fopen(filePath, "wb");
+      CHECK(nullptr != pFilePatched);
+      if(nullptr != pFilePatched) {
+         fwrite(&patched[0], 1, patched.size(), pFilePatched);
+         fclose(pFilePatched);
+      }
+      PEbmModel ebmModelPatched = LoadModel(filePath);
+      const bool bLoaded = nullptr != ebmModelPatched;
+      FreeModel(ebmModelPatched);
+      return bLoaded;
+   };
+   CHECK(loadPatched(file));
+
+   const ptrdiff_t iCutPoints = findBytes(cutPoints0, sizeof(cutPoints0));
+   CHECK(static_cast<size_t>(iCutPoints) < file.size());
+   if(static_cast<size_t>(iCutPoints) < file.size()) {
+      std::vector<unsigned char> patched(file);
+      memcpy(&patched[iCutPoints], cutPointsUnordered, sizeof(cutPointsUnordered));
+      CHECK(!loadPatched(patched));
+   }
+
+   const ptrdiff_t iFeatures = findBytes(features, sizeof(features));
+   CHECK(static_cast<size_t>(iFeatures) < file.size());
+   if(static_cast<size_t>(iFeatures) < file.size()) {
+      EbmNativeFeature featuresEmpty[1];
+      memcpy(featuresEmpty, features, sizeof(features));
+      featuresEmpty[0].countBins = 0;
+      std::vector<unsigned char> patched(file);
+      memcpy(&patched[iFeatures], featuresEmpty, sizeof(featuresEmpty));
+      CHECK(!loadPatched(patched));
+   }
+   remove(filePath);
+}
+
+TEST_CASE("weighted instances boost the same as duplicated instances, multiclass") {
+   // a weight of k on an instance should be equivalent to k copies of that instance, for both the model and the validation metric
+   const WeightedMulticlassInstances data;
+
+   std::vector<ClassificationInstance> trainingDuplicated;
+   for(size_t i = 0; i < data.m_training.size(); ++i) {
+      for(size_t iCopy = 0; iCopy < static_cast<size_t>(data.m_trainingWeights[i]); ++iCopy) {
+         trainingDuplicated.push_back(data.m_training[i]);
+      }
+   }
+   std::vector<ClassificationInstance> validationDuplicated;
+   for(size_t i = 0; i < data.m_validation.size(); ++i) {
+      for(size_t iCopy = 0; iCopy < static_cast<size_t>(data.m_validationWeights[i]); ++iCopy) {
+         validationDuplicated.push_back(data.m_validation[i]);
+      }
+   }
+
+   TestApi testWeighted = TestApi(3);
+   testWeighted.AddFeatures(data.m_features);
+   testWeighted.AddFeatureCombinations({ { 0 }, { 1 }, { 0, 1 } });
+   testWeighted.AddTrainingInstances(data.m_training);
+   testWeighted.AddValidationInstances(data.m_validation);
+   testWeighted.InitializeBoosting();
+
+   TestApi testDuplicated = TestApi(3);
+   testDuplicated.AddFeatures(data.m_features);
+   testDuplicated.AddFeatureCombinations({ { 0 }, { 1 }, { 0, 1 } });
+   testDuplicated.AddTrainingInstances(trainingDuplicated);
+   testDuplicated.AddValidationInstances(validationDuplicated);
+   testDuplicated.InitializeBoosting();
+
+   for(int iEpoch = 0; iEpoch < 100; ++iEpoch) {
+      for(size_t iFeatureCombination = 0; iFeatureCombination < testWeighted.GetFeatureCombinationsCount(); ++iFeatureCombination) {
+         const FloatEbmType validationMetricWeighted = testWeighted.Boost(iFeatureCombination, data.m_trainingWeights, data.m_validationWeights);
+         const FloatEbmType validationMetricDuplicated = testDuplicated.Boost(iFeatureCombination);
+         CHECK_APPROX(validationMetricWeighted, validationMetricDuplicated);
+      }
+   }
+   for(size_t iBin0 = 0; iBin0 < 3; ++iBin0) {
+      for(size_t iBin1 = 0; iBin1 < 2; ++iBin1) {
+         for(size_t iScore = 0; iScore < 3; ++iScore) {
+            CHECK_APPROX(testWeighted.GetCurrentModelPredictorScore(2, { iBin0, iBin1 }, iScore), 
+               testDuplicated.GetCurrentModelPredictorScore(2, { iBin0, iBin1 }, iScore));
+         }
+      }
+   }
+}
+
+TEST_CASE("gradient one side sampling that keeps every instance boosts the same as no sampling, multiclass") {
+   const WeightedMulticlassInstances data;
+
+   TestApi testGradientOneSide = TestApi(3);
+   testGradientOneSide.AddFeatures(data.m_features);
+   testGradientOneSide.AddFeatureCombinations({ { 0 }, { 1 }, { 0, 1 } });
+   testGradientOneSide.AddTrainingInstances(data.m_training);
+   testGradientOneSide.AddValidationInstances(data.m_validation);
+   testGradientOneSide.InitializeBoosting(0, { 2, 1, 0 });
+
+   TestApi testFlat = TestApi(3);
+   testFlat.AddFeatures(data.m_features);
+   testFlat.AddFeatureCombinations({ { 0 }, { 1 }, { 0, 1 } });
+   testFlat.AddTrainingInstances(data.m_training);
+   testFlat.AddValidationInstances(data.m_validation);
+   testFlat.InitializeBoosting(0);
+
+   for(int iEpoch = 0; iEpoch < 100; ++iEpoch) {
+      for(size_t iFeatureCombination = 0; iFeatureCombination < testGradientOneSide.GetFeatureCombinationsCount(); ++iFeatureCombination) {
+         const FloatEbmType validationMetricGradientOneSide = testGradientOneSide.Boost(iFeatureCombination);
+         const FloatEbmType validationMetricFlat = testFlat.Boost(iFeatureCombination);
+         CHECK_APPROX(validationMetricGradientOneSide, validationMetricFlat);
+      }
+   }
+   for(size_t iBin0 = 0; iBin0 < 3; ++iBin0) {
+      for(size_t iBin1 = 0; iBin1 < 2; ++iBin1) {
+         for(size_t iScore = 0; iScore < 3; ++iScore) {
+            CHECK_APPROX(testGradientOneSide.GetCurrentModelPredictorScore(2, { iBin0, iBin1 }, iScore), 
+               testFlat.GetCurrentModelPredictorScore(2, { iBin0, iBin1 }, iScore));
+         }
+      }
+   }
+}
+
+TEST_CASE("gradient one side sampling improves the validation metric, regression") {
+   std::vector<RegressionInstance> training;
+   std::vector<RegressionInstance> validation;
+   AddGridRegressionInstances(&training, &validation);
+
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(5), FeatureTest(4) });
+   test.AddFeatureCombinations({ {}, { 0 }, { 1 }, { 0, 1 } });
+   test.AddTrainingInstances(training);
+   test.AddValidationInstances(validation);
+   test.InitializeBoosting(2, { 2, 0.2, 0.3 });
+
+   FloatEbmType validationMetricFirst = FloatEbmType { 0 };
+   FloatEbmType validationMetric = FloatEbmType { 0 };
+   for(int iEpoch = 0; iEpoch < 200; ++iEpoch) {
+      for(size_t iFeatureCombination = 0; iFeatureCombination < test.GetFeatureCombinationsCount(); ++iFeatureCombination) {
+         validationMetric = test.Boost(iFeatureCombination);
+         if(0 == iEpoch && 0 == iFeatureCombination) {
+            validationMetricFirst = validationMetric;
+         }
+      }
+   }
+   CHECK(validationMetric < validationMetricFirst * FloatEbmType { 0.05 });
+}
+
+TEST_CASE("inner bags that subsample every instance boost the same as no inner bags, weighted multiclass") {
+   const WeightedMulticlassInstances data;
+
+   TestApi testSubsample = TestApi(3);
+   testSubsample.AddFeatures(data.m_features);
+   testSubsample.AddFeatureCombinations({ {}, { 0 }, { 1 }, { 0, 1 } });
+   testSubsample.AddTrainingInstances(data.m_training);
+   testSubsample.AddValidationInstances(data.m_validation);
+   testSubsample.InitializeBoosting(3, { 3, 0, 0, 1 });
+
+   TestApi testFlat = TestApi(3);
+   testFlat.AddFeatures(data.m_features);
+   testFlat.AddFeatureCombinations({ {}, { 0 }, { 1 }, { 0, 1 } });
+   testFlat.AddTrainingInstances(data.m_training);
+   testFlat.AddValidationInstances(data.m_validation);
+   testFlat.InitializeBoosting(0);
+
+   for(int iEpoch = 0; iEpoch < 100; ++iEpoch) {
+      for(size_t iFeatureCombination = 0; iFeatureCombination < testSubsample.GetFeatureCombinationsCount(); ++iFeatureCombination) {
+         const FloatEbmType validationMetricSubsample = testSubsample.Boost(iFeatureCombination, data.m_trainingWeights, data.m_validationWeights);
+         const FloatEbmType validationMetricFlat = testFlat.Boost(iFeatureCombination, data.m_trainingWeights, data.m_validationWeights);
+         CHECK_APPROX(validationMetricSubsample, validationMetricFlat);
+      }
+   }
+   for(size_t iBin0 = 0; iBin0 < 3; ++iBin0) {
+      for(size_t iBin1 = 0; iBin1 < 2; ++iBin1) {
+         for(size_t iScore = 0; iScore < 3; ++iScore) {
+            CHECK_APPROX(testSubsample.GetCurrentModelPredictorScore(3, { iBin0, iBin1 }, iScore), 
+               testFlat.GetCurrentModelPredictorScore(3, { iBin0, iBin1 }, iScore));
+         }
+      }
+   }
+}
+
+TEST_CASE("inner bags that subsample half of the instances improve the validation metric, regression") {
+   std::vector<RegressionInstance> training;
+   std::vector<RegressionInstance> validation;
+   AddGridRegressionInstances(&training, &validation);
+
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(5), FeatureTest(4) });
+   test.AddFeatureCombinations({ {}, { 0 }, { 1 }, { 0, 1 } });
+   test.AddTrainingInstances(training);
+   test.AddValidationInstances(validation);
+   test.InitializeBoosting(2, { 3, 0, 0, 0.5 });
+
+   FloatEbmType validationMetricFirst = FloatEbmType { 0 };
+   FloatEbmType validationMetric = FloatEbmType { 0 };
+   for(int iEpoch = 0; iEpoch < 200; ++iEpoch) {
+      for(size_t iFeatureCombination = 0; iFeatureCombination < test.GetFeatureCombinationsCount(); ++iFeatureCombination) {
+         validationMetric = test.Boost(iFeatureCombination);
+         if(0 == iEpoch && 0 == iFeatureCombination) {
+            validationMetricFirst = validationMetric;
+         }
+      }
+   }
+   CHECK(validationMetric < validationMetricFirst * FloatEbmType { 0.05 });
+}
+
+TEST_CASE("GenerateTrainValidationSplit is stratified and deterministic, multiclass") {
+   constexpr size_t k_cInstances = 20;
+   IntEbmType targets[k_cInstances];
+   for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+      // 10 instances of class 0, 6 of class 1 and 4 of class 2, interleaved
+      targets[iInstance] = iInstance < 10 ? 0 : iInstance < 16 ? 1 : 2;
+   }
+   std::reverse(targets + 5, targets + k_cInstances);
+
+   IntEbmType isValidation1[k_cInstances];
+   IntEbmType ret = GenerateTrainValidationSplit(randomSeed, 3, k_cInstances, targets, 0.25, isValidation1);
+   CHECK(0 == ret);
+   size_t cValidation[3] { 0, 0, 0 };
+   for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+      CHECK((0 == isValidation1[iInstance] || 1 == isValidation1[iInstance]));
+      cValidation[static_cast<size_t>(targets[iInstance])] += static_cast<size_t>(isValidation1[iInstance]);
+   }
+   // 5 validation instances: class 0 gets 2.5, class 1 gets 1.5 and class 2 gets 1, and the remainder tie goes to the lowest class
+   CHECK(3 == cValidation[0]);
+   CHECK(1 == cValidation[1]);
+   CHECK(1 == cValidation[2]);
+
+   IntEbmType isValidation2[k_cInstances];
+   ret = GenerateTrainValidationSplit(randomSeed, 3, k_cInstances, targets, 0.25, isValidation2);
+   CHECK(0 == ret);
+   for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+      CHECK(isValidation1[iInstance] == isValidation2[iInstance]);
+   }
+
+   // out of range targets and fractions are errors
+   targets[0] = 3;
+   ret = GenerateTrainValidationSplit(randomSeed, 3, k_cInstances, targets, 0.25, isValidation2);
+   CHECK(0 != ret);
+   ret = GenerateTrainValidationSplit(randomSeed, 0, k_cInstances, nullptr, 1.5, isValidation2);
+   CHECK(0 != ret);
+}
+
+TEST_CASE("InitializeBoostingClassificationSplit boosts the same as splitting the data ourselves, binary") {
+   constexpr size_t k_cInstances = 40;
+   constexpr FloatEbmType k_validationFraction = 0.25;
+   EbmNativeFeature features[1];
+   features[0].featureType = FeatureTypeOrdinal;
+   features[0].hasMissing = EBM_FALSE;
+   features[0].countBins = 4;
+   EbmNativeFeatureCombination featureCombinations[1];
+   featureCombinations[0].countFeaturesInCombination = 1;
+   const IntEbmType featureCombinationIndexes[] { 0 };
+
+   IntEbmType binnedData[k_cInstances];
+   IntEbmType targets[k_cInstances];
+   FloatEbmType predictorScores[k_cInstances];
+   for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+      binnedData[iInstance] = static_cast<IntEbmType>(iInstance % 4);
+      targets[iInstance] = static_cast<IntEbmType>((iInstance * 7 + iInstance / 4) % 3 == 0 ? 1 : 0);
+      predictorScores[iInstance] = static_cast<FloatEbmType>(iInstance % 5) * FloatEbmType { 0.1 };
+   }
+
+   IntEbmType isValidation[k_cInstances];
+   IntEbmType ret = GenerateTrainValidationSplit(randomSeed, 2, k_cInstances, targets, k_validationFraction, isValidation);
+   CHECK(0 == ret);
+
+   std::vector<IntEbmType> trainingBinnedData;
+   std::vector<IntEbmType> trainingTargets;
+   std::vector<FloatEbmType> trainingPredictorScores;
+   std::vector<IntEbmType> validationBinnedData;
+   std::vector<IntEbmType> validationTargets;
+   std::vector<FloatEbmType> validationPredictorScores;
+   for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+      if(0 == isValidation[iInstance]) {
+         trainingBinnedData.push_back(binnedData[iInstance]);
+         trainingTargets.push_back(targets[iInstance]);
+         trainingPredictorScores.push_back(predictorScores[iInstance]);
+      } else {
+         validationBinnedData.push_back(binnedData[iInstance]);
+         validationTargets.push_back(targets[iInstance]);
+         validationPredictorScores.push_back(predictorScores[iInstance]);
+      }
+   }
+   CHECK(10 == validationTargets.size());
+
+   PEbmBoosting pEbmBoostingManual = InitializeBoostingClassification(
+      2,
+      1,
+      features,
+      1,
+      featureCombinations,
+      featureCombinationIndexes,
+      static_cast<IntEbmType>(trainingTargets.size()),
+      &trainingBinnedData[0],
+      &trainingTargets[0],
+      &trainingPredictorScores[0],
+      static_cast<IntEbmType>(validationTargets.size()),
+      &validationBinnedData[0],
+      &validationTargets[0],
+      &validationPredictorScores[0],
+      2,
+      randomSeed,
+      nullptr
+   );
+   PEbmBoosting pEbmBoostingSplit = InitializeBoostingClassificationSplit(
+      2,
+      1,
+      features,
+      1,
+      featureCombinations,
+      featureCombinationIndexes,
+      k_cInstances,
+      binnedData,
+      targets,
+      predictorScores,
+      k_validationFraction,
+      2,
+      randomSeed,
+      nullptr
+   );
+   CHECK(nullptr != pEbmBoostingManual);
+   CHECK(nullptr != pEbmBoostingSplit);
+
+   for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+      FloatEbmType validationMetricManual = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+      FloatEbmType validationMetricSplit = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+      ret = BoostingStep(pEbmBoostingManual, 0, k_learningRateDefault, k_countTreeSplitsMaxDefault, 
+         k_countInstancesRequiredForParentSplitMinDefault, nullptr, nullptr, &validationMetricManual);
+      CHECK(0 == ret);
+      ret = BoostingStep(pEbmBoostingSplit, 0, k_learningRateDefault, k_countTreeSplitsMaxDefault, 
+         k_countInstancesRequiredForParentSplitMinDefault, nullptr, nullptr, &validationMetricSplit);
+      CHECK(0 == ret);
+      CHECK(validationMetricManual == validationMetricSplit);
+   }
+
+   const FloatEbmType * const aModelManual = GetCurrentModelFeatureCombination(pEbmBoostingManual, 0);
+   const FloatEbmType * const aModelSplit = GetCurrentModelFeatureCombination(pEbmBoostingSplit, 0);
+   for(size_t iBin = 0; iBin < 4; ++iBin) {
+      CHECK(aModelManual[iBin] == aModelSplit[iBin]);
+   }
+
+   FreeBoosting(pEbmBoostingManual);
+   FreeBoosting(pEbmBoostingSplit);
+}
+
+TEST_CASE("shared dataset boosts and detects interactions the same as the pointer based API, binary") {
+   constexpr size_t k_cInstances = 24;
+   constexpr size_t k_cFeatures = 2;
+   EbmNativeFeature features[k_cFeatures];
+   features[0].featureType = FeatureTypeOrdinal;
+   features[0].hasMissing = EBM_FALSE;
+   features[0].countBins = 3;
+   features[1].featureType = FeatureTypeOrdinal;
+   features[1].hasMissing = EBM_FALSE;
+   features[1].countBins = 4;
+   EbmNativeFeatureCombination featureCombinations[2];
+   featureCombinations[0].countFeaturesInCombination = 1;
+   featureCombinations[1].countFeaturesInCombination = 2;
+   const IntEbmType featureCombinationIndexes[] { 0, 0, 1 };
+
+   // feature major, just like the binned data of InitializeBoostingClassification
+   IntEbmType binnedData[k_cFeatures * k_cInstances];
+   IntEbmType targets[k_cInstances];
+   FloatEbmType predictorScores[k_cInstances];
+   for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+      binnedData[iInstance] = static_cast<IntEbmType>(iInstance % 3);
+      binnedData[k_cInstances + iInstance] = static_cast<IntEbmType>((iInstance / 3) % 4);
+      targets[iInstance] = static_cast<IntEbmType>((iInstance % 3 + iInstance / 6) % 2);
+      predictorScores[iInstance] = static_cast<FloatEbmType>(iInstance % 5) * FloatEbmType { 0.1 };
+   }
+
+   const IntEbmType cBytes = SizeDataSetHeader(k_cFeatures) + SizeFeature(3, k_cInstances) + SizeFeature(4, k_cInstances) + 
+      SizeClassificationTarget(2, k_cInstances);
+   CHECK(0 < cBytes);
+   std::vector<IntEbmType> sharedMemory(static_cast<size_t>(cBytes) / sizeof(IntEbmType));
+   unsigned char * const pShared = reinterpret_cast<unsigned char *>(&sharedMemory[0]);
+
+   IntEbmType ret = FillDataSetHeader(k_cFeatures, k_cInstances, cBytes, pShared);
+   CHECK(0 == ret);
+   // the targets go last, after every feature
+   ret = FillClassificationTarget(2, k_cInstances, targets, cBytes, pShared);
+   CHECK(0 != ret);
+   ret = FillFeature(FeatureTypeOrdinal, EBM_FALSE, 3, k_cInstances, &binnedData[0], cBytes, pShared);
+   CHECK(0 == ret);
+   CHECK(nullptr == InitializeInteractionFromDataSet(pShared, nullptr, nullptr, nullptr));
+   ret = FillFeature(FeatureTypeOrdinal, EBM_FALSE, 4, k_cInstances, &binnedData[k_cInstances], cBytes, pShared);
+   CHECK(0 == ret);
+   ret = FillClassificationTarget(2, k_cInstances, targets, cBytes, pShared);
+   CHECK(0 == ret);
+   // the dataset is read only once it's complete
+   ret = FillClassificationTarget(2, k_cInstances, targets, cBytes, pShared);
+   CHECK(0 != ret);
+
+   IntEbmType isValidation[k_cInstances];
+   ret = GenerateTrainValidationSplit(randomSeed, 2, k_cInstances, targets, 0.25, isValidation);
+   CHECK(0 == ret);
+
+   std::vector<IntEbmType> trainingBinnedData;
+   std::vector<IntEbmType> trainingTargets;
+   std::vector<FloatEbmType> trainingPredictorScores;
+   std::vector<IntEbmType> validationBinnedData;
+   std::vector<IntEbmType> validationTargets;
+   std::vector<FloatEbmType> validationPredictorScores;
+   for(size_t iFeature = 0; iFeature < k_cFeatures; ++iFeature) {
+      for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+         if(0 == isValidation[iInstance]) {
+            trainingBinnedData.push_back(binnedData[iFeature * k_cInstances + iInstance]);
+         } else {
+            validationBinnedData.push_back(binnedData[iFeature * k_cInstances + iInstance]);
+         }
+      }
+   }
+   for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+      if(0 == isValidation[iInstance]) {
+         trainingTargets.push_back(targets[iInstance]);
+         trainingPredictorScores.push_back(predictorScores[iInstance]);
+      } else {
+         validationTargets.push_back(targets[iInstance]);
+         validationPredictorScores.push_back(predictorScores[iInstance]);
+      }
+   }
+
+   PEbmBoosting pEbmBoostingManual = InitializeBoostingClassification(
+      2,
+      k_cFeatures,
+      features,
+      2,
+      featureCombinations,
+      featureCombinationIndexes,
+      static_cast<IntEbmType>(trainingTargets.size()),
+      &trainingBinnedData[0],
+      &trainingTargets[0],
+      &trainingPredictorScores[0],
+      static_cast<IntEbmType>(validationTargets.size()),
+      &validationBinnedData[0],
+      &validationTargets[0],
+      &validationPredictorScores[0],
+      0,
+      randomSeed,
+      nullptr
+   );
+   PEbmBoosting pEbmBoostingShared = InitializeBoostingFromDataSet(
+      pShared,
+      isValidation,
+      2,
+      featureCombinations,
+      featureCombinationIndexes,
+      predictorScores,
+      0,
+      randomSeed,
+      nullptr
+   );
+   CHECK(nullptr != pEbmBoostingManual);
+   CHECK(nullptr != pEbmBoostingShared);
+   for(int iEpoch = 0; iEpoch < 5; ++iEpoch) {
+      for(IntEbmType iFeatureCombination = 0; iFeatureCombination < 2; ++iFeatureCombination) {
+         FloatEbmType validationMetricManual = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+         FloatEbmType validationMetricShared = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+         ret = BoostingStep(pEbmBoostingManual, iFeatureCombination, k_learningRateDefault, k_countTreeSplitsMaxDefault, 
+            k_countInstancesRequiredForParentSplitMinDefault, nullptr, nullptr, &validationMetricManual);
+         CHECK(0 == ret);
+         ret = BoostingStep(pEbmBoostingShared, iFeatureCombination, k_learningRateDefault, k_countTreeSplitsMaxDefault, 
+            k_countInstancesRequiredForParentSplitMinDefault, nullptr, nullptr, &validationMetricShared);
+         CHECK(0 == ret);
+         CHECK(validationMetricManual == validationMetricShared);
+      }
+   }
+   FreeBoosting(pEbmBoostingManual);
+   FreeBoosting(pEbmBoostingShared);
+
+   PEbmInteraction pEbmInteractionManual = InitializeInteractionClassification(
+      2,
+      k_cFeatures,
+      features,
+      static_cast<IntEbmType>(trainingTargets.size()),
+      &trainingBinnedData[0],
+      &trainingTargets[0],
+      &trainingPredictorScores[0],
+      nullptr
+   );
+   PEbmInteraction pEbmInteractionShared = InitializeInteractionFromDataSet(pShared, isValidation, predictorScores, nullptr);
+   CHECK(nullptr != pEbmInteractionManual);
+   CHECK(nullptr != pEbmInteractionShared);
+   const IntEbmType featureIndexes[] { 0, 1 };
+   FloatEbmType interactionScoreManual = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+   FloatEbmType interactionScoreShared = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+   ret = GetInteractionScore(pEbmInteractionManual, 2, featureIndexes, &interactionScoreManual);
+   CHECK(0 == ret);
+   ret = GetInteractionScore(pEbmInteractionShared, 2, featureIndexes, &interactionScoreShared);
+   CHECK(0 == ret);
+   CHECK(interactionScoreManual == interactionScoreShared);
+   FreeInteraction(pEbmInteractionManual);
+   FreeInteraction(pEbmInteractionShared);
+}
+
+TEST_CASE("shared dataset rejects bad fills, regression") {
+   constexpr size_t k_cInstances = 4;
+   const IntEbmType binnedData[k_cInstances] { 0, 1, 2, 1 };
+   const IntEbmType binnedDataBad[k_cInstances] { 0, 1, 3, 1 };
+   const FloatEbmType targets[k_cInstances] { 1.5, -2, 0, 3 };
+
+   const IntEbmType cBytes = SizeDataSetHeader(1) + SizeFeature(3, k_cInstances) + SizeRegressionTarget(k_cInstances);
+   CHECK(0 < cBytes);
+   CHECK(SizeDataSetHeader(-1) < 0);
+   std::vector<IntEbmType> sharedMemory(static_cast<size_t>(cBytes) / sizeof(IntEbmType));
+   unsigned char * const pShared = reinterpret_cast<unsigned char *>(&sharedMemory[0]);
+
+   // too little memory for what the header describes
+   IntEbmType ret = FillDataSetHeader(1, k_cInstances, cBytes - 1, pShared);
+   CHECK(0 != ret);
+   ret = FillDataSetHeader(1, k_cInstances, cBytes, pShared);
+   CHECK(0 == ret);
+   ret = FillFeature(FeatureTypeOrdinal, EBM_FALSE, 3, k_cInstances, binnedDataBad, cBytes, pShared);
+   CHECK(0 != ret);
+   ret = FillFeature(FeatureTypeOrdinal, EBM_FALSE, 3, k_cInstances - 1, binnedData, cBytes, pShared);
+   CHECK(0 != ret);
+   ret = FillFeature(FeatureTypeOrdinal, EBM_FALSE, 3, k_cInstances, binnedData, cBytes + 1, pShared);
+   CHECK(0 != ret);
+   // too little memory to even hold the header
+   ret = FillFeature(FeatureTypeOrdinal, EBM_FALSE, 3, k_cInstances, binnedData, IntEbmType { 8 }, pShared);
+   CHECK(0 != ret);
+   ret = FillFeature(FeatureTypeOrdinal, EBM_FALSE, 3, k_cInstances, binnedData, cBytes, pShared);
+   CHECK(0 == ret);
+   ret = FillFeature(FeatureTypeOrdinal, EBM_FALSE, 3, k_cInstances, binnedData, cBytes, pShared);
+   CHECK(0 != ret);
+   ret = FillRegressionTarget(k_cInstances, targets, cBytes, pShared);
+   CHECK(0 == ret);
+
+   EbmNativeFeatureCombination featureCombinations[1];
+   featureCombinations[0].countFeaturesInCombination = 1;
+   const IntEbmType featureCombinationIndexes[] { 0 };
+   PEbmBoosting pEbmBoosting = InitializeBoostingFromDataSet(pShared, nullptr, 1, featureCombinations, featureCombinationIndexes, 
+      nullptr, 0, randomSeed, nullptr);
+   CHECK(nullptr != pEbmBoosting);
+   FloatEbmType validationMetric = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+   ret = BoostingStep(pEbmBoosting, 0, k_learningRateDefault, k_countTreeSplitsMaxDefault, k_countInstancesRequiredForParentSplitMinDefault, 
+      nullptr, nullptr, &validationMetric);
+   CHECK(0 == ret);
+   FreeBoosting(pEbmBoosting);
+
+   // the header is the first 9 values of our memory, and the 8th is the offset of the binned data.  If that is modified after filling, then 
+   // reading through it would go past the end of our memory
+   const IntEbmType offsetBinnedData = sharedMemory[7];
+   sharedMemory[7] = cBytes;
+   pEbmBoosting = InitializeBoostingFromDataSet(pShared, nullptr, 1, featureCombinations, featureCombinationIndexes, 
+      nullptr, 0, randomSeed, nullptr);
+   CHECK(nullptr == pEbmBoosting);
+   sharedMemory[7] = offsetBinnedData;
+   // the stored size is smaller than the parts it describes
+   sharedMemory[1] = cBytes - IntEbmType { 8 };
+   pEbmBoosting = InitializeBoostingFromDataSet(pShared, nullptr, 1, featureCombinations, featureCombinationIndexes, 
+      nullptr, 0, randomSeed, nullptr);
+   CHECK(nullptr == pEbmBoosting);
+}
+
+TEST_CASE("inner bags binned together boost zero, one and two dimensional combinations, multiclass") {
+   constexpr size_t k_cInstances = 30;
+   constexpr size_t k_cFeatures = 2;
+   constexpr IntEbmType k_cInnerBags = 3;
+   EbmNativeFeature features[k_cFeatures];
+   features[0].featureType = FeatureTypeOrdinal;
+   features[0].hasMissing = EBM_FALSE;
+   features[0].countBins = 3;
+   features[1].featureType = FeatureTypeOrdinal;
+   features[1].hasMissing = EBM_FALSE;
+   features[1].countBins = 5;
+   EbmNativeFeatureCombination featureCombinations[3];
+   featureCombinations[0].countFeaturesInCombination = 0;
+   featureCombinations[1].countFeaturesInCombination = 1;
+   featureCombinations[2].countFeaturesInCombination = 2;
+   const IntEbmType featureCombinationIndexes[] { 1, 0, 1 };
+
+   IntEbmType binnedData[k_cFeatures * k_cInstances];
+   IntEbmType targets[k_cInstances];
+   FloatEbmType predictorScores[3 * k_cInstances];
+   for(size_t iScore = 0; iScore < 3 * k_cInstances; ++iScore) {
+      predictorScores[iScore] = FloatEbmType { 0 };
+   }
+   for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+      binnedData[iInstance] = static_cast<IntEbmType>(iInstance % 3);
+      binnedData[k_cInstances + iInstance] = static_cast<IntEbmType>((iInstance * 7) % 5);
+      targets[iInstance] = static_cast<IntEbmType>((iInstance % 3 + iInstance / 5) % 3);
+   }
+
+   // our first booster bins all of its inner bags together, and our second bins each inner bag separately
+   const FloatEbmType tempParamsBinSeparately[] { 7, 0, 0, 0, 0, 0, 0, 1 };
+   const FloatEbmType * const aOptionalTempParams[2] { nullptr, tempParamsBinSeparately };
+   PEbmBoosting apEbmBoosting[2];
+   for(size_t iBoosting = 0; iBoosting < 2; ++iBoosting) {
+      apEbmBoosting[iBoosting] = InitializeBoostingClassification(
+         3,
+         k_cFeatures,
+         features,
+         3,
+         featureCombinations,
+         featureCombinationIndexes,
+         k_cInstances,
+         binnedData,
+         targets,
+         predictorScores,
+         k_cInstances,
+         binnedData,
+         targets,
+         predictorScores,
+         k_cInnerBags,
+         randomSeed,
+         aOptionalTempParams[iBoosting]
+      );
+      CHECK(nullptr != apEbmBoosting[iBoosting]);
+   }
+
+   FloatEbmType validationMetricFirst = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+   FloatEbmType validationMetricLast = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+   for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+      for(IntEbmType iFeatureCombination = 0; iFeatureCombination < 3; ++iFeatureCombination) {
+         FloatEbmType validationMetrics[2];
+         for(size_t iBoosting = 0; iBoosting < 2; ++iBoosting) {
+            validationMetrics[iBoosting] = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+            const IntEbmType ret = BoostingStep(apEbmBoosting[iBoosting], iFeatureCombination, k_learningRateDefault, 
+               k_countTreeSplitsMaxDefault, k_countInstancesRequiredForParentSplitMinDefault, nullptr, nullptr, &validationMetrics[iBoosting]);
+            CHECK(0 == ret);
+         }
+         // our inner bags are a function of our random seed only, and both ways of binning add the same values in the same order.  The 
+         // compiler can still contract or reorder the two loops differently under -ffast-math, so we allow for rounding
+         CHECK_APPROX(validationMetrics[0], validationMetrics[1]);
+         if(0 == iEpoch && 0 == iFeatureCombination) {
+            validationMetricFirst = validationMetrics[0];
+         }
+         validationMetricLast = validationMetrics[0];
+      }
+   }
+   CHECK(validationMetricLast < validationMetricFirst);
+
+   const FloatEbmType * const aModel0 = GetCurrentModelFeatureCombination(apEbmBoosting[0], 2);
+   const FloatEbmType * const aModel1 = GetCurrentModelFeatureCombination(apEbmBoosting[1], 2);
+   for(size_t iScore = 0; iScore < 3 * 3 * 5; ++iScore) {
+      CHECK(!std::isnan(aModel0[iScore]));
+      CHECK_APPROX(aModel0[iScore], aModel1[iScore]);
+   }
+
+   FreeBoosting(apEbmBoosting[0]);
+   FreeBoosting(apEbmBoosting[1]);
+}
+
+TEST_CASE("3 dimensional featureCombination splits off the box that differs, boosting, regression") {
+   const BoxRegressionProblem box({ 3, 4, 2 }, { 0, 2, 1 }, { 1, 4, 2 });
+
+   TestApi test = TestApi(k_learningTypeRegression);
+   box.AddTo(test);
+   test.InitializeBoosting();
+
+   const FloatEbmType validationMetric = test.Boost(0, {}, {}, FloatEbmType { 1 });
+   CHECK_APPROX(validationMetric, FloatEbmType { 0 });
+   CHECK(box.IsModelRecovered(test));
+}
+
+TEST_CASE("mostly empty bins split halfway across the empty run, boosting, regression") {
+   // only 3 of our 256 bins have instances, so our sweep only visits those, and our split lands halfway between the active bins that it separates
+   std::vector<RegressionInstance> instances;
+   for(size_t iInstance = 0; iInstance < 4; ++iInstance) {
+      instances.push_back(RegressionInstance(FloatEbmType { 0 }, { 10 }));
+      instances.push_back(RegressionInstance(FloatEbmType { 10 }, { 200 }));
+      instances.push_back(RegressionInstance(FloatEbmType { 10 }, { 250 }));
+   }
+
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(256) });
+   test.AddFeatureCombinations({ { 0 } });
+   test.AddTrainingInstances(instances);
+   test.AddValidationInstances(instances);
+   test.InitializeBoosting();
+
+   const FloatEbmType validationMetric = test.Boost(0, {}, {}, FloatEbmType { 1 }, 1);
+   CHECK_APPROX(validationMetric, FloatEbmType { 0 });
+   for(size_t iBin = 0; iBin < 256; ++iBin) {
+      // (10 + 200) / 2 == 105 is the last bin on the left side of our split
+      const FloatEbmType expected = iBin <= 105 ? FloatEbmType { 0 } : FloatEbmType { 10 };
+      CHECK_APPROX(test.GetCurrentModelPredictorScore(0, { iBin }, 0), expected);
+   }
+}
+
+TEST_CASE("pairs split from the corners improve the validation metric, binary") {
+   std::vector<ClassificationInstance> training;
+   std::vector<ClassificationInstance> validation;
+   AddGridInstances(
+      120, 
+      [](const size_t i, const IntEbmType iBin0, const IntEbmType iBin1) {
+         return (3 <= iBin0) != (1 <= iBin1) || 0 == i % 7 ? IntEbmType { 1 } : IntEbmType { 0 };
+      }, 
+      &training, 
+      &validation
+   );
+
+   TestApi test = TestApi(2);
+   test.AddFeatures({ FeatureTest(5), FeatureTest(4) });
+   test.AddFeatureCombinations({ { 0, 1 } });
+   test.AddTrainingInstances(training);
+   test.AddValidationInstances(validation);
+   test.InitializeBoosting(0, { 4, 0, 0, 0, 1 });
+
+   const FloatEbmType validationMetricFirst = test.Boost(0);
+   FloatEbmType validationMetric = validationMetricFirst;
+   for(int iEpoch = 0; iEpoch < 100; ++iEpoch) {
+      validationMetric = test.Boost(0);
+   }
+   CHECK(validationMetric < validationMetricFirst * FloatEbmType { 0.75 });
+}
+
+TEST_CASE("coarse-to-fine pair splits find the exhaustive cuts inside super-bins, boosting, regression") {
+   // our cuts after bins 19 and 36 aren't on the boundaries of our super-bins of 8 bins, so the refinement has to find them
+   const BoxRegressionProblem box({ 48, 48 }, { 20, 37 }, { 48, 48 });
+
+   TestApi testExhaustive = TestApi(k_learningTypeRegression);
+   TestApi testCoarseToFine = TestApi(k_learningTypeRegression);
+   box.AddTo(testExhaustive);
+   box.AddTo(testCoarseToFine);
+   testExhaustive.InitializeBoosting();
+   testCoarseToFine.InitializeBoosting(0, { 5, 0, 0, 0, 0, 8 });
+
+   const FloatEbmType validationMetricExhaustive = testExhaustive.Boost(0, {}, {}, FloatEbmType { 1 });
+   const FloatEbmType validationMetricCoarseToFine = testCoarseToFine.Boost(0, {}, {}, FloatEbmType { 1 });
+   CHECK_APPROX(validationMetricExhaustive, FloatEbmType { 0 });
+   CHECK_APPROX(validationMetricCoarseToFine, FloatEbmType { 0 });
+   CHECK(box.IsModelRecovered(testExhaustive));
+   CHECK(box.IsModelRecovered(testCoarseToFine));
+}
+
+TEST_CASE("pair splits find a cut in the last partial block of dimension 0 cuts, boosting, regression") {
+   // 18 cuts on dimension 0 fill 2 blocks of 8 cuts and leave 2 cuts for the last block, where our cut after bin 16 lives
+   const BoxRegressionProblem box({ 19, 5 }, { 17, 2 }, { 19, 5 });
+
+   TestApi test = TestApi(k_learningTypeRegression);
+   box.AddTo(test);
+   test.InitializeBoosting();
+
+   const FloatEbmType validationMetric = test.Boost(0, {}, {}, FloatEbmType { 1 });
+   CHECK_APPROX(validationMetric, FloatEbmType { 0 });
+   CHECK(box.IsModelRecovered(test));
+}
+
+TEST_CASE("pair splits swept in blocks match pair splits swept one cut at a time, boosting, multiclass") {
+   // noisy targets put the best cuts at arbitrary places, and 21 bins on dimension 0 leave a partial block.  Sweeping blocks of cuts together 
+   // must select bit identical splits, so every validation metric and model value has to match exactly
+   std::vector<ClassificationInstance> training;
+   std::vector<ClassificationInstance> validation;
+   RandomStream randomStream(randomSeed);
+   if(!randomStream.IsSuccess()) {
+      exit(1);
+   }
+   for(size_t i = 0; i < 1000; ++i) {
+      const IntEbmType iBin0 = static_cast<IntEbmType>(randomStream.Next(21));
+      const IntEbmType iBin1 = static_cast<IntEbmType>(randomStream.Next(11));
+      // a quarter of our targets are random
+      const IntEbmType target = 0 == randomStream.Next(4) ? static_cast<IntEbmType>(randomStream.Next(3)) : (iBin0 / 7 + iBin1 / 4) % 3;
+      if(0 == i % 4) {
+         validation.push_back(ClassificationInstance(target, { iBin0, iBin1 }));
+      } else {
+         training.push_back(ClassificationInstance(target, { iBin0, iBin1 }));
+      }
+   }
+
+   TestApi testBlocks = TestApi(3);
+   TestApi testSeparately = TestApi(3);
+   for(TestApi * const pTest : { &testBlocks, &testSeparately }) {
+      pTest->AddFeatures({ FeatureTest(21), FeatureTest(11) });
+      pTest->AddFeatureCombinations({ { 0, 1 } });
+      pTest->AddTrainingInstances(training);
+      pTest->AddValidationInstances(validation);
+   }
+   testBlocks.InitializeBoosting(2);
+   testSeparately.InitializeBoosting(2, { 8, 0, 0, 0, 0, 0, 0, 0, 1 });
+
+   for(int iEpoch = 0; iEpoch < 30; ++iEpoch) {
+      const FloatEbmType validationMetricBlocks = testBlocks.Boost(0, {}, {}, FloatEbmType { 0.1 });
+      const FloatEbmType validationMetricSeparately = testSeparately.Boost(0, {}, {}, FloatEbmType { 0.1 });
+      CHECK(validationMetricBlocks == validationMetricSeparately);
+   }
+   for(size_t iBin0 = 0; iBin0 < 21; ++iBin0) {
+      for(size_t iBin1 = 0; iBin1 < 11; ++iBin1) {
+         for(size_t iScore = 0; iScore < 3; ++iScore) {
+            CHECK(testBlocks.GetCurrentModelPredictorScore(0, { iBin0, iBin1 }, iScore) == 
+               testSeparately.GetCurrentModelPredictorScore(0, { iBin0, iBin1 }, iScore));
+         }
+      }
+   }
+}
+
+TEST_CASE("anchored interaction scores match pairwise interaction scores, multiclass and regression") {
+   // more partners than fit in a single pass, so that the anchored histograms get built over several passes
+   constexpr size_t k_cFeatures = 70;
+   constexpr size_t k_cInstances = 300;
+   constexpr IntEbmType k_iFeatureAnchor = 2;
+
+   std::vector<EbmNativeFeature> features(k_cFeatures);
+   for(size_t iFeature = 0; iFeature < k_cFeatures; ++iFeature) {
+      features[iFeature].featureType = FeatureTypeOrdinal;
+      features[iFeature].hasMissing = 0;
+      // feature 0 has only 1 bin, which can't interact with anything
+      features[iFeature].countBins = static_cast<IntEbmType>(1 + iFeature % 6);
+   }
+   std::vector<IntEbmType> binnedData(k_cFeatures * k_cInstances);
+   std::vector<IntEbmType> classificationTargets(k_cInstances);
+   std::vector<FloatEbmType> regressionTargets(k_cInstances);
+   unsigned int random = 12345;
+   for(size_t iFeature = 0; iFeature < k_cFeatures; ++iFeature) {
+      for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+         random = random * 1103515245 + 12345;
+         binnedData[iFeature * k_cInstances + iInstance] = static_cast<IntEbmType>((random >> 16) % (1 + iFeature % 6));
+      }
+   }
+   for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+      random = random * 1103515245 + 12345;
+      const IntEbmType interacting = binnedData[k_iFeatureAnchor * k_cInstances + iInstance] * binnedData[5 * k_cInstances + iInstance];
+      classificationTargets[iInstance] = (interacting + static_cast<IntEbmType>((random >> 16) % 2)) % 3;
+      regressionTargets[iInstance] = static_cast<FloatEbmType>(interacting) + static_cast<FloatEbmType>((random >> 16) % 100) / 100;
+   }
+   std::vector<FloatEbmType> predictorScores(3 * k_cInstances, FloatEbmType { 0 });
+   std::vector<IntEbmType> partners(k_cFeatures);
+   for(size_t iFeature = 0; iFeature < k_cFeatures; ++iFeature) {
+      partners[iFeature] = static_cast<IntEbmType>(k_cFeatures - 1 - iFeature);
+   }
+
+   PEbmInteraction apEbmInteraction[2];
+   apEbmInteraction[0] = InitializeInteractionClassification(
+      3, k_cFeatures, &features[0], k_cInstances, &binnedData[0], &classificationTargets[0], &predictorScores[0], nullptr);
+   apEbmInteraction[1] = InitializeInteractionRegression(
+      k_cFeatures, &features[0], k_cInstances, &binnedData[0], &regressionTargets[0], &predictorScores[0], nullptr);
+   for(PEbmInteraction pEbmInteraction : apEbmInteraction) {
+      CHECK(nullptr != pEbmInteraction);
+      std::vector<FloatEbmType> scores(k_cFeatures, FloatEbmType { -1 });
+      IntEbmType ret = GetInteractionScoresAnchored(pEbmInteraction, k_iFeatureAnchor, k_cFeatures, &partners[0], &scores[0]);
+      CHECK(0 == ret);
+      for(size_t iPartner = 0; iPartner < k_cFeatures; ++iPartner) {
+         const IntEbmType featureIndexes[] { k_iFeatureAnchor, partners[iPartner] };
+         FloatEbmType interactionScore = FloatEbmType { -1 };
+         ret = GetInteractionScore(pEbmInteraction, 2, featureIndexes, &interactionScore);
+         CHECK(0 == ret);
+         CHECK(interactionScore == scores[iPartner]);
+      }
+      CHECK(0 == scores[k_cFeatures - 1]);
+      CHECK(0 < scores[k_cFeatures - 1 - 5]);
+      FreeInteraction(pEbmInteraction);
+   }
+}
+
+TEST_CASE("top interaction pairs match the exhaustive search, multiclass and regression") {
+   constexpr size_t k_cFeatures = 9;
+   constexpr size_t k_cInstances = 1000;
+   const IntEbmType aBins[k_cFeatures] { 30, 3, 14, 1, 5, 9, 20, 2, 16 };
+   // bound the pairs with more than 64 tensor cells before scoring them, so that both kinds of pairs are exercised without big tensors
+   const FloatEbmType tempParams[] { 1, 64 };
+
+   std::vector<EbmNativeFeature> features(k_cFeatures);
+   for(size_t iFeature = 0; iFeature < k_cFeatures; ++iFeature) {
+      features[iFeature].featureType = FeatureTypeOrdinal;
+      features[iFeature].hasMissing = 0;
+      features[iFeature].countBins = aBins[iFeature];
+   }
+   std::vector<IntEbmType> binnedData(k_cFeatures * k_cInstances);
+   std::vector<IntEbmType> classificationTargets(k_cInstances);
+   std::vector<FloatEbmType> regressionTargets(k_cInstances);
+   unsigned int random = 54321;
+   for(size_t iFeature = 0; iFeature < k_cFeatures; ++iFeature) {
+      for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+         random = random * 1103515245 + 12345;
+         binnedData[iFeature * k_cInstances + iInstance] = static_cast<IntEbmType>((random >> 16) % aBins[iFeature]);
+      }
+   }
+   for(size_t iInstance = 0; iInstance < k_cInstances; ++iInstance) {
+      random = random * 1103515245 + 12345;
+      // a strong interaction between two wide features, so that the bounds of the weaker pairs fall below it
+      const bool bInteracting = (15 <= binnedData[0 * k_cInstances + iInstance]) == (10 <= binnedData[6 * k_cInstances + iInstance]);
+      classificationTargets[iInstance] = bInteracting ? 2 : static_cast<IntEbmType>((random >> 16) % 8 == 0 ? 1 : 0);
+      regressionTargets[iInstance] = (bInteracting ? FloatEbmType { 10 } : FloatEbmType { -10 }) + static_cast<FloatEbmType>((random >> 16) % 100) / 100;
+   }
+   std::vector<FloatEbmType> predictorScores(3 * k_cInstances, FloatEbmType { 0 });
+
+   PEbmInteraction apEbmInteraction[2];
+   apEbmInteraction[0] = InitializeInteractionClassification(
+      3, k_cFeatures, &features[0], k_cInstances, &binnedData[0], &classificationTargets[0], &predictorScores[0], tempParams);
+   apEbmInteraction[1] = InitializeInteractionRegression(
+      k_cFeatures, &features[0], k_cInstances, &binnedData[0], &regressionTargets[0], &predictorScores[0], tempParams);
+   for(PEbmInteraction pEbmInteraction : apEbmInteraction) {
+      CHECK(nullptr != pEbmInteraction);
+
+      std::vector<std::pair<FloatEbmType, std::pair<IntEbmType, IntEbmType>>> exhaustive;
+      for(IntEbmType iFeature1 = 0; iFeature1 < static_cast<IntEbmType>(k_cFeatures); ++iFeature1) {
+         for(IntEbmType iFeature2 = iFeature1 + 1; iFeature2 < static_cast<IntEbmType>(k_cFeatures); ++iFeature2) {
+            const IntEbmType featureIndexes[] { iFeature1, iFeature2 };
+            FloatEbmType interactionScore = FloatEbmType { -1 };
+            CHECK(0 == GetInteractionScore(pEbmInteraction, 2, featureIndexes, &interactionScore));
+            // negate the score so that sorting ascending orders by descending score and then by the feature indexes
+            exhaustive.push_back(std::make_pair(-interactionScore, std::make_pair(iFeature1, iFeature2)));
+         }
+      }
+      std::sort(exhaustive.begin(), exhaustive.end());
+
+      for(const IntEbmType countPairsMax : { 1, 3, 36, 50 }) {
+         std::vector<IntEbmType> pairFeatureIndexes(2 * countPairsMax, IntEbmType { -1 });
+         std::vector<FloatEbmType> interactionScores(countPairsMax, FloatEbmType { -1 });
+         IntEbmType countPairs = -1;
+         const IntEbmType ret = GetTopInteractionPairs(pEbmInteraction, countPairsMax, &pairFeatureIndexes[0], &interactionScores[0], &countPairs);
+         CHECK(0 == ret);
+         CHECK(std::min(countPairsMax, static_cast<IntEbmType>(exhaustive.size())) == countPairs);
+         for(IntEbmType iPair = 0; iPair < countPairs; ++iPair) {
+            CHECK(-exhaustive[iPair].first == interactionScores[iPair]);
+            CHECK(exhaustive[iPair].second.first == pairFeatureIndexes[2 * iPair]);
+            CHECK(exhaustive[iPair].second.second == pairFeatureIndexes[2 * iPair + 1]);
+         }
+      }
+      CHECK(0 == exhaustive[0].second.first);
+      CHECK(6 == exhaustive[0].second.second);
+      FreeInteraction(pEbmInteraction);
+   }
+}
+
+TEST_CASE("constant and zero model updates match a zero feature FeatureCombination, boosting, multiclass") {
+   TestApi testZeroFeaturesInCombination = TestApi(3);
+   testZeroFeaturesInCombination.AddFeatures({ FeatureTest(5) });
+   testZeroFeaturesInCombination.AddFeatureCombinations({ {} });
+   testZeroFeaturesInCombination.AddTrainingInstances({ ClassificationInstance(0, { 0 }), ClassificationInstance(1, { 2 }), ClassificationInstance(2, { 4 }), ClassificationInstance(2, { 3 }) });
+   testZeroFeaturesInCombination.AddValidationInstances({ ClassificationInstance(1, { 1 }), ClassificationInstance(2, { 4 }) });
+   testZeroFeaturesInCombination.InitializeBoosting();
+
+   TestApi testConstant = TestApi(3);
+   testConstant.AddFeatures({ FeatureTest(5) });
+   testConstant.AddFeatureCombinations({ { 0 } });
+   testConstant.AddTrainingInstances({ ClassificationInstance(0, { 0 }), ClassificationInstance(1, { 2 }), ClassificationInstance(2, { 4 }), ClassificationInstance(2, { 3 }) });
+   testConstant.AddValidationInstances({ ClassificationInstance(1, { 1 }), ClassificationInstance(2, { 4 }) });
+   testConstant.InitializeBoosting();
+
+   FloatEbmType validationMetricPrev = FloatEbmType { 0 };
+   for(int iEpoch = 0; iEpoch < 100; ++iEpoch) {
+      // with no splits allowed every bin of the update holds the same values, which we apply without unpacking the binned data
+      const FloatEbmType validationMetricZeroFeaturesInCombination = testZeroFeaturesInCombination.Boost(0);
+      const FloatEbmType validationMetricConstant = testConstant.Boost(0, {}, {}, k_learningRateDefault, 0);
+      CHECK(validationMetricZeroFeaturesInCombination == validationMetricConstant);
+      for(size_t iClass = 0; iClass < 3; ++iClass) {
+         const FloatEbmType modelValueZeroFeaturesInCombination = testZeroFeaturesInCombination.GetCurrentModelPredictorScore(0, {}, iClass);
+         for(size_t iBin = 0; iBin < 5; ++iBin) {
+            CHECK(modelValueZeroFeaturesInCombination == testConstant.GetCurrentModelPredictorScore(0, { iBin }, iClass));
+         }
+      }
+      if(0 != iEpoch) {
+         CHECK(validationMetricConstant < validationMetricPrev);
+      }
+
+      // a zero learning rate makes an all zero update, which leaves the training residuals and the validation metric where they were
+      const FloatEbmType validationMetricZero = testConstant.Boost(0, {}, {}, FloatEbmType { 0 });
+      CHECK(validationMetricConstant == validationMetricZero);
+      validationMetricPrev = validationMetricZero;
+   }
+   // a step that can split still learns from the residuals that the constant and zero updates left behind
+   const FloatEbmType validationMetricSplit = testConstant.Boost(0);
+   CHECK(validationMetricSplit < validationMetricPrev);
+}
 
 // TODO: decide what to do with this test
 //TEST_CASE("infinite target training set, boosting, regression") {